@@ -0,0 +1,739 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ To benchmark GOOD software end to end against the local stand-ins of the GNSS archives
+
+ The remote files are taken from the plan of 'run_GOOD' itself ('run_GOOD <cfg> --plan'), so the directory layouts
+ of CDDIS, IGN, WHU, UNAVCO, HK, and the others always follow the ones in the source codes. Synthetic files are
+ made for them (Hatanaka '*.d.Z' and '*.crx.gz', broadcast ephemeris, SP3, CLK, ERP, and IONEX), and every archive
+ is served by a local FTP (for 'ftp'/'ftps') or HTTP (for 'http'/'https') server with the latency and the bandwidth
+ injected. 'run_GOOD' downloads them through the option 'urlRedirect', and the files/s, MB/s, and CPU time per
+ file are reported, so that the regressions of the throughput are caught by comparing with a baseline.
+
+ Usage: python bench_GOOD.py -bin <run_GOOD> [-dir_work <dir_work_path>] [-ftp <FTP_archive>] [-time <yyyy> <doy> <ndays>]
+           [-sites <nsites>] [-epochs <nepochs>] [-scenario <name> ...] [-latency <ms>] [-bandwidth <KB/s>]
+           [-max_conn <nconn>] [-parallel <nparallel>] [-adapt <0|1>] [-runs <nruns>] [-save <json_file>]
+           [-baseline <json_file>] [-tolerance <ratio>]
+
+ OPTIONS:
+   <-bin>          - The executable program of GOOD, i.e., '-bin ../run_GOOD'
+   <-dir_work>     - [optional] The working directory, where the synthetic archives ('archive_<nepochs>', kept for the
+                      next runs), the configure files, and the downloaded files are stored, 'bench_work' by default
+   <-ftp>          - [optional] FTP archive of the observations and products, 'cddis' (default), 'ign', or 'whu'
+   <-time>         - [optional] time setting, 1st: 4-digit year, 2nd: day of year, 3rd: number of consecutive days,
+                      '-time 2022 32 1' by default
+   <-sites>        - [optional] number of the synthetic sites in the site list, 20 by default
+   <-epochs>       - [optional] number of the epochs in every observation file, 2880 (the daily 30s file) by default
+   <-scenario>     - [optional] the scenarios run one by one, all of them by default:
+                      'igs': IGS daily observations (RINEX 2, Hatanaka '*.d.Z') from the FTP archive;
+                      'mgex': MGEX daily observations (RINEX 3, Hatanaka '*.crx.gz') from the FTP archive;
+                      'hk': Hong Kong CORS 30s observations ('*.crx.gz');
+                      'pbo3': UNAVCO daily observations ('*.crx.gz');
+                      'ngs': NGS/NOAA CORS daily observations ('*.d.gz') from AWS by HTTPS;
+                      'prod': broadcast ephemeris, SP3, CLK, ERP, and IONEX from the FTP archive
+   <-latency>      - [optional] the round-trip time injected into every command and data connection (ms), 0 by default
+   <-bandwidth>    - [optional] the bandwidth of every data connection (KB/s), 0 (no limit) by default
+   <-max_conn>     - [optional] the connections to an archive at the same time, the ones over it are refused by FTP '421'
+                      or HTTP '503' as an archive throttling the clients does, 0 (no limit) by default
+   <-parallel>     - [optional] 'maxParallel' of GOOD, 4 by default
+   <-adapt>        - [optional] 'adaptParallel' of GOOD (0: off  1: on), 1 by default
+   <-runs>         - [optional] number of runs of every scenario, whose median is reported, 3 by default
+   <-save>         - [optional] the result is saved to the JSON file, i.e., as the baseline of the next runs
+   <-baseline>     - [optional] the result is compared with the baseline (JSON file), and the exit code is 1 if the
+                      files/s or the MB/s is lower, or the CPU time per file is higher, than the tolerance allows
+   <-tolerance>    - [optional] the tolerance of the comparison with the baseline, 0.1 (10%) by default
+
+EXAMPLES: python bench_GOOD.py -bin ../run_GOOD
+          python bench_GOOD.py -bin ../run_GOOD -ftp ign -sites 50 -latency 80 -bandwidth 2000 -save base.json
+          python bench_GOOD.py -bin ../run_GOOD -ftp ign -sites 50 -latency 80 -bandwidth 2000 -baseline base.json
+
+Changes: 18-Oct-2026   create the benchmark with the local stand-ins of the archives
+         18-Oct-2026   add the option '-max_conn' for the archives throttling the clients (see 'adaptParallel' of GOOD)
+         18-Oct-2026   the HTTP stand-ins give 'ETag' and answer 'If-None-Match' (see 'refresh' of GOOD)
+
+ to get help, type:
+           python bench_GOOD.py -h
+
+"""
+################################################################################
+# Import Python modules
+import os, sys, re, json, time, gzip, random, shutil, socket, platform, argparse, subprocess, threading
+import email.utils
+try:
+    import socketserver
+    import http.server as httpserver
+except ImportError:  # Python 2
+    print('*** ERROR: Python 3 is needed for the benchmark!\n')
+    sys.exit(1)
+try:
+    import resource  # the CPU time of the child processes, NOT available on Windows
+except ImportError:
+    resource = None
+
+
+################################################################################
+# constants
+################################################################################
+CHUNK = 16384                  # the bytes sent at a time by the stand-ins
+SEED = 20261018                # the seed of the synthetic data, so that the archives are the same in every run
+SCENARIOS = ['igs', 'mgex', 'hk', 'pbo3', 'ngs', 'prod']
+
+
+################################################################################
+# FUNCTION: the synthetic files
+################################################################################
+def hline(text, label):
+    """ a line of RINEX header, the label is in the columns 61-80 """
+    return text[:60].ljust(60) + label
+
+
+def sat_values(rnd, ntype, nepoch):
+    """ the smooth observations of a satellite (in 0.001 units), which are well compressed by the differences """
+    values = []
+    for j in range(ntype):
+        kind = j % 4
+        if kind == 0:    # pseudorange (m)
+            v0, v1, v2 = rnd.randint(20000000000, 26000000000), rnd.randint(-800000, 800000), rnd.randint(-50, 50)
+        elif kind == 1:  # carrier phase (cycles)
+            v0, v1, v2 = rnd.randint(100000000000, 140000000000), rnd.randint(-4000000, 4000000), rnd.randint(-250, 250)
+        elif kind == 2:  # Doppler (Hz)
+            v0, v1, v2 = rnd.randint(-4000000, 4000000), rnd.randint(-300, 300), 0
+        else:            # signal strength (dB-Hz)
+            v0, v1, v2 = rnd.randint(35000, 50000), 0, 0
+        values.append([v0 + v1 * k + v2 * k * k + (rnd.randint(-3, 3) if kind < 2 else 0) for k in range(nepoch)])
+    return values
+
+
+def text_diff(old, new):
+    """ the differences of the text to the previous one in Compact RINEX, ' ': NOT changed, '&': changed to space """
+    n = max(len(old), len(new))
+    old, new = old.ljust(n), new.ljust(n)
+    diff = ''.join(' ' if a == b else ('&' if b == ' ' else b) for a, b in zip(old, new))
+    return diff.rstrip()
+
+
+def make_crx(ver, site, yyyy, doy, nepoch, interval, rnd):
+    """ the observation file in Compact RINEX 1.0 (RINEX 2) or 3.0 (RINEX 3), with the differences of the 3rd order """
+    t0 = time.mktime((yyyy, 1, 1, 0, 0, 0, 0, 0, 0)) - time.timezone + (doy - 1) * 86400
+    if ver == 1:
+        sats = ['G%02d' % (i + 1) for i in range(10)]
+        types = ['C1', 'L1', 'L2', 'P2']
+        lines = [hline('1.0                 COMPACT RINEX FORMAT', 'CRINEX VERS   / TYPE'),
+                 hline('bench_GOOD          ' + time.strftime('%d-%b-%y %H:%M', time.gmtime()), 'CRINEX PROG / DATE'),
+                 hline('     2.11           OBSERVATION DATA    G (GPS)', 'RINEX VERSION / TYPE'),
+                 hline(site.upper(), 'MARKER NAME'),
+                 hline('%6d' % len(types) + ''.join('%6s' % t for t in types), '# / TYPES OF OBSERV'),
+                 hline('%10.3f' % interval, 'INTERVAL'),
+                 hline('', 'END OF HEADER')]
+        ntypes = {'G': len(types)}
+    else:
+        sats = ['G%02d' % (i + 1) for i in range(10)] + ['E%02d' % (i + 1) for i in range(6)]
+        types = ['C1C', 'L1C', 'D1C', 'S1C']
+        lines = [hline('3.0                 COMPACT RINEX FORMAT', 'CRINEX VERS   / TYPE'),
+                 hline('bench_GOOD          ' + time.strftime('%d-%b-%y %H:%M', time.gmtime()), 'CRINEX PROG / DATE'),
+                 hline('     3.04           OBSERVATION DATA    M', 'RINEX VERSION / TYPE'),
+                 hline(site.upper(), 'MARKER NAME'),
+                 hline('G%5d ' % len(types) + ' '.join(types), 'SYS / # / OBS TYPES'),
+                 hline('E%5d ' % len(types) + ' '.join(types), 'SYS / # / OBS TYPES'),
+                 hline('%10.3f' % interval, 'INTERVAL'),
+                 hline('', 'END OF HEADER')]
+        ntypes = {'G': len(types), 'E': len(types)}
+
+    values = dict((s, sat_values(rnd, ntypes[s[0]], nepoch)) for s in sats)
+    arcs = dict((s, [None] * ntypes[s[0]]) for s in sats)  # [order, u] of the differential sequences
+    prev = ''
+    for k in range(nepoch):
+        tt = time.gmtime(t0 + k * interval)
+        if ver == 1:
+            epoch = ' %02d %2d %2d %2d %2d%11.7f  0%3d' % (tt.tm_year % 100, tt.tm_mon, tt.tm_mday, tt.tm_hour, tt.tm_min,
+                                                            tt.tm_sec, len(sats)) + ''.join(sats)
+            lines.append('&' + epoch[1:] if k == 0 else text_diff(prev, epoch))
+        else:
+            epoch = '> %4d %02d %02d %02d %02d%11.7f  0%3d      ' % (tt.tm_year, tt.tm_mon, tt.tm_mday, tt.tm_hour, tt.tm_min,
+                                                                   tt.tm_sec, len(sats)) + ''.join(sats)
+            lines.append(epoch if k == 0 else text_diff(prev, epoch))
+        prev = epoch
+        lines.append('')  # NO receiver clock offset
+        for s in sats:
+            fields = []
+            for j, arc in enumerate(arcs[s]):
+                v = values[s][j][k]
+                if arc is None:
+                    arcs[s][j] = [0, [v, 0, 0, 0]]
+                    fields.append('3&%d' % v)
+                    continue
+                order, u = arc[0] + 1 if arc[0] < 3 else 3, arc[1]
+                d = v - sum(u[:order])
+                u[order] = d
+                for i in range(order, 0, -1):
+                    u[i - 1] += u[i]
+                arc[0] = order
+                fields.append('%d' % d)
+            lines.append(' '.join(fields))
+    return ('\n'.join(lines) + '\n').encode()
+
+
+def make_text(kind, name, nline, rnd):
+    """ the product in plain text, i.e., SP3, CLK, ERP, IONEX, or broadcast ephemeris, which is only as big as a real one """
+    lines = ['%-60s%s' % ('     bench_GOOD synthetic ' + kind, 'COMMENT'), '%-60s%s' % (name, 'COMMENT')]
+    for i in range(nline):
+        if kind == 'sp3':
+            lines.append('PG%02d %13.6f %13.6f %13.6f %13.6f' % (i % 32 + 1, rnd.uniform(-26000, 26000),
+                         rnd.uniform(-26000, 26000), rnd.uniform(-26000, 26000), rnd.uniform(-500, 500)))
+        elif kind == 'clk':
+            lines.append('AS G%02d  2022 02 01 %02d %02d %9.6f  1   %19.12e' % (i % 32 + 1, i // 3840 % 24,
+                         i // 64 % 60, i % 2 * 30.0, rnd.uniform(-1e-3, 1e-3)))
+        elif kind == 'ionex':
+            lines.append(''.join('%5d' % rnd.randint(0, 400) for j in range(16)))
+        else:
+            lines.append(' '.join('%19.12e' % rnd.uniform(-1e4, 1e4) for j in range(4)))
+    return ('\n'.join(lines) + '\n').encode()
+
+
+def lzw_compress(data, maxbits=16):
+    """ Unix 'compress' (LZW), without the block mode, the codes of a width are written in the groups of 8 codes """
+    out = bytearray(b'\x1f\x9d' + bytes([maxbits]))
+    maxmax = 1 << maxbits
+    table = {}
+    nbits, free, ncode, ncodes = 9, 256, 0, 0
+    buf, nbuf = 0, 0
+
+    def put(code):
+        nonlocal nbits, ncode, ncodes, buf, nbuf
+        dfree = min(256 + max(ncodes - 1, 0), maxmax)  # the next entry of the decoder
+        while nbits < maxbits and dfree > (1 << nbits) - 1:
+            nbuf += ((8 - ncode % 8) % 8) * nbits      # the rest of the group is skipped
+            ncode = 0
+            nbits += 1
+        buf |= code << nbuf
+        nbuf += nbits
+        ncode += 1
+        ncodes += 1
+        while nbuf >= 8:
+            out.append(buf & 0xff)
+            buf >>= 8
+            nbuf -= 8
+
+    if data:
+        w = data[0]
+        for c in data[1:]:
+            key = (w << 8) | c
+            code = table.get(key)
+            if code is not None:
+                w = code
+                continue
+            put(w)
+            if free < maxmax:
+                table[key] = free
+                free += 1
+            w = c
+        put(w)
+    if nbuf > 0:
+        out.append(buf & 0xff)
+    return bytes(out)
+
+
+def resolve_name(name):
+    """ the name of the synthetic file matching the pattern planned, i.e., 'BS00*20220320000_01D_30S_MO.crx.*' """
+    name = re.sub(r'^([A-Za-z0-9]{4})\*(\d{11}_)', r'\g<1>00BEN_R_\2', name)  # the long name of the site
+    if name.endswith('.*'):
+        name = name[:-2] + ('.gz' if '_' in name else '.Z')
+    name = name.replace('_*_', '_05M_').replace('*', '0').replace('?', '0')
+    return name
+
+
+def make_file(path, yyyy, doy, nepoch, rnd):
+    """ the synthetic file, which is compressed by the suffix of its name """
+    name = os.path.basename(path)
+    base, ext = os.path.splitext(name)
+    if ext not in ('.gz', '.Z'):
+        base = name
+    low = base.lower()
+    if low.endswith('.crx') or re.search(r'\.\d\dd$', low):
+        interval = 30.0 if '_30s_' in low or not low.endswith('.crx') else 15.0 if '_15s_' in low else 30.0
+        data = make_crx(3 if low.endswith('.crx') else 1, base[:4], yyyy, doy, nepoch, interval, rnd)
+    elif '.sp3' in low:
+        data = make_text('sp3', base, 96 * 32, rnd)
+    elif '.clk' in low:
+        data = make_text('clk', base, 2880 * 32, rnd)
+    elif low.endswith('i') or '.inx' in low:
+        data = make_text('ionex', base, 13 * 71 * 5, rnd)
+    elif '_mn.' in low or re.search(r'\.\d\d[nglp]$', low):
+        data = make_text('nav', base, 20000, rnd)
+    else:
+        data = make_text('other', base, 2000, rnd)
+    if ext == '.gz':
+        data = gzip.compress(data, 6)
+    elif ext == '.Z':
+        data = lzw_compress(data)
+    if not os.path.isdir(os.path.dirname(path)):
+        os.makedirs(os.path.dirname(path))
+    with open(path + '.tmp', 'wb') as f_w:
+        f_w.write(data)
+    os.replace(path + '.tmp', path)
+
+
+################################################################################
+# FUNCTION: the local stand-ins of the archives
+################################################################################
+class Link(object):
+    """ the latency, the bandwidth, and the limit of connections injected, and the files and bytes served """
+    def __init__(self, latency, bandwidth, maxconn):
+        self.latency = latency      # the round-trip time (s)
+        self.bandwidth = bandwidth  # bytes/s of every data connection, 0: no limit
+        self.maxconn = maxconn      # the connections to an archive at the same time, 0: no limit
+        self.lock = threading.Lock()
+        self.files = 0
+        self.bytes = 0
+        self.refused = 0
+
+    def wait(self):
+        if self.latency > 0:
+            time.sleep(self.latency)
+
+    def send(self, sock, data):
+        """ send the data as fast as the bandwidth allows """
+        t0 = time.time()
+        for i in range(0, len(data), CHUNK):
+            sock.sendall(data[i:i + CHUNK])
+            with self.lock:
+                self.bytes += len(data[i:i + CHUNK])
+            if self.bandwidth > 0:
+                ahead = (i + CHUNK) / float(self.bandwidth) - (time.time() - t0)
+                if ahead > 0:
+                    time.sleep(ahead)
+
+    def served(self):
+        with self.lock:
+            self.files += 1
+
+    def enter(self, server):
+        """ take a connection to the archive, False: refused as an archive throttling the clients does """
+        with self.lock:
+            if self.maxconn > 0 and server.nconn >= self.maxconn:
+                self.refused += 1
+                return False
+            server.nconn += 1
+            return True
+
+    def leave(self, server):
+        with self.lock:
+            server.nconn -= 1
+
+
+class FtpHandler(socketserver.StreamRequestHandler):
+    """ the FTP server of an archive (passive mode only) """
+    def reply(self, text):
+        self.server.link.wait()
+        self.wfile.write((text + '\r\n').encode())
+
+    def local(self, arg):
+        path = os.path.normpath(os.path.join(self.server.root, arg.lstrip('/')))
+        return path if path.startswith(self.server.root) else ''
+
+    def handle(self):
+        if not self.server.link.enter(self.server):
+            self.reply('421 Too many connections')
+            return
+        try:
+            self.session()
+        finally:
+            self.server.link.leave(self.server)
+
+    def session(self):
+        self.reply('220 bench_GOOD stand-in of ' + self.server.host)
+        pasv, rest = None, 0
+        while True:
+            line = self.rfile.readline()
+            if not line:
+                break
+            cmd, _, arg = line.decode('latin-1').strip().partition(' ')
+            cmd = cmd.upper()
+            path = self.local(arg) if arg else ''
+            if cmd == 'USER':
+                self.reply('331 password please')
+            elif cmd == 'PASS':
+                self.reply('230 logged in')
+            elif cmd in ('TYPE', 'NOOP'):
+                self.reply('200 ok')
+            elif cmd in ('EPSV', 'PASV'):
+                if pasv:
+                    pasv.close()
+                pasv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                pasv.bind(('127.0.0.1', 0))
+                pasv.listen(1)
+                port = pasv.getsockname()[1]
+                if cmd == 'EPSV':
+                    self.reply('229 Entering Extended Passive Mode (|||%d|)' % port)
+                else:
+                    self.reply('227 Entering Passive Mode (127,0,0,1,%d,%d)' % (port >> 8, port & 0xff))
+            elif cmd == 'REST':
+                rest = int(arg)
+                self.reply('350 restarting at %d' % rest)
+            elif cmd in ('RETR', 'NLST', 'LIST'):
+                if cmd == 'RETR' and os.path.isfile(path):
+                    with open(path, 'rb') as f_r:
+                        f_r.seek(rest)
+                        data = f_r.read()
+                elif cmd != 'RETR' and os.path.isdir(path):
+                    data = ''.join(n + '\r\n' for n in sorted(os.listdir(path))).encode()
+                else:
+                    data = None
+                rest = 0
+                if data is None or not pasv:
+                    self.reply('550 not found')
+                    continue
+                self.reply('150 opening data connection')
+                conn, _ = pasv.accept()
+                pasv.close()
+                pasv = None
+                self.server.link.wait()
+                try:
+                    self.server.link.send(conn, data)
+                finally:
+                    conn.close()
+                if cmd == 'RETR':
+                    self.server.link.served()
+                self.reply('226 transfer complete')
+            elif cmd in ('SIZE', 'MDTM'):
+                # the modification time of a directory is given as well, as ProFTPD does
+                if not os.path.isfile(path) and not (cmd == 'MDTM' and os.path.isdir(path)):
+                    self.reply('550 not found')
+                elif cmd == 'SIZE':
+                    self.reply('213 %d' % os.path.getsize(path))
+                else:
+                    self.reply('213 ' + time.strftime('%Y%m%d%H%M%S', time.gmtime(os.path.getmtime(path))))
+            elif cmd == 'QUIT':
+                self.reply('221 bye')
+                break
+            else:
+                self.reply('502 not implemented')
+        if pasv:
+            pasv.close()
+
+
+class HttpHandler(httpserver.BaseHTTPRequestHandler):
+    """ the HTTP server of an archive, with keep-alive, "Range", and the index pages of the directories """
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, format, *args):
+        pass
+
+    def handle(self):
+        self.refused = not self.server.link.enter(self.server)
+        try:
+            httpserver.BaseHTTPRequestHandler.handle(self)
+        finally:
+            if not self.refused:
+                self.server.link.leave(self.server)
+
+    def do_HEAD(self):
+        self.respond(False)
+
+    def do_GET(self):
+        self.respond(True)
+
+    def respond(self, body):
+        self.server.link.wait()
+        if self.refused:
+            self.send_response(503)
+            self.send_header('Content-Length', '0')
+            self.send_header('Connection', 'close')
+            self.end_headers()
+            self.close_connection = True
+            return
+        path = os.path.normpath(os.path.join(self.server.root, self.path.split('?')[0].lstrip('/')))
+        if not path.startswith(self.server.root) or not os.path.exists(path):
+            self.send_response(404)
+            self.send_header('Content-Length', '0')
+            self.end_headers()
+            return
+        mtime = int(os.path.getmtime(path))
+        etag = '"%x-%x"' % (mtime, os.path.getsize(path))
+        since = email.utils.parsedate_tz(self.headers.get('If-Modified-Since', ''))
+        match = self.headers.get('If-None-Match')
+        if (match is not None and match == etag) or (match is None and since and mtime <= email.utils.mktime_tz(since)):
+            self.send_response(304)
+            self.send_header('ETag', etag)
+            self.end_headers()
+            return
+        if os.path.isdir(path):
+            data = ''.join('<a href="%s">%s</a>\n' % (n, n) for n in sorted(os.listdir(path))).encode()
+            offset, code = 0, 200
+        else:
+            with open(path, 'rb') as f_r:
+                data = f_r.read()
+            m = re.match(r'bytes=(\d+)-$', self.headers.get('Range', ''))
+            offset = int(m.group(1)) if m and int(m.group(1)) < len(data) else 0
+            code = 206 if offset > 0 else 200
+        self.send_response(code)
+        self.send_header('Content-Length', str(len(data) - offset))
+        self.send_header('Last-Modified', email.utils.formatdate(mtime, usegmt=True))
+        if os.path.isfile(path):
+            self.send_header('ETag', etag)
+        if code == 206:
+            self.send_header('Content-Range', 'bytes %d-%d/%d' % (offset, len(data) - 1, len(data)))
+        self.end_headers()
+        if body:
+            self.server.link.send(self.connection, data[offset:])
+            if os.path.isfile(path):
+                self.server.link.served()
+
+
+class Server(socketserver.ThreadingMixIn, socketserver.TCPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+    def __init__(self, handler, host, root, link):
+        socketserver.TCPServer.__init__(self, ('127.0.0.1', 0), handler)
+        self.host, self.root, self.link = host, os.path.abspath(root), link
+        self.nconn = 0
+
+
+def start_servers(origins, dir_archive, link):
+    """ a server per archive, the key is the origin (i.e., 'ftps://gdc.cddis.eosdis.nasa.gov') """
+    servers = {}
+    for origin in sorted(origins):
+        scheme, host = origin.split('://')
+        handler = FtpHandler if scheme.startswith('ftp') else HttpHandler
+        srv = Server(handler, host, os.path.join(dir_archive, host), link)
+        threading.Thread(target=srv.serve_forever, daemon=True).start()
+        servers[origin] = srv
+    return servers
+
+
+################################################################################
+# FUNCTION: the configure file and the runs of GOOD
+################################################################################
+def write_cfg(cfgFile, mainDir, args, scenario, siteFile, redirect):
+    """ the configure file of the scenario, the options are the same as 'run_GOOD.py' """
+    line = ''
+    line += '# GAMP II - GOOD (Gnss Observations and prOducts Downloader) options, written by bench_GOOD.py\n'
+    line += 'mainDir           = ' + mainDir + '\n'
+    for sub in ('obs', 'nav', 'orb', 'clk', 'eop', 'obx', 'bia', 'snx', 'ion', 'ztd'):
+        line += '  %sDir          = %s\n' % (sub, sub)
+    line += '  tblDir          = tables\n'
+    line += 'logFile           = 1  ' + os.path.join(mainDir, 'log.txt') + '\n'
+    line += '3partyDir         = 0  ' + mainDir + '\n'
+    line += 'procTime          = 2  %d  %d  %d\n' % (args.time[0], args.time[1], args.time[2])
+    line += 'minusAdd1day      = 0\n'
+    line += 'printInfoWget     = 0\n'
+    line += 'maxParallel       = %d\n' % args.parallel
+    line += 'dayParallel       = 1\n'
+    line += 'adaptParallel     = %d\n' % args.adapt  # the windows are learned in every run, since 'mainDir' is cleaned
+    line += 'urlRedirect       = ' + redirect + '\n'
+    line += 'ftpDownloading    = 1  ' + args.ftp + '\n'
+    obs = {'igs': 'daily  igs', 'mgex': 'daily  mgex', 'hk': '30s  hk', 'pbo3': 'daily  pbo3', 'ngs': 'daily  ngs'}
+    prod = 1 if scenario == 'prod' else 0
+    if scenario in obs:
+        line += '  getObs          = 1  %s  %s  00  1\n' % (obs[scenario], siteFile)
+    line += '  getNav          = %d  daily  mixed3  igs  all  00  1\n' % prod
+    line += '  getOrbClk       = %d  igs  00  1\n' % prod
+    line += '  getEop          = %d  igs  00  1\n' % prod
+    line += '  getIon          = %d  cod\n' % prod
+    line += '  getAtx          = 0\n'
+    with open(cfgFile, 'w') as f_w:
+        f_w.write(line)
+
+
+def plan(binFile, cfgFile):
+    """ the remote files and the local files planned by 'run_GOOD --plan' """
+    out = subprocess.run([binFile, cfgFile, '--plan'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL).stdout
+    urls, places = [], []
+    for line in out.decode('latin-1').splitlines():
+        m = re.search(r'\bfetch\b.*?((?:ftps?|https?)://\S+)', line)
+        if m:
+            urls.append(m.group(1))
+        m = re.search(r'\bplace\b\s+<-\s+#\d+\s+(.+)$', line)
+        if m:
+            places.append(m.group(1).strip())
+    return urls, places
+
+
+def count_files(mainDir):
+    """ the files downloaded, some of which are renamed after placed (i.e., 'BRDC00IGS_R_*_MN.rnx' to 'brdm*.*p') """
+    n = 0
+    for root, dirs, files in os.walk(mainDir):
+        n += sum(1 for f in files if root != mainDir and not f.endswith('.tmp'))
+    return n
+
+
+def cpu_children():
+    if not resource:
+        return 0.0
+    r = resource.getrusage(resource.RUSAGE_CHILDREN)
+    return r.ru_utime + r.ru_stime
+
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    return values[n // 2] if n % 2 else 0.5 * (values[n // 2 - 1] + values[n // 2])
+
+
+def run_scenario(args, scenario, dir_work, siteFile, link):
+    """ plan, make the archives, serve them, and run GOOD 'runs' times """
+    mainDir = os.path.join(dir_work, 'run_' + scenario)
+    cfgFile = os.path.join(dir_work, 'bench_' + scenario + '.cfg')
+    if os.path.isdir(mainDir):
+        shutil.rmtree(mainDir)  # the files existing are NOT planned
+    write_cfg(cfgFile, mainDir, args, scenario, siteFile, '')
+    urls, places = plan(args.bin, cfgFile)
+    if not urls:
+        print('*** WARNING: NOTHING is planned for the scenario ' + scenario)
+        return None
+
+    # the synthetic archives, which are kept for the next runs
+    dir_archive = os.path.join(dir_work, 'archive_%d' % args.epochs)
+    origins = set()
+    for url in urls:
+        m = re.match(r'^([a-z]+://[^/]+)(/.*)$', url)
+        origins.add(m.group(1))
+        host = m.group(1).split('://')[1]
+        path = os.path.join(dir_archive, host, *m.group(2).lstrip('/').split('/'))
+        path = os.path.join(os.path.dirname(path), resolve_name(os.path.basename(path)))
+        if not os.path.isfile(path):
+            make_file(path, args.time[0], args.time[1], args.epochs, random.Random('%d %s' % (SEED, url)))
+
+    servers = start_servers(origins, dir_archive, link)
+    redirect = '+'.join('%s>%s://127.0.0.1:%d' % (o, 'ftp' if o.startswith('ftp') else 'http', s.server_address[1])
+                        for o, s in servers.items())
+    write_cfg(cfgFile, mainDir, args, scenario, siteFile, redirect)
+
+    results = []
+    for r in range(args.runs):
+        if os.path.isdir(mainDir):
+            shutil.rmtree(mainDir)
+        os.makedirs(mainDir)
+        files0, bytes0, refused0 = link.files, link.bytes, link.refused
+        cpu0, t0 = cpu_children(), time.time()
+        with open(os.path.join(dir_work, 'bench_' + scenario + '.log'), 'w') as f_log:
+            subprocess.run([args.bin, cfgFile], stdout=f_log, stderr=subprocess.STDOUT)
+        wall, cpu = time.time() - t0, cpu_children() - cpu0
+        nplaced = count_files(mainDir)
+        results.append({'seconds': wall, 'cpu': cpu, 'files': link.files - files0, 'bytes': link.bytes - bytes0,
+                        'placed': nplaced, 'refused': link.refused - refused0})
+    for srv in servers.values():
+        srv.shutdown()
+        srv.server_close()
+
+    res = {'planned': len(places)}
+    for key in ('seconds', 'cpu', 'files', 'bytes', 'placed', 'refused'):
+        res[key] = median([x[key] for x in results])
+    return summarize(res)
+
+
+def summarize(res):
+    res['files_per_s'] = res['files'] / res['seconds'] if res['seconds'] > 0 else 0.0
+    res['mb_per_s'] = res['bytes'] / 1e6 / res['seconds'] if res['seconds'] > 0 else 0.0
+    res['cpu_ms_per_file'] = 1e3 * res['cpu'] / res['files'] if res['files'] > 0 and resource else 0.0
+    return res
+
+
+def compare(result, baseline, tolerance):
+    """ the regressions against the baseline """
+    regressions = []
+    for key in ('ftp', 'sites', 'epochs', 'latency_ms', 'bandwidth_kbps', 'max_conn', 'parallel', 'adapt'):
+        if key in baseline and baseline[key] != result[key]:
+            print('*** WARNING: the setting %s of the baseline is %s, NOT %s' % (key, baseline[key], result[key]))
+    for name, cur in result['scenarios'].items():
+        base = baseline.get('scenarios', {}).get(name)
+        if not base:
+            continue
+        if cur['files_per_s'] < base['files_per_s'] * (1 - tolerance):
+            regressions.append('%s: files/s %.2f < %.2f' % (name, cur['files_per_s'], base['files_per_s']))
+        if cur['mb_per_s'] < base['mb_per_s'] * (1 - tolerance):
+            regressions.append('%s: MB/s %.2f < %.2f' % (name, cur['mb_per_s'], base['mb_per_s']))
+        if base['cpu_ms_per_file'] > 0 and cur['cpu_ms_per_file'] > base['cpu_ms_per_file'] * (1 + tolerance):
+            regressions.append('%s: CPU ms/file %.1f > %.1f' % (name, cur['cpu_ms_per_file'], base['cpu_ms_per_file']))
+    return regressions
+
+
+################################################################################
+# FUNCTION: benchmark of GOOD software
+################################################################################
+def main_bench_GOOD():
+    parser = argparse.ArgumentParser(description='benchmark of GOOD against the local stand-ins of the GNSS archives')
+    parser.add_argument('-bin', required=True)
+    parser.add_argument('-dir_work', default='bench_work')
+    parser.add_argument('-ftp', default='cddis', choices=['cddis', 'ign', 'whu'])
+    parser.add_argument('-time', nargs=3, type=int, default=[2022, 32, 1])
+    parser.add_argument('-sites', type=int, default=20)
+    parser.add_argument('-epochs', type=int, default=2880)
+    parser.add_argument('-scenario', nargs='+', default=SCENARIOS, choices=SCENARIOS)
+    parser.add_argument('-latency', type=float, default=0.0)
+    parser.add_argument('-bandwidth', type=float, default=0.0)
+    parser.add_argument('-max_conn', type=int, default=0)
+    parser.add_argument('-parallel', type=int, default=4)
+    parser.add_argument('-adapt', type=int, default=1, choices=[0, 1])
+    parser.add_argument('-runs', type=int, default=3)
+    parser.add_argument('-save', default='')
+    parser.add_argument('-baseline', default='')
+    parser.add_argument('-tolerance', type=float, default=0.1)
+    args = parser.parse_args()
+
+    args.bin = os.path.abspath(args.bin)
+    if not os.path.isfile(args.bin):
+        print('*** ERROR: The executable program ' + args.bin + ' is NOT found! Please check it.\n')
+        return 1
+    dir_work = os.path.abspath(args.dir_work)
+    if not os.path.isdir(dir_work):
+        os.makedirs(dir_work)
+
+    # the synthetic sites, i.e., 'b000', 'b001', ...
+    siteFile = os.path.join(dir_work, 'site_bench.list')
+    with open(siteFile, 'w') as f_w:
+        f_w.write(''.join('b%03d\n' % i for i in range(args.sites)))
+
+    link = Link(args.latency / 1e3, args.bandwidth * 1e3, args.max_conn)
+    result = {'platform': platform.platform(), 'ftp': args.ftp, 'sites': args.sites, 'epochs': args.epochs,
+              'latency_ms': args.latency, 'bandwidth_kbps': args.bandwidth, 'max_conn': args.max_conn, 'parallel': args.parallel,
+              'adapt': args.adapt,
+              'runs': args.runs, 'scenarios': {}}
+    print('%-8s %7s %7s %9s %9s %8s %8s %11s' % ('scenario', 'files', 'placed', 'MB', 'seconds', 'files/s', 'MB/s',
+                                                 'CPU ms/file'))
+    total = {'seconds': 0.0, 'cpu': 0.0, 'files': 0, 'bytes': 0, 'placed': 0, 'planned': 0, 'refused': 0}
+    for scenario in args.scenario:
+        res = run_scenario(args, scenario, dir_work, siteFile, link)
+        if not res:
+            continue
+        result['scenarios'][scenario] = res
+        for key in total:
+            total[key] += res[key]
+        print('%-8s %7d %7s %9.2f %9.2f %8.2f %8.2f %11s' % (scenario, res['files'], '%d/%d' % (res['placed'],
+              res['planned']), res['bytes'] / 1e6, res['seconds'], res['files_per_s'], res['mb_per_s'],
+              '%.1f' % res['cpu_ms_per_file'] if resource else 'n/a'))
+        if res['refused'] > 0:
+            print('*** INFO: %d connections are refused by the stand-ins in the scenario %s' % (res['refused'], scenario))
+        if res['placed'] < res['planned']:
+            print('*** WARNING: %d of the files planned are NOT downloaded in the scenario %s, see %s' % (
+                res['planned'] - res['placed'], scenario, os.path.join(dir_work, 'bench_' + scenario + '.log')))
+    result['total'] = summarize(total)
+    print('%-8s %7d %7s %9.2f %9.2f %8.2f %8.2f %11s' % ('total', total['files'], '%d/%d' % (total['placed'],
+          total['planned']), total['bytes'] / 1e6, total['seconds'], total['files_per_s'], total['mb_per_s'],
+          '%.1f' % total['cpu_ms_per_file'] if resource else 'n/a'))
+
+    if args.save:
+        with open(args.save, 'w') as f_w:
+            json.dump(result, f_w, indent=2, sort_keys=True)
+    if args.baseline:
+        with open(args.baseline) as f_r:
+            regressions = compare(result, json.load(f_r), args.tolerance)
+        for reg in regressions:
+            print('*** REGRESSION: ' + reg)
+        if regressions:
+            return 1
+    return 0
+
+
+################################################################################
+# Main program
+################################################################################
+if __name__ == '__main__':
+    sys.exit(main_bench_GOOD())
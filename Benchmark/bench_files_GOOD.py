@@ -0,0 +1,210 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ To benchmark the listing of the local directories of GOOD (StringUtil::GetFilesAll) on thousands of RINEX files
+
+ A local directory is filled with the files named as the observations and the products of many sites and days
+ (i.e., 'r0000010.22o', 'r0000010.22d.Z', 'R00000BEN_R_20220010000_01D_30S_MO.crx.gz'), together with a sub-directory
+ and a hidden file that are NOT listed. A small driver is built with 'StringUtil.cpp' of the source codes, and it lists
+ the directory 'calls' times for every suffix by 'GetFilesAll' ('native') and by the 'ls' pipe which GOOD used before
+ ('ls', NOT on Windows). The milliseconds per call are reported, and the names listed by 'GetFilesAll' must be the
+ same as the ones expected, i.e., the files whose names contain the suffix, sorted by name.
+
+ Usage: python bench_files_GOOD.py [-src <dir_source>] [-cxx <compiler>] [-dir_work <dir_work_path>] [-files <nfiles>]
+           [-calls <ncalls>] [-suffix <suffix> ...]
+
+ OPTIONS:
+   <-src>          - [optional] The directory of the source codes of GOOD, '../GOOD_src' by default
+   <-cxx>          - [optional] The C++ compiler building the driver, 'g++' by default
+   <-dir_work>     - [optional] The working directory, where the driver and the directory of the files
+                      ('files_<nfiles>', kept for the next runs) are stored, 'files_work' by default
+   <-files>        - [optional] number of the files in the directory, 5000 by default
+   <-calls>        - [optional] number of the calls of every suffix, whose average is reported, 20 by default
+   <-suffix>       - [optional] the suffixes listed one by one, "" stands for all the files,
+                      '.22o .22d.Z _MO.crx.gz ""' by default
+
+EXAMPLES: python bench_files_GOOD.py
+          python bench_files_GOOD.py -files 20000 -calls 50 -suffix .22o
+
+Changes: 18-Oct-2026   create the benchmark of the listing of the local directories
+
+ to get help, type:
+           python bench_files_GOOD.py -h
+
+"""
+################################################################################
+# Import Python modules
+import os, sys, argparse, subprocess
+
+
+################################################################################
+# constants
+################################################################################
+SUFFIXES = ['.22o', '.22d.Z', '_MO.crx.gz', '']
+DRIVER = r'''/* the driver of bench_files_GOOD.py: "bench_files <native|ls> <dir> <suffix> <ncalls>" lists the directory by
+   StringUtil::GetFilesAll or by the 'ls' pipe of GOOD before, and prints the milliseconds per call and the names */
+#include "Good.h"
+#include "StringUtil.h"
+#include <chrono>
+
+static void ListLs(const string &dir, const string &suffix, vector<string> &files)
+{
+#ifndef _WIN32
+    string cmd = "cd \"" + dir + "\" && ls *" + suffix + "* 2>/dev/null";
+    FILE *fp = popen(cmd.c_str(), "r");
+    if (fp == NULL) return;
+    char line[MAXSTRPATH] = { '\0' };
+    while (fgets(line, MAXSTRPATH, fp))
+    {
+        string fileName = line;
+        while (fileName.size() > 0 && (fileName.back() == '\n' || fileName.back() == '\r')) fileName.pop_back();
+        if (fileName.size() > 0) files.push_back(fileName);
+    }
+    pclose(fp);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 5) return 1;
+    string mode = argv[1], dir = argv[2], suffix = argv[3];
+    int ncall = atoi(argv[4]);
+    StringUtil str;
+    vector<string> files;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ncall; i++)
+    {
+        files.clear();
+        if (mode == "ls") ListLs(dir, suffix, files);
+        else str.GetFilesAll(dir, suffix, files);
+    }
+    double dt = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%.4f\n", 1e3 * dt / (ncall > 0 ? ncall : 1));
+    for (size_t i = 0; i < files.size(); i++) printf("%s\n", files[i].c_str());
+
+    return 0;
+}
+'''
+
+
+################################################################################
+# FUNCTION: the directory of the files and the driver
+################################################################################
+def file_names(nfile):
+    """ the names of the observations and the products of the sites and the days, 4 files per site and day """
+    names = []
+    for i in range(nfile):
+        k, kind = i // 4, i % 4
+        site, doy = 'r%03d' % (k % 1000), 1 + k // 1000
+        if kind == 0:
+            names.append('%s%03d0.22o' % (site, doy))
+        elif kind == 1:
+            names.append('%s%03d0.22d.Z' % (site, doy))
+        elif kind == 2:
+            names.append('%s00BEN_R_2022%03d0000_01D_30S_MO.crx.gz' % (site.upper(), doy))
+        else:
+            names.append('%s%03d0.22n' % (site, doy))
+    return names
+
+
+def make_dir(dir_files, nfile):
+    """ the directory of the files, with a sub-directory and a hidden file that are NOT listed, the files existing
+        are kept """
+    names = file_names(nfile)
+    if not os.path.isdir(dir_files):
+        os.makedirs(dir_files)
+    for name in names:
+        path = os.path.join(dir_files, name)
+        if not os.path.isfile(path):
+            open(path, 'wb').close()
+    for sub in ('tmp.22o', 'r0000010.22o.d'):
+        if not os.path.isdir(os.path.join(dir_files, sub)):
+            os.makedirs(os.path.join(dir_files, sub))
+    open(os.path.join(dir_files, '.listing'), 'wb').close()
+    return sorted(names)
+
+
+def build_driver(args, dir_work):
+    """ build the driver with 'StringUtil.cpp', the executable program is returned """
+    srcFile = os.path.join(dir_work, 'bench_files.cpp')
+    binFile = os.path.join(dir_work, 'bench_files' + ('.exe' if os.name == 'nt' else ''))
+    with open(srcFile, 'w') as f_w:
+        f_w.write(DRIVER)
+    cmd = [args.cxx, '-O3', '-std=c++11', '-I' + args.src, srcFile, os.path.join(args.src, 'StringUtil.cpp'),
+           '-o', binFile]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    if out.returncode != 0:
+        print(out.stdout.decode('latin-1'))
+        return None
+    return binFile
+
+
+def list_dir(binFile, mode, dir_files, suffix, ncall):
+    """ the milliseconds per call and the names listed by the driver """
+    out = subprocess.run([binFile, mode, dir_files, suffix, str(ncall)], stdout=subprocess.PIPE).stdout
+    lines = out.decode('latin-1').splitlines()
+    if not lines:
+        return 0.0, None
+    return float(lines[0]), lines[1:]
+
+
+################################################################################
+# FUNCTION: benchmark of the listing of GOOD software
+################################################################################
+def main_bench_files_GOOD():
+    parser = argparse.ArgumentParser(description='benchmark of the listing of the local directories of GOOD')
+    parser.add_argument('-src', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'GOOD_src'))
+    parser.add_argument('-cxx', default='g++')
+    parser.add_argument('-dir_work', default='files_work')
+    parser.add_argument('-files', type=int, default=5000)
+    parser.add_argument('-calls', type=int, default=20)
+    parser.add_argument('-suffix', nargs='+', default=SUFFIXES)
+    args = parser.parse_args()
+
+    args.src = os.path.abspath(args.src)
+    if not os.path.isfile(os.path.join(args.src, 'StringUtil.cpp')):
+        print('*** ERROR: StringUtil.cpp is NOT found in ' + args.src + '! Please check it.\n')
+        return 1
+    dir_work = os.path.abspath(args.dir_work)
+    if not os.path.isdir(dir_work):
+        os.makedirs(dir_work)
+    binFile = build_driver(args, dir_work)
+    if not binFile:
+        print('*** ERROR: The driver is NOT built by ' + args.cxx + '! Please check it.\n')
+        return 1
+    dir_files = os.path.join(dir_work, 'files_%d' % args.files)
+    names = make_dir(dir_files, args.files)
+
+    nfail = 0
+    print('%-12s %7s %12s %12s %8s  %s' % ('suffix', 'files', 'native ms', 'ls ms', 'speedup', 'result'))
+    for suffix in args.suffix:
+        expected = [n for n in names if suffix in n]
+        ms, listed = list_dir(binFile, 'native', dir_files, suffix, args.calls)
+        ms_ls = 0.0
+        if os.name != 'nt':
+            ms_ls, listed_ls = list_dir(binFile, 'ls', dir_files, suffix, args.calls)
+        ok = listed == expected
+        print('%-12s %7d %12.3f %12s %8s  %s' % (suffix or '""', len(listed or []), ms,
+                                                '%.3f' % ms_ls if ms_ls > 0 else 'n/a',
+                                                '%.1f' % (ms_ls / ms) if ms > 0 and ms_ls > 0 else 'n/a',
+                                                'passed' if ok else 'FAILED'))
+        if not ok:
+            nfail += 1
+            missing = sorted(set(expected) - set(listed or []))
+            extra = sorted(set(listed or []) - set(expected))
+            print('*** ERROR: %d files are NOT listed (i.e., %s), %d are listed NOT expected (i.e., %s)' % (
+                len(missing), missing[:3], len(extra), extra[:3]))
+    return 1 if nfail > 0 else 0
+
+
+################################################################################
+# Main program
+################################################################################
+if __name__ == '__main__':
+    sys.exit(main_bench_files_GOOD())
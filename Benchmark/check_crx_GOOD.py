@@ -0,0 +1,429 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ To check the built-in decoder of Compact RINEX of GOOD (CrxUtil) against the outputs of 'crx2rnx', and to time it
+
+ The fixtures in 'fixtures' are pairs of the Compact RINEX files and the RINEX files converted by 'crx2rnx' (ver.4.0.7),
+ i.e., 'ca000320.22d'/'ca000320.22o' for RINEX 2 (Compact RINEX 1.0) and 'CC0000BEN_R_20220320000_01D_30S_MO.crx'/
+ '*_MO.rnx' for RINEX 3 (Compact RINEX 3.0). They cover GPS only and mixed files, the satellites rising and setting,
+ the observations missing, the cycle slips (LLI), the receiver clock offsets, and the events with the header records.
+ Every fixture is served by the local stand-ins of 'bench_GOOD.py' as the IGS ('*.d.Z') or the MGEX ('*.crx.gz')
+ daily observations, and the RINEX file placed by 'run_GOOD' must be the same as the one of 'crx2rnx' byte for byte.
+ The wall and CPU time of 'run_GOOD' are reported, and also the ones of 'crx2rnx' for the same files if it is given.
+
+ Usage: python check_crx_GOOD.py -bin <run_GOOD> [-dir_work <dir_work_path>] [-fixtures <dir_fixtures>]
+           [-copies <ncopies>] [-runs <nruns>] [-crx2rnx <crx2rnx>] [-make]
+
+ OPTIONS:
+   <-bin>          - The executable program of GOOD, i.e., '-bin ../run_GOOD'
+   <-dir_work>     - [optional] The working directory, where the archives, the configure files, and the downloaded
+                      files are stored, 'crx_work' by default
+   <-fixtures>     - [optional] The directory of the fixtures, 'fixtures' next to this script by default
+   <-copies>       - [optional] number of the sites served with every fixture (i.e., 'ca00', 'ca01', ...), which is
+                      raised to time the decoder on more files, 1 by default
+   <-runs>         - [optional] number of runs, whose median is reported, 1 by default
+   <-crx2rnx>      - [optional] the external 'crx2rnx', whose outputs are compared with the fixtures and timed for the
+                      same files
+   <-make>         - [optional] make the fixtures again with the external 'crx2rnx' (i.e., after the generator of the
+                      fixtures is changed), '-crx2rnx' is needed
+
+EXAMPLES: python check_crx_GOOD.py -bin ../run_GOOD
+          python check_crx_GOOD.py -bin ../run_GOOD -copies 20 -runs 3 -crx2rnx /usr/local/bin/crx2rnx
+
+Changes: 18-Oct-2026   create the check of the decoder of Compact RINEX with the fixtures converted by 'crx2rnx'
+
+ to get help, type:
+           python check_crx_GOOD.py -h
+
+"""
+################################################################################
+# Import Python modules
+import os, sys, re, time, gzip, random, shutil, argparse, subprocess
+import bench_GOOD as bench
+
+
+################################################################################
+# constants
+################################################################################
+TIME = [2022, 32, 1]           # the day of the fixtures
+INTERVAL = 30.0                # the interval of the fixtures (s)
+# name, format version of Compact RINEX (1 or 3), systems, number of epochs, events/clock offsets/gaps (0: no  1: yes)
+FIXTURES = [('ca000320.22d', 1, 'G', 60, 0),
+            ('cb000320.22d', 1, 'GR', 40, 1),
+            ('CC0000BEN_R_20220320000_01D_30S_MO.crx', 3, 'GE', 60, 0),
+            ('CD0000BEN_R_20220320000_01D_30S_MO.crx', 3, 'GREC', 40, 1)]
+# the observation types, in the groups of pseudorange, carrier phase, Doppler, and signal strength (see bench.sat_values)
+TYPES2 = ['C1', 'L1', 'D1', 'S1', 'P2', 'L2', 'D2', 'S2']
+TYPES3 = {'G': ['C1C', 'L1C', 'D1C', 'S1C', 'C2W', 'L2W', 'D2W', 'S2W'],
+          'R': ['C1C', 'L1C', 'D1C', 'S1C', 'C2P', 'L2P'],
+          'E': ['C1C', 'L1C', 'D1C', 'S1C', 'C5Q', 'L5Q', 'D5Q', 'S5Q'],
+          'C': ['C2I', 'L2I', 'D2I', 'S2I']}
+NSAT = {'G': 12, 'R': 8, 'E': 8, 'C': 6}
+
+
+################################################################################
+# FUNCTION: the fixtures
+################################################################################
+def flag_diff(old, new):
+    """ the differences of the flags to the previous ones, the flags of a new arc are against the empty string, so
+        that the blank flags are kept ('&') as 'rnx2crx' does """
+    diff = []
+    for i, c in enumerate(new):
+        if i < len(old) and old[i] == c:
+            diff.append(' ')
+        else:
+            diff.append('&' if c == ' ' else c)
+    return ''.join(diff).rstrip()
+
+
+def arc_diff(arc, v):
+    """ the differences of the order of the arc, 'arc' is [order, the values of the arc] """
+    hist = arc[1] + [v]
+    order = min(len(hist) - 1, arc[0])
+    d = hist[-order - 1:]
+    for i in range(order):
+        d = [d[j + 1] - d[j] for j in range(len(d) - 1)]
+    arc[1] = hist[-4:]
+    return d[0]
+
+
+def make_fixture(name, ver, systems, nepoch, extra, rnd):
+    """ the fixture in Compact RINEX 1.0 (RINEX 2) or 3.0 (RINEX 3), with the differences of up to the 3rd order """
+    t0 = time.mktime((TIME[0], 1, 1, 0, 0, 0, 0, 0, 0)) - time.timezone + (TIME[1] - 1) * 86400
+    mixed = len(systems) > 1
+    lines = [bench.hline('%-20s%-20s' % ('1.0' if ver == 1 else '3.0', 'COMPACT RINEX FORMAT'), 'CRINEX VERS   / TYPE'),
+             bench.hline('%-40s%s' % ('RNX2CRX ver.4.0.7', '01-Feb-22 00:00'), 'CRINEX PROG / DATE')]
+    if ver == 1:
+        lines.append(bench.hline('     2.11           OBSERVATION DATA    ' + ('M (MIXED)' if mixed else 'G (GPS)'),
+                                 'RINEX VERSION / TYPE'))
+    else:
+        lines.append(bench.hline('     3.04           OBSERVATION DATA    ' + ('M' if mixed else systems),
+                                 'RINEX VERSION / TYPE'))
+    lines.append(bench.hline('check_crx_GOOD      GOOD                01-Feb-22 00:00', 'PGM / RUN BY / DATE'))
+    lines.append(bench.hline('the fixture of the decoder of Compact RINEX', 'COMMENT'))
+    lines.append(bench.hline(name[:4].upper(), 'MARKER NAME'))
+    if ver == 1:
+        lines.append(bench.hline('%6d' % len(TYPES2) + ''.join('%6s' % t for t in TYPES2), '# / TYPES OF OBSERV'))
+    else:
+        for s in systems:
+            lines.append(bench.hline('%s  %3d ' % (s, len(TYPES3[s])) + ' '.join(TYPES3[s]), 'SYS / # / OBS TYPES'))
+    lines.append(bench.hline('%10.3f' % INTERVAL, 'INTERVAL'))
+    lines.append(bench.hline('', 'END OF HEADER'))
+
+    # the satellites rise and set at the epochs of their own
+    sats, values, span = [], {}, {}
+    for s in systems:
+        for prn in range(1, NSAT[s] + 1):
+            sat = '%s%02d' % (s, prn)
+            ntype = len(TYPES2) if ver == 1 else len(TYPES3[s])
+            sats.append(sat)
+            values[sat] = bench.sat_values(rnd, ntype, nepoch)
+            rise = 0 if prn <= NSAT[s] // 2 else rnd.randint(0, nepoch // 2)
+            span[sat] = (rise, rnd.randint(rise + nepoch // 4, nepoch + nepoch // 4))
+    clock = [rnd.randint(-900000, 900000), rnd.randint(-50, 50)]  # the receiver clock offset (ns) and its drift
+    events = set(rnd.sample(range(1, nepoch), 2)) if extra else set()
+
+    prev, state, oldclk = '', {}, None  # state: satellite -> [the arcs of the observations, the flags]
+    for k in range(nepoch):
+        tt = time.gmtime(t0 + k * INTERVAL)
+        if k in events:
+            # the event of the new site occupation with the header records, after which everything is initialized
+            text = ['the event of epoch %d' % k, 'the antenna is moved']
+            lines.append('&' + ' ' * 27 + '4%3d' % len(text) if ver == 1 else '>' + ' ' * 30 + '4%3d' % len(text))
+            lines += [bench.hline(t, 'COMMENT') for t in text]
+        init = k == 0 or k in events
+        cur = [s for s in sats if span[s][0] <= k < span[s][1] and not (extra and rnd.random() < 0.03)]
+        if ver == 1:
+            epoch = ' %02d %2d %2d %2d %2d%11.7f  0%3d' % (tt.tm_year % 100, tt.tm_mon, tt.tm_mday, tt.tm_hour,
+                                                            tt.tm_min, tt.tm_sec, len(cur)) + ''.join(cur)
+            lines.append('&' + epoch[1:] if init else bench.text_diff(prev, epoch))
+        else:
+            epoch = '> %4d %02d %02d %02d %02d%11.7f  0%3d      ' % (tt.tm_year, tt.tm_mon, tt.tm_mday, tt.tm_hour,
+                                                                   tt.tm_min, tt.tm_sec, len(cur)) + ''.join(cur)
+            lines.append(epoch if init else bench.text_diff(prev, epoch))
+        prev = epoch
+        if init:
+            state, oldclk = {}, None
+
+        # the receiver clock offset in 1e-9 s (RINEX 2) or 1e-12 s (RINEX 3), which is lost at some epochs
+        if extra and rnd.random() < 0.9:
+            v = (clock[0] + clock[1] * k) * (1 if ver == 1 else 1000)
+            if oldclk is None:
+                oldclk = [3, [v]]
+                lines.append('3&%d' % v)
+            else:
+                lines.append('%d' % arc_diff(oldclk, v))
+        else:
+            lines.append('')
+            oldclk = None
+
+        for s in cur:
+            ntype = len(values[s])
+            if s not in state:
+                state[s] = [[None] * ntype, '']
+            arcs, oldflag = state[s]
+            fields, flags = [], ''
+            for j in range(ntype):
+                v = values[s][j][k]
+                if extra and rnd.random() < 0.05:  # the observation missing, its arc is initialized again
+                    fields.append('')
+                    flags += '  '
+                    arcs[j] = None
+                    continue
+                slip = j % 4 == 1 and arcs[j] is not None and rnd.random() < 0.02
+                if arcs[j] is None or slip:
+                    arcs[j] = [3, [v]]
+                    fields.append('3&%d' % v)
+                else:
+                    fields.append('%d' % arc_diff(arcs[j], v))
+                lli = '1' if slip else ' '
+                snr = j - j % 4 + 3  # the signal strength of the group, '6' if it is NOT observed
+                ssi = ' ' if j % 4 >= 2 else str(min(9, values[s][snr][k] // 6000)) if snr < ntype else '6'
+                flags += lli + ssi
+            diff = flag_diff(oldflag, flags)
+            state[s][1] = flags
+            lines.append(' '.join(fields) + (' ' + diff if diff else ''))
+
+        # the satellites set keep NO arc
+        for s in list(state):
+            if s not in cur:
+                del state[s]
+    return ('\n'.join(lines) + '\n').encode()
+
+
+def make_fixtures(dir_fixtures, crx2rnx):
+    """ make the fixtures, the RINEX files are converted by the external 'crx2rnx' """
+    if not os.path.isdir(dir_fixtures):
+        os.makedirs(dir_fixtures)
+    for name, ver, systems, nepoch, extra in FIXTURES:
+        crxFile = os.path.join(dir_fixtures, name)
+        with open(crxFile, 'wb') as f_w:
+            f_w.write(make_fixture(name, ver, systems, nepoch, extra, random.Random('%d %s' % (bench.SEED, name))))
+        out = subprocess.run([crx2rnx, crxFile, '-'], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        if out.returncode != 0 or out.stderr:
+            print('*** ERROR: ' + crxFile + ' is NOT converted by crx2rnx: ' + out.stderr.decode('latin-1').strip())
+            return False
+        with open(os.path.join(dir_fixtures, rnx_name(name)), 'wb') as f_w:
+            f_w.write(out.stdout)
+    return True
+
+
+def rnx_name(name):
+    """ the name of the RINEX file of the fixture, i.e., 'ca000320.22d' -> 'ca000320.22o' """
+    return name[:-4] + '.rnx' if name.endswith('.crx') else name[:-1] + 'o'
+
+
+################################################################################
+# FUNCTION: the runs of GOOD and crx2rnx
+################################################################################
+def write_archive(path, data):
+    """ the file of the archive, which is compressed by the suffix of its name """
+    if path.endswith('.gz'):
+        data = gzip.compress(data, 6)
+    elif path.endswith('.Z'):
+        data = bench.lzw_compress(data)
+    if not os.path.isdir(os.path.dirname(path)):
+        os.makedirs(os.path.dirname(path))
+    with open(path, 'wb') as f_w:
+        f_w.write(data)
+
+
+def site_of(name, k):
+    """ the site of the k-th copy of the fixture, i.e., 'ca00', 'ca01', ... """
+    return '%s%02d' % (name[:2].lower(), k)
+
+
+def run_good(args, scenario, fixtures, dir_work):
+    """ serve the fixtures as the observations of the scenario, and run GOOD 'runs' times, the RINEX files placed (the
+        key is the site), the wall time, and the CPU time are returned """
+    mainDir = os.path.join(dir_work, 'run_' + scenario)
+    cfgFile = os.path.join(dir_work, 'check_' + scenario + '.cfg')
+    siteFile = os.path.join(dir_work, 'site_' + scenario + '.list')
+    sites = dict((site_of(name, k), data) for name, data in fixtures for k in range(args.copies))
+    with open(siteFile, 'w') as f_w:
+        f_w.write(''.join(s + '\n' for s in sorted(sites)))
+    if os.path.isdir(mainDir):
+        shutil.rmtree(mainDir)
+    bench.write_cfg(cfgFile, mainDir, args, scenario, siteFile, '')
+    urls, places = bench.plan(args.bin, cfgFile)
+
+    dir_archive = os.path.join(dir_work, 'archive_' + scenario)
+    if os.path.isdir(dir_archive):
+        shutil.rmtree(dir_archive)
+    origins = set()
+    for url in urls:
+        m = re.match(r'^([a-z]+://[^/]+)(/.*)$', url)
+        name = bench.resolve_name(os.path.basename(m.group(2)))
+        if name[:4].lower() not in sites:
+            continue
+        origins.add(m.group(1))
+        host = m.group(1).split('://')[1]
+        path = os.path.join(dir_archive, host, *m.group(2).lstrip('/').split('/'))
+        write_archive(os.path.join(os.path.dirname(path), name), sites[name[:4].lower()])
+    if not origins:
+        return None, 0.0, 0.0
+
+    link = bench.Link(0.0, 0, 0)
+    servers = bench.start_servers(origins, dir_archive, link)
+    redirect = '+'.join('%s>%s://127.0.0.1:%d' % (o, 'ftp' if o.startswith('ftp') else 'http', s.server_address[1])
+                        for o, s in servers.items())
+    bench.write_cfg(cfgFile, mainDir, args, scenario, siteFile, redirect)
+
+    walls, cpus = [], []
+    for r in range(args.runs):
+        if os.path.isdir(mainDir):
+            shutil.rmtree(mainDir)
+        os.makedirs(mainDir)
+        cpu0, t0 = bench.cpu_children(), time.time()
+        with open(os.path.join(dir_work, 'check_' + scenario + '.log'), 'w') as f_log:
+            subprocess.run([args.bin, cfgFile], stdout=f_log, stderr=subprocess.STDOUT)
+        walls.append(time.time() - t0)
+        cpus.append(bench.cpu_children() - cpu0)
+    for srv in servers.values():
+        srv.shutdown()
+        srv.server_close()
+
+    # the RINEX files placed, i.e., 'obs/2022/032/MGEX/daily/ca000320.22o'
+    files = {}
+    for root, dirs, names in os.walk(os.path.join(mainDir, 'obs')):
+        for name in names:
+            if re.search(r'\.(\d\do|rnx)$', name.lower()) and name[:4].lower() in sites:
+                with open(os.path.join(root, name), 'rb') as f_r:
+                    files[name[:4].lower()] = f_r.read()
+    return files, bench.median(walls), bench.median(cpus)
+
+
+def run_crx2rnx(args, fixtures, dir_work):
+    """ convert the fixtures by the external 'crx2rnx' 'copies' times, the outputs (the key is the name) and the
+        median wall time of the runs are returned """
+    dir_crx = os.path.join(dir_work, 'crx2rnx')
+    if not os.path.isdir(dir_crx):
+        os.makedirs(dir_crx)
+    files, walls = {}, []
+    for r in range(args.runs):
+        t0 = time.time()
+        for name, data in fixtures:
+            for k in range(args.copies):
+                crxFile = os.path.join(dir_crx, site_of(name, k) + name[4:])
+                with open(crxFile, 'wb') as f_w:
+                    f_w.write(data)
+                out = subprocess.run([args.crx2rnx, crxFile, '-'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+                files[name] = out.stdout
+        walls.append(time.time() - t0)
+    return files, bench.median(walls)
+
+
+def first_diff(data, ref):
+    """ the line where the RINEX file differs from the reference first """
+    a, b = data.split(b'\n'), ref.split(b'\n')
+    for i in range(max(len(a), len(b))):
+        if i >= len(a) or i >= len(b) or a[i] != b[i]:
+            return ' at line %d' % (i + 1)
+    return ''
+
+
+
+################################################################################
+# FUNCTION: check of the decoder of Compact RINEX of GOOD software
+################################################################################
+def main_check_crx_GOOD():
+    parser = argparse.ArgumentParser(description='check of the decoder of Compact RINEX of GOOD with the fixtures')
+    parser.add_argument('-bin', required=True)
+    parser.add_argument('-dir_work', default='crx_work')
+    parser.add_argument('-fixtures', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'fixtures'))
+    parser.add_argument('-copies', type=int, default=1)
+    parser.add_argument('-runs', type=int, default=1)
+    parser.add_argument('-crx2rnx', default='')
+    parser.add_argument('-make', action='store_true')
+    args = parser.parse_args()
+
+    args.bin = os.path.abspath(args.bin)
+    if not os.path.isfile(args.bin):
+        print('*** ERROR: The executable program ' + args.bin + ' is NOT found! Please check it.\n')
+        return 1
+    if args.crx2rnx:
+        args.crx2rnx = os.path.abspath(args.crx2rnx)
+        if not os.path.isfile(args.crx2rnx):
+            print('*** ERROR: The executable program ' + args.crx2rnx + ' is NOT found! Please check it.\n')
+            return 1
+    if args.make and not args.crx2rnx:
+        print('*** ERROR: The fixtures are made by the external crx2rnx, please give it by \'-crx2rnx\'.\n')
+        return 1
+    if args.copies < 1 or args.copies > 100:
+        print('*** ERROR: The copies of every fixture should be 1 to 100.\n')
+        return 1
+    dir_work = os.path.abspath(args.dir_work)
+    if not os.path.isdir(dir_work):
+        os.makedirs(dir_work)
+    if args.make and not make_fixtures(args.fixtures, args.crx2rnx):
+        return 1
+
+    fixtures, references = {1: [], 3: []}, {}
+    for name, ver, systems, nepoch, extra in FIXTURES:
+        try:
+            with open(os.path.join(args.fixtures, name), 'rb') as f_r:
+                fixtures[ver].append((name, f_r.read()))
+            with open(os.path.join(args.fixtures, rnx_name(name)), 'rb') as f_r:
+                references[name] = f_r.read()
+        except IOError:
+            print('*** ERROR: The fixture ' + name + ' or ' + rnx_name(name) + ' is NOT found in ' + args.fixtures + '\n')
+            return 1
+
+    # the settings of 'bench_GOOD.py', RINEX 2 by the IGS daily observations and RINEX 3 by the MGEX ones
+    args.ftp, args.time, args.parallel, args.adapt = 'cddis', TIME, 4, 1
+    nfail = 0
+    print('%-40s %6s %9s  %s' % ('fixture', 'files', 'KB', 'result'))
+    timing = []
+    for ver, scenario in ((1, 'igs'), (3, 'mgex')):
+        files, wall, cpu = run_good(args, scenario, fixtures[ver], dir_work)
+        if files is None:
+            print('*** ERROR: NOTHING is planned for the fixtures of RINEX %d' % (2 if ver == 1 else 3))
+            nfail += 1
+            continue
+        timing.append((scenario, wall, cpu))
+        for name, data in fixtures[ver]:
+            problems = []
+            for k in range(args.copies):
+                site = site_of(name, k)
+                if site not in files:
+                    problems.append('the RINEX file of ' + site + ' is NOT placed, see ' +
+                                    os.path.join(dir_work, 'check_' + scenario + '.log'))
+                elif files[site] != references[name]:
+                    problems.append('the RINEX file of ' + site + ' differs from ' + rnx_name(name) +
+                                    first_diff(files[site], references[name]))
+            nok = args.copies - len(problems)
+            print('%-40s %6s %9.1f  %s' % (name, '%d/%d' % (nok, args.copies), len(references[name]) / 1e3,
+                                           'FAILED' if problems else 'passed'))
+            for problem in problems[:5]:
+                print('*** ERROR: ' + problem)
+            if problems:
+                nfail += 1
+
+    if args.crx2rnx:
+        files, wall_crx = run_crx2rnx(args, fixtures[1] + fixtures[3], dir_work)
+        for name in sorted(files):
+            if files[name] != references[name]:
+                print('*** WARNING: the output of %s differs from %s%s' % (args.crx2rnx, rnx_name(name),
+                                                                          first_diff(files[name], references[name])))
+    print('')
+    print('%-8s %6s %9s %9s' % ('run', 'files', 'seconds', 'CPU s'))
+    nfile = args.copies * len(FIXTURES)
+    for scenario, wall, cpu in timing:
+        print('%-8s %6d %9.2f %9s' % (scenario, args.copies * len(fixtures[1 if scenario == 'igs' else 3]), wall,
+                                      '%.2f' % cpu if bench.resource else 'n/a'))
+    if args.crx2rnx:
+        print('%-8s %6d %9.2f %9s' % ('crx2rnx', nfile, wall_crx, 'n/a'))
+    return 1 if nfail > 0 else 0
+
+
+################################################################################
+# Main program
+################################################################################
+if __name__ == '__main__':
+    sys.exit(main_check_crx_GOOD())
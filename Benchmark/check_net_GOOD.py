@@ -0,0 +1,346 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ To check the transfer engine of GOOD (NetUtil) against the local stand-ins of the archives with the faults injected
+
+ The stand-ins of 'bench_GOOD.py' are reused, and every case breaks them in one way, i.e., the transfers cut short,
+ "EPSV" refused, the logins refused by "421" or "530", and the connections closed while they are idle in the pool of
+ GOOD. 'run_GOOD' downloads the same files as the run against the stand-ins NOT broken (the reference), and the case
+ passes if the files are the same byte for byte and the fault was hit. The cases of the transfers cut short are run
+ twice, since the partial files are resumed by the next run ("REST" or "Range").
+
+ Usage: python check_net_GOOD.py -bin <run_GOOD> [-dir_work <dir_work_path>] [-case <name> ...] [-sites <nsites>]
+           [-epochs <nepochs>]
+
+ OPTIONS:
+   <-bin>          - The executable program of GOOD, i.e., '-bin ../run_GOOD'
+   <-dir_work>     - [optional] The working directory, where the synthetic archives, the configure files, and the
+                      downloaded files are stored, 'check_work' by default
+   <-case>         - [optional] the cases run one by one, all of them by default:
+                      'ftp_resume': every FTP transfer is cut in the middle once, and resumed by "REST" in the next run;
+                      'http_resume': every HTTP transfer is cut in the middle once, and resumed by "Range" in the next run;
+                      'ftp_epsv': "EPSV" is refused, so the data connections are opened by "PASV";
+                      'ftp_421': the first connections are refused by "421 Too many connections" at the greeting;
+                      'ftp_530': the first logins are refused by "530 Too many users";
+                      'ftp_stale': the control connection is closed after every transfer, so the one reused is stale;
+                      'http_stale': the connection is closed after every response without "Connection: close";
+                      'http_errbody': the first request of every file gets "500" with a body of unknown length, which
+                                      is NOT drained (the run must NOT wait for the timeout of receiving)
+   <-sites>        - [optional] number of the synthetic sites in the site list, 6 by default
+   <-epochs>       - [optional] number of the epochs in every observation file, 240 by default
+
+EXAMPLES: python check_net_GOOD.py -bin ../run_GOOD
+          python check_net_GOOD.py -bin ../run_GOOD -case ftp_resume ftp_stale
+
+Changes: 18-Oct-2026   create the check of the transfer engine with the faults injected into the stand-ins
+
+ to get help, type:
+           python check_net_GOOD.py -h
+
+"""
+################################################################################
+# Import Python modules
+import os, sys, re, time, random, shutil, socket, argparse, subprocess, threading
+import bench_GOOD as bench
+
+
+################################################################################
+# constants
+################################################################################
+CASES = ['ftp_resume', 'http_resume', 'ftp_epsv', 'ftp_421', 'ftp_530', 'ftp_stale', 'http_stale', 'http_errbody']
+NFAULT = 3                     # the connections refused by 'ftp_421' and 'ftp_530'
+MAXWAIT = 30.0                 # the run of 'http_errbody' waiting longer is taken as draining the body (s)
+CURRENT = threading.local()    # the file sent by the thread of the stand-in, 'CURRENT.path'
+
+
+################################################################################
+# FUNCTION: the faults injected into the stand-ins
+################################################################################
+class Faults(object):
+    """ the fault of the case, and the counts of the faults hit and the requests seen """
+    def __init__(self, case):
+        self.case = case
+        self.lock = threading.Lock()
+        self.left = NFAULT
+        self.seen = set()
+        self.counts = {}
+
+    def count(self, key):
+        with self.lock:
+            self.counts[key] = self.counts.get(key, 0) + 1
+
+    def take(self, case):
+        """ True: the fault is injected this time, which is limited to NFAULT times """
+        with self.lock:
+            if self.case != case or self.left <= 0:
+                return False
+            self.left -= 1
+            self.counts['fault'] = self.counts.get('fault', 0) + 1
+            return True
+
+    def first(self, case, key):
+        """ True: the fault is injected into the first request of the key (i.e., the file) """
+        with self.lock:
+            if self.case != case or key in self.seen:
+                return False
+            self.seen.add(key)
+            self.counts['fault'] = self.counts.get('fault', 0) + 1
+            return True
+
+
+class FaultLink(bench.Link):
+    """ the link cutting the first transfer of every file in the middle """
+    def __init__(self, faults):
+        bench.Link.__init__(self, 0.0, 0, 0)
+        self.faults = faults
+
+    def send(self, sock, data):
+        case, path = self.faults.case, getattr(CURRENT, 'path', '')
+        if case.endswith('_resume') and path and len(data) > 1000 and self.faults.first(case, path):
+            bench.Link.send(self, sock, data[:len(data) // 2])
+            sock.shutdown(socket.SHUT_RDWR)
+            return
+        bench.Link.send(self, sock, data)
+
+
+class FaultCommands(object):
+    """ the commands read by the FTP stand-in, some of which are refused before the stand-in sees them """
+    def __init__(self, handler, rfile):
+        self.handler, self.rfile = handler, rfile
+
+    def readline(self):
+        faults = self.handler.server.faults
+        while True:
+            try:
+                line = self.rfile.readline()
+            except socket.error:  # i.e., the connection reset by GOOD
+                line = b''
+            cmd, _, arg = line.decode('latin-1').strip().partition(' ')
+            cmd = cmd.upper()
+            if cmd == 'EPSV' and faults.case == 'ftp_epsv':
+                faults.count('fault')
+                self.handler.reply('500 EPSV not understood')
+                continue
+            if cmd == 'PASS' and faults.take('ftp_530'):
+                self.handler.reply('530 Too many users')
+                continue
+            if cmd in ('PASV', 'EPSV'):
+                faults.count(cmd)
+            if cmd in ('RETR', 'NLST', 'LIST'):
+                CURRENT.path = arg if cmd == 'RETR' else ''
+            if cmd == 'REST' and arg.strip() not in ('', '0'):
+                faults.count('REST')
+            return line
+
+    def __getattr__(self, name):
+        return getattr(self.rfile, name)
+
+
+class FaultFtpHandler(bench.FtpHandler):
+    """ the FTP stand-in with the faults of the case """
+    def setup(self):
+        bench.FtpHandler.setup(self)
+        self.rfile = FaultCommands(self, self.rfile)
+
+    def handle(self):
+        if self.server.faults.take('ftp_421'):
+            self.reply('421 Too many connections')
+            return
+        bench.FtpHandler.handle(self)
+
+    def reply(self, text):
+        bench.FtpHandler.reply(self, text)
+        if text.startswith('226') and self.server.faults.case == 'ftp_stale':
+            self.server.faults.count('fault')
+            self.wfile.flush()
+            self.connection.shutdown(socket.SHUT_RDWR)
+
+
+class FaultHttpHandler(bench.HttpHandler):
+    """ the HTTP stand-in with the faults of the case """
+    def respond(self, body):
+        faults = self.server.faults
+        if self.headers.get('Range'):
+            faults.count('Range')
+        path = self.path.split('?')[0]
+        CURRENT.path = '' if path.endswith('/') else path
+        if body and not path.endswith('/') and faults.first('http_errbody', path):
+            # NO "Content-Length", and the connection is kept open, so the body can NOT be drained
+            self.send_response(500)
+            self.send_header('Connection', 'keep-alive')
+            self.end_headers()
+            self.wfile.write(b'internal error\n')
+            self.wfile.flush()
+            self.connection.settimeout(MAXWAIT * 2)
+            try:
+                self.connection.recv(1)
+            except socket.error:
+                pass
+            self.close_connection = True
+            return
+        bench.HttpHandler.respond(self, body)
+        if faults.case == 'http_stale':
+            faults.count('fault')
+            self.close_connection = True
+
+
+def start_servers(origins, dir_archive, faults):
+    """ a stand-in per archive with the faults of the case, the key is the origin """
+    link = FaultLink(faults)
+    servers = {}
+    for origin in sorted(origins):
+        scheme, host = origin.split('://')
+        handler = FaultFtpHandler if scheme.startswith('ftp') else FaultHttpHandler
+        srv = bench.Server(handler, host, os.path.join(dir_archive, host), link)
+        srv.faults = faults
+        threading.Thread(target=srv.serve_forever, daemon=True).start()
+        servers[origin] = srv
+    return servers
+
+
+################################################################################
+# FUNCTION: the runs of GOOD
+################################################################################
+def local_files(mainDir):
+    """ the files downloaded with their contents, the key is the path relative to 'mainDir', the files of GOOD itself
+        in 'mainDir' (i.e., the log and the windows of the hosts) are NOT counted """
+    files = {}
+    for root, dirs, names in os.walk(mainDir):
+        if root == mainDir:
+            continue
+        for name in names:
+            path = os.path.join(root, name)
+            rel = os.path.relpath(path, mainDir)
+            with open(path, 'rb') as f_r:
+                files[rel] = f_r.read()
+    return files
+
+
+def run_case(args, case, dir_work, dir_archive, siteFile):
+    """ run GOOD against the stand-ins broken by the case, the files downloaded and the faults hit are returned """
+    scenario = 'igs' if case.startswith('ftp') else 'ngs'
+    mainDir = os.path.join(dir_work, 'run_' + case)
+    cfgFile = os.path.join(dir_work, 'check_' + case + '.cfg')
+    if os.path.isdir(mainDir):
+        shutil.rmtree(mainDir)
+    bench.write_cfg(cfgFile, mainDir, args, scenario, siteFile, '')
+    urls, places = bench.plan(args.bin, cfgFile)
+    if not urls:
+        return None, None, 0.0
+
+    origins = set()
+    for url in urls:
+        m = re.match(r'^([a-z]+://[^/]+)(/.*)$', url)
+        origins.add(m.group(1))
+        host = m.group(1).split('://')[1]
+        path = os.path.join(dir_archive, host, *m.group(2).lstrip('/').split('/'))
+        path = os.path.join(os.path.dirname(path), bench.resolve_name(os.path.basename(path)))
+        if not os.path.isfile(path):
+            bench.make_file(path, args.time[0], args.time[1], args.epochs, random.Random('%d %s' % (bench.SEED, url)))
+
+    faults = Faults(case)
+    servers = start_servers(origins, dir_archive, faults)
+    redirect = '+'.join('%s>%s://127.0.0.1:%d' % (o, 'ftp' if o.startswith('ftp') else 'http', s.server_address[1])
+                        for o, s in servers.items())
+    bench.write_cfg(cfgFile, mainDir, args, scenario, siteFile, redirect)
+
+    # the partial files left by the transfers cut short are resumed by the next run
+    nrun = 2 if case.endswith('_resume') or case == 'http_errbody' else 1
+    wall = 0.0
+    for r in range(nrun):
+        t0 = time.time()
+        with open(os.path.join(dir_work, 'check_%s_%d.log' % (case, r + 1)), 'w') as f_log:
+            subprocess.run([args.bin, cfgFile], stdout=f_log, stderr=subprocess.STDOUT)
+        if r == 0:
+            wall = time.time() - t0
+    for srv in servers.values():
+        srv.shutdown()
+        srv.server_close()
+
+    return local_files(mainDir), faults.counts, wall
+
+
+def check_case(case, files, counts, wall, reference):
+    """ the problems of the case, empty: passed """
+    problems = []
+    if files is None:
+        return ['NOTHING is planned']
+    if not reference:
+        problems.append('NOTHING is downloaded by the reference run')
+    for rel in sorted(set(reference) | set(files)):
+        if rel not in files:
+            problems.append(rel + ' is NOT downloaded')
+        elif rel not in reference:
+            problems.append(rel + ' is NOT downloaded by the reference run')
+        elif files[rel] != reference[rel]:
+            problems.append(rel + ' differs from the reference')
+    if counts.get('fault', 0) == 0:
+        problems.append('the fault is NOT hit')
+    if case == 'ftp_resume' and counts.get('REST', 0) == 0:
+        problems.append('NO transfer is resumed by "REST"')
+    if case == 'http_resume' and counts.get('Range', 0) == 0:
+        problems.append('NO transfer is resumed by "Range"')
+    if case == 'ftp_epsv' and counts.get('PASV', 0) == 0:
+        problems.append('NO data connection is opened by "PASV"')
+    if case == 'http_errbody' and wall > MAXWAIT:
+        problems.append('the first run took %.1f s, the body of the error is drained' % wall)
+    return problems
+
+
+################################################################################
+# FUNCTION: check of the transfer engine of GOOD software
+################################################################################
+def main_check_net_GOOD():
+    parser = argparse.ArgumentParser(description='check of the transfer engine of GOOD with the faults injected')
+    parser.add_argument('-bin', required=True)
+    parser.add_argument('-dir_work', default='check_work')
+    parser.add_argument('-case', nargs='+', default=CASES, choices=CASES)
+    parser.add_argument('-sites', type=int, default=6)
+    parser.add_argument('-epochs', type=int, default=240)
+    args = parser.parse_args()
+
+    args.bin = os.path.abspath(args.bin)
+    if not os.path.isfile(args.bin):
+        print('*** ERROR: The executable program ' + args.bin + ' is NOT found! Please check it.\n')
+        return 1
+    dir_work = os.path.abspath(args.dir_work)
+    if not os.path.isdir(dir_work):
+        os.makedirs(dir_work)
+    dir_archive = os.path.join(dir_work, 'archive_%d' % args.epochs)
+
+    # the settings of 'bench_GOOD.py', the logins are tried again ONLY if the windows are adjusted ('adaptParallel')
+    args.ftp, args.time, args.parallel, args.adapt = 'cddis', [2022, 32, 1], 4, 1
+    siteFile = os.path.join(dir_work, 'site_check.list')
+    with open(siteFile, 'w') as f_w:
+        f_w.write(''.join('b%03d\n' % i for i in range(args.sites)))
+
+    references = {}
+    nfail = 0
+    print('%-13s %7s %7s %9s  %s' % ('case', 'files', 'faults', 'seconds', 'result'))
+    for case in args.case:
+        proto = case.split('_')[0]
+        if proto not in references:
+            references[proto], counts, wall = run_case(args, proto + '_none', dir_work, dir_archive, siteFile)
+            references[proto] = references[proto] or {}
+        files, counts, wall = run_case(args, case, dir_work, dir_archive, siteFile)
+        problems = check_case(case, files, counts or {}, wall, references[proto])
+        print('%-13s %7d %7d %9.2f  %s' % (case, len(files or {}), (counts or {}).get('fault', 0), wall,
+                                           'FAILED' if problems else 'passed'))
+        for problem in problems[:10]:
+            print('*** ERROR: ' + problem)
+        if problems:
+            nfail += 1
+    return 1 if nfail > 0 else 0
+
+
+################################################################################
+# Main program
+################################################################################
+if __name__ == '__main__':
+    sys.exit(main_check_net_GOOD())
@@ -0,0 +1,241 @@
+/*------------------------------------------------------------------------------
+* AimdUtil.cpp : the requests in flight per host adjusted by additive-increase/multiplicative-decrease (AIMD)
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    D. Chiu, R. Jain, Analysis of the Increase and Decrease Algorithms for Congestion Avoidance in Computer Networks,
+*    Computer Networks and ISDN Systems, 17(1), 1-14, 1989
+*
+* history : 2026/10/18 1.0  new, the window of every host is widened by one while the throughput grows, and halved when
+*                           the host refuses the requests (FTP 421/530, HTTP 429/503) or resets the connections, and
+*                           the windows are persisted for the next runs
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "FileUtil.h"
+#include "MetricsUtil.h"
+#include "AimdUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define AIMD_INITWND    2.0       /* the window of the host never seen */
+#define AIMD_MAXWND     32.0      /* the max window */
+#define AIMD_GAIN       0.10      /* the growth of throughput for widening the window */
+#define MAX(x, y)       ((x) > (y) ? (x) : (y))
+#define MIN(x, y)       ((x) < (y) ? (x) : (y))
+
+
+/* function definition -------------------------------------------------------*/
+
+AimdUtil::AimdUtil()
+{
+    _verbose = false;
+}
+
+AimdUtil::~AimdUtil()
+{
+
+}
+
+/**
+* @brief   : Host - the window of a host, which is created if it is NOT found
+* @param[I]: host (host name)
+* @param[O]: none
+* @return  : the window
+* @note    : the lock should be held
+**/
+AimdUtil::host_t &AimdUtil::Host(const string &host)
+{
+    StringUtil str;
+    string name = host;
+    str.ToLower(name);
+    std::map<string, host_t>::iterator it = _hosts.find(name);
+    if (it != _hosts.end()) return it->second;
+
+    host_t h = { AIMD_INITWND, 0, 0, 0, 0.0, 0.0, false, 0, 0 };
+
+    return _hosts[name] = h;
+} /* end of Host */
+
+/**
+* @brief   : SetVerbose - print the information of every change of the windows or not
+* @param[I]: verbose (true: print)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void AimdUtil::SetVerbose(bool verbose)
+{
+    _verbose = verbose;
+} /* end of SetVerbose */
+
+/**
+* @brief   : Load - read the windows learned by the previous runs
+* @param[I]: file (the file with full path, empty: NOT persisted)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the windows are kept in memory if the file is the one already loaded
+**/
+bool AimdUtil::Load(const string &file)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (file == _file) return true;
+
+    _file = file;
+    _hosts.clear();
+    if (_file.empty()) return true;
+
+    FILE *fp = fopen(_file.c_str(), "r");
+    if (!fp) return false;  /* NOT created yet */
+
+    char line[MAXCHARS], name[MAXCHARS];
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (line[0] == '#') continue;
+        double wnd;
+        if (sscanf(line, "%s %lf", name, &wnd) != 2 || wnd < 1.0) continue;
+        Host(name).wnd = MIN(wnd, AIMD_MAXWND);
+    }
+    fclose(fp);
+
+    return true;
+} /* end of Load */
+
+/**
+* @brief   : Save - persist the windows for the next runs
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool AimdUtil::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_file.empty()) return true;
+
+    string tmpFile = _file + ".tmp";
+    FILE *fp = fopen(tmpFile.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** WARNING(AimdUtil::Save): open " << tmpFile << " failed" << endl;
+
+        return false;
+    }
+    fprintf(fp, "# host  window  cuts(in the last run)\n");
+    for (std::map<string, host_t>::const_iterator it = _hosts.begin(); it != _hosts.end(); ++it)
+    {
+        fprintf(fp, "%s %.2f %d\n", it->first.c_str(), it->second.wnd, it->second.ncut);
+    }
+    bool ok = fclose(fp) == 0;
+    if (ok) ok = FileUtil::Rename(tmpFile, _file);
+    if (!ok) remove(tmpFile.c_str());
+
+    return ok;
+} /* end of Save */
+
+/**
+* @brief   : Enter - wait until a request to the host is allowed by its window
+* @param[I]: host (host name)
+* @param[O]: none
+* @return  : the generation of the window when the request is started (see Backoff)
+* @note    : every call should be paired with Leave
+**/
+int AimdUtil::Enter(const string &host)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    host_t &h = Host(host);
+    while (h.inflight >= (int)h.wnd) _free.wait(lock);
+
+    /* the round is started when the host gets busy, so the idle time is NOT counted */
+    if (h.inflight == 0)
+    {
+        h.ndone = 0;
+        h.bytes = 0;
+        h.start = MetricsUtil::Now();
+        h.full = false;
+    }
+    if (++h.inflight >= (int)h.wnd) h.full = true;
+
+    return h.gen;
+} /* end of Enter */
+
+/**
+* @brief   : Leave - finish a request to the host
+* @param[I]: host (host name)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void AimdUtil::Leave(const string &host)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    host_t &h = Host(host);
+    if (h.inflight > 0) h.inflight--;
+    _free.notify_all();
+} /* end of Leave */
+
+/**
+* @brief   : Done - add a transfer finished to the current round of the host (additive increase)
+* @param[I]: host (host name)
+* @param[I]: nbytes (number of the bytes transferred)
+* @param[O]: none
+* @return  : none
+* @note    : a round is finished when as many transfers as the window are finished, and the window is widened by
+*            one if it was full and the throughput of the round is higher than the best one by AIMD_GAIN, so that
+*            it stops growing when the host (or the link) is saturated
+**/
+void AimdUtil::Done(const string &host, long long nbytes)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    host_t &h = Host(host);
+    h.ndone++;
+    h.bytes += nbytes;
+    if (h.ndone < (int)h.wnd) return;
+
+    double now = MetricsUtil::Now();
+    double rate = (double)h.bytes / MAX(now - h.start, 1.0E-3);
+    if (h.full && (h.best <= 0.0 || rate >= h.best * (1.0 + AIMD_GAIN)) && h.wnd < AIMD_MAXWND)
+    {
+        h.wnd = MIN(h.wnd + 1.0, AIMD_MAXWND);
+        _free.notify_all();
+        if (_verbose) cout << "*** INFO(AimdUtil::Done): " << host << "  window " << (int)h.wnd << "  (" <<
+            (int)(rate / 1024.0) << " KB/s)" << endl;
+    }
+    if (rate > h.best) h.best = rate;
+    h.ndone = 0;
+    h.bytes = 0;
+    h.start = now;
+    h.full = h.inflight >= (int)h.wnd;
+} /* end of Done */
+
+/**
+* @brief   : Backoff - halve the window of the host (multiplicative decrease)
+* @param[I]: host (host name)
+* @param[I]: why (the signal, i.e., "421", "429", or "reset")
+* @param[I]: gen (the generation of the window when the request was started, see Enter)
+* @param[O]: none
+* @return  : none
+* @note    : the window is cut once per generation, since the other requests refused at the same time were
+*            started with the window before the cut
+**/
+void AimdUtil::Backoff(const string &host, const string &why, int gen)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    host_t &h = Host(host);
+    if (gen != h.gen) return;
+
+    /* the best throughput is expected to be halved as well, so the window grows again if it still pays off */
+    int wnd0 = (int)h.wnd;
+    h.wnd = MAX(1.0, (double)(int)(h.wnd * 0.5));
+    h.best *= 0.5;
+    h.gen++;
+    h.ncut++;
+    h.ndone = 0;
+    h.bytes = 0;
+    h.start = MetricsUtil::Now();
+    h.full = false;
+    if (_verbose) cout << "*** INFO(AimdUtil::Backoff): " << host << "  window " << wnd0 << " -> " << (int)h.wnd <<
+        "  (" << why << ")" << endl;
+} /* end of Backoff */
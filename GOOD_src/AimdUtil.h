@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------------
+* AimdUtil.h : header file of AimdUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class AimdUtil
+{
+private:
+
+    struct host_t
+    {                             /* the window of a host */
+        double wnd;               /* the max number of the requests in flight (the window) */
+        int inflight;             /* number of the requests in flight */
+        int ndone;                /* number of the transfers finished in the current round */
+        long long bytes;          /* the bytes of the transfers finished in the current round */
+        double start;             /* the time when the current round was started (s) */
+        double best;              /* the best throughput of the rounds (bytes/s), 0: unknown */
+        bool full;                /* true: the requests in flight reached the window in the current round */
+        int gen;                  /* the generation of the window, which is increased by every cut */
+        int ncut;                 /* number of the cuts in the run */
+    };
+
+    std::map<string, host_t> _hosts;  /* the windows, the key is the host name in lowercase */
+    std::mutex _lock;             /* the lock of the windows */
+    std::condition_variable _free;  /* notified when a request is finished or a window is widened */
+    string _file;                 /* the file where the windows are persisted (empty: NOT persisted) */
+    bool _verbose;                /* true: print the information of every change of the windows */
+
+private:
+
+    /**
+    * @brief   : Host - the window of a host, which is created if it is NOT found
+    * @param[I]: host (host name)
+    * @param[O]: none
+    * @return  : the window
+    * @note    : the lock should be held
+    **/
+    host_t &Host(const string &host);
+
+public:
+    AimdUtil();
+    ~AimdUtil();
+
+    /**
+    * @brief   : SetVerbose - print the information of every change of the windows or not
+    * @param[I]: verbose (true: print)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetVerbose(bool verbose);
+
+    /**
+    * @brief   : Load - read the windows learned by the previous runs
+    * @param[I]: file (the file with full path, empty: NOT persisted)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the windows are kept in memory if the file is the one already loaded
+    **/
+    bool Load(const string &file);
+
+    /**
+    * @brief   : Save - persist the windows for the next runs
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Save();
+
+    /**
+    * @brief   : Enter - wait until a request to the host is allowed by its window
+    * @param[I]: host (host name)
+    * @param[O]: none
+    * @return  : the generation of the window when the request is started (see Backoff)
+    * @note    : every call should be paired with Leave
+    **/
+    int Enter(const string &host);
+
+    /**
+    * @brief   : Leave - finish a request to the host
+    * @param[I]: host (host name)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Leave(const string &host);
+
+    /**
+    * @brief   : Done - add a transfer finished to the current round of the host (additive increase)
+    * @param[I]: host (host name)
+    * @param[I]: nbytes (number of the bytes transferred)
+    * @param[O]: none
+    * @return  : none
+    * @note    : a round is finished when as many transfers as the window are finished, and the window is widened by
+    *            one if it was full and the throughput of the round is higher than the best one by AIMD_GAIN, so that
+    *            it stops growing when the host (or the link) is saturated
+    **/
+    void Done(const string &host, long long nbytes);
+
+    /**
+    * @brief   : Backoff - halve the window of the host (multiplicative decrease)
+    * @param[I]: host (host name)
+    * @param[I]: why (the signal, i.e., "421", "429", or "reset")
+    * @param[I]: gen (the generation of the window when the request was started, see Enter)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the window is cut once per generation, since the other requests refused at the same time were
+    *            started with the window before the cut
+    **/
+    void Backoff(const string &host, const string &why, int gen);
+};
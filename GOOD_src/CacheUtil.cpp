@@ -0,0 +1,488 @@
+/*------------------------------------------------------------------------------
+* CacheUtil.cpp : the content-addressed cache of the remote files shared by the runs on the same host
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    FIPS PUB 180-4, Secure Hash Standard (SHS), NIST, 2015
+*
+* history : 2026/10/18 1.0  new, the remote files downloaded are kept as the objects named by SHA-256 of the content, and
+*                           the records of the canonical URLs point to them, so the same file asked by another run (i.e.,
+*                           with another 'mainDir') is cloned by reflink or hard link without any transfer
+*           2026/10/18      the objects are looked up for the caching proxy, which downloads the remote files to the
+*                             partial files in "tmp" (see Find, Spool, and ProxyUtil)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "FileUtil.h"
+#include "CacheUtil.h"
+
+#include <stdint.h>
+#include <sys/stat.h>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXHASHBUFF     65536     /* the bytes hashed at a time */
+
+/* the cache directory is laid out as below, and every file is written to "tmp" at first and then renamed
+     "obj/3f/3f9a...c2"  the object, i.e., the content of a remote file, named by its SHA-256 (read-only)
+     "url/a0/a07e...19"  the record of a remote URL, named by SHA-256 of the canonical URL, with two lines
+                         "<canonical URL>"
+                         "<object> <object size> <remote size> <remote mtime> <CRC32> <ETag>" */
+
+
+/* function definition -------------------------------------------------------*/
+
+struct sha256_t
+{                                 /* the state of SHA-256 */
+    uint32_t h[8];                /* the hash values */
+    unsigned char block[64];      /* the bytes of the block NOT hashed yet */
+    size_t nblock;                /* number of the bytes in the block */
+    unsigned long long nbytes;    /* number of the bytes hashed */
+};
+
+static const uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR32(x, n)    (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+* @brief   : Sha256Block - hash a block of 64 bytes
+* @param[I]: ctx (the state)
+* @param[I]: p (the block)
+* @param[O]: ctx (the state updated)
+* @return  : none
+* @note    :
+**/
+static void Sha256Block(sha256_t &ctx, const unsigned char *p)
+{
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++)
+    {
+        w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 | (uint32_t)p[4 * i + 2] << 8 | (uint32_t)p[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++)
+    {
+        uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = ctx.h[0], b = ctx.h[1], c = ctx.h[2], d = ctx.h[3], e = ctx.h[4], f = ctx.h[5], g = ctx.h[6], h = ctx.h[7];
+    for (int i = 0; i < 64; i++)
+    {
+        uint32_t t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + K256[i] + w[i];
+        uint32_t t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    ctx.h[0] += a;
+    ctx.h[1] += b;
+    ctx.h[2] += c;
+    ctx.h[3] += d;
+    ctx.h[4] += e;
+    ctx.h[5] += f;
+    ctx.h[6] += g;
+    ctx.h[7] += h;
+} /* end of Sha256Block */
+
+/**
+* @brief   : Sha256Init - start SHA-256
+* @param[I]: none
+* @param[O]: ctx (the state)
+* @return  : none
+* @note    :
+**/
+static void Sha256Init(sha256_t &ctx)
+{
+    static const uint32_t h0[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    for (int i = 0; i < 8; i++) ctx.h[i] = h0[i];
+    ctx.nblock = 0;
+    ctx.nbytes = 0;
+} /* end of Sha256Init */
+
+/**
+* @brief   : Sha256Update - hash the bytes
+* @param[I]: ctx (the state)
+* @param[I]: buff (the bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: ctx (the state updated)
+* @return  : none
+* @note    :
+**/
+static void Sha256Update(sha256_t &ctx, const char *buff, size_t n)
+{
+    const unsigned char *p = (const unsigned char *)buff;
+    ctx.nbytes += n;
+    while (n > 0)
+    {
+        size_t m = 64 - ctx.nblock;
+        if (m > n) m = n;
+        memcpy(ctx.block + ctx.nblock, p, m);
+        ctx.nblock += m;
+        p += m;
+        n -= m;
+        if (ctx.nblock == 64)
+        {
+            Sha256Block(ctx, ctx.block);
+            ctx.nblock = 0;
+        }
+    }
+} /* end of Sha256Update */
+
+/**
+* @brief   : Sha256Final - finish SHA-256
+* @param[I]: ctx (the state)
+* @param[O]: none
+* @return  : the digest in hex
+* @note    :
+**/
+static string Sha256Final(sha256_t &ctx)
+{
+    /* padding: '1' bit, zeros, and the length in bits (big-endian) */
+    unsigned long long nbits = ctx.nbytes * 8;
+    unsigned char pad[72] = { 0x80 };
+    size_t npad = (ctx.nblock < 56 ? 56 : 120) - ctx.nblock;
+    for (int i = 0; i < 8; i++) pad[npad + i] = (unsigned char)(nbits >> (56 - 8 * i));
+    Sha256Update(ctx, (const char *)pad, npad + 8);
+
+    char hex[65] = { '\0' };
+    for (int i = 0; i < 8; i++) sprintf(hex + 8 * i, "%08x", (unsigned int)ctx.h[i]);
+
+    return hex;
+} /* end of Sha256Final */
+
+CacheUtil::CacheUtil()
+{
+
+}
+
+CacheUtil::~CacheUtil()
+{
+
+}
+
+/**
+* @brief   : Canonical - the canonical form of a remote URL
+* @param[I]: url (URL)
+* @param[O]: none
+* @return  : the URL with the scheme and the host in lowercase, and without the user, the default port, and the
+*            repeated '/', i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/igs21906.sp3.Z"
+* @note    :
+**/
+string CacheUtil::Canonical(const string &url)
+{
+    size_t pos = url.find("://");
+    if (pos == string::npos) return url;
+
+    StringUtil str;
+    string scheme = url.substr(0, pos), rest = url.substr(pos + 3);
+    str.ToLower(scheme);
+    size_t slash = rest.find('/');
+    string host = rest.substr(0, slash), path = slash == string::npos ? "/" : rest.substr(slash);
+
+    /* the user (and password), and the default port */
+    size_t at = host.find_last_of('@');
+    if (at != string::npos) host.erase(0, at + 1);
+    str.ToLower(host);
+    size_t colon = host.find_last_of(':'), bracket = host.find_last_of(']');
+    if (colon != string::npos && (bracket == string::npos || colon > bracket))
+    {
+        string port = host.substr(colon + 1);
+        if (port.empty() || (port == "21" && (scheme == "ftp" || scheme == "ftps")) || (port == "80" && scheme == "http") ||
+            (port == "443" && scheme == "https")) host.erase(colon);
+    }
+
+    string canon = scheme + "://" + host;
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        if (path[i] == '/' && canon[canon.size() - 1] == '/') continue;
+        canon += path[i];
+    }
+
+    return canon;
+} /* end of Canonical */
+
+/**
+* @brief   : Sha256 - SHA-256 of the bytes
+* @param[I]: buff (the bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : the digest in hex
+* @note    :
+**/
+string CacheUtil::Sha256(const char *buff, size_t n)
+{
+    sha256_t ctx;
+    Sha256Init(ctx);
+    Sha256Update(ctx, buff, n);
+
+    return Sha256Final(ctx);
+} /* end of Sha256 */
+
+/**
+* @brief   : Sha256File - SHA-256 of the content of a file
+* @param[I]: file (the file with full path)
+* @param[O]: length (size of the file)
+* @return  : the digest in hex, empty: error
+* @note    :
+**/
+string CacheUtil::Sha256File(const string &file, long long &length)
+{
+    length = 0;
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return "";
+
+    sha256_t ctx;
+    Sha256Init(ctx);
+    std::vector<char> buff(MAXHASHBUFF);
+    size_t n;
+    while ((n = fread(&buff[0], 1, buff.size(), fp)) > 0)
+    {
+        Sha256Update(ctx, &buff[0], n);
+        length += (long long)n;
+    }
+    bool ok = !ferror(fp);
+    fclose(fp);
+
+    return ok ? Sha256Final(ctx) : "";
+} /* end of Sha256File */
+
+/**
+* @brief   : Path - the file in a sub-directory of the cache named by the first two characters of the key
+* @param[I]: sub (the sub-directory, "obj" or "url")
+* @param[I]: key (the digest in hex)
+* @param[O]: none
+* @return  : the file with full path, i.e., "<dir>/obj/3f/3f9a..."
+* @note    :
+**/
+string CacheUtil::Path(const string &sub, const string &key)
+{
+    StringUtil str;
+
+    return str.FullPath(str.FullPath(str.FullPath(_dir, sub), key.substr(0, 2)), key);
+} /* end of Path */
+
+/**
+* @brief   : TmpName - the suffix of a temporary file, which is unique among the threads and the processes
+* @param[I]: none
+* @param[O]: none
+* @return  : the suffix, i.e., ".1234.5f3e0a7c.tmp"
+* @note    :
+**/
+string CacheUtil::TmpName()
+{
+    char tmpName[64] = { '\0' };
+    sprintf(tmpName, ".%d.%llx.tmp", (int)getpid(), (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    return tmpName;
+} /* end of TmpName */
+
+/**
+* @brief   : Open - use the directory as the cache
+* @param[I]: dir (the directory, empty: NOT used)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the directory (and its sub-directories) are created if they do NOT exist
+**/
+bool CacheUtil::Open(const string &dir)
+{
+    StringUtil str;
+    _dir.clear();
+    if (dir.empty()) return true;
+
+    if (!FileUtil::MakeDir(str.FullPath(dir, "obj")) || !FileUtil::MakeDir(str.FullPath(dir, "url")) ||
+        !FileUtil::MakeDir(str.FullPath(dir, "tmp")))
+    {
+        cerr << "*** WARNING(CacheUtil::Open): the cache " << dir << " can NOT be used" << endl;
+
+        return false;
+    }
+    _dir = dir;
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : IsOpen - check if the cache is used
+* @param[I]: none
+* @param[O]: none
+* @return  : true: used, false: NOT used
+* @note    :
+**/
+bool CacheUtil::IsOpen()
+{
+    return !_dir.empty();
+} /* end of IsOpen */
+
+/**
+* @brief   : Find - look up a remote file in the cache
+* @param[I]: url (URL of the remote file)
+* @param[O]: entry (the remote file in the cache)
+* @param[O]: objFile (the object with full path, which is read-only)
+* @return  : true: found, false: NOT in the cache or error
+* @note    :
+**/
+bool CacheUtil::Find(const string &url, entry_t &entry, string &objFile)
+{
+    if (_dir.empty()) return false;
+
+    string canon = Canonical(url);
+    FILE *fp = fopen(Path("url", Sha256(canon.c_str(), canon.size())).c_str(), "r");
+    if (!fp) return false;
+
+    char line[MAXCHARS] = { '\0' }, object[MAXCHARS] = { '\0' }, etag[MAXCHARS] = { '\0' };
+    long long mtime = 0;
+    bool ok = fgets(line, sizeof(line), fp) != nullptr;
+    if (ok)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        ok = canon == line && fgets(line, sizeof(line), fp) != nullptr && sscanf(line, "%s %lld %lld %lld %lx %[^\r\n]",
+            object, &entry.length, &entry.size, &mtime, &entry.crc, etag) >= 5 && strlen(object) == 64;
+    }
+    fclose(fp);
+    if (!ok) return false;
+    entry.object = object;
+    entry.mtime = (time_t)mtime;
+    entry.etag = etag;
+
+    /* the object removed or truncated (i.e., by hand) is NOT used */
+    objFile = Path("obj", entry.object);
+    struct stat st;
+
+    return stat(objFile.c_str(), &st) == 0 && (long long)st.st_size == entry.length;
+} /* end of Find */
+
+/**
+* @brief   : Get - make the local file from the cache if the remote file is in it
+* @param[I]: url (URL of the remote file)
+* @param[I]: localFile (the local file with full path)
+* @param[O]: entry (the remote file in the cache)
+* @return  : true: made from the cache, false: NOT in the cache or error
+* @note    : the local file is cloned from the object by reflink or hard link (see FileUtil::Clone) without any
+*            transfer, and it replaces the existing one atomically
+**/
+bool CacheUtil::Get(const string &url, const string &localFile, entry_t &entry)
+{
+    string objFile;
+    if (!Find(url, entry, objFile)) return false;
+
+    string tmpFile = localFile + TmpName();
+    if (FileUtil::Clone(objFile, tmpFile) == 0) return false;
+    if (!FileUtil::Rename(tmpFile, localFile))
+    {
+        remove(tmpFile.c_str());
+
+        return false;
+    }
+
+    return true;
+} /* end of Get */
+
+/**
+* @brief   : Put - add the local file downloaded to the cache
+* @param[I]: url (URL of the remote file)
+* @param[I]: localFile (the local file with full path)
+* @param[I]: size (size of the remote file, -1: unknown)
+* @param[I]: mtime (modification time of the remote file, 0: unknown)
+* @param[I]: etag (entity tag of the remote file, empty: unknown)
+* @param[I]: crc (CRC32 of the content)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the object is shared by the remote files with the same content. The object and the record of the URL
+*            are written to temporary files and renamed, so the other processes never see a part of them
+**/
+bool CacheUtil::Put(const string &url, const string &localFile, long long size, time_t mtime, const string &etag,
+    unsigned long crc)
+{
+    if (_dir.empty()) return false;
+
+    StringUtil str;
+    long long length;
+    string object = Sha256File(localFile, length);
+    if (object.empty()) return false;
+
+    /* the object is NOT written again if it has been added by another run; it is read-only, so the local files
+       linked to it can NOT be changed in place */
+    string objFile = Path("obj", object);
+    struct stat st;
+    if (stat(objFile.c_str(), &st) != 0 || (long long)st.st_size != length)
+    {
+        string tmpFile = str.FullPath(str.FullPath(_dir, "tmp"), object + TmpName());
+        if (!FileUtil::MakeDir(str.FullPath(str.FullPath(_dir, "obj"), object.substr(0, 2))) ||
+            FileUtil::Clone(localFile, tmpFile) == 0) return false;
+#ifndef _WIN32  /* for Linux or Mac */
+        chmod(tmpFile.c_str(), 0444);
+#endif
+        if (!FileUtil::Rename(tmpFile, objFile))
+        {
+            remove(tmpFile.c_str());
+
+            return false;
+        }
+    }
+
+    /* the record of the URL */
+    string canon = Canonical(url), key = Sha256(canon.c_str(), canon.size());
+    string tmpFile = str.FullPath(str.FullPath(_dir, "tmp"), key + TmpName());
+    if (!FileUtil::MakeDir(str.FullPath(str.FullPath(_dir, "url"), key.substr(0, 2)))) return false;
+    FILE *fp = fopen(tmpFile.c_str(), "w");
+    if (!fp) return false;
+    bool ok = fprintf(fp, "%s\n%s %lld %lld %lld %08lx %s\n", canon.c_str(), object.c_str(), length, size, (long long)mtime,
+        crc & 0xffffffffUL, etag.find_first_of("\r\n") == string::npos ? etag.c_str() : "") > 0;
+    if (fclose(fp) != 0) ok = false;
+    if (ok) ok = FileUtil::Rename(tmpFile, Path("url", key));
+    if (!ok) remove(tmpFile.c_str());
+
+    return ok;
+} /* end of Put */
+
+/**
+* @brief   : Forget - remove the record of a remote file, i.e., it has been republished
+* @param[I]: url (URL of the remote file)
+* @param[O]: none
+* @return  : none
+* @note    : the object is kept, since it may be shared by the other remote files
+**/
+void CacheUtil::Forget(const string &url)
+{
+    if (_dir.empty()) return;
+
+    string canon = Canonical(url);
+    remove(Path("url", Sha256(canon.c_str(), canon.size())).c_str());
+} /* end of Forget */
+
+/**
+* @brief   : Spool - the partial file where a remote file is downloaded before it is added to the cache
+* @param[I]: url (URL of the remote file)
+* @param[O]: none
+* @return  : the file with full path, i.e., "<dir>/tmp/a07e...19.part", empty: the cache is NOT used
+* @note    : it is named by SHA-256 of the canonical URL, so the transfer broken is resumed by the next one
+*            (see NetUtil::GetPart), and ONLY one transfer of the URL should be running at a time
+**/
+string CacheUtil::Spool(const string &url)
+{
+    if (_dir.empty()) return "";
+
+    StringUtil str;
+    string canon = Canonical(url);
+
+    return str.FullPath(str.FullPath(_dir, "tmp"), Sha256(canon.c_str(), canon.size()) + ".part");
+} /* end of Spool */
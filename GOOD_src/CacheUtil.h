@@ -0,0 +1,151 @@
+/*------------------------------------------------------------------------------
+* CacheUtil.h : header file of CacheUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class CacheUtil
+{
+public:
+
+    struct entry_t
+    {                             /* the remote file in the cache */
+        string object;            /* SHA-256 of the content (in hex), which is the name of the object */
+        long long length;         /* size of the object (bytes) */
+        long long size;           /* size of the remote file (bytes), -1: unknown */
+        time_t mtime;             /* modification time of the remote file in seconds since 1970-01-01 UTC, 0: unknown */
+        string etag;              /* entity tag of the remote file, empty: unknown */
+        unsigned long crc;        /* CRC32 of the content */
+    };
+
+private:
+
+    string _dir;                  /* the directory of the cache, empty: NOT used */
+
+private:
+
+    /**
+    * @brief   : Canonical - the canonical form of a remote URL
+    * @param[I]: url (URL)
+    * @param[O]: none
+    * @return  : the URL with the scheme and the host in lowercase, and without the user, the default port, and the
+    *            repeated '/', i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/igs21906.sp3.Z"
+    * @note    :
+    **/
+    static string Canonical(const string &url);
+
+    /**
+    * @brief   : Sha256 - SHA-256 of the bytes
+    * @param[I]: buff (the bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : the digest in hex
+    * @note    :
+    **/
+    static string Sha256(const char *buff, size_t n);
+
+    /**
+    * @brief   : Sha256File - SHA-256 of the content of a file
+    * @param[I]: file (the file with full path)
+    * @param[O]: length (size of the file)
+    * @return  : the digest in hex, empty: error
+    * @note    :
+    **/
+    static string Sha256File(const string &file, long long &length);
+
+    /**
+    * @brief   : Path - the file in a sub-directory of the cache named by the first two characters of the key
+    * @param[I]: sub (the sub-directory, "obj" or "url")
+    * @param[I]: key (the digest in hex)
+    * @param[O]: none
+    * @return  : the file with full path, i.e., "<dir>/obj/3f/3f9a..."
+    * @note    :
+    **/
+    string Path(const string &sub, const string &key);
+
+    /**
+    * @brief   : TmpName - the suffix of a temporary file, which is unique among the threads and the processes
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the suffix, i.e., ".1234.5f3e0a7c.tmp"
+    * @note    :
+    **/
+    static string TmpName();
+
+public:
+    CacheUtil();
+    ~CacheUtil();
+
+    /**
+    * @brief   : Open - use the directory as the cache
+    * @param[I]: dir (the directory, empty: NOT used)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the directory (and its sub-directories) are created if they do NOT exist
+    **/
+    bool Open(const string &dir);
+
+    /**
+    * @brief   : IsOpen - check if the cache is used
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: used, false: NOT used
+    * @note    :
+    **/
+    bool IsOpen();
+
+    /**
+    * @brief   : Find - look up a remote file in the cache
+    * @param[I]: url (URL of the remote file)
+    * @param[O]: entry (the remote file in the cache)
+    * @param[O]: objFile (the object with full path, which is read-only)
+    * @return  : true: found, false: NOT in the cache or error
+    * @note    :
+    **/
+    bool Find(const string &url, entry_t &entry, string &objFile);
+
+    /**
+    * @brief   : Get - make the local file from the cache if the remote file is in it
+    * @param[I]: url (URL of the remote file)
+    * @param[I]: localFile (the local file with full path)
+    * @param[O]: entry (the remote file in the cache)
+    * @return  : true: made from the cache, false: NOT in the cache or error
+    * @note    : the local file is cloned from the object by reflink or hard link (see FileUtil::Clone) without any
+    *            transfer, and it replaces the existing one atomically
+    **/
+    bool Get(const string &url, const string &localFile, entry_t &entry);
+
+    /**
+    * @brief   : Put - add the local file downloaded to the cache
+    * @param[I]: url (URL of the remote file)
+    * @param[I]: localFile (the local file with full path)
+    * @param[I]: size (size of the remote file, -1: unknown)
+    * @param[I]: mtime (modification time of the remote file, 0: unknown)
+    * @param[I]: etag (entity tag of the remote file, empty: unknown)
+    * @param[I]: crc (CRC32 of the content)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the object is shared by the remote files with the same content. The object and the record of the URL
+    *            are written to temporary files and renamed, so the other processes never see a part of them
+    **/
+    bool Put(const string &url, const string &localFile, long long size, time_t mtime, const string &etag,
+        unsigned long crc);
+
+    /**
+    * @brief   : Forget - remove the record of a remote file, i.e., it has been republished
+    * @param[I]: url (URL of the remote file)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the object is kept, since it may be shared by the other remote files
+    **/
+    void Forget(const string &url);
+
+    /**
+    * @brief   : Spool - the partial file where a remote file is downloaded before it is added to the cache
+    * @param[I]: url (URL of the remote file)
+    * @param[O]: none
+    * @return  : the file with full path, i.e., "<dir>/tmp/a07e...19.part", empty: the cache is NOT used
+    * @note    : it is named by SHA-256 of the canonical URL, so the transfer broken is resumed by the next one
+    *            (see NetUtil::GetPart), and ONLY one transfer of the URL should be running at a time
+    **/
+    string Spool(const string &url);
+};
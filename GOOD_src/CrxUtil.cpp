@@ -0,0 +1,580 @@
+/*------------------------------------------------------------------------------
+* CrxUtil.cpp : decoder of Compact RINEX (Hatanaka) format
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    Y. Hatanaka, A Compression Format and Tools for GNSS Observation Data, Bulletin of the Geospatioal Information
+*    Authority of Japan, 55, 21-30, 2008
+*
+* history : 2026/10/18 1.0  new, Compact RINEX 1.0 (RINEX 2) and 3.0 (RINEX 3 or later) are decoded in the process
+*                           instead of the external 'crx2rnx'
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "CrxUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXOUTBUFF      65536     /* the decoded bytes are given to the receiver in blocks of this size */
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : ParseInt - parse the integer of the field in Compact RINEX
+* @param[I]: p (the first character of the field)
+* @param[I]: e (the end of the field)
+* @param[O]: val (the integer)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool ParseInt(const char *p, const char *e, long long &val)
+{
+    bool neg = false;
+    if (p < e && (*p == '-' || *p == '+')) neg = *p++ == '-';
+    if (p == e) return false;
+
+    long long x = 0;
+    for (; p < e; p++)
+    {
+        if (*p < '0' || *p > '9') return false;
+        x = x * 10 + (*p - '0');
+    }
+    val = neg ? -x : x;
+
+    return true;
+} /* end of ParseInt */
+
+/**
+* @brief   : PutFixed - put the integer as a fixed point number right-justified in the field
+* @param[I]: val (the integer, i.e., the number multiplied by 10^ndec)
+* @param[I]: ndec (number of decimals)
+* @param[I]: width (width of the field)
+* @param[O]: out (the output)
+* @return  : none
+* @note    : the zero before the decimal point is omitted as FORTRAN does, i.e., "-.123"
+**/
+static void PutFixed(long long val, int ndec, int width, string &out)
+{
+    char buff[32];
+    char *p = buff + sizeof(buff);
+    unsigned long long x = val < 0 ? 0ULL - (unsigned long long)val : (unsigned long long)val;
+    for (int i = 0; i < ndec; i++, x /= 10) *--p = (char)('0' + x % 10);
+    *--p = '.';
+    for (; x > 0; x /= 10) *--p = (char)('0' + x % 10);
+    if (val < 0) *--p = '-';
+
+    int n = (int)(buff + sizeof(buff) - p);
+    if (n < width) out.append(width - n, ' ');
+    out.append(p, n);
+} /* end of PutFixed */
+
+/**
+* @brief   : Repair - apply the differences of the text to the text of the previous epoch
+* @param[I]: diff (the differences, ' ': NOT changed, '&': changed to space)
+* @param[I]: n (number of characters of the differences)
+* @param[O]: text (the text of the previous epoch as input, the text of the current epoch as output)
+* @return  : none
+* @note    :
+**/
+static void Repair(const char *diff, size_t n, string &text)
+{
+    if (text.size() < n) text.resize(n, ' ');
+    for (size_t i = 0; i < n; i++)
+    {
+        if (diff[i] == ' ') continue;
+        text[i] = diff[i] == '&' ? ' ' : diff[i];
+    }
+} /* end of Repair */
+
+/**
+* @brief   : TrimEnd - remove the spaces at the end of the output line
+* @param[I]: start (the start of the line in the output)
+* @param[O]: out (the output)
+* @return  : none
+* @note    :
+**/
+static void TrimEnd(size_t start, string &out)
+{
+    size_t n = out.size();
+    while (n > start && out[n - 1] == ' ') n--;
+    out.resize(n);
+} /* end of TrimEnd */
+
+/**
+* @brief   : Differ - compute the next value of the differential sequence
+* @param[I]: p (the first character of the field)
+* @param[I]: e (the end of the field)
+* @param[O]: u (the value (u[0]) and its differences up to the current order)
+* @param[O]: order (the current order of the differences, -1: the field was blank)
+* @param[O]: arcOrder (the order of the differences given at the initialization of the arc)
+* @return  : 1: ok, 0: the arc is NOT initialized, -1: invalid field
+* @note    : the field is "n&value" (n: the order of the differences) at the initialization of the arc, or the
+*            difference of the current order
+**/
+static int Differ(const char *p, const char *e, long long *u, int &order, int &arcOrder)
+{
+    const char *amp = (const char *)memchr(p, '&', e - p);
+    long long val = 0;
+    if (amp)
+    {
+        long long n = 0;
+        if (!ParseInt(p, amp, n) || n < 0 || n > MAXDIFFORDER || !ParseInt(amp + 1, e, val)) return -1;
+        arcOrder = (int)n;
+        order = 0;
+        u[0] = val;
+
+        return 1;
+    }
+    if (!ParseInt(p, e, val)) return -1;
+    if (order < 0) return 0;
+
+    if (order < arcOrder) order++;
+    u[order] = val;
+    for (int k = order; k > 0; k--) u[k - 1] += u[k];
+
+    return 1;
+} /* end of Differ */
+
+CrxUtil::CrxUtil()
+{
+    _nline = 0;
+    _next = LINE_CRXVERS;
+    _crxVer = 0;
+    _ntype = 0;
+    memset(_ntypes, 0, sizeof(_ntypes));
+    _clock.order = -1;
+    _clock.arcOrder = 0;
+    _isat = 0;
+    _nrec = 0;
+    _ok = false;
+}
+
+CrxUtil::~CrxUtil()
+{
+}
+
+/**
+* @brief   : DecodeLine - decode one line of Compact RINEX
+* @param[I]: line (the line without the end of line)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool CrxUtil::DecodeLine(string &line)
+{
+    _nline++;
+    switch (_next)
+    {
+    case LINE_CRXVERS:
+        if (line.size() < 80 || line.compare(60, 20, "CRINEX VERS   / TYPE") != 0)
+        {
+            cerr << "*** WARNING(CrxUtil::DecodeLine): the file is NOT in Compact RINEX format" << endl;
+
+            return false;
+        }
+        _crxVer = (int)atof(line.substr(0, 20).c_str());
+        if (_crxVer != 1 && _crxVer != 3)
+        {
+            cerr << "*** WARNING(CrxUtil::DecodeLine): the version of Compact RINEX is NOT supported" << endl;
+
+            return false;
+        }
+        _next = LINE_CRXPROG;
+
+        return true;
+    case LINE_CRXPROG:
+        _next = LINE_HEADER;
+
+        return true;
+    case LINE_HEADER:
+        _out += line;
+        _out += '\n';
+        if (line.size() > 60)
+        {
+            string label = line.substr(60);
+            if (label.compare(0, 20, "RINEX VERSION / TYPE") == 0)
+            {
+                int rnxVer = (int)atof(line.substr(0, 9).c_str());
+                if ((_crxVer == 1) != (rnxVer == 2) || rnxVer < 2)
+                {
+                    cerr << "*** WARNING(CrxUtil::DecodeLine): the version of RINEX is NOT supported" << endl;
+
+                    return false;
+                }
+            }
+            else if (label.compare(0, 19, "# / TYPES OF OBSERV") == 0)
+            {
+                if (line.compare(0, 6, "      ") != 0) _ntype = atoi(line.substr(0, 6).c_str());
+            }
+            else if (label.compare(0, 19, "SYS / # / OBS TYPES") == 0)
+            {
+                unsigned char sys = (unsigned char)line[0];
+                if (sys != ' ' && sys < 128) _ntypes[sys] = atoi(line.substr(3, 3).c_str());
+            }
+            else if (label.compare(0, 13, "END OF HEADER") == 0) _next = LINE_EPOCH;
+        }
+
+        return true;
+    case LINE_EPOCH:
+        return DecodeEpoch(line);
+    case LINE_CLOCK:
+    {
+        int ret = 1;
+        if (line.empty()) _clock.order = -1;
+        else ret = Differ(line.c_str(), line.c_str() + line.size(), _clock.u, _clock.order, _clock.arcOrder);
+        if (ret <= 0)
+        {
+            cerr << "*** WARNING(CrxUtil::DecodeLine): line " << _nline << ": invalid receiver clock offset" << endl;
+
+            return false;
+        }
+
+        /* the epoch record */
+        size_t start = _out.size();
+        if (_crxVer == 1)
+        {
+            _out.append(_epoch, 0, 68);
+            if (_clock.order >= 0)
+            {
+                if (_out.size() - start < 68) _out.append(68 - (_out.size() - start), ' ');
+                PutFixed(_clock.u[0], 9, 12, _out);
+            }
+            else TrimEnd(start, _out);
+            _out += '\n';
+            for (size_t i = 68; i < _epoch.size(); i += 36)
+            {
+                _out.append(32, ' ');
+                _out.append(_epoch, i, 36);
+                _out += '\n';
+            }
+        }
+        else
+        {
+            _out.append(_epoch, 0, 41);
+            if (_clock.order >= 0)
+            {
+                if (_out.size() - start < 41) _out.append(41 - (_out.size() - start), ' ');
+                PutFixed(_clock.u[0], 12, 15, _out);
+            }
+            else TrimEnd(start, _out);
+            _out += '\n';
+        }
+        _isat = 0;
+        _next = _cur.empty() ? LINE_EPOCH : LINE_DATA;
+        if (_cur.empty()) _sats.swap(_cur);
+
+        return true;
+    }
+    case LINE_DATA:
+        if (!DecodeData(line)) return false;
+        if (++_isat >= _cur.size())
+        {
+            _sats.swap(_cur);
+            _next = LINE_EPOCH;
+        }
+
+        return true;
+    case LINE_EVENT:
+        _out += line;
+        _out += '\n';
+        if (--_nrec <= 0) _next = LINE_EPOCH;
+
+        return true;
+    }
+
+    return false;
+} /* end of DecodeLine */
+
+/**
+* @brief   : DecodeEpoch - decode the epoch record
+* @param[I]: line (the line of the epoch record)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the epoch record of Compact RINEX 1.0 is initialized by '&' at the top, and that of 3.0 by '>'
+**/
+bool CrxUtil::DecodeEpoch(string &line)
+{
+    bool init = !line.empty() && line[0] == (_crxVer == 1 ? '&' : '>');
+    if (init)
+    {
+        if (_crxVer == 1) line[0] = ' ';
+        _epoch = line;
+        _sats.clear();
+        _clock.order = -1;
+    }
+    else if (_epoch.empty())
+    {
+        cerr << "*** WARNING(CrxUtil::DecodeEpoch): line " << _nline << ": the epoch is NOT initialized" << endl;
+
+        return false;
+    }
+    else Repair(line.c_str(), line.size(), _epoch);
+
+    /* the special event, the records following it are copied */
+    size_t iflag = _crxVer == 1 ? 28 : 31, insat = iflag + 1, isat = _crxVer == 1 ? 32 : 41;
+    char flag = _epoch.size() > iflag ? _epoch[iflag] : ' ';
+    int nsat = _epoch.size() > insat ? atoi(_epoch.substr(insat, 3).c_str()) : 0;
+    if (flag >= '2' && flag <= '5')
+    {
+        size_t start = _out.size();
+        _out += _epoch;
+        TrimEnd(start, _out);
+        _out += '\n';
+        _epoch.clear();  /* the next epoch is initialized */
+        _nrec = nsat;
+        _next = _nrec > 0 ? LINE_EVENT : LINE_EPOCH;
+
+        return true;
+    }
+
+    /* the satellites of the current epoch, whose state is taken from the previous epoch */
+    _epoch.resize(isat + 3 * nsat, ' ');
+    _cur.resize(nsat);
+    for (int i = 0; i < nsat; i++)
+    {
+        sat_t &sat = _cur[i];
+        memcpy(sat.id, _epoch.c_str() + isat + 3 * i, 3);
+        sat.id[3] = '\0';
+
+        /* the satellites are mostly in the same order as the previous epoch */
+        size_t j = 0, n = _sats.size();
+        for (; j < n; j++)
+        {
+            sat_t &old = _sats[(i + j) % n];
+            if (old.id[0] == '\0' || memcmp(old.id, sat.id, 3) != 0) continue;
+            sat.arcs.swap(old.arcs);
+            sat.flag.swap(old.flag);
+            old.id[0] = '\0';
+            break;
+        }
+
+        int ntype = _crxVer == 1 ? _ntype : ((unsigned char)sat.id[0] < 128 ? _ntypes[(unsigned char)sat.id[0]] : 0);
+        if (j >= n)
+        {
+            sat.flag.clear();
+            sat.arcs.clear();
+        }
+        arc_t blank;
+        blank.order = -1;
+        blank.arcOrder = 0;
+        sat.arcs.resize(ntype, blank);
+    }
+    _next = LINE_CLOCK;
+
+    return true;
+} /* end of DecodeEpoch */
+
+/**
+* @brief   : DecodeData - decode the observation data of one satellite
+* @param[I]: line (the line of the data)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the fields are separated by a space and followed by the differences of the flags, and a blank field
+*            means that the data is missing
+**/
+bool CrxUtil::DecodeData(const string &line)
+{
+    sat_t &sat = _cur[_isat];
+    const char *p = line.c_str(), *e = p + line.size();
+    size_t ntype = sat.arcs.size();
+    for (size_t j = 0; j < ntype; j++)
+    {
+        arc_t &arc = sat.arcs[j];
+        if (p >= e)
+        {
+            arc.order = -1;
+            continue;
+        }
+        const char *q = (const char *)memchr(p, ' ', e - p);
+        if (!q) q = e;
+        if (q == p) arc.order = -1;
+        else
+        {
+            int ret = Differ(p, q, arc.u, arc.order, arc.arcOrder);
+            if (ret <= 0)
+            {
+                if (ret == 0) cerr << "*** WARNING(CrxUtil::DecodeData): line " << _nline << ": the arc of " << sat.id <<
+                    " is NOT initialized" << endl;
+                else cerr << "*** WARNING(CrxUtil::DecodeData): line " << _nline << ": invalid data field" << endl;
+
+                return false;
+            }
+        }
+        p = q + 1;
+    }
+    if (p < e) Repair(p, e - p, sat.flag);
+    if (sat.flag.size() < 2 * ntype) sat.flag.resize(2 * ntype, ' ');
+
+    /* RINEX 2: five observations per line, RINEX 3: all observations in one line after the satellite ID */
+    size_t start = _out.size();
+    if (_crxVer != 1) _out.append(sat.id, 3);
+    for (size_t j = 0; j < ntype; j++)
+    {
+        if (_crxVer == 1 && j > 0 && j % 5 == 0)
+        {
+            TrimEnd(start, _out);
+            _out += '\n';
+            start = _out.size();
+        }
+        if (sat.arcs[j].order >= 0) PutFixed(sat.arcs[j].u[0], 3, 14, _out);
+        else if (_crxVer == 1)
+        {
+            /* the flags of the missing data are cleared in RINEX 2, but kept in RINEX 3 as 'crx2rnx' does */
+            sat.flag[2 * j] = sat.flag[2 * j + 1] = ' ';
+            _out.append(16, ' ');
+            continue;
+        }
+        else _out.append(14, ' ');
+        _out += sat.flag[2 * j];
+        _out += sat.flag[2 * j + 1];
+    }
+    TrimEnd(start, _out);
+    _out += '\n';
+
+    return true;
+} /* end of DecodeData */
+
+/**
+* @brief   : Flush - give the decoded bytes to the receiver
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool CrxUtil::Flush()
+{
+    if (_out.empty()) return true;
+    bool ok = _sink ? _sink(_out.c_str(), _out.size()) : false;
+    _out.clear();
+
+    return ok;
+} /* end of Flush */
+
+/**
+* @brief   : Open - start decoding a Compact RINEX stream
+* @param[I]: sink (the receiver of the decoded RINEX bytes)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CrxUtil::Open(const sink_t &sink)
+{
+    _sink = sink;
+    _line.clear();
+    _out.clear();
+    _out.reserve(MAXOUTBUFF + MAXCHARS);
+    _nline = 0;
+    _next = LINE_CRXVERS;
+    _crxVer = 0;
+    _ntype = 0;
+    memset(_ntypes, 0, sizeof(_ntypes));
+    _epoch.clear();
+    _clock.order = -1;
+    _sats.clear();
+    _cur.clear();
+    _isat = 0;
+    _nrec = 0;
+    _ok = true;
+} /* end of Open */
+
+/**
+* @brief   : Write - feed the bytes of Compact RINEX
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the bytes may be split anywhere, i.e., in the middle of a line
+**/
+bool CrxUtil::Write(const char *buff, size_t n)
+{
+    const char *p = buff, *e = buff + n;
+    while (_ok && p < e)
+    {
+        const char *q = (const char *)memchr(p, '\n', e - p);
+        if (!q)
+        {
+            _line.append(p, e - p);
+            break;
+        }
+        _line.append(p, q - p);
+        p = q + 1;
+        if (!_line.empty() && _line[_line.size() - 1] == '\r') _line.resize(_line.size() - 1);
+        if (!DecodeLine(_line)) _ok = false;
+        _line.clear();
+        if (_ok && _out.size() >= MAXOUTBUFF && !Flush()) _ok = false;
+    }
+
+    return _ok;
+} /* end of Write */
+
+/**
+* @brief   : Close - finish decoding the Compact RINEX stream
+* @param[I]: none
+* @param[O]: none
+* @return  : true: the stream is decoded completely, false: error or truncated stream
+* @note    :
+**/
+bool CrxUtil::Close()
+{
+    if (_ok && !_line.empty())
+    {
+        if (_line[_line.size() - 1] == '\r') _line.resize(_line.size() - 1);
+        if (!DecodeLine(_line)) _ok = false;
+        _line.clear();
+    }
+    if (_ok && _next != LINE_EPOCH)
+    {
+        cerr << "*** WARNING(CrxUtil::Close): the file seems to be truncated" << endl;
+        _ok = false;
+    }
+    if (_ok && !Flush()) _ok = false;
+
+    bool ok = _ok;
+    _ok = false;
+    _sink = nullptr;
+    _sats.clear();
+    _cur.clear();
+
+    return ok;
+} /* end of Close */
+
+/**
+* @brief   : Crx2Rnx - convert Compact RINEX file to RINEX file
+* @param[I]: crxFile (Compact RINEX file with full path, i.e., "algo0320.22d" or "*.crx")
+* @param[I]: rnxFile (RINEX file with full path, i.e., "algo0320.22o" or "*.rnx")
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the same output as 'crx2rnx' (ver.4.0.7)
+**/
+bool CrxUtil::Crx2Rnx(const string &crxFile, const string &rnxFile)
+{
+    FILE *fpIn = fopen(crxFile.c_str(), "rb");
+    if (!fpIn)
+    {
+        cerr << "*** WARNING(CrxUtil::Crx2Rnx): open " << crxFile << " failed" << endl;
+
+        return false;
+    }
+    FILE *fpOut = fopen(rnxFile.c_str(), "wb");
+    if (!fpOut)
+    {
+        cerr << "*** WARNING(CrxUtil::Crx2Rnx): open " << rnxFile << " failed" << endl;
+        fclose(fpIn);
+
+        return false;
+    }
+
+    Open([fpOut](const char *buff, size_t n) { return fwrite(buff, 1, n, fpOut) == n; });
+    std::vector<char> buff(MAXOUTBUFF);
+    size_t n;
+    bool ok = true;
+    while (ok && (n = fread(&buff[0], 1, buff.size(), fpIn)) > 0) ok = Write(&buff[0], n);
+    ok = Close() && ok;
+    fclose(fpIn);
+    if (fclose(fpOut) != 0) ok = false;
+    if (!ok) remove(rnxFile.c_str());
+
+    return ok;
+} /* end of Crx2Rnx */
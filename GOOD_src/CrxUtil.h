@@ -0,0 +1,138 @@
+/*------------------------------------------------------------------------------
+* CrxUtil.h : header file of CrxUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXDIFFORDER    5         /* maximum order of the differences in Compact RINEX */
+
+class CrxUtil
+{
+public:
+
+    /* the receiver of the decoded RINEX bytes, return false to abort the decoding */
+    typedef std::function<bool(const char *buff, size_t n)> sink_t;
+
+private:
+
+    struct arc_t
+    {                             /* the differential sequence of one data field */
+        long long u[MAXDIFFORDER + 1];  /* the value (u[0]) and its differences up to the current order */
+        int order;                /* the current order of the differences, -1: the field is blank */
+        int arcOrder;             /* the order of the differences given at the initialization of the arc */
+    };
+
+    struct sat_t
+    {                             /* the state of one satellite in the previous epoch */
+        char id[4];               /* satellite ID, i.e., "G01" */
+        std::vector<arc_t> arcs;  /* the sequences of the observation types */
+        string flag;              /* LLI and signal strength flags, two characters per observation type */
+    };
+
+    enum
+    {                             /* the kind of the next line */
+        LINE_CRXVERS,             /* "CRINEX VERS   / TYPE" */
+        LINE_CRXPROG,             /* "CRINEX PROG / DATE" */
+        LINE_HEADER,              /* RINEX header */
+        LINE_EPOCH,               /* epoch record */
+        LINE_CLOCK,               /* receiver clock offset */
+        LINE_DATA,                /* observation data of one satellite */
+        LINE_EVENT                /* the records following a special event */
+    };
+
+    sink_t _sink;                 /* the receiver of the decoded RINEX bytes */
+    string _line;                 /* the line being received */
+    string _out;                  /* the decoded bytes NOT yet given to the receiver */
+    long _nline;                  /* number of the lines received */
+    int _next;                    /* the kind of the next line */
+    int _crxVer;                  /* 1: Compact RINEX 1.0 (RINEX 2), 3: Compact RINEX 3.0 (RINEX 3 or later) */
+    int _ntype;                   /* number of the observation types (RINEX 2) */
+    int _ntypes[128];             /* number of the observation types per satellite system (RINEX 3 or later) */
+    string _epoch;                /* the epoch record of the previous epoch, empty: the next epoch is initialized */
+    arc_t _clock;                 /* the sequence of the receiver clock offset */
+    std::vector<sat_t> _sats;     /* the satellites of the previous epoch */
+    std::vector<sat_t> _cur;      /* the satellites of the current epoch */
+    size_t _isat;                 /* index of the satellite whose data line is the next one */
+    int _nrec;                    /* number of the records following a special event not yet copied */
+    bool _ok;                     /* false: the decoding failed */
+
+private:
+
+    /**
+    * @brief   : DecodeLine - decode one line of Compact RINEX
+    * @param[I]: line (the line without the end of line)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool DecodeLine(string &line);
+
+    /**
+    * @brief   : DecodeEpoch - decode the epoch record
+    * @param[I]: line (the line of the epoch record)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool DecodeEpoch(string &line);
+
+    /**
+    * @brief   : DecodeData - decode the observation data of one satellite
+    * @param[I]: line (the line of the data)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool DecodeData(const string &line);
+
+    /**
+    * @brief   : Flush - give the decoded bytes to the receiver
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Flush();
+
+public:
+    CrxUtil();
+    ~CrxUtil();
+
+    /**
+    * @brief   : Open - start decoding a Compact RINEX stream
+    * @param[I]: sink (the receiver of the decoded RINEX bytes)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Open(const sink_t &sink);
+
+    /**
+    * @brief   : Write - feed the bytes of Compact RINEX
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the bytes may be split anywhere, i.e., in the middle of a line
+    **/
+    bool Write(const char *buff, size_t n);
+
+    /**
+    * @brief   : Close - finish decoding the Compact RINEX stream
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: the stream is decoded completely, false: error or truncated stream
+    * @note    :
+    **/
+    bool Close();
+
+    /**
+    * @brief   : Crx2Rnx - convert Compact RINEX file to RINEX file
+    * @param[I]: crxFile (Compact RINEX file with full path, i.e., "algo0320.22d" or "*.crx")
+    * @param[I]: rnxFile (RINEX file with full path, i.e., "algo0320.22o" or "*.rnx")
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the same output as 'crx2rnx' (ver.4.0.7)
+    **/
+    bool Crx2Rnx(const string &crxFile, const string &rnxFile);
+};
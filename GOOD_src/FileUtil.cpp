@@ -0,0 +1,267 @@
+/*------------------------------------------------------------------------------
+* FileUtil.cpp : the operations on the local files and directories without any shell command
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, 'mkdir -p', 'mv', and 'rm -rf' (or 'mkdir', 'move /y', 'del', and 'rd /s /q') are
+*                           done by the system calls instead of the shell commands, and the directories created are
+*                           remembered during the run
+*           2026/10/18      the renaming is recorded as a span of the trace (see TraceUtil)
+*           2026/10/18      the file is cloned by reflink or hard link for the shared cache (see CacheUtil)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "TraceUtil.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifndef _WIN32 /* for Linux or Mac */
+#include <dirent.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+#ifdef __APPLE__
+#include <sys/clonefile.h>
+#endif
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXCOPYBUFF     65536     /* the bytes copied at a time if the file can NOT be linked */
+
+
+/* function definition -------------------------------------------------------*/
+
+std::set<string> FileUtil::_dirs;
+std::mutex FileUtil::_lock;
+
+/**
+* @brief   : IsSep - check if the character is a path separator
+* @param[I]: c (character)
+* @param[O]: none
+* @return  : true: '/' (or '\' on Windows), false: otherwise
+* @note    :
+**/
+bool FileUtil::IsSep(char c)
+{
+#ifdef _WIN32   /* for Windows */
+    return c == '\\' || c == '/';
+#else           /* for Linux or Mac */
+    return c == '/';
+#endif
+} /* end of IsSep */
+
+/**
+* @brief   : MakeOneDir - create a directory whose parent exists
+* @param[I]: dir (the directory)
+* @param[O]: none
+* @return  : 0: created or it exists, otherwise: the error number (i.e., ENOENT if the parent does NOT exist)
+* @note    :
+**/
+int FileUtil::MakeOneDir(const string &dir)
+{
+#ifdef _WIN32   /* for Windows */
+    if (_mkdir(dir.c_str()) == 0) return 0;
+#else           /* for Linux or Mac */
+    if (mkdir(dir.c_str(), 0755) == 0) return 0;
+#endif
+    int err = errno;
+
+    /* it exists (i.e., created by another thread or run at the same time), or it is the root of a drive */
+    struct stat st;
+    if (stat(dir.c_str(), &st) == 0) return (st.st_mode & S_IFMT) == S_IFDIR ? 0 : ENOTDIR;
+
+    return err;
+} /* end of MakeOneDir */
+
+/**
+* @brief   : MakeDir - create a directory and its parents if they do NOT exist (as 'mkdir -p')
+* @param[I]: dir (the directory)
+* @param[O]: none
+* @return  : true: created or it exists, false: error
+* @note    : the directories created or found are remembered during the run, so the same directory asked by every
+*            getter and every day costs NO system call after the first time
+**/
+bool FileUtil::MakeDir(const string &dir)
+{
+    string path = dir;
+    while (path.size() > 1 && IsSep(path[path.size() - 1])) path.erase(path.size() - 1);
+    if (path.empty()) return false;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_dirs.find(path) != _dirs.end()) return true;
+    }
+
+    /* the parents are created ONLY if the directory can NOT be created, so the usual case costs one system call */
+    int err = MakeOneDir(path);
+    if (err == ENOENT)
+    {
+        size_t pos = path.size() - 1;
+        while (pos > 0 && !IsSep(path[pos])) pos--;
+        if (pos > 0 && MakeDir(path.substr(0, pos))) err = MakeOneDir(path);
+    }
+    if (err != 0)
+    {
+        cerr << "*** WARNING(FileUtil::MakeDir): create " << path << " failed, " << strerror(err) << endl;
+
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _dirs.insert(path);
+
+    return true;
+} /* end of MakeDir */
+
+/**
+* @brief   : Rename - rename a file, and replace the target if it exists (as 'mv')
+* @param[I]: from (the file with full path)
+* @param[I]: to (the new file with full path)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the target is replaced atomically, so it is either the old file or the new one when it is seen by
+*            others (including on Windows, where 'rename' does NOT replace the existing file)
+**/
+bool FileUtil::Rename(const string &from, const string &to)
+{
+    TraceUtil::Span span("rename", "rename", to);
+#ifdef _WIN32   /* for Windows */
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else           /* for Linux or Mac */
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+} /* end of Rename */
+
+/**
+* @brief   : Clone - make a file with the same content as another one, without copying it if possible
+* @param[I]: from (the file with full path)
+* @param[I]: to (the new file with full path, which should NOT exist)
+* @param[O]: none
+* @return  : 1: reflink (copy-on-write), 2: hard link, 3: copied, 0: error
+* @note    : the reflink ("FICLONE" on Linux, i.e., Btrfs and XFS, or 'clonefile' on Mac) is tried at first, then
+*            the hard link, and the file is copied ONLY if both fail (i.e., on different file systems). The hard
+*            link shares the content with the original file, which should NOT be changed in place
+**/
+int FileUtil::Clone(const string &from, const string &to)
+{
+#ifdef _WIN32   /* for Windows */
+    if (CreateHardLinkA(to.c_str(), from.c_str(), NULL)) return 2;
+    if (CopyFileA(from.c_str(), to.c_str(), TRUE)) return 3;
+
+    return 0;
+#else           /* for Linux or Mac */
+#ifdef __APPLE__
+    if (clonefile(from.c_str(), to.c_str(), 0) == 0) return 1;
+#endif
+#ifdef FICLONE
+    int fdIn = open(from.c_str(), O_RDONLY);
+    if (fdIn < 0) return 0;
+    int fdOut = open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fdOut >= 0)
+    {
+        bool ok = ioctl(fdOut, FICLONE, fdIn) == 0;
+        close(fdOut);
+        close(fdIn);
+        if (ok) return 1;
+        unlink(to.c_str());
+    }
+    else close(fdIn);
+#endif
+    if (link(from.c_str(), to.c_str()) == 0) return 2;
+
+    /* different file systems */
+    FILE *fpIn = fopen(from.c_str(), "rb");
+    if (!fpIn) return 0;
+    FILE *fpOut = fopen(to.c_str(), "wb");
+    if (!fpOut)
+    {
+        fclose(fpIn);
+
+        return 0;
+    }
+    std::vector<char> buff(MAXCOPYBUFF);
+    size_t n;
+    bool ok = true;
+    while (ok && (n = fread(&buff[0], 1, buff.size(), fpIn)) > 0) ok = fwrite(&buff[0], 1, n, fpOut) == n;
+    if (ferror(fpIn)) ok = false;
+    fclose(fpIn);
+    if (fclose(fpOut) != 0) ok = false;
+    if (!ok) unlink(to.c_str());
+
+    return ok ? 3 : 0;
+#endif
+} /* end of Clone */
+
+/**
+* @brief   : Remove - remove a file, or a directory with everything in it (as 'rm -rf')
+* @param[I]: path (the file or the directory)
+* @param[O]: none
+* @return  : true: removed or it does NOT exist, false: error
+* @note    : the symbolic link is removed without following it
+**/
+bool FileUtil::Remove(const string &path)
+{
+    bool ok = true;
+#ifdef _WIN32   /* for Windows */
+    DWORD attr = GetFileAttributesA(path.c_str());
+    if (attr == INVALID_FILE_ATTRIBUTES)
+    {
+        DWORD err = GetLastError();
+
+        return err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND;
+    }
+    if (attr & FILE_ATTRIBUTE_READONLY) SetFileAttributesA(path.c_str(), attr & ~FILE_ATTRIBUTE_READONLY);
+    if ((attr & FILE_ATTRIBUTE_DIRECTORY) && !(attr & FILE_ATTRIBUTE_REPARSE_POINT))
+    {
+        WIN32_FIND_DATAA data;
+        HANDLE h = FindFirstFileA((path + "\\*").c_str(), &data);
+        if (h != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                string name = data.cFileName;
+                if (name == "." || name == "..") continue;
+                if (!Remove(path + "\\" + name)) ok = false;
+            } while (FindNextFileA(h, &data));
+            FindClose(h);
+        }
+        if (!RemoveDirectoryA(path.c_str())) ok = false;
+    }
+    else if (attr & FILE_ATTRIBUTE_DIRECTORY) ok = RemoveDirectoryA(path.c_str()) != 0;
+    else ok = DeleteFileA(path.c_str()) != 0;
+#else           /* for Linux or Mac */
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) return errno == ENOENT;
+    if (S_ISDIR(st.st_mode))
+    {
+        DIR *dp = opendir(path.c_str());
+        if (dp)
+        {
+            struct dirent *ent;
+            while ((ent = readdir(dp)) != NULL)
+            {
+                string name = ent->d_name;
+                if (name == "." || name == "..") continue;
+                if (!Remove(path + "/" + name)) ok = false;
+            }
+            closedir(dp);
+        }
+        if (rmdir(path.c_str()) != 0) ok = false;
+    }
+    else ok = unlink(path.c_str()) == 0;
+#endif
+
+    /* the directories removed are forgotten */
+    std::lock_guard<std::mutex> lock(_lock);
+    std::set<string>::iterator it = _dirs.lower_bound(path);
+    while (it != _dirs.end() && it->compare(0, path.size(), path) == 0)
+    {
+        if (it->size() == path.size() || IsSep((*it)[path.size()])) it = _dirs.erase(it);
+        else ++it;
+    }
+
+    return ok;
+} /* end of Remove */
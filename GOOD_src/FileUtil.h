@@ -0,0 +1,76 @@
+/*------------------------------------------------------------------------------
+* FileUtil.h : header file of FileUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class FileUtil
+{
+private:
+
+    static std::set<string> _dirs;  /* the directories created or found during the run */
+    static std::mutex _lock;        /* the lock of the directories */
+
+private:
+
+    /**
+    * @brief   : IsSep - check if the character is a path separator
+    * @param[I]: c (character)
+    * @param[O]: none
+    * @return  : true: '/' (or '\' on Windows), false: otherwise
+    * @note    :
+    **/
+    static bool IsSep(char c);
+
+    /**
+    * @brief   : MakeOneDir - create a directory whose parent exists
+    * @param[I]: dir (the directory)
+    * @param[O]: none
+    * @return  : 0: created or it exists, otherwise: the error number (i.e., ENOENT if the parent does NOT exist)
+    * @note    :
+    **/
+    static int MakeOneDir(const string &dir);
+
+public:
+
+    /**
+    * @brief   : MakeDir - create a directory and its parents if they do NOT exist (as 'mkdir -p')
+    * @param[I]: dir (the directory)
+    * @param[O]: none
+    * @return  : true: created or it exists, false: error
+    * @note    : the directories created or found are remembered during the run, so the same directory asked by every
+    *            getter and every day costs NO system call after the first time
+    **/
+    static bool MakeDir(const string &dir);
+
+    /**
+    * @brief   : Rename - rename a file, and replace the target if it exists (as 'mv')
+    * @param[I]: from (the file with full path)
+    * @param[I]: to (the new file with full path)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the target is replaced atomically, so it is either the old file or the new one when it is seen by
+    *            others (including on Windows, where 'rename' does NOT replace the existing file)
+    **/
+    static bool Rename(const string &from, const string &to);
+
+    /**
+    * @brief   : Clone - make a file with the same content as another one, without copying it if possible
+    * @param[I]: from (the file with full path)
+    * @param[I]: to (the new file with full path, which should NOT exist)
+    * @param[O]: none
+    * @return  : 1: reflink (copy-on-write), 2: hard link, 3: copied, 0: error
+    * @note    : the reflink ("FICLONE" on Linux, i.e., Btrfs and XFS, or 'clonefile' on Mac) is tried at first, then
+    *            the hard link, and the file is copied ONLY if both fail (i.e., on different file systems). The hard
+    *            link shares the content with the original file, which should NOT be changed in place
+    **/
+    static int Clone(const string &from, const string &to);
+
+    /**
+    * @brief   : Remove - remove a file, or a directory with everything in it (as 'rm -rf')
+    * @param[I]: path (the file or the directory)
+    * @param[O]: none
+    * @return  : true: removed or it does NOT exist, false: error
+    * @note    : the symbolic link is removed without following it
+    **/
+    static bool Remove(const string &path);
+};
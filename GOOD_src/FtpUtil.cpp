@@ -76,10 +76,85 @@
 *           2022/01/17      perfect the output information of the log file to more intuitively understand the name of the downloading files (by Feng Zhou @ SDUST)
 *           2022/02/19      change "BRDX*" to "BRD4" for "mixed4" (RINEX 4.xx) broadcast ephemeris file downloading (by Feng Zhou @ SDUST and Zan Liu @ CUMT)
 *           2022/03/19      move the codes for log file writing from "FtpUtil.cpp" to "PreProcess.cpp" (by Feng Zhou @ SDUST)
+*           2026/10/18 2.1  replace the per-file 'wget' process with the built-in FTP/FTPS/HTTP/HTTPS transfer engine (NetUtil) that keeps
+*                             the connections open per host; 'wget' is ONLY the fallback for the URL NetUtil can NOT handle
+*           2026/10/18      add the option "maxParallel" for downloading the observations of the sites in 'site.list' by a pool of worker
+*                             threads, with the limit of connections per archive host
+*           2026/10/18      remove all the 'chdir' calls (the files are handled with full path) and run the getters of observations
+*                             and products at the same time
+*           2026/10/18      list every remote directory only once for all the sites (see NetUtil::ListCached), and add the option
+*                             "listCache" for persisting the listings
+*           2026/10/18      the observation files are decompressed and converted to 'o' files while they are being downloaded (see
+*                             FetchObs and PipeUtil) without any intermediate file, and add the option "keepRawObs"
+*           2026/10/18      the Compact RINEX (Hatanaka) files are decoded by the built-in decoder (see CrxUtil) instead of the
+*                             third-party software 'crx2rnx'
+*           2026/10/18      '*.gz' and '*.Z' files are decompressed by the built-in decompressor (see ZipUtil) instead of the
+*                             third-party software 'gzip'
+*           2026/10/18      the remote files are downloaded to '*.part' files which are resumed by REST/Range after a failed
+*                             transfer and renamed when complete (see NetUtil::GetPart)
+*           2026/10/18      add the option "hedgeMirror" for racing the remote files among CDDIS, IGN, and WHU from the historically
+*                             fastest archive, with a hedged request to the next one if the first byte is late (see MirrorUtil)
+*           2026/10/18      add the option "manifest" for recording the files downloaded with their remote URL, size, modification
+*                             time, and CRC32, and the getters finished, so that the days finished are skipped without walking
+*                             the directories and the truncated 'o' files are downloaded again (see ManifestUtil)
+*           2026/10/18      add the option "dayParallel" for downloading several days at the same time, which share the
+*                             connections per host (see FtpDownload for the days)
+*           2026/10/18      the getters plan the remote files instead of downloading them if "planOnly" is on, and the job graph
+*                             is printed before any transfer (see PlanUtil)
+*           2026/10/18      the directories are created, and the files are renamed or removed by the system calls (see FileUtil)
+*                             instead of 'mkdir', 'mv', and 'rm' in the shell
+*           2026/10/18      the sites are taken from the tables read once from 'site.list' files (see PreProcess::ReadSiteList)
+*                             instead of reading the files in every getter of every day, and the nine-character long names are
+*                             used in the patterns of long file names (see LongPrefix)
+*           2026/10/18      the directories of the archives and the names of the observation files are expanded from the
+*                             templates compiled once (see TemplateUtil, ArchiveUrl, and FileName) instead of the chains of
+*                             CDDIS, IGN, and WHU and the strings concatenated in every getter
+*           2026/10/18      add the option "metrics" for measuring every transfer (resolving, connecting, TLS handshake, first
+*                             byte, transfer, decompressing, and decoding) and writing the report of the run in JSON and in
+*                             the text format of Prometheus (see MetricsUtil)
+*           2026/10/18      add the option "trace" for writing the timeline of the run with the spans of the days, the getters,
+*                             the jobs, and the stages of the transfers on a lane per worker thread (see TraceUtil)
+*           2026/10/18      add the option "urlRedirect" for downloading from the local stand-ins of the archives (see
+*                             NetUtil::SetRedirect and Benchmark/bench_GOOD.py)
+*           2026/10/18      add the option "adaptParallel" for adjusting the requests in flight per host by AIMD, with the
+*                             windows learned persisted for the next runs (see AimdUtil)
+*           2026/10/18      add the option "watch" for polling the ultra-rapid products and the hourly observations at their
+*                             cadences, and downloading every issue as soon as it is published (see FtpWatch)
+*           2026/10/18      add the option "refresh" for downloading again the ultra-rapid orbit and EOP files, the CNES
+*                             real-time files, and the rapid GIMs republished under the same name (see Refresh)
+*           2026/10/18      add the option "cache" for sharing the remote files downloaded among the runs on the same host
+*                             (see CacheUtil)
+*           2026/10/18      add the options "proxy" and "viaProxy" for serving the remote files to the other GOOD on the LAN
+*                             as an HTTP caching proxy, and downloading through it (see FtpProxy and ProxyUtil)
+*           2026/10/18      add the option "shard" for sharing the getters of the days and the sites of the observations
+*                             among the nodes through the lease files on a shared file system (see OpenShard and ShardUtil)
+*           2026/10/18      the directories on the other archives are found by the templates of the directories instead of
+*                             the layouts of the sub-directories in 'MirrorUrls'
+*           2026/10/18      the jobs of the days, the getters, and the sites are queued to the worker threads started once
+*                             by Setup instead of a new pool per RunJobs (see PoolUtil)
+*           2026/10/18      the getters finished are recorded in the manifest by their names instead of their positions
+*           2026/10/18      the files raced on the mirrors are recorded with the mirror they came from, and the racing
+*                             transfers are run by the worker threads of the run (see MirrorUtil::Race)
 *-----------------------------------------------------------------------------*/
 #include "Good.h"
 #include "TimeUtil.h"
 #include "StringUtil.h"
+#include "FileUtil.h"
+#include "NetUtil.h"
+#include "MetricsUtil.h"
+#include "TraceUtil.h"
+#include "MirrorUtil.h"
+#include "AimdUtil.h"
+#include "ManifestUtil.h"
+#include "CacheUtil.h"
+#include "ProxyUtil.h"
+#include "ShardUtil.h"
+#include "PoolUtil.h"
+#include "PlanUtil.h"
+#include "TemplateUtil.h"
+#include "CrxUtil.h"
+#include "ZipUtil.h"
+#include "PipeUtil.h"
 #include "FtpUtil.h"
 
 
@@ -104,6 +179,22 @@
 #define IDX_ROTI   17   /* index for Rate of TEC index (ROTI) downloaded */
 #define IDX_ZTD    18   /* index for IGS final tropospheric product downloaded */
 
+#define NAME_OBSD_D   0     /* IGS daily observation file, "{site}{DDD}0.{YY}d" */
+#define NAME_OBSD_O   1     /* IGS daily observation file after decoding, "{site}{DDD}0.{YY}o" */
+#define NAME_OBSH_D   2     /* IGS hourly observation file, "{site}{DDD}{H}.{YY}d" */
+#define NAME_OBSH_O   3     /* IGS hourly observation file after decoding, "{site}{DDD}{H}.{YY}o" */
+#define NAME_OBSHR_D  4     /* IGS high-rate observation file, "{site}{DDD}{H}{MM}.{YY}d" */
+#define NAME_OBSHR_O  5     /* IGS high-rate observation file after decoding, "{site}{DDD}{H}{MM}.{YY}o" */
+#define NAME_OBMD     6     /* MGEX daily observation (30s) file */
+#define NAME_OBMD15   7     /* MGEX daily observation (15s) file */
+#define NAME_OBMH     8     /* MGEX hourly observation file */
+#define NAME_OBMHR    9     /* MGEX high-rate observation file */
+#define NAME_CUT      10    /* CUT daily observation file */
+#define NAME_HK30S    11    /* Hong Kong CORS 30s observation file */
+#define NAME_HK5S     12    /* Hong Kong CORS 5s observation file */
+#define NAME_HK1S     13    /* Hong Kong CORS 1s observation file */
+#define NAME_ZPD      14    /* IGS final tropospheric product file */
+
 #define PROD_REALTIME    1   /* index for real-time orbit and clock products downloading */
 #define PROD_ULTRA_RAPID 2   /* index for ultra-rapid orbit and clock products downloading */
 #define PROD_RAPID       3   /* index for rapid orbit and clock products downloading */
@@ -111,6 +202,10 @@
 #define PROD_FINAL_MGEX  5   /* index for MGEX final orbit and clock products downloading */
 
 
+/* the failures of the getter running in the thread (see Fail) */
+thread_local std::atomic<int> *FtpUtil::_nfail = nullptr;
+
+
 /* function definition -------------------------------------------------------*/
 
 /**
@@ -122,6 +217,9 @@
 **/
 void FtpUtil::init()
 {
+    /* the archives are set ONLY once, since they are read by all the days downloaded at the same time */
+    if (!_ftpArchive.CDDIS.empty()) return;
+
     /* FTP archive for CDDIS */
     _ftpArchive.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily");                /* IGS daily observation (30s) files */
     _ftpArchive.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/hourly");               /* IGS hourly observation (30s) files */
@@ -184,8 +282,614 @@ void FtpUtil::init()
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* global ionosphere map (GIM) files */
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* Rate of TEC index (ROTI) files */
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/troposphere/new");                 /* IGS final tropospheric product files */
+
+    /* the templates of the directories under the archives, "{YYYY}": year, "{DDD}": day of year, "{YY}": two-digit
+       year, "{HH}": hour, "{WWWW}": GPS week (see TemplateUtil), so that an archive is added by a column here */
+    const char *names[3] = { "CDDIS", "IGN", "WHU" };
+    const std::vector<string> *bases[3] = { &_ftpArchive.CDDIS, &_ftpArchive.IGN, &_ftpArchive.WHU };
+    const struct
+    {
+        const char *dir[3];       /* the directories under CDDIS, IGN, and WHU */
+        bool mirrored;            /* false: the files differ among the archives, so that they are NOT hedged */
+    } dirs[] = {
+        /*  CDDIS                       IGN                 WHU                               mirrored */
+        { { "{YYYY}/{DDD}/{YY}d",       "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{YY}d"        }, true  },  /* IGS daily observation (30s) files */
+        { { "{YYYY}/{DDD}/{HH}",        "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{HH}"         }, true  },  /* IGS hourly observation (30s) files */
+        { { "{YYYY}/{DDD}/{YY}d/{HH}",  "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{YY}d/{HH}"   }, true  },  /* IGS high-rate observation (1s) files */
+        { { "{YYYY}/{DDD}/{YY}d",       "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{YY}d"        }, true  },  /* MGEX daily observation (30s) files */
+        { { "{YYYY}/{DDD}/{HH}",        "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{HH}"         }, true  },  /* MGEX hourly observation (30s) files */
+        { { "{YYYY}/{DDD}/{YY}d/{HH}",  "{YYYY}/{DDD}",     "{YYYY}/{DDD}/{YY}d/{HH}"   }, true  },  /* MGEX high-rate observation (1s) files */
+        { { "{YYYY}/brdc",              "{YYYY}/{DDD}",     "{YYYY}/brdc"               }, false },  /* broadcast ephemeris files (WHU before 2020 in GetNav) */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* IGS SP3 files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* IGS CLK files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* IGS EOP files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* IGS weekly SINEX files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* MGEX SP3 files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* MGEX CLK files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* MGEX ORBEX files */
+        { { "{YYYY}",                   "{YYYY}",           "{YYYY}"                    }, true  },  /* MGEX DSB files */
+        { { "{WWWW}",                   "{WWWW}",           "{WWWW}"                    }, true  },  /* MGEX OSB files */
+        { { "{YYYY}/{DDD}",             "{YYYY}/{DDD}",     "{YYYY}/{DDD}"              }, false },  /* global ionosphere map (GIM) files */
+        { { "{YYYY}/{DDD}",             "{YYYY}/{DDD}",     "{YYYY}/{DDD}"              }, false },  /* Rate of TEC index (ROTI) files */
+        { { "{YYYY}/{DDD}",             "{YYYY}/{DDD}",     "{YYYY}/{DDD}"              }, false }   /* IGS final tropospheric product files */
+    };
+    for (int i = 0; i < 3; i++)
+    {
+        std::vector<TemplateUtil> &tpls = _ftpArchive.dirs[names[i]];
+        tpls.resize(bases[i]->size());
+        for (size_t j = 0; j < bases[i]->size(); j++) tpls[j].Compile((*bases[i])[j] + "/" + dirs[j].dir[i]);
+    }
+    _ftpArchive.mirrored.resize(sizeof(dirs) / sizeof(dirs[0]));
+    for (size_t j = 0; j < _ftpArchive.mirrored.size(); j++) _ftpArchive.mirrored[j] = dirs[j].mirrored;
+
+    /* the templates of the names of observation files (see NAME_*), "{site}" and "{SITE}": four-character site name in
+       lower and upper case, "{LONG}": the beginning of the long file name, "{H}": hourly session, "{MM}": minute */
+    const char *files[] = {
+        "{site}{DDD}0.{YY}d",                                /* NAME_OBSD_D */
+        "{site}{DDD}0.{YY}o",                                /* NAME_OBSD_O */
+        "{site}{DDD}{H}.{YY}d",                              /* NAME_OBSH_D */
+        "{site}{DDD}{H}.{YY}o",                              /* NAME_OBSH_O */
+        "{site}{DDD}{H}{MM}.{YY}d",                          /* NAME_OBSHR_D */
+        "{site}{DDD}{H}{MM}.{YY}o",                          /* NAME_OBSHR_O */
+        "{LONG}{YYYY}{DDD}0000_01D_30S_MO.crx",              /* NAME_OBMD */
+        "{LONG}{YYYY}{DDD}0000_01D_15S_MO.crx",              /* NAME_OBMD15 */
+        "{LONG}{YYYY}{DDD}{HH}00_01H_30S_MO.crx",            /* NAME_OBMH */
+        "{LONG}{YYYY}{DDD}{HH}{MM}_15M_01S_MO.crx",          /* NAME_OBMHR */
+        "{SITE}00AUS_R_{YYYY}{DDD}0000_01D_30S_MO.crx",      /* NAME_CUT */
+        "{SITE}00HKG_R_{YYYY}{DDD}0000_01D_30S_MO.crx",      /* NAME_HK30S */
+        "{SITE}00HKG_R_{YYYY}{DDD}{HH}00_01H_05S_MO.crx",    /* NAME_HK5S */
+        "{SITE}00HKG_R_{YYYY}{DDD}{HH}00_01H_01S_MO.crx",    /* NAME_HK1S */
+        "{site}{DDD}0.{YY}zpd"                               /* NAME_ZPD */
+    };
+    _ftpArchive.names.resize(sizeof(files) / sizeof(files[0]));
+    for (size_t i = 0; i < _ftpArchive.names.size(); i++) _ftpArchive.names[i].Compile(files[i]);
 } /* end of init */
 
+/**
+* @brief   : MirrorUrls - find the remote directory on all the archives (CDDIS, IGN, and WHU)
+* @param[I]: url (URL of the directory on one of the archives)
+* @param[O]: cls (the class of products, i.e., IDX_OBSD)
+* @param[O]: mirrors (the names of archives, the one of the URL is the first)
+* @param[O]: urls (URL of the directory on each archive)
+* @return  : true: found on more than one archive, false: NOT mirrored
+* @note    : the sub-directories (i.e., year, day of year, hour, or GPS week) are translated by the templates of
+*            the directories on the archives, and the archives NOT supported by the built-in transfer engine are skipped
+**/
+bool FtpUtil::MirrorUrls(const string &url, int &cls, std::vector<string> &mirrors, std::vector<string> &urls)
+{
+    const char *names[3] = { "CDDIS", "IGN", "WHU" };
+    string dirUrl = url;
+    while (!dirUrl.empty() && dirUrl[dirUrl.size() - 1] == '/') dirUrl.erase(dirUrl.size() - 1);
+
+    /* the archive and the class of products, by the template of the directory matched */
+    int from = -1;
+    TemplateUtil::fields_t fields;
+    cls = -1;
+    for (int i = 0; i < 3 && from < 0; i++)
+    {
+        const std::vector<TemplateUtil> &tpls = _ftpArchive.dirs[names[i]];
+        for (size_t j = 0; j < tpls.size() && j < _ftpArchive.mirrored.size(); j++)
+        {
+            if (!_ftpArchive.mirrored[j] || !tpls[j].Match(dirUrl, fields)) continue;
+            from = i;
+            cls = (int)j;
+            break;
+        }
+    }
+    if (from < 0) return false;
+
+    mirrors.clear();
+    urls.clear();
+    mirrors.push_back(names[from]);
+    urls.push_back(url);
+    string mirrorUrl;
+    for (int i = 0; i < 3; i++)
+    {
+        if (i == from) continue;
+        _ftpArchive.dirs[names[i]][cls].Expand(fields, mirrorUrl);
+        /* the placeholder whose value is unknown (i.e., the hour from IGN) is kept by Expand */
+        if (mirrorUrl.find('{') != string::npos || !_net.IsSupported(mirrorUrl)) continue;
+        mirrors.push_back(names[i]);
+        urls.push_back(mirrorUrl);
+    }
+
+    return urls.size() > 1;
+} /* end of MirrorUrls */
+
+/**
+* @brief   : Fail - count a failure against the getter running in the thread
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the getter with any failure is NOT recorded as finished in the manifest
+**/
+void FtpUtil::Fail()
+{
+    if (_nfail) (*_nfail)++;
+} /* end of Fail */
+
+/**
+* @brief   : Uncompress - decompress '*.gz' or '*.Z' file downloaded, and remove it
+* @param[I]: compFile (the compressed file with full path, i.e., "igs21906.sp3.Z")
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the record of the compressed file in the manifest is moved to the decompressed one
+**/
+bool FtpUtil::Uncompress(const string &compFile)
+{
+    double t0 = MetricsUtil::Now();
+    bool ok = ZipUtil::Uncompress(compFile);
+    double t1 = MetricsUtil::Now();
+    _metrics.AddInflate(compFile, t1 - t0);
+    TraceUtil::Add("inflate", "inflate", compFile, t0, t1);
+    if (!ok)
+    {
+        Fail();
+
+        return false;
+    }
+    _manifest.Move(compFile, compFile.substr(0, compFile.find_last_of('.')));
+
+    return true;
+} /* end of Uncompress */
+
+/**
+* @brief   : Refresh - check if the remote file of a local one has been republished, and move the local one aside if so
+* @param[I]: localFile (the local file with full path, i.e., "igu21906_00.sp3")
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: republished and moved to '*.old', which is settled by Settle after downloading it again,
+*            false: otherwise
+* @note    : ONLY if 'refresh' is on, the remote file recorded in the manifest is revalidated by a round trip (see
+*            NetUtil::Revalidate). The local file NOT recorded (i.e., downloaded with 'manifest' and 'refresh' off)
+*            is taken as fresh
+**/
+bool FtpUtil::Refresh(const string &localFile, const ftpopt_t *fopt)
+{
+    if (!fopt->refresh || fopt->planOnly) return false;
+
+    ManifestUtil::entry_t entry;
+    if (!_manifest.Find(localFile, entry) || !_manifest.Exists(localFile)) return false;
+
+    /* the local copy is kept if the archive can NOT tell, i.e., it is NOT reachable */
+    NetUtil::remote_t known, remote;
+    known.size = entry.size;
+    known.mtime = entry.mtime;
+    known.etag = entry.etag;
+    int modified = _net.Revalidate(entry.url, known, remote);
+
+    /* the modification time NOT known (i.e., NOT given by "RETR") is recorded, so that "SIZE" is NOT asked next time */
+    if (modified == 0 && ((entry.mtime <= 0 && remote.mtime > 0) || (entry.etag.empty() && !remote.etag.empty())))
+    {
+        _manifest.Add(localFile, entry.url, entry.size, remote.mtime > 0 ? remote.mtime : entry.mtime,
+            remote.etag.empty() ? entry.etag : remote.etag, entry.crc);
+    }
+    if (modified <= 0)
+    {
+        if (fopt->printInfoWget) cout << "*** INFO(FtpUtil::Refresh): " << entry.url << (modified == 0 ?
+            "  NOT modified" : "  NOT revalidated") << endl;
+
+        return false;
+    }
+
+    string oldFile = localFile + ".old";
+    if (!FileUtil::Rename(localFile, oldFile)) return false;
+    _cache.Forget(entry.url);
+    cout << "*** INFO(FtpUtil::Refresh): " << entry.url << " has been republished, download it again" << endl;
+    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Refresh): %s  republished\n", entry.url.c_str());
+
+    return true;
+} /* end of Refresh */
+
+/**
+* @brief   : Settle - remove the local file moved aside by Refresh, or put it back if it is NOT downloaded again
+* @param[I]: localFile (the local file with full path)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::Settle(const string &localFile)
+{
+    string oldFile = localFile + ".old";
+    if (access(localFile.c_str(), 0) == 0) remove(oldFile.c_str());
+    else FileUtil::Rename(oldFile, localFile);
+} /* end of Settle */
+
+/**
+* @brief   : Plan - plan the remote file (or the files matching the pattern) instead of downloading it
+* @param[I]: url (URL of the remote file, or URL of the directory + "/" + the pattern)
+* @param[I]: localFile (the local file with full path, or the local directory if its name is unknown)
+* @param[I]: decode (true: decoded from Compact RINEX after it is decompressed)
+* @param[I]: wget (true: fetched by 'wget')
+* @param[O]: none
+* @return  : none
+* @note    : the size is estimated by the statistics of the mirrored archives (see MirrorUtil::Size)
+**/
+void FtpUtil::Plan(const string &url, const string &localFile, bool decode, bool wget)
+{
+    size_t pos = url.find_last_of('/');
+    string name = pos == string::npos ? url : url.substr(pos + 1);
+    size_t n = name.size();
+    bool inflate = PipeUtil::IsCompressed(name) || (n > 2 && name.compare(n - 2, 2, ".*") == 0);
+
+    /* the class of products by the directory, even if it is NOT mirrored */
+    int cls = -1;
+    std::vector<string> mirrors, urls;
+    if (pos != string::npos) MirrorUrls(url.substr(0, pos), cls, mirrors, urls);
+    _plan.Add(url, localFile, cls >= 0 ? _mirror.Size(cls) : -1, inflate, decode, wget);
+} /* end of Plan */
+
+/**
+* @brief   : ArchiveUrl - the remote directory of the products on the archive
+* @param[I]: ftpName (the name of archive, i.e., "CDDIS", "IGN", or "WHU")
+* @param[I]: idx (the class of products, i.e., IDX_OBSD)
+* @param[I]: fields (the values of the placeholders)
+* @param[O]: none
+* @return  : URL of the directory, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily/2022/032/22d"
+* @note    : the archive NOT known is taken as CDDIS
+**/
+string FtpUtil::ArchiveUrl(const string &ftpName, int idx, const TemplateUtil::fields_t &fields)
+{
+    std::map<string, std::vector<TemplateUtil> >::const_iterator it = _ftpArchive.dirs.find(ftpName);
+    if (it == _ftpArchive.dirs.end()) it = _ftpArchive.dirs.find("CDDIS");
+
+    return it->second[idx].Expand(fields);
+} /* end of ArchiveUrl */
+
+/**
+* @brief   : FileName - the name of the observation file of the site
+* @param[I]: idx (the kind of the file name, i.e., NAME_OBSD_O)
+* @param[I]: fields (the values of the placeholders, including the site)
+* @param[O]: none
+* @return  : the file name, i.e., "algo0320.22o" or "ALGO00CAN_?_20220320000_01D_30S_MO.crx"
+* @note    :
+**/
+string FtpUtil::FileName(int idx, const TemplateUtil::fields_t &fields)
+{
+    return _ftpArchive.names[idx].Expand(fields);
+} /* end of FileName */
+
+/**
+* @brief   : FetchMirrors - download the remote file, or the files matching the pattern, from the mirrored archives
+* @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+* @param[I]: accept (file name pattern, i.e., "igs21906.sp3.*", or empty)
+* @param[I]: localDir (local directory where the files are saved)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : number of files downloaded
+* @note    : every file is raced among the archives (see MirrorUtil::Race) if 'hedgeMirror' is on and the directory is
+*            mirrored, otherwise it is downloaded from the archive of the URL ONLY. The files are recorded in the manifest
+**/
+int FtpUtil::FetchMirrors(const string &url, const string &accept, const string &localDir, const ftpopt_t *fopt)
+{
+    StringUtil str;
+    string dirUrl = url;
+    std::vector<string> names;
+    if (accept.empty())
+    {
+        size_t pos = url.find_last_of('/');
+        if (pos == string::npos || pos + 1 >= url.size())
+        {
+            Fail();
+
+            return 0;
+        }
+        dirUrl = url.substr(0, pos);
+        names.push_back(url.substr(pos + 1));
+    }
+    while (!dirUrl.empty() && dirUrl[dirUrl.size() - 1] == '/') dirUrl.erase(dirUrl.size() - 1);
+
+    /* the same directory on the other archives, from the historically fastest one */
+    int cls = -1;
+    std::vector<string> mirrors, urls;
+    if (fopt->hedgeMirror && MirrorUrls(dirUrl, cls, mirrors, urls)) _mirror.Order(cls, mirrors, urls);
+    else
+    {
+        mirrors.assign(1, "");
+        urls.assign(1, dirUrl);
+    }
+
+    /* the directory is listed on the fastest archive, or the next one if it failed or is empty */
+    for (size_t i = 0; i < urls.size() && !accept.empty() && names.empty(); i++) _net.ListCached(urls[i], names);
+
+    int nget = 0, nmatch = 0;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (!accept.empty() && !str.MatchPattern(names[i], accept)) continue;
+        nmatch++;
+
+        std::vector<string> fileUrls;
+        for (size_t j = 0; j < urls.size(); j++) fileUrls.push_back(urls[j] + "/" + names[i]);
+        string localFile = str.FullPath(localDir, names[i]);
+
+        /* the file downloaded by another run (i.e., with another 'mainDir') is cloned from the cache without any
+           transfer */
+        CacheUtil::entry_t cached;
+        int hit = -1;
+        for (size_t j = 0; j < fileUrls.size() && hit < 0; j++) if (_cache.Get(fileUrls[j], localFile, cached)) hit = (int)j;
+        if (hit >= 0)
+        {
+            _manifest.Add(localFile, fileUrls[hit], cached.size, cached.mtime, cached.etag, cached.crc);
+            if (fopt->printInfoWget) cout << "*** INFO(FtpUtil::FetchMirrors): " << fileUrls[hit] << "  ->  " << localFile <<
+                "  (cache)" << endl;
+            nget++;
+            continue;
+        }
+
+        string partFile = localFile + ".part";
+        unsigned long crc = 0;
+        NetUtil::sink_t toCrc = [&crc](const char *buff, size_t n) { crc = ZipUtil::Crc32(crc, buff, n); return true; };
+        NetUtil::remote_t remote;
+        MetricsUtil::timing_t timing;
+        double start = _metrics.Begin(timing);
+        int won = -1;
+        bool ok = _mirror.Race(_net, _pool, cls, mirrors, fileUrls, partFile, &toCrc, &remote, &won);
+        if (ok)
+        {
+            ok = FileUtil::Rename(partFile, localFile);
+            if (!ok) remove(partFile.c_str());
+        }
+
+        /* the file is recorded with the mirror it came from, whose size and modification time are given */
+        const string &fileUrl = fileUrls[won >= 0 ? won : 0];
+        _metrics.End(timing, start, fileUrl, localFile, ok);
+        if (ok)
+        {
+            _manifest.Add(localFile, fileUrl, remote.size, remote.mtime, remote.etag, crc);
+            _cache.Put(fileUrl, localFile, remote.size, remote.mtime, remote.etag, crc);
+        }
+        else Fail();
+        if (fopt->printInfoWget)
+        {
+            if (ok) cout << "*** INFO(FtpUtil::FetchMirrors): " << fileUrl << "  ->  " << localFile << endl;
+            else cout << "*** INFO(FtpUtil::FetchMirrors): " << fileUrl << "  NOT downloaded" << endl;
+        }
+        if (ok) nget++;
+    }
+    if (nmatch == 0) Fail();  /* NOT found, i.e., NOT published yet */
+
+    return nget;
+} /* end of FetchMirrors */
+
+/**
+* @brief   : FetchFiles - download the remote file, or the files matching the pattern in the remote directory
+* @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+* @param[I]: accept (file name pattern, i.e., "brdc0010.21n.*", or empty)
+* @param[I]: localDir (local directory where the files are saved)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : number of files downloaded (-1: unknown when 'wget' is called)
+* @note    : the built-in transfer engine is used, and 'wget' is ONLY called for the URL it can NOT handle. Nothing
+*            is downloaded but planned if 'planOnly' is on (see Plan)
+**/
+int FtpUtil::FetchFiles(const string &url, const string &accept, const string &localDir, const ftpopt_t *fopt)
+{
+    if (fopt->planOnly)
+    {
+        /* the remote directory is NOT listed, and the pattern stands for the files matching it */
+        StringUtil str;
+        string name = accept.empty() ? url.substr(url.find_last_of('/') + 1) : accept;
+        size_t n = name.size();
+        if (n > 2 && name.compare(n - 2, 2, ".*") == 0) name.erase(n - 2);
+        else if (PipeUtil::IsCompressed(name)) name.erase(name.find_last_of('.'));
+        bool known = !name.empty() && name.find_first_of("*?[") == string::npos;
+        string fileUrl = accept.empty() ? url : url + (url[url.size() - 1] == '/' ? "" : "/") + accept;
+        Plan(fileUrl, known ? str.FullPath(localDir, name) : localDir, false, !_net.IsSupported(url));
+
+        return 0;
+    }
+
+    if (_net.IsSupported(url)) return FetchMirrors(url, accept, localDir, fopt);
+
+    /* 'wget' as fallback, i.e., "ftps" or "https" without TLS support, and its result is unknown */
+    Fail();
+    string wgetFull = fopt->wgetFull, qr = fopt->qr;
+    if (wgetFull.empty())
+    {
+        cerr << "*** WARNING(FtpUtil::FetchFiles): " << url << " is NOT supported and wget CANNOT be found!" << endl;
+
+        return 0;
+    }
+    string cmd = wgetFull + " " + qr + " -nd -P " + localDir;
+    if (!accept.empty()) cmd += " -A " + accept;
+    cmd += " " + url;
+    std::system(cmd.c_str());
+
+    return -1;
+} /* end of FetchFiles */
+
+/**
+* @brief   : FetchObs - download the observation files matching the pattern, and convert them to 'o' files on the fly
+* @param[I]: url (URL of the directory)
+* @param[I]: accept (file name pattern, i.e., "ALGO*_R_20220320000_01D_30S_MO.crx.*", or the exact file name)
+* @param[I]: localDir (local directory where the 'o' files are saved)
+* @param[I]: obsName (the function giving the name of 'o' file from the name of remote file)
+* @param[I]: fopt (FTP options)
+* @param[O]: remoteFile (the name of the last remote file converted, nullptr:NO output)
+* @return  : number of 'o' files created
+* @note    : the remote file is decompressed and decoded (Hatanaka) while it is being downloaded, without any
+*            intermediate file unless 'keepRawObs' is on. The remote file is skipped if its 'o' file exists. The bytes as
+*            downloaded are written to '*.part' file, and an interrupted transfer is resumed from it next time. The
+*            remote file is raced among the mirrored archives if 'hedgeMirror' is on. The 'o' file created is recorded
+*            in the manifest. Nothing is downloaded but planned if 'planOnly' is on
+**/
+int FtpUtil::FetchObs(const string &url, const string &accept, const string &localDir,
+    const std::function<string(const string &)> &obsName, const ftpopt_t *fopt, string *remoteFile)
+{
+    StringUtil str;
+    bool native = _net.IsSupported(url);
+    bool exact = accept.find_first_of("*?[") == string::npos;
+    if (fopt->planOnly)
+    {
+        /* the remote directory is NOT listed, and the pattern stands for the files matching it */
+        string oFile = obsName(accept), name = accept;
+        bool known = !oFile.empty() && oFile.find_first_of("*?[") == string::npos;
+        string localFile = known ? str.FullPath(localDir, oFile) : localDir;
+        size_t n = name.size();
+        if (n > 2 && name.compare(n - 2, 2, ".*") == 0) name.erase(n - 2);
+        if (!known || !_manifest.Exists(localFile))
+        {
+            Plan(url + (url[url.size() - 1] == '/' ? "" : "/") + accept, localFile, PipeUtil::IsHatanaka(name), !native);
+        }
+
+        return 0;
+    }
+
+    /* the same directory on the other archives, from the historically fastest one */
+    int cls = -1;
+    std::vector<string> mirrors, urls;
+    bool hedged = native && fopt->hedgeMirror && MirrorUrls(url, cls, mirrors, urls);
+    if (hedged) _mirror.Order(cls, mirrors, urls);
+    else urls.assign(1, url);
+
+    std::vector<string> names;
+    if (!native)
+    {
+        /* 'wget' as fallback, the remote files are downloaded at first and then put through the pipeline */
+        FetchFiles(url, accept, localDir, fopt);
+        str.GetFilesAll(localDir, "", names);
+    }
+    else if (exact) names.push_back(accept);  /* retrieved directly without listing the directory */
+    else
+    {
+        for (size_t i = 0; i < urls.size() && names.empty(); i++) _net.ListCached(urls[i], names);
+    }
+
+    string dirUrl = url;
+    if (dirUrl[dirUrl.size() - 1] != '/') dirUrl += '/';
+    int nobs = 0, nmatch = 0;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (exact ? names[i] != accept : !str.MatchPattern(names[i], accept)) continue;
+        string oFile = obsName(names[i]);
+        if (oFile.empty()) continue;
+        nmatch++;
+        string localFile = str.FullPath(localDir, oFile);
+        if (_manifest.Exists(localFile)) continue;
+
+        PipeUtil pipe;
+        string rawFile = str.FullPath(localDir, names[i]);
+        string partFile = rawFile + ".part";
+        string fileUrl = dirUrl + names[i];
+        unsigned long crc = 0;
+        NetUtil::remote_t remote;
+        MetricsUtil::timing_t timing;
+        double start = _metrics.Begin(timing);
+        bool ok = pipe.Open(names[i], localFile), okNet = false;
+        if (ok && native)
+        {
+            /* the bytes as downloaded are kept in '*.part' file, so an interrupted transfer is resumed next time */
+            NetUtil::sink_t toPipe = [&pipe, &crc](const char *buff, size_t n)
+            {
+                crc = ZipUtil::Crc32(crc, buff, n);
+
+                return pipe.Write(buff, n);
+            };
+            if (hedged)
+            {
+                std::vector<string> fileUrls;
+                for (size_t j = 0; j < urls.size(); j++) fileUrls.push_back(urls[j] + "/" + names[i]);
+                int won = -1;
+                ok = okNet = _mirror.Race(_net, _pool, cls, mirrors, fileUrls, partFile, &toPipe, &remote, &won);
+                if (won >= 0) fileUrl = fileUrls[won];  /* the mirror the file came from */
+            }
+            else ok = okNet = _net.GetPart(fileUrl, partFile, &toPipe, &remote);
+        }
+        else if (ok)
+        {
+            FILE *fp = fopen(rawFile.c_str(), "rb");
+            char buff[65536];
+            size_t n;
+            if (!fp) ok = false;
+            while (ok && (n = fread(buff, 1, sizeof(buff), fp)) > 0)
+            {
+                crc = ZipUtil::Crc32(crc, buff, n);
+                ok = pipe.Write(buff, n);
+            }
+            if (fp) fclose(fp);
+            if (!fopt->keepRawObs) remove(rawFile.c_str());
+        }
+        ok = pipe.Close(ok);
+        pipe.Seconds(timing.inflate, timing.decode);
+        _metrics.End(timing, start, fileUrl, localFile, ok);
+        if (ok) _manifest.Add(localFile, fileUrl, remote.size, remote.mtime, remote.etag, crc);
+        else Fail();
+        if (okNet && ok && fopt->keepRawObs) FileUtil::Rename(partFile, rawFile);
+        else if (okNet) remove(partFile.c_str());  /* complete, but NOT kept or NOT converted */
+
+        if (fopt->printInfoWget)
+        {
+            if (ok) cout << "*** INFO(FtpUtil::FetchObs): " << fileUrl << "  ->  " << localFile << endl;
+            else cout << "*** INFO(FtpUtil::FetchObs): " << fileUrl << "  NOT converted" << endl;
+        }
+        if (!ok) continue;
+        nobs++;
+        if (remoteFile) *remoteFile = names[i];
+    }
+    if (nmatch == 0) Fail();  /* NOT found, i.e., NOT published yet */
+
+    return nobs;
+} /* end of FetchObs */
+
+/**
+* @brief   : FetchObs - download the observation file matching the pattern, and convert it to the 'o' file on the fly
+* @param[I]: url (URL of the directory)
+* @param[I]: accept (file name pattern, i.e., "ALGO*_R_20220320000_01D_30S_MO.crx.*", or the exact file name)
+* @param[I]: localDir (local directory where the 'o' file is saved)
+* @param[I]: oFile (the name of 'o' file)
+* @param[I]: fopt (FTP options)
+* @param[O]: remoteFile (the name of the remote file converted, nullptr:NO output)
+* @return  : number of 'o' files created (0 or 1)
+* @note    :
+**/
+int FtpUtil::FetchObs(const string &url, const string &accept, const string &localDir, const string &oFile,
+    const ftpopt_t *fopt, string *remoteFile)
+{
+    return FetchObs(url, accept, localDir, [&oFile](const string &) { return oFile; }, fopt, remoteFile);
+} /* end of FetchObs */
+
+/**
+* @brief   : RunJobs - run the jobs (i.e., one site per job) by the worker threads of the run
+* @param[I]: njob (number of jobs)
+* @param[I]: fopt (FTP options)
+* @param[I]: job (the job to run, the argument is the index of job)
+* @param[O]: none
+* @return  : none
+* @note    : 'maxParallel' jobs are run at the same time at most, and they are run one by one if it is less than 2.
+*            The failures in the jobs are counted against the getter calling it (see Fail)
+**/
+void FtpUtil::RunJobs(int njob, const ftpopt_t *fopt, const std::function<void(int)> &job)
+{
+    RunJobs(njob, fopt->maxParallel, job);
+} /* end of RunJobs */
+
+/**
+* @brief   : RunJobs - run the jobs (i.e., one day per job) by the worker threads of the run
+* @param[I]: njob (number of jobs)
+* @param[I]: nparallel (number of jobs run at the same time at most)
+* @param[I]: job (the job to run, the argument is the index of job)
+* @param[O]: none
+* @return  : none
+* @note    : the jobs are queued to the pool started by Setup, and they are run one by one if nparallel is less than 2.
+*            The failures in the jobs are counted against the getter calling it (see Fail)
+**/
+void FtpUtil::RunJobs(int njob, int nparallel, const std::function<void(int)> &job)
+{
+    /* the job may be run by any worker, or by this thread while it waits (see PoolUtil::Run), and the connections
+       per host are limited by NetUtil */
+    std::atomic<int> *nfail = _nfail;
+    _pool.Run(njob, nparallel, [&](int k)
+    {
+        std::atomic<int> *nfail0 = _nfail;
+        _nfail = nfail;
+        {
+            TraceUtil::Span span("job", "job " + to_string(k));
+            job(k);
+        }
+        _nfail = nfail0;
+    });
+} /* end of RunJobs */
+
 /**
 * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
 * @param[I]: ts (start time)
@@ -202,23 +906,8 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -229,185 +918,74 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
-        string url, cutDirs = " --cut-dirs=7 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+        string url = ArchiveUrl(ftpName, IDX_OBSD, tf);
 
         /* it is OK for '*.Z' or '*.gz' format */
         string dFile = "*" + sDoy + "0." + sYy + "d";
         string dxFile = dFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = "." + sYy + "d";
-        vector<string> dFiles;
-        str.GetFilesAll(subDir, suffix, dFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < dFiles.size(); i++)
+        FetchObs(url, dxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the IGS observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsIgs): open site.list = " << fopt->obsLst << 
-                    " file failed, please check it" << endl;
+            const std::vector<site_t> &sites = fopt->obsSites;
+            string url = ArchiveUrl(ftpName, IDX_OBSD, tf);
 
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
                 {
-                    string url, cutDirs = " --cut-dirs=7 ";
-                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-                        cutDirs = " --cut-dirs=5 ";
-                    }
-                    else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
-
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dxFile = dFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                    bool isgz = false;
-                    if (access(dgzFile.c_str(), 0) == 0)
-                    {
-                        /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + dgzFile;
-                        std::system(cmd.c_str());
-                        isgz = true;
-
-                        if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                        {
-                            /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dzFile;
-#endif
-                            std::system(cmd.c_str());
-                        }
-                    }
-                    if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                    {
-                        /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + dzFile;
-                        std::system(cmd.c_str());
-                        isgz = false;
-                    }
+                    string remoteFile;
+                    FetchObs(url, dxFile, subDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " << oFile << endl;
-
-                        string url0 = url + '/' + dxFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " << oFile << endl;
 
-                        continue;
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " << oFile << endl;
 
-                        if (isgz) dxFile = dgzFile;
-                        else dxFile = dzFile;
                         string url0 = url + '/' + dxFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file " << oFile << 
                     " or " << dFile << " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsIgs */
@@ -428,16 +1006,8 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -448,51 +1018,28 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-            string url, cutDirs = " --cut-dirs=7 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBSH, hf);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -502,193 +1049,74 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "." + sYy + "d";
             string dxFile = dFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
-            /* get the file list */
-            string suffix = "." + sYy + "d";
-            vector<string> dFiles;
-            str.GetFilesAll(sHhDir, suffix, dFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < dFiles.size(); i++)
+            FetchObs(url, dxFile, sHhDir, [&](const string &remoteFile)
             {
-                if (access(dFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + dFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    dFile = site + sDoy + sch + "." + sYy + "d";
-                    if (access(dFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+                char sitName[MAXCHARS];
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                return site + sDoy + sch + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the IGS observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHourlyObsIgs): open site.list = " << fopt->obsLst << 
-                    " file failed, please check it" << endl;
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-                return;
-            }
+                string url = ArchiveUrl(ftpName, IDX_OBSH, hf);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
+                    string oFile = FileName(NAME_OBSH_O, sf);
+                    string dFile = FileName(NAME_OBSH_D, sf);
+                    if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                     {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
-                    str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
-                    {
-                        string url, cutDirs = " --cut-dirs=7 ";
-                        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
-                        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
-
                         /* it is OK for '*.Z' or '*.gz' format */
                         string dxFile = dFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                        std::system(cmd.c_str());
-
-                        string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                        bool isgz = false;
-                        if (access(dgzFile.c_str(), 0) == 0)
-                        {
-                            /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + dgzFile;
-                            std::system(cmd.c_str());
-                            isgz = true;
-
-                            if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                            {
-                                /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dzFile;
-#endif
-                                std::system(cmd.c_str());
-                            }
-                        }
-                        if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                        {
-                            /* extract '*.Z' */
-                            cmd = gzipFull + " -d -f " + dzFile;
-                            std::system(cmd.c_str());
-                            isgz = false;
-                        }
+                        string remoteFile;
+                        FetchObs(url, dxFile, sHhDir, oFile, fopt, &remoteFile);
 
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                         string localFile = tmpFile;
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                         {
-                            cout << "*** WARNING(FtpUtil::GetHourlyObsIgs): failed to download IGS Hourly observation file " << oFile << endl;
-
-                            string url0 = url + '/' + dxFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                            cout << "*** INFO(FtpUtil::GetHourlyObsIgs): successfully download IGS hourly observation file " << oFile << endl;
 
-                            continue;
+                            string url0 = url + '/' + remoteFile;
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                         }
-
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(oFile.c_str(), 0) == 0)
+                        else
                         {
-                            cout << "*** INFO(FtpUtil::GetHourlyObsIgs): successfully download IGS hourly observation file " << oFile << endl;
+                            cout << "*** WARNING(FtpUtil::GetHourlyObsIgs): failed to download IGS Hourly observation file " << oFile << endl;
 
-                            if (isgz) dxFile = dgzFile;
-                            else dxFile = dzFile;
                             string url0 = url + '/' + dxFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                            /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
-#endif
-                            std::system(cmd.c_str());
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsIgs): IGS hourly observation file " <<
                         oFile << " or " << dFile << " has existed!" << endl;
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHourlyObsIgs */
@@ -709,16 +1137,8 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -729,54 +1149,28 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
-
-            string url, cutDirs = " --cut-dirs=8 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU")
-            {
-                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBSHR, hf);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -786,205 +1180,83 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "*." + sYy + "d";
             string dxFile = dFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
-            std::vector<string> minuStr = { "00", "15", "30", "45" };
-            for (int i = 0; i < minuStr.size(); i++)
+            FetchObs(url, dxFile, sHhDir, [&](const string &remoteFile)
             {
-                /* get the file list */
-                string suffix = minuStr[i] + "." + sYy + "d";
-                vector<string> dFiles;
-                str.GetFilesAll(sHhDir, suffix, dFiles);
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
                 char sitName[MAXCHARS];
-                for (int j = 0; j < dFiles.size(); j++)
-                {
-                    if (access(dFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + dFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(dFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
-                }
-            }
+                /* the minute, i.e., "algo032a15.22d.gz" or "ALGO00CAN_R_20220320015_15M_01S_MO.crx.gz" */
+                string minu = (remoteFile.size() > 23 && remoteFile[9] == '_') ? remoteFile.substr(21, 2) : remoteFile.substr(8, 2);
+
+                return site + sDoy + sch + minu + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the IGS observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHrObsIgs): open site.list = " << fopt->obsLst << 
-                    " file failed, please check it" << endl;
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-                return;
-            }
+                string url = ArchiveUrl(ftpName, IDX_OBSHR, hf);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
 
                     std::vector<string> minuStr = { "00", "15", "30", "45" };
                     for (int i = 0; i < minuStr.size(); i++)
                     {
-                        str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        sf.mm = atoi(minuStr[i].c_str());
+                        string oFile = FileName(NAME_OBSHR_O, sf);
+                        string dFile = FileName(NAME_OBSHR_D, sf);
+                        if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                         {
-                            string url, cutDirs = " --cut-dirs=8 ";
-                            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else if (ftpName == "WHU")
-                            {
-                                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-
                             /* it is OK for '*.Z' or '*.gz' format */
                             string dxFile = dFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
-
-                            string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                            bool isgz = false;
-                            if (access(dgzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.gz' */
-                                cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
-                                isgz = true;
-
-                                if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                                {
-                                    /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                    cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                    cmd = "rm -rf " + dzFile;
-#endif
-                                    std::system(cmd.c_str());
-                                }
-                            }
-                            if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.Z' */
-                                cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
-                                isgz = false;
-                            }
+                            string remoteFile;
+                            FetchObs(url, dxFile, sHhDir, oFile, fopt, &remoteFile);
 
                             char tmpFile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
                             sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                             string localFile = tmpFile;
-                            if (access(dFile.c_str(), 0) == -1)
+                            if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                             {
-                                cout << "*** WARNING(FtpUtil::GetHrObsIgs): failed to download IGS high-rate observation file " << oFile << endl;
-
-                                string url0 = url + '/' + dxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                                cout << "*** INFO(FtpUtil::GetHrObsIgs): successfully download IGS high-rate observation file " << oFile << endl;
 
-                                continue;
+                                string url0 = url + '/' + remoteFile;
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                             }
-
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
-
-                            if (access(oFile.c_str(), 0) == 0)
+                            else
                             {
-                                cout << "*** INFO(FtpUtil::GetHrObsIgs): successfully download IGS high-rate observation file " << oFile << endl;
+                                cout << "*** WARNING(FtpUtil::GetHrObsIgs): failed to download IGS high-rate observation file " << oFile << endl;
 
-                                if (isgz) dxFile = dgzFile;
-                                else dxFile = dzFile;
                                 string url0 = url + '/' + dxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsIgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
-#endif
-                                std::system(cmd.c_str());
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsIgs): IGS high-rate observation file " <<
                             oFile << " or " << dFile << " has existed!" << endl;
                     }
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHrObsIgs */
@@ -1005,23 +1277,8 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -1032,184 +1289,75 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
-        string url, cutDirs = " --cut-dirs=7 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+        string url = ArchiveUrl(ftpName, IDX_OBMD, tf);
 
         /* it is OK for '*.Z' or '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxxFile = crxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
-        /* download the MGEX observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
-        {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsMgex): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
-                {
-                    string url, cutDirs = " --cut-dirs=7 ";
-                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-                        cutDirs = " --cut-dirs=5 ";
-                    }
-                    else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
-
-                    /* it is OK for '*.Z' or '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
-                    string crxxFile = crxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    string crxgzFile = crxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    bool isgz = true;
-                    string crxzFile;
-                    char tmpFile[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
-                    string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
-                    {
-                        /* extract '*.Z' */
-                        crxzFile = crxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
-
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        isgz = false;
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
-
-                            string url0 = url + '/' + crxxFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-
-                            continue;
-                        }
-                    }
+        /* download the MGEX observation file site-by-site */
+        if (!fopt->obsSites.empty())
+        {
+            const std::vector<site_t> &sites = fopt->obsSites;
+            string url = ArchiveUrl(ftpName, IDX_OBMD, tf);
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+            RunJobs((int)sites.size(), fopt, [&](int k)
+            {
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
+                {
+                    /* it is OK for '*.Z' or '*.gz' format */
+                    string crxFile = FileName(NAME_OBMD, sf);
+                    string crxxFile = crxFile + ".*";
+                    string remoteFile;
+                    FetchObs(url, crxxFile, subDir, oFile, fopt, &remoteFile);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    char tmpFile[MAXSTRPATH] = { '\0' };
+                    char sep = (char)FILEPATHSEP;
+                    sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
+                    string localFile = tmpFile;
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " << oFile << endl;
 
-                        if (isgz) crxxFile = crxgzFile;
-                        else crxxFile = crxzFile;
-                        string url0 = url + '/' + crxxFile;
+                        string url0 = url + '/' + remoteFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsMgex): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                    }
+                    else
+                    {
+                        cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        string url0 = url + '/' + crxxFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsMgex): MGEX daily observation file " << oFile << 
                     " or " << dFile << " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsMgex */
@@ -1230,16 +1378,8 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -1250,246 +1390,107 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-            string url, cutDirs = " --cut-dirs=7 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBMH, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            /* get the file list */
-            string suffix = ".crx";
-            vector<string> crxFiles;
-            str.GetFilesAll(sHhDir, suffix, crxFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < crxFiles.size(); i++)
+            FetchObs(url, crxxFile, sHhDir, [&](const string &remoteFile)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+                char sitName[MAXCHARS];
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                return site + sDoy + sch + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the MGEX observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHourlyObsMgex): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-                return;
-            }
+                string url = ArchiveUrl(ftpName, IDX_OBMH, hf);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
-                    str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
+                    string oFile = FileName(NAME_OBSH_O, sf);
+                    string dFile = FileName(NAME_OBSH_D, sf);
+                    if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
-                        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
-                        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
-
                         /* it is OK for '*.Z' or '*.gz' format */
-                        str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = FileName(NAME_OBMH, sf);
                         string crxxFile = crxFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        string remoteFile;
+                        FetchObs(url, crxxFile, sHhDir, oFile, fopt, &remoteFile);
 
-                        /* extract '*.gz' */
-                        string crxgzFile = crxFile + ".gz";
-                        cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
-#else          /* for Linux or Mac */
-                        changeFileName = "mv";
-#endif
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        bool isgz = true;
-                        string crxzFile;
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                         string localFile = tmpFile;
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                         {
-                            /* extract '*.Z' */
-                            crxzFile = crxFile + ".Z";
-                            cmd = gzipFull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
-
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
-
-                                string url0 = url + '/' + crxxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                            cout << "*** INFO(FtpUtil::GetHourlyObsMgex): successfully download MGEX hourly observation file " << oFile << endl;
 
-                                continue;
-                            }
+                            string url0 = url + '/' + remoteFile;
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsMgex): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                         }
-
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(oFile.c_str(), 0) == 0)
+                        else
                         {
-                            cout << "*** INFO(FtpUtil::GetHourlyObsMgex): successfully download MGEX hourly observation file " << oFile << endl;
+                            cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
 
-                            if (isgz) crxxFile = crxgzFile;
-                            else crxxFile = crxzFile;
                             string url0 = url + '/' + crxxFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsMgex): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                            /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
-#endif
-                            std::system(cmd.c_str());
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsMgex): MGEX hourly observation file " <<
                         oFile << " or " << dFile << " has existed!" << endl;
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHourlyObsMgex */
@@ -1510,16 +1511,8 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -1530,263 +1523,116 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-            string url, cutDirs = " --cut-dirs=8 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU")
-            {
-                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBMHR, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            std::vector<string> minuStr = { "00", "15", "30", "45" };
-            for (int i = 0; i < minuStr.size(); i++)
+            FetchObs(url, crxxFile, sHhDir, [&](const string &remoteFile)
             {
-                /* get the file list */
-                string suffix = minuStr[i] + "_15M_01S_MO.crx";
-                vector<string> crxFiles;
-                str.GetFilesAll(sHhDir, suffix, crxFiles);
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
                 char sitName[MAXCHARS];
-                for (int j = 0; j < crxFiles.size(); j++)
-                {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] +  "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
-                }
-            }
+                /* the minute, i.e., "algo032a15.22d.gz" or "ALGO00CAN_R_20220320015_15M_01S_MO.crx.gz" */
+                string minu = (remoteFile.size() > 23 && remoteFile[9] == '_') ? remoteFile.substr(21, 2) : remoteFile.substr(8, 2);
+
+                return site + sDoy + sch + minu +  "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the MGEX observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHrObsMgex): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-                return;
-            }
+                string url = ArchiveUrl(ftpName, IDX_OBMHR, hf);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
 
                     std::vector<string> minuStr = { "00", "15", "30", "45" };
                     for (int i = 0; i < minuStr.size(); i++)
                     {
-                        str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        sf.mm = atoi(minuStr[i].c_str());
+                        string oFile = FileName(NAME_OBSHR_O, sf);
+                        string dFile = FileName(NAME_OBSHR_D, sf);
+                        if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                         {
-                            string url, cutDirs = " --cut-dirs=8 ";
-                            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else if (ftpName == "WHU")
-                            {
-                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + 
-                                sYy + "d" + "/" + sHh;
-
                             /* it is OK for '*.Z' or '*.gz' format */
-                            str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = FileName(NAME_OBMHR, sf);
                             string crxxFile = crxFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            string remoteFile;
+                            FetchObs(url, crxxFile, sHhDir, oFile, fopt, &remoteFile);
 
-                            /* extract '*.gz' */
-                            string crxgzFile = crxFile + ".gz";
-                            cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
-                            string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
-#else          /* for Linux or Mac */
-                            changeFileName = "mv";
-#endif
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            bool isgz = true;
-                            string crxzFile;
                             char tmpFile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
                             sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                             string localFile = tmpFile;
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                /* extract '*.Z' */
-                                crxzFile = crxFile + ".Z";
-                                cmd = gzipFull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
-
-                                cmd = changeFileName + " " + crxFile + " " + dFile;
-                                std::system(cmd.c_str());
-                                isgz = false;
-                                if (access(dFile.c_str(), 0) == -1)
-                                {
-                                    cout << "*** WARNING(FtpUtil::GetHrObsMgex): failed to download MGEX high-rate observation file " << oFile << endl;
-
-                                    string url0 = url + '/' + crxxFile;
-                                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-
-                                    continue;
-                                }
-                            }
-
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
-
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsMgex): successfully download MGEX high-rate observation file " << oFile << endl;
 
-                                if (isgz) crxxFile = crxgzFile;
-                                else crxxFile = crxzFile;
-                                string url0 = url + '/' + crxxFile;
+                                string url0 = url + '/' + remoteFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsMgex): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                            }
+                            else
+                            {
+                                cout << "*** WARNING(FtpUtil::GetHrObsMgex): failed to download MGEX high-rate observation file " << oFile << endl;
 
-                                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
-#endif
-                                std::system(cmd.c_str());
+                                string url0 = url + '/' + crxxFile;
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsMgex): MGEX high-rate observation file " << 
                             oFile << " or " << dFile << " has existed!" << endl;
                     }
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHrObsMgex */
@@ -1808,23 +1654,8 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -1835,295 +1666,103 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
-        string url, cutDirs = " --cut-dirs=7 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+        string url = ArchiveUrl(ftpName, IDX_OBMD, tf);
 
         /* it is OK for '*.Z' or '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxxFile = crxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
 
         /* download all the IGS observation files */
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+        url = ArchiveUrl(ftpName, IDX_OBSD, tf);
 
         /* it is OK for '*.Z' or '*.gz' format */
         string dFile = "*" + sDoy + "0." + sYy + "d";
         string dxFile = dFile + ".*";
-        cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        suffix = "." + sYy + "d";
-        vector<string> dFiles;
-        str.GetFilesAll(subDir, suffix, dFiles);
-        for (int i = 0; i < dFiles.size(); i++)
+        FetchObs(url, dxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                if (access(oFile.c_str(), 0) == 0)
-                {
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    continue;
-                }
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsIgm): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
                 {
                     /* download the MGEX observation file site-by-site */
-                    string url, cutDirs = " --cut-dirs=7 ";
-                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-                        cutDirs = " --cut-dirs=5 ";
-                    }
-                    else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+                    string url = ArchiveUrl(ftpName, IDX_OBMD, tf);
 
                     /* it is OK for '*.Z' or '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = FileName(NAME_OBMD, sf);
                     string crxxFile = crxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    string crxgzFile = crxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    bool isgz = true;
+                    string remoteFile;
+                    string dxFile = dFile + ".*";
+                    if (FetchObs(url, crxxFile, subDir, oFile, fopt, &remoteFile) <= 0)
+                    {
+                        /* download the IGS observation file site-by-site */
+                        url = ArchiveUrl(ftpName, IDX_OBSD, tf);
+
+                        /* it is OK for '*.Z' or '*.gz' format */
+                        FetchObs(url, dxFile, subDir, oFile, fopt, &remoteFile);
+                    }
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        /* extract '*.Z' */
-                        string crxzFile = crxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
-
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        isgz = false;
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            /* download the IGS observation file site-by-site */
-                            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d";
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=5 ";
-                            }
-                            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d";
-                            else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
-
-                            /* it is OK for '*.Z' or '*.gz' format */
-                            string dxFile = dFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
-
-                            string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                            if (access(dgzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.gz' */
-                                cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
-                                isgz = true;
-
-                                if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                                {
-                                    /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                    cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                    cmd = "rm -rf " + dzFile;
-#endif
-                                    std::system(cmd.c_str());
-                                }
-                            }
-                            if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.Z' */
-                                cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
-                                isgz = false;
-                            }
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                cout << "*** WARNING(FtpUtil::GetDailyObsIgm): failed to download IGM daily observation file " << oFile << endl;
+                        cout << "*** INFO(FtpUtil::GetDailyObsIgm): successfully download IGM daily observation file " << oFile << endl;
 
-                                string url0 = url + '/' + crxxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-                                url0 = url + '/' + dxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        string url0 = url + '/' + remoteFile;
 
-                                continue;
-                            }
-                        }
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsIgm): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsIgm): successfully download IGM daily observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::GetDailyObsIgm): failed to download IGM daily observation file " << oFile << endl;
 
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsIgm): %s  ->  %s  OK\n", oFile.c_str(), localFile.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        string url0 = url + '/' + crxxFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        url0 = url + '/' + dxFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsIgm): IGM daily observation file " << oFile <<
                     " or " << dFile << " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsIgm */
@@ -2145,16 +1784,8 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -2165,358 +1796,135 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
             /* download all the MGEX observation files */
-            string url, cutDirs = " --cut-dirs=7 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBMH, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            /* get the file list */
-            string suffix = ".crx";
-            vector<string> crxFiles;
-            str.GetFilesAll(sHhDir, suffix, crxFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < crxFiles.size(); i++)
+            FetchObs(url, crxxFile, sHhDir, [&](const string &remoteFile)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+                char sitName[MAXCHARS];
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                return site + sDoy + sch + "." + sYy + "o";
+            }, fopt, nullptr);
 
             /* download all the IGS observation files */
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+            url = ArchiveUrl(ftpName, IDX_OBSH, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "." + sYy + "d";
             string dxFile = dFile + ".*";
-            cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
-            /* get the file list */
-            suffix = "." + sYy + "d";
-            vector<string> dFiles;
-            str.GetFilesAll(sHhDir, suffix, dFiles);
-            for (int i = 0; i < dFiles.size(); i++)
+            FetchObs(url, dxFile, sHhDir, [&](const string &remoteFile)
             {
-                if (access(dFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + dFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    dFile = site + sDoy + sch + "." + sYy + "d";
-                    if (access(dFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    if (access(oFile.c_str(), 0) == 0)
-                    {
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        continue;
-                    }
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+                char sitName[MAXCHARS];
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                return site + sDoy + sch + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHourlyObsIgm): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
-                    str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
+                    string oFile = FileName(NAME_OBSH_O, sf);
+                    string dFile = FileName(NAME_OBSH_D, sf);
+                    if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                     {
                         /* download the MGEX observation file site-by-site */
-                        string url, cutDirs = " --cut-dirs=7 ";
-                        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
-                        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                        string url = ArchiveUrl(ftpName, IDX_OBMH, hf);
 
                         /* it is OK for '*.Z' or '*.gz' format */
-                        str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = FileName(NAME_OBMH, sf);
                         string crxxFile = crxFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        string remoteFile;
+                        string dxFile = dFile + ".*";
+                        if (FetchObs(url, crxxFile, sHhDir, oFile, fopt, &remoteFile) <= 0)
+                        {
+                            /* download the IGS observation file site-by-site */
+                            url = ArchiveUrl(ftpName, IDX_OBSH, hf);
 
-                        /* extract '*.gz' */
-                        string crxgzFile = crxFile + ".gz";
-                        cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
-#else          /* for Linux or Mac */
-                        changeFileName = "mv";
-#endif
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        bool isgz = true;
+                            /* it is OK for '*.Z' or '*.gz' format */
+                            FetchObs(url, dxFile, sHhDir, oFile, fopt, &remoteFile);
+                        }
 
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                         string localFile = tmpFile;
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                         {
-                            /* extract '*.Z' */
-                            string crxzFile = crxFile + ".Z";
-                            cmd = gzipFull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
+                            cout << "*** INFO(FtpUtil::GetHourlyObsIgm ): successfully download IGM hourly observation file " << oFile << endl;
 
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            isgz = false;
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                /* download the IGS observation file site-by-site */
-                                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                                    sYyyy + "/" + sDoy + "/" + sHh;
-                                else if (ftpName == "IGN")
-                                {
-                                    url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                                    cutDirs = " --cut-dirs=6 ";
-                                }
-                                else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                                    sYyyy + "/" + sDoy + "/" + sHh;
-                                else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                            string url0 = url + '/' + remoteFile;
 
-                                /* it is OK for '*.Z' or '*.gz' format */
-                                string dxFile = dFile + ".*";
-                                string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                                std::system(cmd.c_str());
-
-                                string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                                if (access(dgzFile.c_str(), 0) == 0)
-                                {
-                                    /* extract '*.gz' */
-                                    cmd = gzipFull + " -d -f " + dgzFile;
-                                    std::system(cmd.c_str());
-                                    isgz = true;
-
-                                    if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                                    {
-                                        /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                        cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                        cmd = "rm -rf " + dzFile;
-#endif
-                                        std::system(cmd.c_str());
-                                    }
-                                }
-                                if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                                {
-                                    /* extract '*.Z' */
-                                    cmd = gzipFull + " -d -f " + dzFile;
-                                    std::system(cmd.c_str());
-                                    isgz = false;
-                                }
-                                if (access(dFile.c_str(), 0) == -1)
-                                {
-                                    cout << "*** WARNING(FtpUtil::GetHourlyObsIgm): failed to download IGM Hourly observation file " << oFile << endl;
-
-                                    string url0 = url + '/' + crxxFile;
-                                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-                                    url0 = url + '/' + dxFile;
-                                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-
-                                    continue;
-                                }
-                            }
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsIgm): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                         }
-
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(oFile.c_str(), 0) == 0)
+                        else
                         {
-                            cout << "*** INFO(FtpUtil::GetHourlyObsIgm ): successfully download IGM hourly observation file " << oFile << endl;
+                            cout << "*** WARNING(FtpUtil::GetHourlyObsIgm): failed to download IGM Hourly observation file " << oFile << endl;
 
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsIgm): %s  ->  %s  OK\n", oFile.c_str(), localFile.c_str());
-
-                            /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
-#endif
-                            std::system(cmd.c_str());
+                            string url0 = url + '/' + crxxFile;
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                            url0 = url + '/' + dxFile;
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsIgm ): IGM hourly observation file " <<
                         oFile << " or " << dFile << " has existed!" << endl;
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHourlyObsIgm */
@@ -2538,16 +1946,8 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -2558,371 +1958,146 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         for (int i = 0; i < fopt->hhObs.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
             char tmpDir[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
             /* download all the MGEX observation files */
-            string url, cutDirs = " --cut-dirs=8 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU")
-            {
-                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            string url = ArchiveUrl(ftpName, IDX_OBMHR, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            std::vector<string> minuStr = { "00", "15", "30", "45" };
-            for (int i = 0; i < minuStr.size(); i++)
+            FetchObs(url, crxxFile, sHhDir, [&](const string &remoteFile)
             {
-                /* get the file list */
-                string suffix = minuStr[i] + "_15M_01S_MO.crx";
-                vector<string> crxFiles;
-                str.GetFilesAll(sHhDir, suffix, crxFiles);
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
                 char sitName[MAXCHARS];
-                for (int j = 0; j < crxFiles.size(); j++)
-                {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
-                }
-            }
+                /* the minute, i.e., "algo032a15.22d.gz" or "ALGO00CAN_R_20220320015_15M_01S_MO.crx.gz" */
+                string minu = (remoteFile.size() > 23 && remoteFile[9] == '_') ? remoteFile.substr(21, 2) : remoteFile.substr(8, 2);
+
+                return site + sDoy + sch + minu + "." + sYy + "o";
+            }, fopt, nullptr);
 
             /* download all the IGS observation files */
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU")
-            {
-                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            url = ArchiveUrl(ftpName, IDX_OBSHR, hf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "*." + sYy + "d";
             string dxFile = dFile + ".*";
-            cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
-            for (int i = 0; i < minuStr.size(); i++)
+            FetchObs(url, dxFile, sHhDir, [&](const string &remoteFile)
             {
-                /* get the file list */
-                string suffix = minuStr[i] + "." + sYy + "d";
-                vector<string> dFiles;
-                str.GetFilesAll(sHhDir, suffix, dFiles);
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
                 char sitName[MAXCHARS];
-                for (int j = 0; j < dFiles.size(); j++)
-                {
-                    if (access(dFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + dFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(dFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
-                }
-            }
+                /* the minute, i.e., "algo032a15.22d.gz" or "ALGO00CAN_R_20220320015_15M_01S_MO.crx.gz" */
+                string minu = (remoteFile.size() > 23 && remoteFile[9] == '_') ? remoteFile.substr(21, 2) : remoteFile.substr(8, 2);
+
+                return site + sDoy + sch + minu + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the MGEX observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHrObsIgm): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
 
                     std::vector<string> minuStr = { "00", "15", "30", "45" };
                     for (int i = 0; i < minuStr.size(); i++)
                     {
-                        str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        sf.mm = atoi(minuStr[i].c_str());
+                        string oFile = FileName(NAME_OBSHR_O, sf);
+                        string dFile = FileName(NAME_OBSHR_D, sf);
+                        if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                         {
-                            string url, cutDirs = " --cut-dirs=8 ";
-                            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else if (ftpName == "WHU")
-                            {
-                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
-                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" +
-                                sYy + "d" + "/" + sHh;
+                            string url = ArchiveUrl(ftpName, IDX_OBMHR, hf);
 
                             /* it is OK for '*.Z' or '*.gz' format */
-                            str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = FileName(NAME_OBMHR, sf);
                             string crxxFile = crxFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            string remoteFile;
+                            string dxFile = dFile + ".*";
+                            if (FetchObs(url, crxxFile, sHhDir, oFile, fopt, &remoteFile) <= 0)
+                            {
+                                url = ArchiveUrl(ftpName, IDX_OBSHR, hf);
 
-                            /* extract '*.gz' */
-                            string crxgzFile = crxFile + ".gz";
-                            cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
-                            string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
-#else          /* for Linux or Mac */
-                            changeFileName = "mv";
-#endif
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            bool isgz = true;
+                                /* it is OK for '*.Z' or '*.gz' format */
+                                FetchObs(url, dxFile, sHhDir, oFile, fopt, &remoteFile);
+                            }
 
                             char tmpFile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
                             sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                             string localFile = tmpFile;
-                            if (access(dFile.c_str(), 0) == -1)
+                            if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                             {
-                                /* extract '*.Z' */
-                                string crxzFile = crxFile + ".Z";
-                                cmd = gzipFull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
-
-                                cmd = changeFileName + " " + crxFile + " " + dFile;
-                                std::system(cmd.c_str());
-                                isgz = false;
-                                if (access(dFile.c_str(), 0) == -1)
-                                {
-                                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                                        sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                                    else if (ftpName == "IGN")
-                                    {
-                                        url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                                        cutDirs = " --cut-dirs=6 ";
-                                    }
-                                    else if (ftpName == "WHU")
-                                    {
-                                        url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                                        cutDirs = " --cut-dirs=6 ";
-                                    }
-                                    else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-
-                                    /* it is OK for '*.Z' or '*.gz' format */
-                                    string dxFile = dFile + ".*";
-                                    cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                                    std::system(cmd.c_str());
-
-                                    string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                                    if (access(dgzFile.c_str(), 0) == 0)
-                                    {
-                                        /* extract '*.gz' */
-                                        cmd = gzipFull + " -d -f " + dgzFile;
-                                        std::system(cmd.c_str());
-                                        isgz = true;
-
-                                        if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                                        {
-                                            /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                            cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                            cmd = "rm -rf " + dzFile;
-#endif
-                                            std::system(cmd.c_str());
-                                        }
-                                    }
-                                    if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                                    {
-                                        /* extract '*.Z' */
-                                        cmd = gzipFull + " -d -f " + dzFile;
-                                        std::system(cmd.c_str());
-                                        isgz = false;
-                                    }
-                                    if (access(dFile.c_str(), 0) == -1)
-                                    {
-                                        cout << "*** WARNING(FtpUtil::GetHrObsIgm): failed to download IGM high-rate observation file " << oFile << endl;
-
-                                        string url0 = url + '/' + crxxFile;
-                                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-                                        url0 = url + '/' + dxFile;
-                                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-
-                                        continue;
-                                    }
-                                }
-                            }
+                                cout << "*** INFO(FtpUtil::GetHrObsIgm): successfully download IGM high-rate observation file " << oFile << endl;
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                                string url0 = url + '/' + remoteFile;
 
-                            if (access(oFile.c_str(), 0) == 0)
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsIgm): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                            }
+                            else
                             {
-                                cout << "*** INFO(FtpUtil::GetHrObsIgm): successfully download IGM high-rate observation file " << oFile << endl;
-
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsIgm): %s  ->  %s  OK\n", oFile.c_str(), localFile.c_str());
+                                cout << "*** WARNING(FtpUtil::GetHrObsIgm): failed to download IGM high-rate observation file " << oFile << endl;
 
-                                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
-#endif
-                                std::system(cmd.c_str());
+                                string url0 = url + '/' + crxxFile;
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                                url0 = url + '/' + dxFile;
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsIgm): IGM high-rate observation file " <<
                             oFile << " or " << dFile << " has existed!" << endl;
                     }
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHrObsIgm */
@@ -2944,23 +2119,8 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -2971,85 +2131,48 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "http://saegnss2.curtin.edu/ldc/rinex3/daily/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Curtin University of Technology (CUT) observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+    if (!fopt->obsSites.empty())
     {
-        ifstream sitLst(fopt->obsLst);
-        if (!sitLst.is_open())
-        {
-            cerr << "*** ERROR(FtpUtil::GetDailyObsCut): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-            return;
-        }
-
-        string sitName;
-        while (getline(sitLst, sitName))
+        const std::vector<site_t> &sites = fopt->obsSites;
+        RunJobs((int)sites.size(), fopt, [&](int k)
         {
-            if (sitName[0] == '#') continue;
-            str.TrimSpace4String(sitName);
-            if (sitName.size() != 4) continue;
-            str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            TemplateUtil::fields_t sf = tf;
+            sf.site = &sites[k];
+            string oFile = FileName(NAME_OBSD_O, sf);
+            if (!_manifest.Exists(str.FullPath(subDir, oFile)))
             {
                 /* it is OK for '*.gz' format */
-                str.ToUpper(sitName);
-                string crxFile = sitName + "00AUS_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                string crxFile = FileName(NAME_CUT, sf);
                 string crxgzFile = crxFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
-
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                string remoteFile;
+                FetchObs(url, crxgzFile, subDir, oFile, fopt, &remoteFile);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                 string localFile = tmpFile;
-                if (access(crxFile.c_str(), 0) == -1)
+                if (_manifest.Exists(str.FullPath(subDir, oFile)))
                 {
-                    cout << "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " << oFile << endl;
-
-                    string url0 = url + '/' + crxgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsCut): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                    cout << "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " << oFile << endl;
 
-                    continue;
+                    string url0 = url + '/' + remoteFile;
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsCut): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                 }
-
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                if (access(oFile.c_str(), 0) == 0)
+                else
                 {
-                    cout << "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " << oFile << endl;
+                    cout << "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " << oFile << endl;
 
                     string url0 = url + '/' + crxgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsCut): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                    /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsCut): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
             }
             else cout << "*** INFO(FtpUtil::GetDailyObsCut): CUT daily observation file " << oFile <<
                 " has existed!" << endl;
-        }
-
-        /* close 'site.list' */
-        sitLst.close();
+        });
     }
 } /* end of GetDailyObsCut */
 
@@ -3070,23 +2193,8 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -3097,142 +2205,67 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://ftp.data.gnss.ga.gov.au/daily/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=3 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxgzFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the GA observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsGa): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)))
                 {
                     /* it is OK for '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = FileName(NAME_OBMD, sf);
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    string remoteFile;
+                    FetchObs(url, crxgzFile, subDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
-
-                        string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::GetDailyObsGa): successfully download GA daily observation file " << oFile << endl;
 
-                        continue;
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsGa): successfully download GA daily observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
 
                         string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsGa): GA daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsGa */
@@ -3254,16 +2287,8 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -3274,10 +2299,9 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.data.gnss.ga.gov.au/hourly/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the GA observation files */
@@ -3288,194 +2312,87 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
             string url = url0 + "/" + sHh;
             /* it is OK for '*.gz' format */
             string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
             string crxgzFile = crxFile + ".gz";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            /* get the file list */
-            string suffix = ".crx";
-            vector<string> crxFiles;
-            str.GetFilesAll(sHhDir, suffix, crxFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < crxFiles.size(); i++)
+            FetchObs(url, crxgzFile, sHhDir, [&](const string &remoteFile)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + "  -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+                char sitName[MAXCHARS];
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                return site + sDoy + sch + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the GA observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHourlyObsGa): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
-                    str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
+                    string oFile = FileName(NAME_OBSH_O, sf);
+                    string dFile = FileName(NAME_OBSH_D, sf);
+                    if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                     {
                         string url = url0 + "/" + sHh;
                         /* it is OK for '*.gz' format */
-                        str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = FileName(NAME_OBMH, sf);
                         string crxgzFile = crxFile + ".gz";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                        std::system(cmd.c_str());
-
-                        /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
-#else          /* for Linux or Mac */
-                        changeFileName = "mv";
-#endif
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        string remoteFile;
+                        FetchObs(url, crxgzFile, sHhDir, oFile, fopt, &remoteFile);
 
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                         string localFile = tmpFile;
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                         {
-                            cout << "*** WARNING(FtpUtil::GetHourlyObsGa): failed to download GA hourly observation file " << oFile << endl;
-
-                            string url0 = url + '/' + crxgzFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                            cout << "*** INFO(FtpUtil::GetHourlyObsGa): successfully download GA hourly observation file " << oFile << endl;
 
-                            continue;
+                            string url0 = url + '/' + remoteFile;
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                         }
-
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(oFile.c_str(), 0) == 0)
+                        else
                         {
-                            cout << "*** INFO(FtpUtil::GetHourlyObsGa): successfully download GA hourly observation file " << oFile << endl;
+                            cout << "*** WARNING(FtpUtil::GetHourlyObsGa): failed to download GA hourly observation file " << oFile << endl;
 
                             string url0 = url + '/' + crxgzFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHourlyObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                            /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
-#endif
-                            std::system(cmd.c_str());
+                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsGa): GA hourly observation file " <<
                         oFile << " or " << dFile << " has existed!" << endl;
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHourlyObsMgex */
@@ -3497,16 +2414,8 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -3517,10 +2426,9 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.data.gnss.ga.gov.au/highrate/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
@@ -3531,203 +2439,96 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + sHhDir;
-#endif
-                std::system(cmd.c_str());
-            }
-
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
             string url = url0 + "/" + sHh;
             /* it is OK for '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxgzFile = crxFile + ".gz";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
-
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
             char ch = ii;
             string sch;
             sch.push_back(ch);
 
-            std::vector<string> minuStr = { "00", "15", "30", "45" };
-            for (int i = 0; i < minuStr.size(); i++)
+            FetchObs(url, crxgzFile, sHhDir, [&](const string &remoteFile)
             {
-                /* get the file list */
-                string suffix = minuStr[i] + "_15M_01S_MO.crx";
-                vector<string> crxFiles;
-                str.GetFilesAll(sHhDir, suffix, crxFiles);
+                /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
                 char sitName[MAXCHARS];
-                for (int j = 0; j < crxFiles.size(); j++)
-                {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
 
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
-                }
-            }
+                /* the minute, i.e., "algo032a15.22d.gz" or "ALGO00CAN_R_20220320015_15M_01S_MO.crx.gz" */
+                string minu = (remoteFile.size() > 23 && remoteFile[9] == '_') ? remoteFile.substr(21, 2) : remoteFile.substr(8, 2);
+
+                return site + sDoy + sch + minu + "." + sYy + "o";
+            }, fopt, nullptr);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the GA observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            for (int i = 0; i < fopt->hhObs.size(); i++)
             {
-                cerr << "*** ERROR(FtpUtil::GetHrObsGa): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
+                string sHh = str.hh2str(fopt->hhObs[i]);
+                TemplateUtil::fields_t hf = tf;
+                hf.hh = fopt->hhObs[i];
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+                string sHhDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(sHhDir);
 
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                for (int i = 0; i < fopt->hhObs.size(); i++)
+                RunJobs((int)sites.size(), fopt, [&](int k)
                 {
-                    string sHh = str.hh2str(fopt->hhObs[i]);
-                    char tmpDir[MAXSTRPATH] = { '\0' };
-                    char sep = (char)FILEPATHSEP;
-                    sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                    string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
-
-                    /* 'a' = 97, 'b' = 98, ... */
-                    int ii = fopt->hhObs[i] + 97;
-                    char ch = ii;
-                    string sch;
-                    sch.push_back(ch);
+                    TemplateUtil::fields_t sf = hf;
+                    sf.site = &sites[k];
 
                     string url = url0 + "/" + sHh;
                     std::vector<string> minuStr = { "00", "15", "30", "45" };
                     for (int i = 0; i < minuStr.size(); i++)
                     {
-                        str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        sf.mm = atoi(minuStr[i].c_str());
+                        string oFile = FileName(NAME_OBSHR_O, sf);
+                        string dFile = FileName(NAME_OBSHR_D, sf);
+                        if (!_manifest.Exists(str.FullPath(sHhDir, oFile)) && !_manifest.Exists(str.FullPath(sHhDir, dFile)))
                         {
                             /* it is OK for '*.gz' format */
-                            str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = FileName(NAME_OBMHR, sf);
                             string crxgzFile = crxFile + ".gz";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                            std::system(cmd.c_str());
-
-                            /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
-                            string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
-#else          /* for Linux or Mac */
-                            changeFileName = "mv";
-#endif
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            string remoteFile;
+                            FetchObs(url, crxgzFile, sHhDir, oFile, fopt, &remoteFile);
 
                             char tmpFile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
                             sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                             string localFile = tmpFile;
-                            if (access(dFile.c_str(), 0) == -1)
+                            if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                             {
-                                cout << "*** WARNING(FtpUtil::GetHrObsGa): failed to download GA high-rate observation file " << oFile << endl;
-
-                                string url0 = url + '/' + crxgzFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                                cout << "*** INFO(FtpUtil::GetHrObsGa): successfully download GA high-rate observation file " << oFile << endl;
 
-                                continue;
+                                string url0 = url + '/' + remoteFile;
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                             }
-
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
-
-                            if (access(oFile.c_str(), 0) == 0)
+                            else
                             {
-                                cout << "*** INFO(FtpUtil::GetHrObsGa): successfully download GA high-rate observation file " << oFile << endl;
+                                cout << "*** WARNING(FtpUtil::GetHrObsGa): failed to download GA high-rate observation file " << oFile << endl;
 
                                 string url0 = url + '/' + crxgzFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetHrObsGa): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
-#endif
-                                std::system(cmd.c_str());
+                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsGa): GA high-rate observation file " <<
                             oFile << " or " << dFile << " has existed!" << endl;
                     }
-                }
+                });
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetHrObsGa */
@@ -3749,23 +2550,8 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "30s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -3776,86 +2562,50 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+    if (!fopt->obsSites.empty())
     {
-        ifstream sitLst(fopt->obsLst);
-        if (!sitLst.is_open())
-        {
-            cerr << "*** ERROR(FtpUtil::Get30sObsHk): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-            return;
-        }
-
-        string sitName;
-        while (getline(sitLst, sitName))
+        const std::vector<site_t> &sites = fopt->obsSites;
+        RunJobs((int)sites.size(), fopt, [&](int k)
         {
-            if (sitName[0] == '#') continue;
-            str.TrimSpace4String(sitName);
-            if (sitName.size() != 4) continue;
-            str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
+            string sitName = sites[k].name;
+            TemplateUtil::fields_t sf = tf;
+            sf.site = &sites[k];
+            string oFile = FileName(NAME_OBSD_O, sf);
             string url = url0 + "/" + sitName + "/30s";
-            if (access(oFile.c_str(), 0) == -1)
+            if (!_manifest.Exists(str.FullPath(subDir, oFile)))
             {
                 /* it is OK for '*.gz' format */
-                str.ToUpper(sitName);
-                string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                string crxFile = FileName(NAME_HK30S, sf);
                 string crxgzFile = crxFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
-
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                string remoteFile;
+                FetchObs(url, crxgzFile, subDir, oFile, fopt, &remoteFile);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                 string localFile = tmpFile;
-                if (access(crxFile.c_str(), 0) == -1)
+                if (_manifest.Exists(str.FullPath(subDir, oFile)))
                 {
-                    cout << "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " << oFile << endl;
-
-                    string url0 = url + '/' + crxgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get30sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                    cout << "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " << oFile << endl;
 
-                    continue;
+                    string url0 = url + '/' + remoteFile;
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get30sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                 }
-
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                if (access(oFile.c_str(), 0) == 0)
+                else
                 {
-                    cout << "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " << oFile << endl;
+                    cout << "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " << oFile << endl;
 
                     string url0 = url + '/' + crxgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get30sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                    /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get30sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
             }
             else cout << "*** INFO(FtpUtil::Get30sObsHk): HK CORS 30s observation file " << oFile <<
                 " has existed!" << endl;
-        }
-
-        /* close 'site.list' */
-        sitLst.close();
+        });
     }
 } /* end of Get30sObsHk */
 
@@ -3876,23 +2626,8 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "5s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -3903,117 +2638,63 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+    if (!fopt->obsSites.empty())
     {
-        ifstream sitLst(fopt->obsLst);
-        if (!sitLst.is_open())
+        const std::vector<site_t> &sites = fopt->obsSites;
+        for (int i = 0; i < fopt->hhObs.size(); i++)
         {
-            cerr << "*** ERROR(FtpUtil::Get5sObsHk): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-            return;
-        }
+            string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            char sep = (char)FILEPATHSEP;
+            sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+            string sHhDir = tmpDir;
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-        string sitName;
-        while (getline(sitLst, sitName))
-        {
-            if (sitName[0] == '#') continue;
-            str.TrimSpace4String(sitName);
-            if (sitName.size() != 4) continue;
-            for (int i = 0; i < fopt->hhObs.size(); i++)
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                string sHh = str.hh2str(fopt->hhObs[i]);
-                char tmpDir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                string sHhDir = tmpDir;
-                if (access(sHhDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + sHhDir;
-#endif
-                    std::system(cmd.c_str());
-                }
-
-                /* change directory */
-#ifdef _WIN32   /* for Windows */
-                _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                chdir(sHhDir.c_str());
-#endif
-
-                /* 'a' = 97, 'b' = 98, ... */
-                int ii = fopt->hhObs[i] + 97;
-                char ch = ii;
-                string sch;
-                sch.push_back(ch);
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + sch + "." + sYy + "o";
+                string sitName = sites[k].name;
+                TemplateUtil::fields_t sf = hf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSH_O, sf);
                 string url = url0 + "/" + sitName + "/5s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (!_manifest.Exists(str.FullPath(sHhDir, oFile)))
                 {
                     /* it is OK for '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_05S_MO.crx";
+                    string crxFile = FileName(NAME_HK5S, sf);
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    string remoteFile;
+                    FetchObs(url, crxgzFile, sHhDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(crxFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                     {
-                        cout << "*** WARNING(FtpUtil::Get5sObsHk): failed to download HK CORS 5s observation file " << oFile << endl;
-
-                        string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get5sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::Get5sObsHk): successfully download HK CORS 5s observation file " << oFile << endl;
 
-                        continue;
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get5sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::Get5sObsHk): successfully download HK CORS 5s observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::Get5sObsHk): failed to download HK CORS 5s observation file " << oFile << endl;
 
                         string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get5sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get5sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::Get5sObsHk): HK CORS 5s observation file " << oFile <<
                     " has existed!" << endl;
-            }
+            });
         }
-
-        /* close 'site.list' */
-        sitLst.close();
     }
 } /* end of Get5sObsHk */
 
@@ -4034,23 +2715,8 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "1s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4061,117 +2727,63 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+    if (!fopt->obsSites.empty())
     {
-        ifstream sitLst(fopt->obsLst);
-        if (!sitLst.is_open())
+        const std::vector<site_t> &sites = fopt->obsSites;
+        for (int i = 0; i < fopt->hhObs.size(); i++)
         {
-            cerr << "*** ERROR(FtpUtil::Get1sObsHk): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-            return;
-        }
+            string sHh = str.hh2str(fopt->hhObs[i]);
+            TemplateUtil::fields_t hf = tf;
+            hf.hh = fopt->hhObs[i];
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            char sep = (char)FILEPATHSEP;
+            sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
+            string sHhDir = tmpDir;
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(sHhDir);
 
-        string sitName;
-        while (getline(sitLst, sitName))
-        {
-            if (sitName[0] == '#') continue;
-            str.TrimSpace4String(sitName);
-            if (sitName.size() != 4) continue;
-            for (int i = 0; i < fopt->hhObs.size(); i++)
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                string sHh = str.hh2str(fopt->hhObs[i]);
-                char tmpDir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
-                string sHhDir = tmpDir;
-                if (access(sHhDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + sHhDir;
-#endif
-                    std::system(cmd.c_str());
-                }
-
-                /* change directory */
-#ifdef _WIN32   /* for Windows */
-                _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                chdir(sHhDir.c_str());
-#endif
-
-                /* 'a' = 97, 'b' = 98, ... */
-                int ii = fopt->hhObs[i] + 97;
-                char ch = ii;
-                string sch;
-                sch.push_back(ch);
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + sch + "." + sYy + "o";
+                string sitName = sites[k].name;
+                TemplateUtil::fields_t sf = hf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSH_O, sf);
                 string url = url0 + "/" + sitName + "/1s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (!_manifest.Exists(str.FullPath(sHhDir, oFile)))
                 {
                     /* it is OK for '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_01S_MO.crx";
+                    string crxFile = FileName(NAME_HK1S, sf);
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    string remoteFile;
+                    FetchObs(url, crxgzFile, sHhDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(crxFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(sHhDir, oFile)))
                     {
-                        cout << "*** WARNING(FtpUtil::Get1sObsHk): failed to download HK CORS 1s observation file " << oFile << endl;
-
-                        string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get1sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::Get1sObsHk): successfully download HK CORS 1s observation file " << oFile << endl;
 
-                        continue;
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get1sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::Get1sObsHk): successfully download HK CORS 1s observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::Get1sObsHk): failed to download HK CORS 1s observation file " << oFile << endl;
 
                         string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(Get1sObsHk): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get1sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::Get1sObsHk): HK CORS 1s observation file " << oFile <<
                     " has existed!" << endl;
-            }
+            });
         }
-
-        /* close 'site.list' */
-        sitLst.close();
     }
 } /* end of Get1sObsHk */
 
@@ -4192,23 +2804,8 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4219,84 +2816,49 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "https://noaa-cors-pds.s3.amazonaws.com/rinex/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     /* download the NGS/NOAA CORS observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+    if (!fopt->obsSites.empty())
     {
-        ifstream sitLst(fopt->obsLst);
-        if (!sitLst.is_open())
-        {
-            cerr << "*** ERROR(FtpUtil::GetDailyObsNgs): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-            return;
-        }
-
-        string sitName;
-        while (getline(sitLst, sitName))
+        const std::vector<site_t> &sites = fopt->obsSites;
+        RunJobs((int)sites.size(), fopt, [&](int k)
         {
-            if (sitName[0] == '#') continue;
-            str.TrimSpace4String(sitName);
-            if (sitName.size() != 4) continue;
-            str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            string sitName = sites[k].name;
+            TemplateUtil::fields_t sf = tf;
+            sf.site = &sites[k];
+            string oFile = FileName(NAME_OBSD_O, sf);
+            if (!_manifest.Exists(str.FullPath(subDir, oFile)))
             {
                 /* it is OK for '*.gz' format */
-                string dFile = sitName + sDoy + "0." + sYy + "d";
+                string dFile = FileName(NAME_OBSD_D, sf);
                 string dgzFile = dFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + sitName + "/" + dgzFile;
-                std::system(cmd.c_str());
-
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + dgzFile;
-                std::system(cmd.c_str());
+                string remoteFile;
+                FetchObs(url + "/" + sitName, dgzFile, subDir, oFile, fopt, &remoteFile);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                 string localFile = tmpFile;
-                if (access(dFile.c_str(), 0) == -1)
+                if (_manifest.Exists(str.FullPath(subDir, oFile)))
                 {
-                    cout << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
-
-                    string url0 = url + '/' + dgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsNgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                    cout << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
 
-                    continue;
+                    string url0 = url + '/' + remoteFile;
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsNgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                 }
-
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                if (access(oFile.c_str(), 0) == 0)
+                else
                 {
-                    cout << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
+                    cout << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
 
                     string url0 = url + '/' + dgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsNgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsNgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
             }
             else cout << "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " << oFile <<
                 " has existed!" << endl;
-        }
-
-        /* close 'site.list' */
-        sitLst.close();
+        });
     }
 } /* end of GetDailyObsNgs */
 
@@ -4317,23 +2879,8 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4344,142 +2891,67 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://ftp.epncb.oma.be/pub/obs/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxgzFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the EPN observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsEpn): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)))
                 {
                     /* it is OK for '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = FileName(NAME_OBMD, sf);
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    string remoteFile;
+                    FetchObs(url, crxgzFile, subDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
-                    {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " << oFile << endl;
-
-                        string url0 = url + '/' + crxgzFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsEpn): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-
-                        continue;
-                    }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsEpn): successfully download EPN daily observation file " << oFile << endl;
 
-                        string url0 = url + '/' + crxgzFile;
+                        string url0 = url + '/' + remoteFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsEpn): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                    }
+                    else
+                    {
+                        cout << "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " << oFile << endl;
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        string url0 = url + '/' + crxgzFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsEpn): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsEpn): EPN daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsEpn */
@@ -4501,23 +2973,8 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4528,158 +2985,66 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.Z' or '*.gz' format */
         string dFile = "*" + sDoy + "0." + sYy + "d";
         string dxFile = dFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = "." + sYy + "d";
-        vector<string> dFiles;
-        str.GetFilesAll(subDir, suffix, dFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < dFiles.size(); i++)
+        FetchObs(url, dxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the PBO observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsPbo2): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dxFile = dFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                    bool isgz = false;
-                    if (access(dgzFile.c_str(), 0) == 0)
-                    {
-                        /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + dgzFile;
-                        std::system(cmd.c_str());
-                        isgz = true;
-
-                        if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                        {
-                            /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dzFile;
-#endif
-                            std::system(cmd.c_str());
-                        }
-                    }
-
-                    if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                    {
-                        /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + dzFile;
-                        std::system(cmd.c_str());
-                        isgz = false;
-                    }
+                    string remoteFile;
+                    FetchObs(url, dxFile, subDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsPbo2): failed to download PBO daily observation file " << oFile << endl;
-
-                        string url0 = url + '/' + dxFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo2): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::GetDailyObsPbo2): successfully download PBO daily observation file " << oFile << endl;
 
-                        continue;
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo2): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsPbo2): successfully download PBO daily observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::GetDailyObsPbo2): failed to download PBO daily observation file " << oFile << endl;
 
-                        if (isgz) dxFile = dgzFile;
-                        else dxFile = dzFile;
                         string url0 = url + '/' + dxFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo2): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo2): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo2): PBO daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsPbo2 */
@@ -4701,23 +3066,8 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4728,158 +3078,67 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.Z' or '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
         string crxxFile = crxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the PBO observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsPbo3): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+                    string crxFile = FileName(NAME_OBMD15, sf);
                     string crxxFile = crxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    string crxgzFile = crxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    bool isgz = true;
-                    string crxzFile;
+                    string remoteFile;
+                    FetchObs(url, crxxFile, subDir, oFile, fopt, &remoteFile);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        /* extract '*.Z' */
-                        crxzFile = crxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
-
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        isgz = false;
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            cout << "*** WARNING(FtpUtil::GetDailyObsPbo3): failed to download PBO daily observation file " << oFile << endl;
-
-                            string url0 = url + '/' + crxxFile;
-                            if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo3): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        cout << "*** INFO(FtpUtil::GetDailyObsPbo3): successfully download PBO daily observation file " << oFile << endl;
 
-                            continue;
-                        }
+                        string url0 = url + '/' + remoteFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo3): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsPbo3): successfully download PBO daily observation file " << oFile << endl;
+                        cout << "*** WARNING(FtpUtil::GetDailyObsPbo3): failed to download PBO daily observation file " << oFile << endl;
 
-                        if (isgz) crxxFile = crxgzFile;
-                        else crxxFile = crxzFile;
                         string url0 = url + '/' + crxxFile;
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo3): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo3): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo3): PBO daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsPbo3 */
@@ -4902,23 +3161,8 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
     /* compute day of year */
     TimeUtil tu;
@@ -4929,246 +3173,94 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
-        string cutDirs = " --cut-dirs=5 ";
         /* it is OK for '*.Z' or '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
         string crxxFile = crxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        string suffix = ".crx";
-        vector<string> crxFiles;
-        str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        FetchObs(url, crxxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
         
         /* to download the observation files with short name "d" */
         url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
         /* it is OK for '*.Z' or '*.gz' format */
         string dFile = "*" + sDoy + "0." + sYy + "d";
         string dxFile = dFile + ".*";
-        cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        suffix = "." + sYy + "d";
-        vector<string> dFiles;
-        str.GetFilesAll(subDir, suffix, dFiles);
-        for (int i = 0; i < dFiles.size(); i++)
+        FetchObs(url, dxFile, subDir, [&](const string &remoteFile)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                if (access(oFile.c_str(), 0) == 0)
-                {
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    continue;
-                }
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+            /* the name of 'o' file, i.e., the first four characters (site name) of the remote file */
+            char sitName[MAXCHARS];
+            str.StrMid(sitName, remoteFile.c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
-        }
+            return site + sDoy + "0." + sYy + "o";
+        }, fopt, nullptr);
     }
     else  /* the option of full path of site list file is selected */
     {
         /* download the PBO observation file site-by-site */
-        if (access(fopt->obsLst, 0) == 0)
+        if (!fopt->obsSites.empty())
         {
-            ifstream sitLst(fopt->obsLst);
-            if (!sitLst.is_open())
+            const std::vector<site_t> &sites = fopt->obsSites;
+            RunJobs((int)sites.size(), fopt, [&](int k)
             {
-                cerr << "*** ERROR(FtpUtil::GetDailyObsPbo5): open site.list = " << fopt->obsLst << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
-            {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
-                str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                TemplateUtil::fields_t sf = tf;
+                sf.site = &sites[k];
+                string oFile = FileName(NAME_OBSD_O, sf);
+                string dFile = FileName(NAME_OBSD_D, sf);
+                if (!_manifest.Exists(str.FullPath(subDir, oFile)) && !_manifest.Exists(str.FullPath(subDir, dFile)))
                 {
                     string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
-                    string cutDirs = " --cut-dirs=5 ";
                     /* it is OK for '*.Z' or '*.gz' format */
-                    str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+                    string crxFile = FileName(NAME_OBMD15, sf);
                     string crxxFile = crxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    /* extract '*.gz' */
-                    string crxgzFile = crxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    string remoteFile;
+                    string dxFile = dFile + ".*";
+                    if (FetchObs(url, crxxFile, subDir, oFile, fopt, &remoteFile) <= 0)
+                    {
+                        /* to download the observation files with short name "d" */
+                        url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
+                        /* it is OK for '*.Z' or '*.gz' format */
+                        FetchObs(url, dxFile, subDir, oFile, fopt, &remoteFile);
+                    }
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, oFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (_manifest.Exists(str.FullPath(subDir, oFile)))
                     {
-                        /* extract '*.Z' */
-                        string crxzFile = crxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
-
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            /* to download the observation files with short name "d" */
-                            url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
-                            /* it is OK for '*.Z' or '*.gz' format */
-                            string dxFile = dFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
-
-                            string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                            if (access(dgzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.gz' */
-                                cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
-
-                                if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
-                                {
-                                    /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                                    cmd = "del " + dzFile;
-#else           /* for Linux or Mac */
-                                    cmd = "rm -rf " + dzFile;
-#endif
-                                    std::system(cmd.c_str());
-                                }
-                            }
-                            if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
-                            {
-                                /* extract '*.Z' */
-                                cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
-                            }
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                cout << "*** WARNING(FtpUtil::GetDailyObsPbo5): failed to download PBO daily observation file " << oFile << endl;
+                        cout << "*** INFO(FtpUtil::GetDailyObsPbo5): successfully download PBO daily observation file " << oFile << endl;
 
-                                string url0 = url + '/' + crxxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo5): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
-                                url0 = url + '/' + dxFile;
-                                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo5): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        string url0 = url + '/' + remoteFile;
 
-                                continue;
-                            }
-                        }
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo5): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
                     }
-
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (access(oFile.c_str(), 0) == 0)
+                    else
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsPbo5): successfully download PBO daily observation file " << oFile << endl;
-
-                        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsPbo5): %s  ->  %s  OK\n", oFile.c_str(), localFile.c_str());
+                        cout << "*** WARNING(FtpUtil::GetDailyObsPbo5): failed to download PBO daily observation file " << oFile << endl;
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                        string url0 = url + '/' + crxxFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo5): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+                        url0 = url + '/' + dxFile;
+                        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo5): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo5): PBO daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
-
-            /* close 'site.list' */
-            sitLst.close();
+            });
         }
     }
 } /* end of GetDailyObsPbo5 */
@@ -5193,6 +3285,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
@@ -5213,23 +3306,8 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
-        {
-            /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subDir;
-#endif
-            std::system(cmd.c_str());
-        }
-
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-#endif
+        /* If the directory does not exist, creat it */
+        FileUtil::MakeDir(subDir);
 
         string navFile, nav0File;
         if (navSys == "gps")
@@ -5257,29 +3335,15 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             nav0File = "brd4" + sDoy + "0." + sYy + "p";
         }
 
-        if (access(navFile.c_str(), 0) == -1 && access(nav0File.c_str(), 0) == -1)
+        if (access(str.FullPath(subDir, navFile).c_str(), 0) == -1 && access(str.FullPath(subDir, nav0File).c_str(), 0) == -1)
         {
-            string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-            string url, cutDirs = " --cut-dirs=6 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_NAV] + "/" +
-                sYyyy + "/brdc";
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_NAV] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=5 ";
-            }
-            else if (ftpName == "WHU")
+            string url = ArchiveUrl(ftpName, IDX_NAV, tf);
+            if (ftpName == "WHU" && yyyy < 2020)  /* the files of WHU are in the directories of the day before 2020 */
             {
-                if (yyyy >= 2020) url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/brdc";
-                else
-                {
-                    if (navSys == "gps") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "n";
-                    else if (navSys == "glo") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "g";
-                    if (navSys == "mixed3") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "p";
-                }
-                cutDirs = " --cut-dirs=7 ";
+                if (navSys == "gps") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "n";
+                else if (navSys == "glo") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "g";
+                if (navSys == "mixed3") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "p";
             }
-            else url = _ftpArchive.CDDIS[IDX_NAV] + "/" + sYyyy + "/brdc";
 
             if (navSys == "mixed3")
             {
@@ -5305,45 +3369,40 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 else if (navAc == "GOP")
                 {
                     url = "ftp://ftp.pecny.cz/LDC/orbits_brd/gop3/" + sYyyy;
-                    cutDirs = " --cut-dirs=4 ";
                 }
                 else if (navAc == "WRD")
                 {
                     url = "https://igs.bkg.bund.de/root_ftp/IGS/BRDC/" + sYyyy + "/" + sDoy;
-                    cutDirs = " --cut-dirs=5 ";
                 }
             }
 
             /* it is OK for '*.Z' or '*.gz' format */
-            string cmd, url0, navxFile;
+            string url0, navxFile;
             if (navAc == "WRD")
             {
                 string navgzFile = navFile + ".gz";
                 url0 = url + "/" + navgzFile;
-                cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
+                FetchFiles(url0, "", subDir, fopt);
             }
             else
             {
                 navxFile = navFile + ".*";
-                cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
+                FetchFiles(url, navxFile, subDir, fopt);
                 url0 = url + "/" + navxFile;
             }
-            std::system(cmd.c_str());
 
             string navgzFile = navFile + ".gz", navzFile = navFile + ".Z";
             bool isgz = false;
-            if (access(navgzFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, navgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + navgzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, navgzFile));
                 isgz = true;
             }
-            else if (access(navzFile.c_str(), 0) == 0)
+            else if (access(str.FullPath(subDir, navzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + navzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, navzFile));
                 isgz = false;
             }
 
@@ -5351,7 +3410,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, nav0File.c_str());
             string localFile = tmpFile;
-            if (access(navFile.c_str(), 0) == -1)
+            if (access(str.FullPath(subDir, navFile).c_str(), 0) == -1)
             {
                 cout << "*** INFO(FtpUtil::GetNav): failed to download broadcast ephemeris file " << nav0File << endl;
 
@@ -5360,32 +3419,20 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             if (navSys == "mixed3" || navSys == "mixed4")
             {
-                string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
-#else          /* for Linux or Mac */
-                changeFileName = "mv";
-#endif
-                cmd = changeFileName + " " + navFile + " " + nav0File;
-                std::system(cmd.c_str());
+                FileUtil::Rename(str.FullPath(subDir, navFile), str.FullPath(subDir, nav0File));
             }
 
             if (navAc == "GOP")
             {
                 /* delete some temporary directories */
                 string tmpDir = "log";
-                if (access(tmpDir.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, tmpDir).c_str(), 0) == 0)
                 {
-#ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
+                    FileUtil::Remove(str.FullPath(subDir, tmpDir));
                 }
             }
 
-            if (access(nav0File.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, nav0File).c_str(), 0) == 0)
             {
                 cout << "*** INFO(FtpUtil::GetNav): successfully download broadcast ephemeris file " << nav0File << endl;
 
@@ -5405,59 +3452,27 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
-        {
-            /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        /* If the directory does not exist, creat it */
+        FileUtil::MakeDir(subDir);
 
-        string sitFile = fopt->navLst;
         /* download the broadcast ephemeris file site-by-site */
-        if (access(sitFile.c_str(), 0) == 0)
+        if (!fopt->navSites.empty())
         {
-            ifstream sitLst(sitFile.c_str());
-            if (!sitLst.is_open())
-            {
-                cerr << "*** ERROR(FtpUtil::GetHourlyObsMgex): open site.list = " << sitFile << " file failed, please check it" << endl;
-
-                return;
-            }
-
-            string sitName;
-            while (getline(sitLst, sitName))
+            for (size_t k = 0; k < fopt->navSites.size(); k++)
             {
-                if (sitName[0] == '#') continue;
-                str.TrimSpace4String(sitName);
-                if (sitName.size() != 4) continue;
+                const site_t &site = fopt->navSites[k];
+                string sitName = site.name;
                 for (int i = 0; i < fopt->hhNav.size(); i++)
                 {
                     string sHh = str.hh2str(fopt->hhNav[i]);
+                    TemplateUtil::fields_t hf = tf;
+                    hf.hh = fopt->hhNav[i];
                     char tmpDir[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
-                    {
-                        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                        string cmd = "mkdir " + sHhDir;
-#else           /* for Linux or Mac */
-                        string cmd = "mkdir -p " + sHhDir;
-#endif
-                        std::system(cmd.c_str());
-                    }
-
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* If the directory does not exist, creat it */
+                    FileUtil::MakeDir(sHhDir);
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhNav[i] + 97;
@@ -5469,13 +3484,14 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     string navgsFile = sitName + sDoy + sch + "." + sYy + "g";
                     
                     str.ToUpper(sitName);
-                    string navnlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_GN.rnx";  /* long file name */
-                    string navglFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_RN.rnx";
-                    string navclFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_CN.rnx";
-                    string navelFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_EN.rnx";
-                    string navjlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_JN.rnx";
-                    string navilFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_IN.rnx";
-                    string navmlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_MN.rnx";
+                    string prefix = site.longName.empty() ? sitName + "*_R_" : site.longName + "_R_";
+                    string navnlFile = prefix + sYyyy + sDoy + sHh + "00_01H_GN.rnx";  /* long file name */
+                    string navglFile = prefix + sYyyy + sDoy + sHh + "00_01H_RN.rnx";
+                    string navclFile = prefix + sYyyy + sDoy + sHh + "00_01H_CN.rnx";
+                    string navelFile = prefix + sYyyy + sDoy + sHh + "00_01H_EN.rnx";
+                    string navjlFile = prefix + sYyyy + sDoy + sHh + "00_01H_JN.rnx";
+                    string navilFile = prefix + sYyyy + sDoy + sHh + "00_01H_IN.rnx";
+                    string navmlFile = prefix + sYyyy + sDoy + sHh + "00_01H_MN.rnx";
                     std::vector<string> navFiles;
                     if (navSys == "gps")
                     {
@@ -5546,53 +3562,31 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     
                     for (int i = 0; i < navFiles.size(); i++)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
-                        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
-                        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" + 
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                        string url = ArchiveUrl(ftpName, IDX_OBMH, hf);
 
                         /* it is OK for '*.Z' or '*.gz' format */
-                        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                         string navxFile = navFiles[i] + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        FetchFiles(url, navxFile, sHhDir, fopt);
 
                         /* extract '*.gz' */
                         string navgzFile = navFiles[i] + ".gz";
-                        cmd = gzipFull + " -d -f " + navgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
-#else          /* for Linux or Mac */
-                        changeFileName = "mv";
-#endif
-                        cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(sHhDir, navgzFile));
+                        FileUtil::Rename(str.FullPath(sHhDir, navFiles[i]), str.FullPath(sHhDir, nav0Files[i]));
                         bool isgz = true;
                         string navzFile;
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", sHhDir.c_str(), sep, nav0Files[i].c_str());
                         string localFile = tmpFile;
-                        if (access(nav0Files[i].c_str(), 0) == -1)
+                        if (access(str.FullPath(sHhDir, nav0Files[i]).c_str(), 0) == -1)
                         {
                             /* extract '*.Z' */
                             navzFile = navFiles[i] + ".Z";
-                            cmd = gzipFull + " -d -f " + navzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(sHhDir, navzFile));
 
-                            cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
-                            std::system(cmd.c_str());
+                            FileUtil::Rename(str.FullPath(sHhDir, navFiles[i]), str.FullPath(sHhDir, nav0Files[i]));
                             isgz = false;
-                            if (access(nav0Files[i].c_str(), 0) == 0)
+                            if (access(str.FullPath(sHhDir, nav0Files[i]).c_str(), 0) == 0)
                             {
                                 cout << "*** INFO(FtpUtil::GetNav): successfully download hourly broadcast ephemeris file " <<
                                     navFiles[i] << endl;
@@ -5628,9 +3622,6 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     }
                 }
             }
-
-            /* close 'site.list' */
-            sitLst.close();
         }
     }
 } /* end of GetNav */
@@ -5660,10 +3651,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
     string sYyyy = str.yyyy2str(yyyy);
     string sDoy = str.doy2str(doy);
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     str.TrimSpace4String(ac);
     str.ToLower(ac);
     if (prodType == PROD_REALTIME)          /* for CNES real-time orbit and clock products from CNES offline files  */
@@ -5674,28 +3665,21 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         std::vector<string> sp3clkgzFiles = { sp3gzFile, clkgzFile };
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(dirs[i].c_str());
-#else           /* for Linux or Mac */
-            chdir(dirs[i].c_str());
-#endif
-
-            if (access(sp3clkFiles[i].c_str(), 0) == -1)
+            /* the files are republished under the same name during the day */
+            bool refetch = Refresh(str.FullPath(dirs[i], sp3clkFiles[i]), fopt);
+            if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == -1)
             {
                 string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3clkgzFiles[i];
-                string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, "", dirs[i], fopt);
 
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(dirs[i], sp3clkgzFiles[i]));
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dirs[i].c_str(), sep, sp3clkFiles[i].c_str());
                 string localFile = tmpFile;
-                if (access(sp3clkFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == 0)
                 {
                     if (i == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download CNES real-time precise orbit file " <<
                         sp3clkFiles[i] << endl;
@@ -5717,16 +3701,11 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 
                 /* delete some temporary directories */
                 std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
-                for (int i = 0; i < tmpDir.size(); i++)
+                for (int j = 0; j < tmpDir.size(); j++)
                 {
-                    if (access(tmpDir[i].c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[i], tmpDir[j]).c_str(), 0) == 0)
                     {
-#ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir[i];
-#else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir[i];
-#endif
-                        std::system(cmd.c_str());
+                        FileUtil::Remove(str.FullPath(dirs[i], tmpDir[j]));
                     }
                 }
             }
@@ -5737,23 +3716,16 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 else if (i == 1) cout << "*** INFO(FtpUtil::GetOrbClk): CNES real-time precise clock file " << sp3clkFiles[i] <<
                     " has existed!" << endl;
             }
+            if (refetch) Settle(str.FullPath(dirs[i], sp3clkFiles[i]));
         }
     }
     else if (prodType == PROD_ULTRA_RAPID)  /* for ultra-rapid orbit and clock products  */
     {
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(dirs[0].c_str());
-#else           /* for Linux or Mac */
-        chdir(dirs[0].c_str());
-#endif
-
-        string url, cutDirs, acName, acFile;
+        string url, acName, acFile;
         int idx = 0;
         if (ac == "esa_u")       /* ESA */
         {
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acFile = "esu";
             acName = "ESA";
             idx = 0;
@@ -5761,29 +3733,20 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         else if (ac == "gfz_u")  /* GFZ */
         {
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acFile = "gfu";
             acName = "GFZ";
             idx = 1;
         }
         else if (ac == "igs_u")  /* IGS */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
+            url = ArchiveUrl(ftpName, IDX_SP3, tf);
             acFile = "igu";
             acName = "IGS";
             idx = 2;
         }
         else if (ac == "whu_u")  /* WHU */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
+            url = ArchiveUrl(ftpName, IDX_SP3M, tf);
             acName = "WHU";
             acFile = "wuu";
             idx = 3;
@@ -5793,36 +3756,33 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         {
             string sHh = str.hh2str(fopt->hhOrbClk[idx][i]);
             string sp3File = acFile + sWwww + sDow + "_" + sHh + ".sp3";
-            if (access(sp3File.c_str(), 0) == -1)
+            bool refetch = Refresh(str.FullPath(dirs[0], sp3File), fopt);
+            if (access(str.FullPath(dirs[0], sp3File).c_str(), 0) == -1)
             {
-                string cmd, url0, sp3zFile, sp3gzFile, sp3xFile;
+                string url0, sp3zFile, sp3gzFile, sp3xFile;
                 bool isgz = false;
                 if (ac == "esa_u")  /* ESA */
                 {
                     sp3zFile = sp3File + ".Z";
                     url0 = url + "/" + sp3zFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    FetchFiles(url0, "", dirs[0], fopt);
 
-                    if (access(sp3zFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[0], sp3zFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[0], sp3zFile));
                         isgz = false;
                     }
                     else
                     {
                         sp3gzFile = sp3File + ".gz";
                         url0 = url + "/" + sp3gzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        FetchFiles(url0, "", dirs[0], fopt);
 
-                        if (access(sp3gzFile.c_str(), 0) == 0)
+                        if (access(str.FullPath(dirs[0], sp3gzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + sp3gzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(dirs[0], sp3gzFile));
                             isgz = true;
                         }
                     }
@@ -5832,31 +3792,20 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     string sp30File = "WUM0MGXULA_" + sYyyy + sDoy + sHh + "00_01D_*_ORB.SP3";
                     /* it is OK for '*.Z' or '*.gz' format */
                     sp3xFile = sp30File + ".*";
-                    cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, sp3xFile, dirs[0], fopt);
 
                     /* extract '*.gz' */
                     sp3gzFile = sp30File + ".gz";
-                    cmd = gzipFull + " -d -f " + sp3gzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + sp30File + " " + sp3File;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dirs[0], sp3gzFile));
+                    FileUtil::Rename(str.FullPath(dirs[0], sp30File), str.FullPath(dirs[0], sp3File));
                     isgz = true;
-                    if (access(sp3File.c_str(), 0) == -1)
+                    if (access(str.FullPath(dirs[0], sp3File).c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         sp3zFile = sp30File + ".Z";
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[0], sp3zFile));
 
-                        cmd = changeFileName + " " + sp30File + " " + sp3File;
-                        std::system(cmd.c_str());
+                        FileUtil::Rename(str.FullPath(dirs[0], sp30File), str.FullPath(dirs[0], sp3File));
                         isgz = false;
                     }
 
@@ -5866,23 +3815,20 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     sp3xFile = sp3File + ".*";
-                    cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, sp3xFile, dirs[0], fopt);
 
                     sp3gzFile = sp3File + ".gz";
                     sp3zFile = sp3File + ".Z";
-                    if (access(sp3gzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[0], sp3gzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + sp3gzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[0], sp3gzFile));
                         isgz = true;
                     }
-                    if (access(sp3File.c_str(), 0) == -1 && access(sp3zFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[0], sp3File).c_str(), 0) == -1 && access(str.FullPath(dirs[0], sp3zFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[0], sp3zFile));
                         isgz = false;
                     }
 
@@ -5893,7 +3839,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dirs[0].c_str(), sep, sp3File.c_str());
                 string localFile = tmpFile;
-                if (access(sp3File.c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[0], sp3File).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " ultra-rapid precise orbit file " <<
                         sp3File << endl;
@@ -5915,31 +3861,26 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 {
                     /* delete some temporary directories */
                     string tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[0], tmpDir).c_str(), 0) == 0)
                     {
-#ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
-#endif
-                        std::system(cmd.c_str());
+                        FileUtil::Remove(str.FullPath(dirs[0], tmpDir));
                     }
                 }
             }
             else cout << "*** INFO(FtpUtil::GetOrbClk): " << acName << " ultra-rapid precise orbit file " << sp3File <<
                 " has existed!" << endl;
+            if (refetch) Settle(str.FullPath(dirs[0], sp3File));
         }
     }
     else if (prodType == PROD_RAPID)  /* for rapid orbit and clock products  */
     {
-        string url, cutDirs, acName;
+        string url, acName;
         string sp3File, clkFile;
         if (ac == "cod_r")  /* CODE */
         {
             sp3File = "COD" + sWwww + sDow + ".EPH_M";
             clkFile = "COD" + sWwww + sDow + ".CLK_M";
             url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy + "_M";
-            cutDirs = " --cut-dirs=2 ";
             acName = "CODE";
         }
         else if (ac == "emr_r")  /* NRCan */
@@ -5947,7 +3888,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             sp3File = "emr" + sWwww + sDow + ".sp3";
             clkFile = "emr" + sWwww + sDow + ".clk";
             url = "ftp://rtopsdata1.geod.nrcan.gc.ca/gps/products/rapid/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
             acName = "NRCan";
         }
         else if (ac == "esa_r")  /* ESA */
@@ -5955,7 +3895,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             sp3File = "esr" + sWwww + sDow + ".sp3";
             clkFile = "esr" + sWwww + sDow + ".clk";
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acName = "ESA";
         }
         else if (ac == "gfz_r")  /* GFZ */
@@ -5963,18 +3902,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             sp3File = "gfz" + sWwww + sDow + ".sp3";
             clkFile = "gfz" + sWwww + sDow + ".clk";
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/rapid/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acName = "GFZ";
         }
         else if (ac == "igs_r")  /* IGS */
         {
             sp3File = "igr" + sWwww + sDow + ".sp3";
             clkFile = "igr" + sWwww + sDow + ".clk";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
+            url = ArchiveUrl(ftpName, IDX_SP3, tf);
             acName = "IGS";
         }
 
@@ -5987,41 +3921,30 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         std::vector<string> sp3clkxFiles = { sp3xFile, clkxFile };
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(dirs[i].c_str());
-#else           /* for Linux or Mac */
-            chdir(dirs[i].c_str());
-#endif
-
-            if (access(sp3clkFiles[i].c_str(), 0) == -1)
+            if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == -1)
             {
-                string cmd, url0;
+                string url0;
                 bool isgz = false;
                 if (ac == "esa_r")  /* ESA */
                 {
                     url0 = url + "/" + sp3clkzFiles[i];
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    FetchFiles(url0, "", dirs[i], fopt);
 
-                    if (access(sp3zFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[i], sp3zFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[i], sp3clkzFiles[i]));
                         isgz = false;
                     }
                     else
                     {
                         url0 = url + "/" + sp3clkgzFiles[i];
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        FetchFiles(url0, "", dirs[i], fopt);
 
-                        if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
+                        if (access(str.FullPath(dirs[i], sp3clkgzFiles[i]).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(dirs[i], sp3clkgzFiles[i]));
                             isgz = true;
                         }
                     }
@@ -6029,32 +3952,24 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 else
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
-                    cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, sp3clkxFiles[i], dirs[i], fopt);
 
-                    if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[i], sp3clkgzFiles[i]).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[i], sp3clkgzFiles[i]));
                         isgz = true;
 
-                        if (access(sp3clkFiles[i].c_str(), 0) == 0 && access(sp3clkzFiles[i].c_str(), 0) == 0)
+                        if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == 0 && access(str.FullPath(dirs[i], sp3clkzFiles[i]).c_str(), 0) == 0)
                         {
                             /* delete '*.Z' file */
-#ifdef _WIN32   /* for Windows */
-                            cmd = "del " + sp3clkzFiles[i];
-#else           /* for Linux or Mac */
-                            cmd = "rm -rf " + sp3clkzFiles[i];
-#endif
-                            std::system(cmd.c_str());
+                            FileUtil::Remove(str.FullPath(dirs[i], sp3clkzFiles[i]));
                         }
                     }
-                    if (access(sp3clkFiles[i].c_str(), 0) == -1 && access(sp3clkzFiles[i].c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == -1 && access(str.FullPath(dirs[i], sp3clkzFiles[i]).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dirs[i], sp3clkzFiles[i]));
                         isgz = false;
                     }
 
@@ -6065,7 +3980,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dirs[i].c_str(), sep, sp3clkFiles[i].c_str());
                 string localFile = tmpFile;
-                if (access(sp3clkFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == 0)
                 {
                     if (i == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " rapid precise orbit file " <<
                         sp3clkFiles[i] << endl;
@@ -6094,14 +4009,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     string tmpDir;
                     if (ac == "emr_r") tmpDir = "dcm";
                     else if (ac == "igs_r") tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(str.FullPath(dirs[i], tmpDir).c_str(), 0) == 0)
                     {
-#ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
-#endif
-                        std::system(cmd.c_str());
+                        FileUtil::Remove(str.FullPath(dirs[i], tmpDir));
                     }
                 }
             }
@@ -6146,39 +4056,25 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         string sp3xFile = sp3File + ".*", clkxFile = clkFile + ".*";
         std::vector<string> sp3clkxFiles = { sp3xFile, clkxFile };
 
-        string url, cutDirs = " --cut-dirs=4 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
+        string url = ArchiveUrl(ftpName, IDX_SP3, tf);
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(dirs[i].c_str());
-#else           /* for Linux or Mac */
-            chdir(dirs[i].c_str());
-#endif
-
-            if (access(sp3clkFiles[i].c_str(), 0) == -1)
+            if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
-                string cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, sp3clkxFiles[i], dirs[i], fopt);
 
                 bool isgz = false;
-                if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clkgzFiles[i]).c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dirs[i], sp3clkgzFiles[i]));
                     isgz = true;
                 }
-                if (access(sp3clkFiles[i].c_str(), 0) == -1 && access(sp3clkzFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == -1 && access(str.FullPath(dirs[i], sp3clkzFiles[i]).c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dirs[i], sp3clkzFiles[i]));
                     isgz = false;
                 }
 
@@ -6186,7 +4082,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dirs[i].c_str(), sep, sp3clkFiles[i].c_str());
                 string localFile = tmpFile;
-                if (access(sp3clkFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clkFiles[i]).c_str(), 0) == 0)
                 {
                     if (i == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " final precise orbit file " <<
                         sp3clkFiles[i] << endl;
@@ -6212,14 +4108,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 
                 /* delete some temporary directories */
                 string tmpDir = "repro3";
-                if (access(tmpDir.c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], tmpDir).c_str(), 0) == 0)
                 {
-#ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
+                    FileUtil::Remove(str.FullPath(dirs[i], tmpDir));
                 }
             }
             else
@@ -6276,55 +4167,33 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         string sp3xFile = sp3File + ".*", clkxFile = clkFile + ".*";
         std::vector<string> sp3clkxFiles = { sp3xFile, clkxFile };
 
-        string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
+        string url = ArchiveUrl(ftpName, IDX_SP3M, tf);
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(dirs[i].c_str());
-#else           /* for Linux or Mac */
-            chdir(dirs[i].c_str());
-#endif
-
-            if (access(sp3clk0Files[i].c_str(), 0) == -1)
+            if (access(str.FullPath(dirs[i], sp3clk0Files[i]).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
-                string cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, sp3clkxFiles[i], dirs[i], fopt);
 
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                std::system(cmd.c_str());
-                string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
-#else          /* for Linux or Mac */
-                changeFileName = "mv";
-#endif
-                cmd = changeFileName + " " + sp3clkFiles[i] + " " + sp3clk0Files[i];
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(dirs[i], sp3clkgzFiles[i]));
+                FileUtil::Rename(str.FullPath(dirs[i], sp3clkFiles[i]), str.FullPath(dirs[i], sp3clk0Files[i]));
                 bool isgz = true;
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dirs[i].c_str(), sep, sp3clk0Files[i].c_str());
                 string localFile = tmpFile;
-                if (access(sp3clk0Files[i].c_str(), 0) == -1)
+                if (access(str.FullPath(dirs[i], sp3clk0Files[i]).c_str(), 0) == -1)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dirs[i], sp3clkzFiles[i]));
 
-                    cmd = changeFileName + " " + sp3clkFiles[i] + " " + sp3clk0Files[i];
-                    std::system(cmd.c_str());
+                    FileUtil::Rename(str.FullPath(dirs[i], sp3clkFiles[i]), str.FullPath(dirs[i], sp3clk0Files[i]));
 
                     isgz = false;
 
-                    if (access(sp3clk0Files[i].c_str(), 0) == -1)
+                    if (access(str.FullPath(dirs[i], sp3clk0Files[i]).c_str(), 0) == -1)
                     {
                         if (i == 0) cout << "*** WARNING(FtpUtil::GetOrbClk): failed to download " << acName << " MGEX final precise orbit file " <<
                             sp3clk0Files[i] << endl;
@@ -6336,7 +4205,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     }
                 }
 
-                if (access(sp3clk0Files[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dirs[i], sp3clk0Files[i]).c_str(), 0) == 0)
                 {
                     if (i == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " MGEX final precise orbit file " <<
                         sp3clk0Files[i] << endl;
@@ -6442,51 +4311,31 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     }
 
     /* If the directory does not exist, creat it */
-    if (access(subDir.c_str(), 0) == -1)
-    {
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isUltra)  /* for ultra-rapid EOP products  */
     {
-        string url, cutDirs, acName, acFile;
+        string url, acName, acFile;
         if (ac == "esa_u")       /* ESA */
         {
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acFile = "esu";
             acName = "ESA";
         }
         else if (ac == "gfz_u")  /* GFZ */
         {
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acFile = "gfu";
             acName = "GFZ";
         }
         else if (ac == "igs_u")  /* IGS */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
+            url = ArchiveUrl(ftpName, IDX_EOP, tf);
             acFile = "igu";
             acName = "IGS";
         }
@@ -6495,36 +4344,33 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         {
             string sHh = str.hh2str(fopt->hhEop[i]);
             string eopFile = acFile + sWwww + sDow + "_" + sHh + ".erp";
-            if (access(eopFile.c_str(), 0) == -1)
+            bool refetch = Refresh(str.FullPath(subDir, eopFile), fopt);
+            if (access(str.FullPath(subDir, eopFile).c_str(), 0) == -1)
             {
-                string cmd, url0, eopzFile, eopgzFile, eopxFile;
+                string url0, eopzFile, eopgzFile, eopxFile;
                 bool isgz = false;
                 if (ac == "esa_u")  /* ESA */
                 {
                     eopzFile = eopFile + ".Z";
                     url0 = url + "/" + eopzFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    FetchFiles(url0, "", subDir, fopt);
 
-                    if (access(eopzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(subDir, eopzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(subDir, eopzFile));
                         isgz = false;
                     }
                     else
                     {
                         eopgzFile = eopFile + ".gz";
                         url0 = url + "/" + eopgzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        FetchFiles(url0, "", subDir, fopt);
 
-                        if (access(eopgzFile.c_str(), 0) == 0)
+                        if (access(str.FullPath(subDir, eopgzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + eopgzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(subDir, eopgzFile));
                             isgz = true;
                         }
                     }
@@ -6533,23 +4379,20 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     eopxFile = eopFile + ".*";
-                    cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, eopxFile, subDir, fopt);
 
                     eopgzFile = eopFile + ".gz";
                     eopzFile = eopFile + ".Z";
-                    if (access(eopgzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(subDir, eopgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + eopgzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(subDir, eopgzFile));
                         isgz = true;
                     }
-                    if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(subDir, eopFile).c_str(), 0) == -1 && access(str.FullPath(subDir, eopzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(subDir, eopzFile));
                         isgz = false;
                     }
 
@@ -6560,7 +4403,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, eopFile.c_str());
                 string localFile = tmpFile;
-                if (access(eopFile.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, eopFile).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " ultra-rapid EOP file " << eopFile << endl;
 
@@ -6580,18 +4423,14 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* delete some temporary directories */
                     string tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(str.FullPath(subDir, tmpDir).c_str(), 0) == 0)
                     {
-#ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
-#endif
-                        std::system(cmd.c_str());
+                        FileUtil::Remove(str.FullPath(subDir, tmpDir));
                     }
                 }
             }
             else cout << "*** INFO(FtpUtil::GetEop): " << acName << " ultra-rapid EOP file " << eopFile << " has existed!" << endl;
+            if (refetch) Settle(str.FullPath(subDir, eopFile));
         }
     }
     else if (isIGS)  /* for IGS final EOP products  */
@@ -6607,34 +4446,27 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         else if (ac == "mit") acName = "MIT";
 
         string eopFile = ac + sWwww + "7.erp";
-        if (access(eopFile.c_str(), 0) == -1)
+        if (access(str.FullPath(subDir, eopFile).c_str(), 0) == -1)
         {
             /* download the EOP file */
-            string url, cutDirs = " --cut-dirs=4 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
+            string url = ArchiveUrl(ftpName, IDX_EOP, tf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string eopxFile = eopFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, eopxFile, subDir, fopt);
 
             string eopgzFile = eopFile + ".gz", eopzFile = eopFile + ".Z";
             bool isgz = false;
-            if (access(eopgzFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, eopgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + eopgzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, eopgzFile));
                 isgz = true;
             }
-            if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, eopFile).c_str(), 0) == -1 && access(str.FullPath(subDir, eopzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + eopzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, eopzFile));
                 isgz = false;
             }
 
@@ -6642,7 +4474,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, eopFile.c_str());
             string localFile = tmpFile;
-            if (access(eopFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, eopFile).c_str(), 0) == 0)
             {
                 cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " final EOP file " << eopFile << endl;
 
@@ -6661,14 +4493,9 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* delete some temporary directories */
             string tmpDir = "repro3";
-            if (access(tmpDir.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, tmpDir).c_str(), 0) == 0)
             {
-#ifdef _WIN32  /* for Windows */
-                cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                cmd = "rm -rf " + tmpDir;
-#endif
-                std::system(cmd.c_str());
+                FileUtil::Remove(str.FullPath(subDir, tmpDir));
             }
         }
         else cout << "*** INFO(FtpUtil::GetEop): " << acName << " final EOP file " << eopFile << " has existed!" << endl;
@@ -6745,47 +4572,30 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         subDir = tmpDir;
     }
 
-    if (access(subDir.c_str(), 0) == -1)
-    {
-        /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-        string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-        string cmd = "mkdir -p " + subDir;
-#endif
-        std::system(cmd.c_str());
-    }
-
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(subDir);
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isRt)  /* for CNES real-time ORBEX from CNES offline files  */
     {
         string obxFile = ac + sWwww + sDow + ".obx";
-        if (access(obxFile.c_str(), 0) == -1)
+        if (access(str.FullPath(subDir, obxFile).c_str(), 0) == -1)
         {
             string obxgzFile = obxFile + ".gz";
             string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + obxgzFile;
-            string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, "", subDir, fopt);
 
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + obxgzFile;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(subDir, obxgzFile));
 
             char tmpFile[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, obxFile.c_str());
             string localFile = tmpFile;
-            if (access(obxFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, obxFile).c_str(), 0) == 0)
             {
                 cout << "*** INFO(FtpUtil::GetObx): successfully download CNES real-time ORBEX file " << obxFile << endl;
 
@@ -6800,16 +4610,11 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* delete some temporary directories */
             std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
-            for (int i = 0; i < tmpDir.size(); i++)
+            for (int j = 0; j < tmpDir.size(); j++)
             {
-                if (access(tmpDir[i].c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, tmpDir[j]).c_str(), 0) == 0)
                 {
-#ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir[i];
-#else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir[i];
-#endif
-                    std::system(cmd.c_str());
+                    FileUtil::Remove(str.FullPath(subDir, tmpDir[j]));
                 }
             }
         }
@@ -6818,11 +4623,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     }
     else if (isMGEX)  /* for MGEX final ORBEX files  */
     {
-        string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBXM] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBXM] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + sWwww;
+        string url = ArchiveUrl(ftpName, IDX_OBXM, tf);
 
         if (ac == "all_m")
         {
@@ -6855,43 +4656,32 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     acName = "WHU";
                 }
 
-                if (access(obx0File.c_str(), 0) == -1)
+                if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string obxxFile = obxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + obxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, obxxFile, subDir, fopt);
 
                     /* extract '*.gz' */
                     string obxgzFile = obxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + obxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + obxFile + " " + obx0File;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(subDir, obxgzFile));
+                    FileUtil::Rename(str.FullPath(subDir, obxFile), str.FullPath(subDir, obx0File));
                     bool isgz = true;
                     string obxzFile;
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, obx0File.c_str());
                     string localFile = tmpFile;
-                    if (access(obx0File.c_str(), 0) == -1)
+                    if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         obxzFile = obxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + obxzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(subDir, obxzFile));
                         isgz = false;
 
-                        cmd = changeFileName + " " + obxFile + " " + obx0File;
-                        std::system(cmd.c_str());
+                        FileUtil::Rename(str.FullPath(subDir, obxFile), str.FullPath(subDir, obx0File));
 
-                        if (access(obx0File.c_str(), 0) == -1)
+                        if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
                         {
                             cout << "*** INFO(FtpUtil::GetObx): failed to download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
@@ -6900,7 +4690,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         }
                     }
 
-                    if (access(obx0File.c_str(), 0) == 0)
+                    if (access(str.FullPath(subDir, obx0File).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::GetObx): successfully download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
@@ -6941,43 +4731,32 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 acName = "WHU";
             }
 
-            if (access(obx0File.c_str(), 0) == -1)
+            if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string obxxFile = obxFile + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + obxxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, obxxFile, subDir, fopt);
 
                 /* extract '*.gz' */
                 string obxgzFile = obxFile + ".gz";
-                cmd = gzipFull + " -d -f " + obxgzFile;
-                std::system(cmd.c_str());
-                string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
-#else          /* for Linux or Mac */
-                changeFileName = "mv";
-#endif
-                cmd = changeFileName + " " + obxFile + " " + obx0File;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, obxgzFile));
+                FileUtil::Rename(str.FullPath(subDir, obxFile), str.FullPath(subDir, obx0File));
                 bool isgz = true;
                 string obxzFile;
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, obx0File.c_str());
                 string localFile = tmpFile;
-                if (access(obx0File.c_str(), 0) == -1)
+                if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
                 {
                     /* extract '*.Z' */
                     obxzFile = obxFile + ".Z";
-                    cmd = gzipFull + " -d -f " + obxzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(subDir, obxzFile));
                     isgz = false;
 
-                    cmd = changeFileName + " " + obxFile + " " + obx0File;
-                    std::system(cmd.c_str());
+                    FileUtil::Rename(str.FullPath(subDir, obxFile), str.FullPath(subDir, obx0File));
 
-                    if (access(obx0File.c_str(), 0) == -1)
+                    if (access(str.FullPath(subDir, obx0File).c_str(), 0) == -1)
                     {
                         cout << "*** INFO(FtpUtil::GetObx): failed to download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
@@ -6986,7 +4765,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     }
                 }
 
-                if (access(obx0File.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, obx0File).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetObx): successfully download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
@@ -7012,13 +4791,6 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute day of year */
     TimeUtil tu;
     int yyyy, doy;
@@ -7026,6 +4798,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     StringUtil str;
     string sYyyy = str.yyyy2str(yyyy);
     string sDoy = str.doy2str(doy);
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     string ac(fopt->dsbAc);
     str.TrimSpace4String(ac);
@@ -7042,42 +4815,26 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.TrimSpace4String(ftpName);
                 str.ToUpper(ftpName);
                 string dsbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_01D_DCB.BSX";
-                if (access(dsbFile.c_str(), 0) == -1)
+                if (access(str.FullPath(dir, dsbFile).c_str(), 0) == -1)
                 {
-                    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                    string url, cutDirs = " --cut-dirs=5 ";
-                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_DSBM] + "/" + sYyyy;
-                        cutDirs = " --cut-dirs=6 ";
-                    }
-                    else if (ftpName == "WHU")
-                    {
-                        url = _ftpArchive.WHU[IDX_DSBM] + "/" + sYyyy;
-                        cutDirs = " --cut-dirs=6 ";
-                    }
-                    else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                    string url = ArchiveUrl(ftpName, IDX_DSBM, tf);
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dsbxFile = dsbFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + dsbxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, dsbxFile, dir, fopt);
 
                     string dsbgzFile = dsbFile + ".gz", dsbzFile = dsbFile + ".Z";
                     bool isgz = false;
-                    if (access(dsbgzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dir, dsbgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + dsbgzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dir, dsbgzFile));
                         isgz = true;
                     }
-                    else if (access(dsbzFile.c_str(), 0) == 0)
+                    else if (access(str.FullPath(dir, dsbzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + dsbzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dir, dsbzFile));
                         isgz = false;
                     }
 
@@ -7085,7 +4842,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", dir, sep, dsbFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dsbFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dir, dsbFile).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::GetDsb): successfully download multi-GNSS DSB file " << dsbFile << endl;
 
@@ -7121,31 +4878,27 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     dcb0File = dcbType[i] + sYy + sMm + ".DCB";
                     if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + sYy + sMm + "_RINEX.DCB";
 
-                    if (access(dcbFile.c_str(), 0) == -1 && access(dcb0File.c_str(), 0) == -1)
+                    if (access(str.FullPath(dir, dcbFile).c_str(), 0) == -1 && access(str.FullPath(dir, dcb0File).c_str(), 0) == -1)
                     {
                         /* download CODE DCB file */
-                        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                         string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         string dcbxFile = dcbFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + " --cut-dirs=2 " + url;
-                        std::system(cmd.c_str());
+                        FetchFiles(url, dcbxFile, dir, fopt);
 
                         string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
                         bool isgz = false;
-                        if (access(dcbgzFile.c_str(), 0) == 0)
+                        if (access(str.FullPath(dir, dcbgzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + dcbgzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(dir, dcbgzFile));
                             isgz = true;
                         }
-                        else if (access(dcbzFile.c_str(), 0) == 0)
+                        else if (access(str.FullPath(dir, dcbzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
-                            cmd = gzipFull + " -d -f " + dcbzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(dir, dcbzFile));
                             isgz = false;
                         }
 
@@ -7153,7 +4906,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", dir, sep, dcbFile.c_str());
                         string localFile = tmpFile;
-                        if (access(dcbFile.c_str(), 0) == -1)
+                        if (access(str.FullPath(dir, dcbFile).c_str(), 0) == -1)
                         {
                             cout << "*** INFO(FtpUtil::GetDsb): failed to download CODE DCB file " << dcbFile << endl;
 
@@ -7163,17 +4916,10 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
                         if (dcbType[i] == "P2C2")
                         {
-                            string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
-#else          /* for Linux or Mac */
-                            changeFileName = "mv";
-#endif
-                            cmd = changeFileName + " " + dcbFile + " " + dcb0File;
-                            std::system(cmd.c_str());
+                            FileUtil::Rename(str.FullPath(dir, dcbFile), str.FullPath(dir, dcb0File));
                         }
 
-                        if (access(dcb0File.c_str(), 0) == 0)
+                        if (access(str.FullPath(dir, dcb0File).c_str(), 0) == 0)
                         {
                             cout << "*** INFO(FtpUtil::GetDsb): successfully download CODE DCB file " << dcb0File << endl;
 
@@ -7196,42 +4942,26 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.TrimSpace4String(ftpName);
             str.ToUpper(ftpName);
             string dsbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_01D_DCB.BSX";
-            if (access(dsbFile.c_str(), 0) == -1)
+            if (access(str.FullPath(dir, dsbFile).c_str(), 0) == -1)
             {
-                string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                string url, cutDirs = " --cut-dirs=5 ";
-                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
-                else if (ftpName == "IGN")
-                {
-                    url = _ftpArchive.IGN[IDX_DSBM] + "/" + sYyyy;
-                    cutDirs = " --cut-dirs=6 ";
-                }
-                else if (ftpName == "WHU")
-                {
-                    url = _ftpArchive.WHU[IDX_DSBM] + "/" + sYyyy;
-                    cutDirs = " --cut-dirs=6 ";
-                }
-                else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                string url = ArchiveUrl(ftpName, IDX_DSBM, tf);
 
                 /* it is OK for '*.Z' or '*.gz' format */
                 string dsbxFile = dsbFile + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + dsbxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, dsbxFile, dir, fopt);
 
                 string dsbgzFile = dsbFile + ".gz", dsbzFile = dsbFile + ".Z";
                 bool isgz = false;
-                if (access(dsbgzFile.c_str(), 0) == 0)
+                if (access(str.FullPath(dir, dsbgzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + dsbgzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dir, dsbgzFile));
                     isgz = true;
                 }
-                else if (access(dsbzFile.c_str(), 0) == 0)
+                else if (access(str.FullPath(dir, dsbzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + dsbzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dir, dsbzFile));
                     isgz = false;
                 }
 
@@ -7239,7 +4969,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dir, sep, dsbFile.c_str());
                 string localFile = tmpFile;
-                if (access(dsbFile.c_str(), 0) == 0)
+                if (access(str.FullPath(dir, dsbFile).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetDsb): successfully download multi-GNSS DSB file " << dsbFile << endl;
 
@@ -7275,31 +5005,27 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 dcb0File = dcbType[i] + sYy + sMm + ".DCB";
                 if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + sYy + sMm + "_RINEX.DCB";
 
-                if (access(dcbFile.c_str(), 0) == -1 && access(dcb0File.c_str(), 0) == -1)
+                if (access(str.FullPath(dir, dcbFile).c_str(), 0) == -1 && access(str.FullPath(dir, dcb0File).c_str(), 0) == -1)
                 {
                     /* download CODE DCB file */
-                    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                     string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dcbxFile = dcbFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + " --cut-dirs=2 " + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, dcbxFile, dir, fopt);
 
                     string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
                     bool isgz = false;
-                    if (access(dcbgzFile.c_str(), 0) == 0)
+                    if (access(str.FullPath(dir, dcbgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + dcbgzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dir, dcbgzFile));
                         isgz = true;
                     }
-                    else if (access(dcbzFile.c_str(), 0) == 0)
+                    else if (access(str.FullPath(dir, dcbzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + dcbzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dir, dcbzFile));
                         isgz = false;
                     }
 
@@ -7307,7 +5033,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", dir, sep, dcbFile.c_str());
                     string localFile = tmpFile;
-                    if (access(dcbFile.c_str(), 0) == -1)
+                    if (access(str.FullPath(dir, dcbFile).c_str(), 0) == -1)
                     {
                         cout << "*** INFO(FtpUtil::GetDsb): failed to download CODE DCB file " << dcbFile << endl;
 
@@ -7317,17 +5043,10 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
                     if (dcbType[i] == "P2C2")
                     {
-                        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
-#else          /* for Linux or Mac */
-                        changeFileName = "mv";
-#endif
-                        cmd = changeFileName + " " + dcbFile + " " + dcb0File;
-                        std::system(cmd.c_str());
+                        FileUtil::Rename(str.FullPath(dir, dcbFile), str.FullPath(dir, dcb0File));
                     }
 
-                    if (access(dcb0File.c_str(), 0) == 0)
+                    if (access(str.FullPath(dir, dcb0File).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::GetDsb): successfully download CODE DCB file " << dcb0File << endl;
 
@@ -7354,13 +5073,6 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute GPS week and day of week */
     TimeUtil tu;
     int wwww, dow;
@@ -7405,29 +5117,27 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         return;
     }
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isRt)  /* for CNES real-time OSB from CNES offline files  */
     {
         string osbFile = ac + sWwww + sDow + ".bia";
-        if (access(osbFile.c_str(), 0) == -1)
+        if (access(str.FullPath(dir, osbFile).c_str(), 0) == -1)
         {
             string osbgzFile = osbFile + ".gz";
             string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + osbgzFile;
-            string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, "", dir, fopt);
 
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + osbgzFile;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(dir, osbgzFile));
 
             char tmpFile[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
             sprintf(tmpFile, "%s%c%s", dir, sep, osbFile.c_str());
             string localFile = tmpFile;
-            if (access(osbFile.c_str(), 0) == 0)
+            if (access(str.FullPath(dir, osbFile).c_str(), 0) == 0)
             {
                 cout << "*** INFO(FtpUtil::GetOsb): successfully download CNES real-time OSB file " << osbFile << endl;
 
@@ -7442,16 +5152,11 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* delete some temporary directories */
             std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
-            for (int i = 0; i < tmpDir.size(); i++)
+            for (int j = 0; j < tmpDir.size(); j++)
             {
-                if (access(tmpDir[i].c_str(), 0) == 0)
+                if (access(str.FullPath(dir, tmpDir[j]).c_str(), 0) == 0)
                 {
-#ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir[i];
-#else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir[i];
-#endif
-                    std::system(cmd.c_str());
+                    FileUtil::Remove(str.FullPath(dir, tmpDir[j]));
                 }
             }
         }
@@ -7460,11 +5165,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     }
     else if (isMGEX)  /* for MGEX final OSB files  */
     {
-        string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OSBM] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OSBM] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + sWwww;
+        string url = ArchiveUrl(ftpName, IDX_OSBM, tf);
 
         if (ac == "all_m")
         {
@@ -7503,54 +5204,40 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     acName = "WHU";
                 }
 
-                if (access(osb0File.c_str(), 0) == -1)
+                if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string osbxFile = osbFile + ".*";
-                    string cmd;
                     if (ac_m == "cas_m")
                     {
                         string url0 = "ftp://ftp.gipp.org.cn/product/dcb/mgex/" + sYyyy;
-                        string cutDirs0 = " --cut-dirs=4 ";
-                        cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs0 + url0;
-                        std::system(cmd.c_str());
+                        FetchFiles(url0, osbxFile, dir, fopt);
                     }
                     else
                     {
-                        cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        FetchFiles(url, osbxFile, dir, fopt);
                     }
 
                     /* extract '*.gz' */
                     string osbgzFile = osbFile + ".gz";
-                    cmd = gzipFull + " -d -f " + osbgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
-#else          /* for Linux or Mac */
-                    changeFileName = "mv";
-#endif
-                    cmd = changeFileName + " " + osbFile + " " + osb0File;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dir, osbgzFile));
+                    FileUtil::Rename(str.FullPath(dir, osbFile), str.FullPath(dir, osb0File));
                     bool isgz = true;
                     string osbzFile;
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpFile, "%s%c%s", dir, sep, osb0File.c_str());
                     string localFile = tmpFile;
-                    if (access(osb0File.c_str(), 0) == -1)
+                    if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         osbzFile = osbFile + ".Z";
-                        cmd = gzipFull + " -d -f " + osbzFile;
-                        std::system(cmd.c_str());
+                        Uncompress(str.FullPath(dir, osbzFile));
                         isgz = false;
 
-                        cmd = changeFileName + " " + osbFile + " " + osb0File;
-                        std::system(cmd.c_str());
+                        FileUtil::Rename(str.FullPath(dir, osbFile), str.FullPath(dir, osb0File));
 
-                        if (access(osb0File.c_str(), 0) == -1)
+                        if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
                         {
                             cout << "*** INFO(FtpUtil::GetOsb): failed to download " << acName << " MGEX OSB file " << osb0File << endl;
 
@@ -7559,7 +5246,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         }
                     }
 
-                    if (access(osb0File.c_str(), 0) == 0)
+                    if (access(str.FullPath(dir, osb0File).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::GetOsb): successfully download " << acName << " MGEX OSB file " << osb0File << endl;
 
@@ -7606,54 +5293,40 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 acName = "WHU";
             }
 
-            if (access(osb0File.c_str(), 0) == -1)
+            if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string osbxFile = osbFile + ".*";
-                string cmd;
                 if (ac == "cas_m")
                 {
                     string url0 = "ftp://ftp.gipp.org.cn/product/dcb/mgex/" + sYyyy;
-                    string cutDirs0 = " --cut-dirs=4 ";
-                    cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs0 + url0;
-                    std::system(cmd.c_str());
+                    FetchFiles(url0, osbxFile, dir, fopt);
                 }
                 else
                 {
-                    cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    FetchFiles(url, osbxFile, dir, fopt);
                 }
 
                 /* extract '*.gz' */
                 string osbgzFile = osbFile + ".gz";
-                cmd = gzipFull + " -d -f " + osbgzFile;
-                std::system(cmd.c_str());
-                string changeFileName;
-#ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
-#else          /* for Linux or Mac */
-                changeFileName = "mv";
-#endif
-                cmd = changeFileName + " " + osbFile + " " + osb0File;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(dir, osbgzFile));
+                FileUtil::Rename(str.FullPath(dir, osbFile), str.FullPath(dir, osb0File));
                 bool isgz = true;
                 string osbzFile;
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", dir, sep, osb0File.c_str());
                 string localFile = tmpFile;
-                if (access(osb0File.c_str(), 0) == -1)
+                if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
                 {
                     /* extract '*.Z' */
                     osbzFile = osbFile + ".Z";
-                    cmd = gzipFull + " -d -f " + osbzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(dir, osbzFile));
                     isgz = false;
 
-                    cmd = changeFileName + " " + osbFile + " " + osb0File;
-                    std::system(cmd.c_str());
+                    FileUtil::Rename(str.FullPath(dir, osbFile), str.FullPath(dir, osb0File));
 
-                    if (access(osb0File.c_str(), 0) == -1)
+                    if (access(str.FullPath(dir, osb0File).c_str(), 0) == -1)
                     {
                         cout << "*** INFO(FtpUtil::GetOsb): failed to download " << acName << " MGEX OSB file " << osb0File << endl;
 
@@ -7662,7 +5335,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     }
                 }
 
-                if (access(osb0File.c_str(), 0) == 0)
+                if (access(str.FullPath(dir, osb0File).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetOsb): successfully download " << acName << " MGEX OSB file " << osb0File << endl;
 
@@ -7688,13 +5361,6 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute GPS week and day of week */
     TimeUtil tu;
     int wwww;
@@ -7703,54 +5369,39 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sWwww = str.wwww2str(wwww);
     string sDow(to_string(dow));
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
     string snx0File = "igs" + sWwww + ".snx";
-    if (access(snx0File.c_str(), 0) == -1)
+    if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;        
-        string url, cutDirs = " --cut-dirs=4 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
+        string url = ArchiveUrl(ftpName, IDX_SNX, tf);
         
         /* it is OK for '*.Z' or '*.gz' format */
         string snxFile = "igs*P" + sWwww + ".snx";
         string snxxFile = snxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        FetchFiles(url, snxxFile, dir, fopt);
 
         /* extract '*.Z' */
         string snxzFile = snxFile + ".Z";
-        cmd = gzipFull + " -d -f " + snxzFile;
-        std::system(cmd.c_str());
-        string changeFileName;
-#ifdef _WIN32  /* for Windows */
-        changeFileName = "rename";
-#else          /* for Linux or Mac */
-        changeFileName = "mv";
-#endif
-        cmd = changeFileName + " " + snxFile + " " + snx0File;
-        std::system(cmd.c_str());
+        Uncompress(str.FullPath(dir, snxzFile));
+        FileUtil::Rename(str.FullPath(dir, snxFile), str.FullPath(dir, snx0File));
         bool isgz = false;
         string snxgzFile;
         char tmpFile[MAXSTRPATH] = { '\0' };
         char sep = (char)FILEPATHSEP;
         sprintf(tmpFile, "%s%c%s", dir, sep, snx0File.c_str());
         string localFile = tmpFile;
-        if (access(snx0File.c_str(), 0) == -1)
+        if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
         {
             /* extract '*.Z' */
             snxgzFile = snxFile + ".gz";
-            cmd = gzipFull + " -d -f " + snxgzFile;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(dir, snxgzFile));
 
-            cmd = changeFileName + " " + snxFile + " " + snx0File;
-            std::system(cmd.c_str());
+            FileUtil::Rename(str.FullPath(dir, snxFile), str.FullPath(dir, snx0File));
             isgz = true;
-            if (access(snx0File.c_str(), 0) == -1)
+            if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
             {
                 cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " << snx0File << endl;
 
@@ -7760,44 +5411,29 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         }
 
         /* If the weekly SINEX file does not exist,  we use the daily SINEX file instead */
-        if (access(snx0File.c_str(), 0) == -1)
+        if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
         {
-            string url, cutDirs = " --cut-dirs=4 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
+            string url = ArchiveUrl(ftpName, IDX_SNX, tf);
             
             /* it is OK for '*.Z' or '*.gz' format */
             string snxFile = "igs*P" + sWwww + sDow + ".snx";
             string snxxFile = snxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, snxxFile, dir, fopt);
 
             /* extract '*.Z' */
             string snxzFile = snxFile + ".Z";
-            cmd = gzipFull + " -d -f " + snxzFile;
-            std::system(cmd.c_str());
-            string changeFileName;
-#ifdef _WIN32  /* for Windows */
-            changeFileName = "rename";
-#else          /* for Linux or Mac */
-            changeFileName = "mv";
-#endif
-            cmd = changeFileName + " " + snxFile + " " + snx0File;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(dir, snxzFile));
+            FileUtil::Rename(str.FullPath(dir, snxFile), str.FullPath(dir, snx0File));
             isgz = false;
-            if (access(snx0File.c_str(), 0) == -1)
+            if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
             {
                 /* extract '*.Z' */
                 string snxgzFile = snxFile + ".gz";
-                cmd = gzipFull + " -d -f " + snxgzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(dir, snxgzFile));
 
-                cmd = changeFileName + " " + snxFile + " " + snx0File;
-                std::system(cmd.c_str());
+                FileUtil::Rename(str.FullPath(dir, snxFile), str.FullPath(dir, snx0File));
                 isgz = true;
-                if (access(snx0File.c_str(), 0) == -1)
+                if (access(str.FullPath(dir, snx0File).c_str(), 0) == -1)
                 {
                     cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " << snx0File << endl;
 
@@ -7807,7 +5443,7 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             }
         }
 
-        if (access(snx0File.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, snx0File).c_str(), 0) == 0)
         {
             cout << "*** INFO(FtpUtil::GetSnx): successfully download IGS weekly SINEX file " << snx0File << endl;
 
@@ -7819,14 +5455,9 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
         /* delete some temporary directories */
         string tmpDir = "repro3";
-        if (access(tmpDir.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, tmpDir).c_str(), 0) == 0)
         {
-#ifdef _WIN32  /* for Windows */
-            cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-            cmd = "rm -rf " + tmpDir;
-#endif
-            std::system(cmd.c_str());
+            FileUtil::Remove(str.FullPath(dir, tmpDir));
         }
     }
     else cout << "*** INFO(FtpUtil::GetSnx): IGS weekly SINEX file " << snx0File << " has existed!" << endl;
@@ -7843,13 +5474,6 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute day of year */
     TimeUtil tu;
     int yyyy, doy;
@@ -7860,6 +5484,7 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
@@ -7968,59 +5593,36 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             if (isRapid) sprintf(tmpDir, "%s%c%s", dir, sep, "rapid");
             else sprintf(tmpDir, "%s%c%s", dir, sep, "final");
             subDir = tmpDir;
-            if (access(subDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + subDir;
-#endif
-                std::system(cmd.c_str());
-            }  
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(subDir);
         }
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-#endif
 
         for (int i = 0; i < acFiles.size(); i++)
         {
             string acFile = acFiles[i];
             string ionFile = acFile + "g" + sDoy + "0." + sYy + "i";
-            if (access(ionFile.c_str(), 0) == -1)
+            /* the rapid and predicted GIMs are republished under the same name, but NOT the final ones */
+            bool refetch = !isFinal && Refresh(str.FullPath(subDir, ionFile), fopt);
+            if (access(str.FullPath(subDir, ionFile).c_str(), 0) == -1)
             {
-                string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                string url, cutDirs = " --cut-dirs=6 ";
-                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else url = _ftpArchive.CDDIS[IDX_ION] + "/" + sYyyy + "/" + sDoy;
+                string url = ArchiveUrl(ftpName, IDX_ION, tf);
 
                 /* it is OK for '*.Z' or '*.gz' format */
                 string ionxFile = ionFile + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + ionxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                FetchFiles(url, ionxFile, subDir, fopt);
 
                 string iongzFile = ionFile + ".gz", ionzFile = ionFile + ".Z";
                 bool isgz = false;
-                if (access(iongzFile.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, iongzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + iongzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(subDir, iongzFile));
                     isgz = true;
                 }
-                else if (access(ionzFile.c_str(), 0) == 0)
+                else if (access(str.FullPath(subDir, ionzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + ionzFile;
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(subDir, ionzFile));
                     isgz = false;
                 }
 
@@ -8028,7 +5630,7 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, ionFile.c_str());
                 string localFile = tmpFile;
-                if (access(ionFile.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, ionFile).c_str(), 0) == 0)
                 {
                     cout << "*** INFO(FtpUtil::GetIono): successfully download GIM file " << ionFile << endl;
 
@@ -8047,17 +5649,13 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
                 /* delete some temporary directories */
                 string tmpDir = "topex";
-                if (access(tmpDir.c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, tmpDir).c_str(), 0) == 0)
                 {
-#ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
+                    FileUtil::Remove(str.FullPath(subDir, tmpDir));
                 }
             }
             else cout << "*** INFO(FtpUtil::GetIono): GIM file " << ionFile << " has existed!" << endl;
+            if (refetch) Settle(str.FullPath(subDir, ionFile));
         }
     }
 } /* end of GetIono */
@@ -8073,13 +5671,6 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute day of year */
     TimeUtil tu;
     int yyyy, doy;
@@ -8090,41 +5681,31 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
     string rotFile = "roti" + sDoy + "0." + sYy + "f";
-    if (access(rotFile.c_str(), 0) == -1)
+    if (access(str.FullPath(dir, rotFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-        string url, cutDirs = " --cut-dirs=6 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
-        else url = _ftpArchive.CDDIS[IDX_ROTI] + "/" + sYyyy + "/" + sDoy;
+        string url = ArchiveUrl(ftpName, IDX_ROTI, tf);
 
         /* it is OK for '*.Z' or '*.gz' format */
         string rotxFile = rotFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + rotxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        FetchFiles(url, rotxFile, dir, fopt);
 
         string rotgzFile = rotFile + ".gz", rotzFile = rotFile + ".Z";
         bool isgz = false;
-        if (access(rotgzFile.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, rotgzFile).c_str(), 0) == 0)
         {
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + rotgzFile;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(dir, rotgzFile));
             isgz = true;
         }
-        else if (access(rotzFile.c_str(), 0) == 0)
+        else if (access(str.FullPath(dir, rotzFile).c_str(), 0) == 0)
         {
             /* extract '*.Z' */
-            cmd = gzipFull + " -d -f " + rotzFile;
-            std::system(cmd.c_str());
+            Uncompress(str.FullPath(dir, rotzFile));
             isgz = false;
         }
 
@@ -8132,7 +5713,7 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpFile, "%s%c%s", dir, sep, rotFile.c_str());
         string localFile = tmpFile;
-        if (access(rotFile.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, rotFile).c_str(), 0) == 0)
         {
             cout << "*** INFO(FtpUtil::GetRoti): successfully download ROTI file " << rotFile << endl;
 
@@ -8151,14 +5732,9 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
         /* delete some temporary directories */
         string tmpDir = "topex";
-        if (access(tmpDir.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, tmpDir).c_str(), 0) == 0)
         {
-#ifdef _WIN32  /* for Windows */
-            cmd = "rd /s /q " + tmpDir;
-#else          /* for Linux or Mac */
-            cmd = "rm -rf " + tmpDir;
-#endif
-            std::system(cmd.c_str());
+            FileUtil::Remove(str.FullPath(dir, tmpDir));
         }
     }
     else cout << "*** INFO(FtpUtil::GetRoti): ROTI file " << rotFile << " has existed!" << endl;
@@ -8175,13 +5751,6 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
     /* compute day of year */
     TimeUtil tu;
     int yyyy, doy;
@@ -8195,11 +5764,11 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     int dow = tu.time2gpst(ts, &wwww, nullptr);
     string sWwww = str.wwww2str(wwww);
     string sDow(to_string(dow));
+    TemplateUtil::fields_t tf = TemplateUtil::Fields(ts);  /* the values of the placeholders (see TemplateUtil) */
 
     string ac(fopt->trpAc);
     str.TrimSpace4String(ac);
     str.ToLower(ac);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (ac == "igs")
     {
         /* creation of sub-directory ('daily') */
@@ -8207,23 +5776,8 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "IGS");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
-        {
-            /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subDir;
-#endif
-            std::system(cmd.c_str());
-        }
-
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-#endif
+        /* If the directory does not exist, creat it */
+        FileUtil::MakeDir(subDir);
 
         string ftpName = fopt->ftpFrom;
         str.TrimSpace4String(ftpName);
@@ -8232,23 +5786,12 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         if (strlen(sitFile.c_str()) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
         {
             /* download all the IGS ZPD files */
-            string url, cutDirs = " --cut-dirs=7 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
-                sYyyy + "/" + sDoy;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
-                sYyyy + "/" + sDoy;
-            else url = _ftpArchive.CDDIS[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
+            string url = ArchiveUrl(ftpName, IDX_ZTD, tf);
 
             /* it is OK for '*.Z' or '*.gz' format */
             string zpdFile = "*" + sDoy + "0." + sYy + "zpd";
             string zpdxFile = zpdFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, zpdxFile, subDir, fopt);
 
             /* get the file list */
             string suffix = "." + sYy + "zpd";
@@ -8256,67 +5799,43 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.GetFilesAll(dir, suffix, zpdFiles);
             for (int i = 0; i < zpdFiles.size(); i++)
             {
-                if (access(zpdFiles[i].c_str(), 0) == 0)
+                if (access(str.FullPath(subDir, zpdFiles[i]).c_str(), 0) == 0)
                 {
                     /* extract it */
-                    cmd = gzipFull + " -d -f " + zpdFiles[i];
-                    std::system(cmd.c_str());
+                    Uncompress(str.FullPath(subDir, zpdFiles[i]));
                 }
             }
         }
         else  /* the option of full path of site list file is selected */
         {
             /* download the IGS ZPD file site-by-site */
-            if (access(sitFile.c_str(), 0) == 0)
+            if (!fopt->trpSites.empty())
             {
-                ifstream sitLst(sitFile.c_str());
-                if (!sitLst.is_open())
+                for (size_t k = 0; k < fopt->trpSites.size(); k++)
                 {
-                    cerr << "*** ERROR(FtpUtil::GetTrop): open site.list = " << sitFile << " file failed, please check it" << endl;
-
-                    return;
-                }
-
-                string sitName;
-                while (getline(sitLst, sitName))
-                {
-                    if (sitName[0] == '#') continue;
-                    str.TrimSpace4String(sitName);
-                    if (sitName.size() != 4) continue;
-                    str.ToLower(sitName);
-                    string zpdFile = sitName + sDoy + "0." + sYy + "zpd";
-                    if (access(zpdFile.c_str(), 0) == -1)
+                    TemplateUtil::fields_t sf = tf;
+                    sf.site = &fopt->trpSites[k];
+                    string zpdFile = FileName(NAME_ZPD, sf);
+                    if (access(str.FullPath(subDir, zpdFile).c_str(), 0) == -1)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
-                        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
-                            sYyyy + "/" + sDoy;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
-                        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
-                            sYyyy + "/" + sDoy;
-                        
+                        string url = ArchiveUrl(ftpName, IDX_ZTD, tf);
+
                         /* it is OK for '*.Z' or '*.gz' format */
                         string zpdxFile = zpdFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        FetchFiles(url, zpdxFile, subDir, fopt);
 
                         string zpdgzFile = zpdFile + ".gz", zpdzFile = zpdFile + ".Z";
                         bool isgz = false;
-                        if (access(zpdgzFile.c_str(), 0) == 0)
+                        if (access(str.FullPath(subDir, zpdgzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + zpdgzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(subDir, zpdgzFile));
                             isgz = true;
                         }
-                        else if (access(zpdzFile.c_str(), 0) == 0)
+                        else if (access(str.FullPath(subDir, zpdzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
-                            cmd = gzipFull + " -d -f " + zpdzFile;
-                            std::system(cmd.c_str());
+                            Uncompress(str.FullPath(subDir, zpdzFile));
                             isgz = false;
                         }
 
@@ -8324,7 +5843,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         char sep = (char)FILEPATHSEP;
                         sprintf(tmpFile, "%s%c%s", subDir.c_str(), sep, zpdFile.c_str());
                         string localFile = tmpFile;
-                        if (access(zpdFile.c_str(), 0) == 0)
+                        if (access(str.FullPath(subDir, zpdFile).c_str(), 0) == 0)
                         {
                             cout << "*** INFO(FtpUtil::GetTrop): successfully download IGS tropospheric product file " << zpdFile << endl;
 
@@ -8344,9 +5863,6 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     else cout << "*** INFO(FtpUtil::GetTrop): IGS tropospheric product file " << zpdFile << 
                         " has existed!" << endl;
                 }
-
-                /* close 'site.list' */
-                sitLst.close();
             }
         }
     }
@@ -8357,49 +5873,30 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "CODE");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
-        {
-            /* If the directory does not exist, creat it */
-    #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subDir;
-    #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subDir;
-    #endif
-            std::system(cmd.c_str());
-        }
-
-        /* change directory */
-    #ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-    #else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-    #endif
+        /* If the directory does not exist, creat it */
+        FileUtil::MakeDir(subDir);
 
         string trpFile = "COD" + sWwww + sDow + ".TRO";
-        if (access(trpFile.c_str(), 0) == -1)
+        if (access(str.FullPath(subDir, trpFile).c_str(), 0) == -1)
         {
             string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
-            string cutDirs = " --cut-dirs=2 ";
 
             /* it is OK for '*.Z' or '*.gz' format */
             string trpxFile = trpFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + trpxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            FetchFiles(url, trpxFile, subDir, fopt);
 
             string trpgzFile = trpFile + ".gz", trpzFile = trpFile + ".Z";
             bool isgz = false;
-            if (access(trpgzFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, trpgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + trpgzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, trpgzFile));
                 isgz = true;
             }
-            else if (access(trpzFile.c_str(), 0) == 0)
+            else if (access(str.FullPath(subDir, trpzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + trpzFile;
-                std::system(cmd.c_str());
+                Uncompress(str.FullPath(subDir, trpzFile));
                 isgz = false;
             }
 
@@ -8407,7 +5904,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpFile, "%s%c%s", dir, sep, trpFile.c_str());
             string localFile = tmpFile;
-            if (access(trpFile.c_str(), 0) == 0)
+            if (access(str.FullPath(subDir, trpFile).c_str(), 0) == 0)
             {
                 cout << "*** INFO(FtpUtil::GetTrop): successfully download CODE tropospheric product file " << trpFile << endl;
 
@@ -8440,26 +5937,18 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
-
+    StringUtil str;
     string atxFile("igs14.atx");
-    if (access(atxFile.c_str(), 0) == -1)
+    if (access(str.FullPath(dir, atxFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, qr = fopt->qr;
         string url = "https://files.igs.org/pub/station/general/" + atxFile;
-        string cmd = wgetFull + " " + qr + " -nH --cut-dirs=3 " + url;
-        std::system(cmd.c_str());
+        FetchFiles(url, "", dir, fopt);
 
         char tmpFile[MAXSTRPATH] = { '\0' };
         char sep = (char)FILEPATHSEP;
         sprintf(tmpFile, "%s%c%s", dir, sep, atxFile.c_str());
         string localFile = tmpFile;
-        if (access(atxFile.c_str(), 0) == 0)
+        if (access(str.FullPath(dir, atxFile).c_str(), 0) == 0)
         {
             cout << "*** INFO(FtpUtil::GetAntexIGS): successfully download IGS ANTEX file " << atxFile << endl;
 
@@ -8476,102 +5965,243 @@ void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 } /* end of GetAntexIGS */
 
 /**
-* @brief     : FtpDownload - GNSS data downloading via FTP
-* @param[I]  : popt (processing options)
+* @brief   : OptionSign - the signature of the options with which the getters are run
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : CRC32 of the options and the sites in 'site.list' files, i.e., "5d2e8a1f"
+* @note    :
+**/
+string FtpUtil::OptionSign(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    /* the directories and the options of every getter */
+    string text = string(popt->mainDir) + "|" + popt->obsDir + "|" + popt->navDir + "|" + popt->orbDir + "|" +
+        popt->clkDir + "|" + popt->eopDir + "|" + popt->obxDir + "|" + popt->snxDir + "|" + popt->biaDir + "|" +
+        popt->ionDir + "|" + popt->ztdDir + "|" + popt->tblDir + "|" + fopt->ftpFrom;
+    text += "|obs " + to_string(fopt->getObs) + " " + fopt->obsTyp + " " + fopt->obsFrom + " " + fopt->obsLst;
+    for (size_t i = 0; i < fopt->hhObs.size(); i++) text += " " + to_string(fopt->hhObs[i]);
+    text += "|nav " + to_string(fopt->getNav) + " " + fopt->navTyp + " " + fopt->navSys + " " + fopt->navAc + " " +
+        fopt->navLst;
+    for (size_t i = 0; i < fopt->hhNav.size(); i++) text += " " + to_string(fopt->hhNav[i]);
+    text += "|orbclk " + to_string(fopt->getOrbClk) + " " + fopt->orbClkAc;
+    for (size_t i = 0; i < fopt->hhOrbClk.size(); i++)
+    {
+        text += " :";
+        for (size_t j = 0; j < fopt->hhOrbClk[i].size(); j++) text += " " + to_string(fopt->hhOrbClk[i][j]);
+    }
+    text += "|obx " + to_string(fopt->getObx) + " " + fopt->obxAc;
+    text += "|eop " + to_string(fopt->getEop) + " " + fopt->eopAc;
+    for (size_t i = 0; i < fopt->hhEop.size(); i++) text += " " + to_string(fopt->hhEop[i]);
+    text += "|snx " + to_string(fopt->getSnx);
+    text += "|dsb " + to_string(fopt->getDsb) + " " + fopt->dsbAc;
+    text += "|osb " + to_string(fopt->getOsb) + " " + fopt->osbAc;
+    text += "|ion " + to_string(fopt->getIon) + " " + fopt->ionAc;
+    text += "|roti " + to_string(fopt->getRoti);
+    text += "|trp " + to_string(fopt->getTrp) + " " + fopt->trpAc + " " + fopt->trpLst;
+    text += "|atx " + to_string(fopt->getAtx);
+    text += "|" + to_string(fopt->minusAdd1day) + " " + to_string(fopt->keepRawObs);
+    if (fopt->shard) text += "|shard";  /* the observations are got per site (see GetDay) */
+    unsigned long crc = ZipUtil::Crc32(0, text.c_str(), text.size());
+
+    /* the sites read from 'site.list' files, so that the comments and the order of the lines do NOT matter */
+    const std::vector<site_t> *tables[3] = { &fopt->obsSites, &fopt->navSites, &fopt->trpSites };
+    for (int i = 0; i < 3; i++)
+    {
+        string sites = "|";
+        for (size_t k = 0; k < tables[i]->size(); k++)
+        {
+            sites += (*tables[i])[k].name + " " + (*tables[i])[k].longName + ",";
+        }
+        crc = ZipUtil::Crc32(crc, sites.c_str(), sites.size());
+    }
+
+    char sign[16];
+    sprintf(sign, "%08lx", crc);
+
+    return sign;
+} /* end of OptionSign */
+
+/**
+* @brief   : DayKey - the key of the day in the manifest
+* @param[I]: ts (the time of the day)
+* @param[O]: none
+* @return  : the key, i.e., "2022/032"
+* @note    :
+**/
+string FtpUtil::DayKey(gtime_t ts)
+{
+    TimeUtil tu;
+    StringUtil str;
+    int yyyy, doy;
+    tu.time2yrdoy(ts, &yyyy, &doy);
+
+    return str.yyyy2str(yyyy) + "/" + str.doy2str(doy);
+} /* end of DayKey */
+
+/**
+* @brief   : OpenManifest - open the manifest of the files downloaded and the getters finished
+* @param[I]: popt (processing options, the sub-directories are the main ones, NOT the ones of a day)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: opened, false: 'manifest' and 'refresh' are off or error
+* @note    : the getters (and the days) finished with the same options are skipped by FtpDownload, but NOT if
+*            'refresh' is on, for which the files are recorded ONLY (see Refresh)
+**/
+bool FtpUtil::OpenManifest(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    _sign.clear();
+    if (!fopt->manifest && !fopt->refresh) return false;
+
+    /* the manifest is kept in the root/main directory by default */
+    StringUtil str;
+    string file = fopt->manifestFil;
+    if (file.empty() && fopt->shard) file = str.FullPath(popt->mainDir, "GOOD." + ShardUtil::HostName() + ".manifest");
+    if (file.empty()) file = str.FullPath(popt->mainDir, "GOOD.manifest");
+    size_t pos = file.find_last_of(FILEPATHSEP);
+    string dir = pos == string::npos ? "" : file.substr(0, pos);
+    /* If the directory does not exist, creat it */
+    if (!dir.empty()) FileUtil::MakeDir(dir);
+    if (!_manifest.Open(file)) return false;
+    if (!fopt->refresh) _sign = OptionSign(popt, fopt);
+
+    return true;
+} /* end of OpenManifest */
+
+/**
+* @brief   : OpenShard - join the queue of the jobs shared by the nodes running the same configure file
+* @param[I]: popt (processing options, the sub-directories are the main ones, NOT the ones of a day)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: opened, false: 'shard' is off or error
+* @note    : every getter of a day, and every site of the observations, is a job run by ONE node at a time, and
+*            the nodes should mount the shared file system at the same path, since the directories are a part of
+*            the signature of the options (see OptionSign)
+**/
+bool FtpUtil::OpenShard(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    if (!fopt->shard) return false;
+
+    /* the queue is kept in the root/main directory by default, which is shared by the nodes */
+    StringUtil str;
+    string dir = fopt->shardDir;
+    if (dir.empty()) dir = str.FullPath(popt->mainDir, "GOOD_shard");
+
+    return _shard.Open(dir, OptionSign(popt, fopt), fopt->shardLease);
+} /* end of OpenShard */
+
+/**
+* @brief   : IsDayDone - check if all the getters of a day have been finished with the same options
+* @param[I]: ts (the time of the day)
+* @param[O]: none
+* @return  : true: finished, false: otherwise or the manifest is NOT opened
+* @note    :
+**/
+bool FtpUtil::IsDayDone(gtime_t ts)
+{
+    return !_sign.empty() && _manifest.IsDone(DayKey(ts), _sign);
+} /* end of IsDayDone */
+
+/**
+* @brief     : Setup - set up the archives, the third-party software, and the transfer engine before downloading
 * @param[I/O]: fopt (FTP options)
 * @return    : none
 * @note      :
 **/
-void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
+void FtpUtil::Setup(ftpopt_t *fopt)
 {
     /* Get FTP archive for CDDIS, IGN, or WHU */
     init();
 
-    /* setting of the third-party softwares (.i.e, wget, gzip, crx2rnx etc.) */
+    /* setting of the third-party software (.i.e, wget) */
     StringUtil str;
     if (fopt->isPath3party)  /* the path of third-party softwares is NOT set in the environmental variable */
     {
+#ifdef _WIN32   /* for Windows */
         char cmdTmp[MAXCHARS] = { '\0' };
         char sep = (char)FILEPATHSEP;
 
-#ifdef _WIN32   /* for Windows */
         /* for wget */
         sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "wget.exe");
         str.TrimSpace4Char(cmdTmp);
         str.CutFilePathSep(cmdTmp);
         if (access(cmdTmp, 0) == 0) strcpy(fopt->wgetFull, cmdTmp);
-        else
-        {
-            cout << "*** WARNING(FtpUtil::FtpDownload): wget CANNOT be found, please check the setting of 3partyDir!" << endl;
-
-            return;
-        }
-
-        /* for gzip */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "gzip.exe");
-        str.TrimSpace4Char(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        if (access(cmdTmp, 0) == 0) strcpy(fopt->gzipFull, cmdTmp);
-        else
-        {
-            cout << "*** WARNING(FtpUtil::FtpDownload): gzip CANNOT be found, please check the setting of 3partyDir!" << endl;
-
-            return;
-        }
-
-        /* for crx2rnx */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "crx2rnx.exe");
-        str.TrimSpace4Char(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        if (access(cmdTmp, 0) == 0) strcpy(fopt->crx2rnxFull, cmdTmp);
-        else
-        {
-            cout << "*** WARNING(FtpUtil::FtpDownload): crx2rnx CANNOT be found, please check the setting of 3partyDir!" << endl;
-
-            return;
-        }
+        else cout << "*** WARNING(FtpUtil::FtpDownload): wget CANNOT be found, ONLY the built-in transfer engine is used!" << endl;
 #else           /* for Linux or Mac */
         str.SetStr(fopt->wgetFull, "wget", 5);
-        str.SetStr(fopt->gzipFull, "gzip", 5);
-
-        /* for crx2rnx */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "crx2rnx");
-        str.TrimSpace4Char(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        if (access(cmdTmp, 0) == 0) strcpy(fopt->crx2rnxFull, cmdTmp);
-        else
-        {
-            cout << "*** WARNING(FtpUtil::FtpDownload): crx2rnx CANNOT be found, please check the setting of 3partyDir!" << endl;
-
-            return;
-        }
 #endif
     }
     else  /* the path of third-party softwares is set in the environmental variable */
     {
         str.SetStr(fopt->wgetFull, "wget", 5);
-        str.SetStr(fopt->gzipFull, "gzip", 5);
-        str.SetStr(fopt->crx2rnxFull, "crx2rnx", 8);
     }
 
     /* "-qr" (printInfoWget == false, not print information of 'wget') or "r" (printInfoWget == true, print information of 'wget') in 'wget' command line */
     if (fopt->printInfoWget) str.SetStr(fopt->qr, "-r", 3);
     else str.SetStr(fopt->qr, "-qr", 4);
+    _net.SetVerbose(fopt->printInfoWget);
+
+    /* the limit of connections per host, i.e., "cddis:2+hk:1" */
+    _net.SetHostLimit("", fopt->maxParallel);
+    std::vector<string> hostLimits;
+    str.GetSubStr(fopt->hostParallel, "+", hostLimits);
+    for (int i = 0; i < hostLimits.size(); i++)
+    {
+        size_t pos = hostLimits[i].find(':');
+        if (pos == string::npos) continue;
+        _net.SetHostLimit(hostLimits[i].substr(0, pos), atoi(hostLimits[i].c_str() + pos + 1));
+    }
+
+    /* the prefixes of the remote URLs replaced, i.e., "ftps://gdc.cddis.eosdis.nasa.gov>ftp://127.0.0.1:2121" */
+    std::vector<string> redirects;
+    str.GetSubStr(fopt->urlRedirect, "+", redirects);
+    for (int i = 0; i < redirects.size(); i++)
+    {
+        size_t pos = redirects[i].find('>');
+        if (pos == string::npos) continue;
+        _net.SetRedirect(redirects[i].substr(0, pos), redirects[i].substr(pos + 1));
+    }
+
+    /* the remote files are downloaded through the caching proxy of another GOOD on the LAN, i.e.,
+       "http://192.168.1.10:8021", but NOT by the proxy itself */
+    if (!fopt->proxy) _net.SetProxy(fopt->viaProxy);
+
+    /* the listings of the remote directories are shared by all the sites, and (optionally) persisted for the next run */
+    _net.SetListCache(fopt->listCacheDir, fopt->listCacheTtl);
+
+    /* the remote files are raced among the mirrored archives from the historically fastest one, and the statistics
+       of the archives are (optionally) persisted for the next run */
+    _mirror.SetDelay(fopt->hedgeDelay);
+    _mirror.SetVerbose(fopt->printInfoWget);
+    if (fopt->hedgeMirror || fopt->planOnly) _mirror.Load(fopt->mirrorStat);  /* the sizes are estimated by them */
+
+    /* the worker threads are started once for the run, and shared by the days, the getters, and the sites as the
+       global budget of concurrency (the thread calling RunJobs runs the jobs as well) */
+    int nworker = fopt->maxParallel * fopt->dayParallel;
+    if (nworker > 1) _pool.Start(nworker);
+} /* end of Setup */
+
+/**
+* @brief   : GetDay - download the observations and products of a day
+* @param[I]: popt (processing options, the sub-directories are the ones of the day)
+* @param[I]: fopt (FTP options, see Setup)
+* @param[O]: none
+* @return  : number of the getters NOT finished, i.e., with any file NOT found
+* @note    : it is called for several days at the same time (see FtpDownload for the days)
+**/
+int FtpUtil::GetDay(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    StringUtil str;
+
+    /* the getters of observations and products, they are run at the same time if "maxParallel" > 1 since they
+       are independent of each other (the working directory of the process is NOT changed by any of them) */
+    std::vector<std::function<void()> > getters;
+    std::vector<string> names;  /* the names of the getters shown in the trace, i.e., "orbclk cod" */
 
     /* IGS observation (short name 'd') downloaded */
     if (fopt->getObs)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->obsDir, 0) == -1)
-        {
-            string tmpDir = popt->obsDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->obsDir);
 
         string obsTyp = fopt->obsTyp;
         str.TrimSpace4String(obsTyp);
@@ -8588,74 +6218,90 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
                 str.ToUpper(obsuFrom);
                 /* creation of sub-directory */
                 string subObsDir = popt->obsDir;
-                char tmpDir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(tmpDir, "%s%c%s", popt->obsDir, sep, obsuFrom.c_str());
-                subObsDir = tmpDir;
-                if (access(subObsDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + subObsDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + subObsDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                char tmpDir[MAXSTRPATH] = { '\0' };
+                char sep = (char)FILEPATHSEP;
+                sprintf(tmpDir, "%s%c%s", popt->obsDir, sep, obsuFrom.c_str());
+                subObsDir = tmpDir;
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(subObsDir);
 
-                if (obsFrom == "igs")       /* IGS observation (RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "mgex") /* MGEX observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "igm")  /* the union of IGS and MGEX observation with respect to the site name */
-                {
-                    if (obsTyp == "daily") GetDailyObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "cut")  /* Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsCut(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "ga")   /* Geoscience Australia (GA) observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsGa(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsGa(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsGa(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "hk")   /* Hong Kong CORS observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "30s") Get30sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "5s" || obsTyp == "05s") Get5sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "1s" || obsTyp == "01s") Get1sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "ngs")  /* NGS/NOAA CORS observation (RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsNgs(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "epn")  /* EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name "crx" and RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsEpn(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "pbo2") /* Plate Boundary Observatory (PBO) observation (RINEX version 2.xx, short name "d") */
+                std::function<void(const ftpopt_t *)> getObs = [=](const ftpopt_t *fopt)
                 {
-                    if (obsTyp == "daily") GetDailyObsPbo2(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "pbo3") /* Plate Boundary Observatory (PBO) observation (RINEX version 3.xx, long name "crx") */
+                    if (obsFrom == "igs")       /* IGS observation (RINEX version 2.xx, short name "d") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsIgs(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "hourly") GetHourlyObsIgs(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "highrate") GetHrObsIgs(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "mgex") /* MGEX observation (RINEX version 3.xx, long name "crx") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsMgex(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "hourly") GetHourlyObsMgex(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "highrate") GetHrObsMgex(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "igm")  /* the union of IGS and MGEX observation with respect to the site name */
+                    {
+                        if (obsTyp == "daily") GetDailyObsIgm(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "hourly") GetHourlyObsIgm(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "highrate") GetHrObsIgm(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "cut")  /* Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name "crx") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsCut(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "ga")   /* Geoscience Australia (GA) observation (RINEX version 3.xx, long name "crx") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsGa(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "hourly") GetHourlyObsGa(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "highrate") GetHrObsGa(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "hk")   /* Hong Kong CORS observation (RINEX version 3.xx, long name "crx") */
+                    {
+                        if (obsTyp == "30s") Get30sObsHk(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "5s" || obsTyp == "05s") Get5sObsHk(popt->ts, subObsDir.c_str(), fopt);
+                        else if (obsTyp == "1s" || obsTyp == "01s") Get1sObsHk(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "ngs")  /* NGS/NOAA CORS observation (RINEX version 2.xx, short name "d") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsNgs(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "epn")  /* EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name "crx" and RINEX version 2.xx, short name "d") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsEpn(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "pbo2") /* Plate Boundary Observatory (PBO) observation (RINEX version 2.xx, short name "d") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsPbo2(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "pbo3") /* Plate Boundary Observatory (PBO) observation (RINEX version 3.xx, long name "crx") */
+                    {
+                        if (obsTyp == "daily") GetDailyObsPbo3(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                    else if (obsFrom == "pbo5") /* Plate Boundary Observatory (PBO) observation (taking the union of pbo2 and pbo3 (pbo2 + pbo3), while the priority of pbo3 sites is higher) */
+                    {
+                        if (obsTyp == "daily") GetDailyObsPbo5(popt->ts, subObsDir.c_str(), fopt);
+                    }
+                };
+
+                /* the sites in 'site.list' are the jobs of their own if the jobs are shared among the nodes, so
+                   that the observations of a day are downloaded by all of them (see OpenShard) */
+                if (_shard.IsOpen() && strlen(fopt->obsLst) >= 9 && !fopt->obsSites.empty())
                 {
-                    if (obsTyp == "daily") GetDailyObsPbo3(popt->ts, subObsDir.c_str(), fopt);
+                    for (size_t k = 0; k < fopt->obsSites.size(); k++)
+                    {
+                        names.push_back("obs " + obsFrom + " " + obsTyp + " " + fopt->obsSites[k].name);
+                        getters.push_back([=]()
+                        {
+                            ftpopt_t fsite = *fopt;
+                            fsite.obsSites.assign(1, fopt->obsSites[k]);
+                            getObs(&fsite);
+                        });
+                    }
                 }
-                else if (obsFrom == "pbo5") /* Plate Boundary Observatory (PBO) observation (taking the union of pbo2 and pbo3 (pbo2 + pbo3), while the priority of pbo3 sites is higher) */
+                else
                 {
-                    if (obsTyp == "daily") GetDailyObsPbo5(popt->ts, subObsDir.c_str(), fopt);
+                    names.push_back("obs " + obsFrom + " " + obsTyp);
+                    getters.push_back([=]() { getObs(fopt); });
                 }
             }
         }
@@ -8665,18 +6311,10 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
     if (fopt->getNav)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->navDir, 0) == -1)
-        {
-            string tmpDir = popt->navDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->navDir);
 
-        GetNav(popt->ts, popt->navDir, fopt);
+        names.push_back("nav");
+        getters.push_back([=]() { GetNav(popt->ts, popt->navDir, fopt); });
     }
 
     /* precise orbit and clock product downloaded */
@@ -8840,45 +6478,33 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
                 subClkDir = tmpDir;
             }
             /* for orb at a specified day */
-            if (access(subOrbDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + subOrbDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + subOrbDir;
-#endif
-                std::system(cmd.c_str());
-            }
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(subOrbDir);
             /* for clk at a specified day */
             if (prodType > 0 && prodType != PROD_ULTRA_RAPID)
             {
-                if (access(subClkDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + subClkDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + subClkDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                /* If the directory does not exist, creat it */
+                FileUtil::MakeDir(subClkDir);
             }
             std::vector<string> subDirs = { subOrbDir, subClkDir };
-            GetOrbClk(popt->ts, subDirs, prodType, ac_i, fopt);
-
-            if (fopt->minusAdd1day && (prodType == PROD_FINAL_IGS || prodType == PROD_FINAL_MGEX))
+            names.push_back("orbclk " + ac_i);
+            getters.push_back([=]()
             {
-                TimeUtil tu;
-                gtime_t tt;
-                /* precise orbit and clock product downloaded for the day before the specified day */
-                tt = tu.TimeAdd(popt->ts, -86400.0);
-                GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
-
-                /* precise orbit and clock product downloaded for the day after the specified day */
-                tt = tu.TimeAdd(popt->ts, 86400.0);
-                GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
-            }
+                GetOrbClk(popt->ts, subDirs, prodType, ac_i, fopt);
+
+                if (fopt->minusAdd1day && (prodType == PROD_FINAL_IGS || prodType == PROD_FINAL_MGEX))
+                {
+                    TimeUtil tu;
+                    gtime_t tt;
+                    /* precise orbit and clock product downloaded for the day before the specified day */
+                    tt = tu.TimeAdd(popt->ts, -86400.0);
+                    GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
+
+                    /* precise orbit and clock product downloaded for the day after the specified day */
+                    tt = tu.TimeAdd(popt->ts, 86400.0);
+                    GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
+                }
+            });
         }
     }
     
@@ -8886,36 +6512,20 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
     if (fopt->getEop)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->eopDir, 0) == -1)
-        {
-            string tmpDir = popt->eopDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->eopDir);
 
-        GetEop(popt->ts, popt->eopDir, fopt);
+        names.push_back("eop");
+        getters.push_back([=]() { GetEop(popt->ts, popt->eopDir, fopt); });
     }
 
     /* ORBEX (ORBit EXchange format) downloaded */
     if (fopt->getObx)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->obxDir, 0) == -1)
-        {
-            string tmpDir = popt->obxDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->obxDir);
 
-        GetObx(popt->ts, popt->obxDir, fopt);
+        names.push_back("obx");
+        getters.push_back([=]() { GetObx(popt->ts, popt->obxDir, fopt); });
     }
 
 
@@ -8923,18 +6533,10 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
     if (fopt->getDsb)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->biaDir, 0) == -1)
-        {
-            string tmpDir = popt->biaDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->biaDir);
 
-        GetDsb(popt->ts, popt->biaDir, fopt);
+        names.push_back("dsb");
+        getters.push_back([=]() { GetDsb(popt->ts, popt->biaDir, fopt); });
     }
 
 
@@ -8942,107 +6544,431 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
     if (fopt->getOsb)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->biaDir, 0) == -1)
-        {
-            string tmpDir = popt->biaDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->biaDir);
 
-        GetOsb(popt->ts, popt->biaDir, fopt);
+        names.push_back("osb");
+        getters.push_back([=]() { GetOsb(popt->ts, popt->biaDir, fopt); });
     }
 
     /* IGS SINEX file downloaded */
     if (fopt->getSnx)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->snxDir, 0) == -1)
-        {
-            string tmpDir = popt->snxDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->snxDir);
 
-        GetSnx(popt->ts, popt->snxDir, fopt);
+        names.push_back("snx");
+        getters.push_back([=]() { GetSnx(popt->ts, popt->snxDir, fopt); });
     }
 
     /* global ionosphere map (GIM) downloaded */
     if (fopt->getIon)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->ionDir, 0) == -1)
-        {
-            string tmpDir = popt->ionDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->ionDir);
 
-        GetIono(popt->ts, popt->ionDir, fopt);
+        names.push_back("ion");
+        getters.push_back([=]() { GetIono(popt->ts, popt->ionDir, fopt); });
     }
 
     /* Rate of TEC index (ROTI) file downloaded */
     if (fopt->getRoti)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->ionDir, 0) == -1)
-        {
-            string tmpDir = popt->ionDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->ionDir);
 
-        GetRoti(popt->ts, popt->ionDir, fopt);
+        names.push_back("roti");
+        getters.push_back([=]() { GetRoti(popt->ts, popt->ionDir, fopt); });
     }
 
     /* final tropospheric product downloaded */
     if (fopt->getTrp)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->ztdDir, 0) == -1)
-        {
-            string tmpDir = popt->ztdDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        FileUtil::MakeDir(popt->ztdDir);
 
-        GetTrop(popt->ts, popt->ztdDir, fopt);
+        names.push_back("trop");
+        getters.push_back([=]() { GetTrop(popt->ts, popt->ztdDir, fopt); });
     }
 
     /* IGS ANTEX file downloaded */
     if (fopt->getAtx)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->tblDir, 0) == -1)
+        FileUtil::MakeDir(popt->tblDir);
+
+        names.push_back("atx");
+        getters.push_back([=]() { GetAntexIGS(popt->ts, popt->tblDir, fopt); });
+    }
+
+    /* the getters finished with the same options are skipped, and the day is finished when all of them are (see
+       OpenManifest) */
+    string day = DayKey(popt->ts);
+    TraceUtil::Span span("day", "day " + day);
+    std::atomic<int> ndone(0), nleft(0);
+    RunJobs((int)getters.size(), fopt, [&](int k)
+    {
+        /* the getter is known by its name (i.e., "2022/032 orbclk cod"), so the records stay with their products
+           when the getters are added, removed, or reordered */
+        string key = day + " " + names[k];
+        if (!_sign.empty() && _manifest.IsDone(key, _sign))
         {
-            string tmpDir = popt->tblDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
+            ndone++;
+
+            return;
+        }
+
+        /* the getters finished by the other nodes are skipped, and the ones being run by them are left for the
+           next pass (see FtpDownload) */
+        const string &job = key;
+        int claim = _shard.Claim(job);
+        if (claim == SHARD_DONE)
+        {
+            if (!_sign.empty()) _manifest.SetDone(key, _sign);
+            ndone++;
+
+            return;
+        }
+        if (claim != SHARD_RUN)
+        {
+            nleft++;
+
+            return;
+        }
+
+        std::atomic<int> nfail(0), *nfail0 = _nfail;
+        _nfail = &nfail;
+        {
+            TraceUtil::Span span("getter", names[k], day);
+            getters[k]();
+        }
+        _nfail = nfail0;
+        _shard.Finish(job, nfail == 0);
+        if (nfail > 0) nleft++;
+        if (_sign.empty() || nfail > 0 || fopt->planOnly) return;
+        _manifest.SetDone(key, _sign);
+        ndone++;
+    });
+    if (!_sign.empty() && !fopt->planOnly && ndone == (int)getters.size()) _manifest.SetDone(day, _sign);
+
+    return nleft;
+} /* end of GetDay */
+
+/**
+* @brief   : StartRun - set up the metrics and the windows of the hosts before the transfers
+* @param[I]: popt (processing options, the sub-directories are the main ones)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : the files are in the root/main directory unless they are given
+**/
+void FtpUtil::StartRun(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    StringUtil str;
+
+    /* the metrics of every transfer, and the report of the run */
+    if (fopt->metrics)
+    {
+        string file = fopt->metricsFil;
+        if (file.empty()) file = str.FullPath(popt->mainDir, "GOOD_metrics");
+        _metrics.SetFile(file);
+    }
+
+    /* the requests in flight per host start from the windows learned by the previous runs */
+    if (fopt->adaptParallel)
+    {
+        string file = fopt->adaptFil;
+        if (file.empty()) file = str.FullPath(popt->mainDir, "GOOD_hosts.txt");
+        _aimd.SetVerbose(fopt->printInfoWget);
+        _aimd.Load(file);
+        _net.SetAimd(&_aimd);
+    }
+
+    /* the remote files are shared with the other runs on the host */
+    if (fopt->cache)
+    {
+        string dir = fopt->cacheDir;
+        if (dir.empty()) dir = str.FullPath(popt->mainDir, "GOOD_cache");
+        _cache.Open(dir);
+    }
+} /* end of StartRun */
+
+/**
+* @brief   : SaveRun - persist the windows of the hosts and the statistics of the archives, and write the report
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : it is called after every poll with any product downloaded in the watch mode (see FtpWatch)
+**/
+void FtpUtil::SaveRun(const ftpopt_t *fopt)
+{
+    if (fopt->adaptParallel) _aimd.Save();
+    if (fopt->hedgeMirror) _mirror.Save();
+    if (fopt->metrics) _metrics.Save();
+} /* end of SaveRun */
+
+/**
+* @brief   : PollIssue - download an issue of the product polled in the watch mode
+* @param[I]: popt (processing options, the sub-directories are the main ones)
+* @param[I]: fopt (FTP options)
+* @param[I]: w (the product polled)
+* @param[I]: epoch (the epoch of the issue (s since 1970-01-01), i.e., 06:00 for "igu*_06.sp3")
+* @param[O]: none
+* @return  : number of the getters NOT finished (0: the issue has been downloaded)
+* @note    : ONLY the getter of the product is run for the hour of the issue (see GetDay), and the files downloaded
+*            are skipped, so the issue polled again costs the revalidation of the listings at most
+**/
+int FtpUtil::PollIssue(const prcopt_t *popt, const ftpopt_t *fopt, const watch_t &w, long long epoch)
+{
+    /* the day and the hour of the issue, MJD 40587 is 1970-01-01 */
+    prcopt_t pday = *popt;
+    pday.ts.mjd = (int)(epoch / 86400) + 40587;
+    pday.ts.sod = 0.0;
+    int hh = (int)(epoch % 86400 / 3600);
+
+    ftpopt_t fday = *fopt;
+    fday.getObs = fday.getNav = fday.getOrbClk = fday.getObx = fday.getEop = fday.getSnx = false;
+    fday.getDsb = fday.getOsb = fday.getIon = fday.getRoti = fday.getTrp = fday.getAtx = false;
+    if (w.idx < 0)
+    {
+        /* the observations are in the sub-directory of the day, i.e., "obs/2022/032" */
+        TimeUtil tu;
+        StringUtil str;
+        int yyyy, doy;
+        tu.time2yrdoy(pday.ts, &yyyy, &doy);
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obsDir, sep, str.yyyy2str(yyyy).c_str(), sep, str.doy2str(doy).c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(pday.obsDir, dir);
+        fday.getObs = true;
+        fday.hhObs.assign(1, hh);
+    }
+    else
+    {
+        fday.getOrbClk = true;
+        strcpy(fday.orbClkAc, w.ac.c_str());
+        fday.hhOrbClk.assign(4, std::vector<int>());
+        fday.hhOrbClk[w.idx].push_back(hh);
+    }
+
+    return GetDay(&pday, &fday);
+} /* end of PollIssue */
+
+/**
+* @brief     : FtpDownload - GNSS data downloading via FTP
+* @param[I]  : popt (processing options)
+* @param[I/O]: fopt (FTP options)
+* @return    : none
+* @note      :
+**/
+void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
+{
+    FtpDownload(std::vector<prcopt_t>(1, *popt), fopt);
+} /* end of FtpDownload */
+
+/**
+* @brief     : FtpDownload - GNSS data downloading via FTP for the days planned
+* @param[I]  : popts (processing options of every day, the sub-directories are the ones of the day)
+* @param[I/O]: fopt (FTP options)
+* @return    : none
+* @note      : 'dayParallel' days are downloaded at the same time, and they share the limit of connections per host
+*              (see 'maxParallel' and 'hostParallel') as the global budget of concurrency, and the requests in flight
+*              per host are adjusted within it if 'adaptParallel' is on (see AimdUtil). If 'planOnly' is on, the
+*              job graph is printed instead (see PlanUtil::Print). The report of the run is written if 'metrics' is on
+*              (see MetricsUtil::Save), and the timeline of the run is written if 'trace' is on (see TraceUtil::Save)
+**/
+void FtpUtil::FtpDownload(const std::vector<prcopt_t> &popts, ftpopt_t *fopt)
+{
+    Setup(fopt);
+    if (fopt->planOnly)
+    {
+        /* the getters are run as usual but plan the remote files instead of downloading them, and their messages
+           are dropped since nothing is downloaded */
+        _plan.Clear();
+        std::streambuf *buf = cout.rdbuf(nullptr);
+        RunJobs((int)popts.size(), fopt->dayParallel, [&](int k) { GetDay(&popts[k], fopt); });
+        cout.rdbuf(buf);
+        _plan.Print();
+
+        return;
+    }
+
+    /* the metrics of every transfer, and the windows of the hosts learned by the previous runs */
+    if (!popts.empty()) StartRun(&popts[0], fopt);
+    if (fopt->trace) TraceUtil::Start();
+    RunJobs((int)popts.size(), fopt->dayParallel, [&](int k) { GetDay(&popts[k], fopt); });
+
+    /* the jobs being run by the other nodes are polled until they are finished, or taken over if their leases
+       expire (see ShardUtil::Claim) */
+    for (int nbusy = _shard.Pass(); nbusy > 0; nbusy = _shard.Pass())
+    {
+        cout << "*** INFO(FtpUtil::FtpDownload): " << nbusy << " job(s) are being run by the other nodes" << endl;
+        std::this_thread::sleep_for(std::chrono::seconds(fopt->shardLease / 4 > 1 ? fopt->shardLease / 4 : 1));
+        RunJobs((int)popts.size(), fopt->dayParallel, [&](int k) { GetDay(&popts[k], fopt); });
+    }
+    _shard.Close();
+    SaveRun(fopt);
+
+    /* the timeline of the run */
+    if (fopt->trace && !popts.empty())
+    {
+        StringUtil str;
+        string file = fopt->traceFil;
+        if (file.empty()) file = str.FullPath(popts[0].mainDir, "GOOD_trace.json");
+        TraceUtil::Save(file);
+    }
+} /* end of FtpDownload */
+/**
+* @brief     : FtpWatch - keep polling the ultra-rapid orbit and clock products and the hourly/high-rate observations,
+*              and download every issue as soon as it is published
+* @param[I]  : popt (processing options, the sub-directories are the main ones, and the time settings are NOT used)
+* @param[I/O]: fopt (FTP options)
+* @return    : none
+* @note      : it does NOT return. The issues are due at the cadences of the products (6 h for "igs_u" and "esa_u",
+*              3 h for "gfz_u", 1 h for "whu_u" and the observations), and the latest 'watchDepth' issues NOT
+*              downloaded yet are polled every 'watchPoll' seconds. The listings are revalidated by "MDTM" or
+*              "If-Modified-Since" (see NetUtil::ExpireListings), and the FTP connections are kept open between the
+*              polls (see NetUtil::KeepAlive)
+**/
+void FtpUtil::FtpWatch(const prcopt_t *popt, ftpopt_t *fopt)
+{
+    Setup(fopt);
+    StartRun(popt, fopt);
+
+    /* the products polled, with the cadences of their issues */
+    StringUtil str;
+    std::vector<watch_t> products;
+    if (fopt->getObs)
+    {
+        string obsTyp = fopt->obsTyp, obsFrom = fopt->obsFrom;
+        str.TrimSpace4String(obsTyp);
+        str.ToLower(obsTyp);
+        str.TrimSpace4String(obsFrom);
+        str.ToLower(obsFrom);
+        if (obsTyp == "hourly" || obsTyp == "highrate")
+        {
+            /* the hourly file is due when the hour is over */
+            watch_t w = { "obs " + obsFrom + " " + obsTyp, "", -1, 1, 1 };
+            products.push_back(w);
+        }
+    }
+    if (fopt->getOrbClk)
+    {
+        string ac = fopt->orbClkAc;
+        str.TrimSpace4String(ac);
+        str.ToLower(ac);
+        std::vector<string> acs;
+        str.GetSubStr(ac, "+", acs);
+        const std::vector<string> ultraAc = { "esa_u", "gfz_u", "igs_u", "whu_u" };  /* the order of 'hhOrbClk' */
+        const int steps[] = { 6, 3, 6, 1 };
+        for (int i = 0; i < acs.size(); i++)
+        {
+            for (int k = 0; k < ultraAc.size(); k++)
+            {
+                if (acs[i] != ultraAc[k]) continue;
+                watch_t w = { "orbclk " + acs[i], acs[i], k, steps[k], 0 };
+                products.push_back(w);
+            }
+        }
+    }
+    if (products.empty())
+    {
+        cerr << "*** WARNING(FtpUtil::FtpWatch): nothing to watch, ONLY the ultra-rapid orbit and clock products and the "
+            "hourly/high-rate observations are polled!" << endl;
+
+        return;
+    }
+    for (int i = 0; i < products.size(); i++)
+    {
+        cout << "*** INFO(FtpUtil::FtpWatch): " << products[i].name << " is polled every " << fopt->watchPoll <<
+            " s, issued every " << products[i].step << " h" << endl;
+    }
+
+    TimeUtil tu;
+    for (;;)
+    {
+        /* the directories may have got the files published since the last poll */
+        _net.ExpireListings();
+        long long now = (long long)::time(NULL);
+        long long next = now + fopt->watchPoll;  /* the time of the next poll */
+        bool got = false;
+        for (int i = 0; i < products.size(); i++)
+        {
+            watch_t &w = products[i];
+            long long step = w.step * 3600LL;
+            long long last = (now - w.lag * 3600LL) / step * step;  /* the epoch of the latest issue due */
+            for (int k = fopt->watchDepth - 1; k >= 0; k--)
+            {
+                long long epoch = last - k * step;
+                if (w.done.count(epoch) > 0) continue;
+                if (PollIssue(popt, fopt, w, epoch) > 0) continue;
+                w.done.insert(epoch);
+                got = true;
+
+                gtime_t te = { (int)(epoch / 86400) + 40587, (double)(epoch % 86400) };
+                cout << "*** INFO(FtpUtil::FtpWatch): " << w.name << " issued at " << tu.TimeStr(te, 0) <<
+                    " has been downloaded" << endl;
+                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(FtpWatch): %s  %s  OK\n", w.name.c_str(), tu.TimeStr(te, 0));
+            }
+
+            /* the issues earlier than the ones polled are given up */
+            while (!w.done.empty() && *w.done.begin() <= last - fopt->watchDepth * step) w.done.erase(w.done.begin());
+
+            /* the next issue is polled as soon as it is due */
+            next = std::min(next, last + step + w.lag * 3600LL);
+        }
+        if (got)
+        {
+            SaveRun(fopt);
+            if (fopt->fpLog) fflush(fopt->fpLog);
         }
 
-        GetAntexIGS(popt->ts, popt->tblDir, fopt);
+        /* the FTP control connections are kept open for the next poll */
+        _net.KeepAlive();
+        long long wait = next - (long long)::time(NULL);
+        if (wait > 0) std::this_thread::sleep_for(std::chrono::seconds(wait));
+    }
+} /* end of FtpWatch */
+
+/**
+* @brief     : FtpProxy - serve the remote files asked for by the other GOOD on the LAN as an HTTP caching proxy
+* @param[I]  : popt (processing options, ONLY the root/main directory is used)
+* @param[I/O]: fopt (FTP options, 'cache' is turned on)
+* @return    : none
+* @note      : it does NOT return unless the port can NOT be listened at. The remote files are downloaded once into
+*              the cache (see 'cache') and sent from it by 'sendfile', and the requests of the same file at the same
+*              time share one transfer from the archive (see ProxyUtil). The listings and the files served are
+*              revalidated with the archives every 'proxyTtl' seconds, and the other GOOD ask for them through
+*              'viaProxy' (see NetUtil::SetProxy)
+**/
+void FtpUtil::FtpProxy(const prcopt_t *popt, ftpopt_t *fopt)
+{
+    /* the remote files are served from the cache, which is 'GOOD_cache' in the root/main directory by default */
+    fopt->cache = true;
+    Setup(fopt);
+    StartRun(popt, fopt);
+
+    ProxyUtil proxy;
+    proxy.SetVerbose(fopt->printInfoWget);
+    if (!proxy.Start(&_net, &_cache, fopt->proxyPort))
+    {
+        cerr << "*** WARNING(FtpUtil::FtpProxy): the proxy can NOT be started at port " << fopt->proxyPort << endl;
+
+        return;
+    }
+    cout << "*** INFO(FtpUtil::FtpProxy): the remote files are served at port " << fopt->proxyPort <<
+        ", and revalidated every " << fopt->proxyTtl << " s" << endl;
+
+    for (;;)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(fopt->proxyTtl));
+
+        /* the listings and the files are revalidated when they are asked for again, and the FTP control connections
+           are kept open for the next requests */
+        _net.ExpireListings();
+        proxy.Expire();
+        _net.KeepAlive();
+        SaveRun(fopt);
     }
-} /* end of FtpDownload */
\ No newline at end of file
+} /* end of FtpProxy */
@@ -12,9 +12,33 @@ private:
         std::vector<string> CDDIS;  /* CDDIS FTP */
         std::vector<string> IGN;    /* IGN FTP */
         std::vector<string> WHU;    /* WHU FTP */
+        std::map<string, std::vector<TemplateUtil> > dirs;  /* the templates of the directories under every archive, i.e., "CDDIS" */
+        std::vector<bool> mirrored;       /* the class of products is found on the other archives by 'dirs' (false: NOT mirrored) */
+        std::vector<TemplateUtil> names;  /* the templates of the names of observation files (see NAME_*) */
     };
     ftpArchive_t _ftpArchive;
 
+    struct watch_t
+    {                               /* a product polled in the watch mode (see FtpWatch) */
+        string name;                /* the name shown, i.e., "orbclk igs_u" or "obs igs hourly" */
+        string ac;                  /* the analysis center of the ultra-rapid product, i.e., "igs_u", empty: the observations */
+        int idx;                    /* the index in 'hhOrbClk' of the ultra-rapid product, -1: the observations */
+        int step;                   /* the cadence of the issues (h), i.e., 6 for "igs_u" */
+        int lag;                    /* the issue is due 'lag' hours after its epoch, i.e., 1 for the hourly observations */
+        std::set<long long> done;   /* the epochs of the issues downloaded (s since 1970-01-01) */
+    };
+    NetUtil _net;                   /* the built-in transfer engine, the connections are kept open per host */
+    MirrorUtil _mirror;             /* the hedged downloading from the mirrored archives */
+    AimdUtil _aimd;                 /* the windows of the requests in flight per host (see 'adaptParallel') */
+    ManifestUtil _manifest;         /* the files downloaded and the getters finished (see OpenManifest) */
+    CacheUtil _cache;               /* the remote files shared with the other runs on the host (see 'cache') */
+    ShardUtil _shard;               /* the jobs shared with the other nodes on the shared file system (see OpenShard) */
+    PlanUtil _plan;                 /* the remote files planned instead of downloaded if 'planOnly' is on */
+    MetricsUtil _metrics;           /* the metrics of every transfer and the report of the run (see 'metrics') */
+    string _sign;                   /* the signature of the options with which the getters are finished */
+    PoolUtil _pool;                 /* the worker threads shared by the days, the getters, and the sites (see Setup) */
+    static thread_local std::atomic<int> *_nfail;  /* the failures of the getter running in the thread, nullptr: none */
+
 private:
 
     /**
@@ -26,6 +50,190 @@ private:
     **/
     void init();
 
+    /**
+    * @brief   : Fail - count a failure against the getter running in the thread
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the getter with any failure is NOT recorded as finished in the manifest
+    **/
+    void Fail();
+
+    /**
+    * @brief   : Uncompress - decompress '*.gz' or '*.Z' file downloaded, and remove it
+    * @param[I]: compFile (the compressed file with full path, i.e., "igs21906.sp3.Z")
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the record of the compressed file in the manifest is moved to the decompressed one
+    **/
+    bool Uncompress(const string &compFile);
+
+    /**
+    * @brief   : Refresh - check if the remote file of a local one has been republished, and move the local one aside if so
+    * @param[I]: localFile (the local file with full path, i.e., "igu21906_00.sp3")
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: republished and moved to '*.old', which is settled by Settle after downloading it again,
+    *            false: otherwise
+    * @note    : ONLY if 'refresh' is on, the remote file recorded in the manifest is revalidated by a round trip (see
+    *            NetUtil::Revalidate). The local file NOT recorded (i.e., downloaded with 'manifest' and 'refresh' off)
+    *            is taken as fresh
+    **/
+    bool Refresh(const string &localFile, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Settle - remove the local file moved aside by Refresh, or put it back if it is NOT downloaded again
+    * @param[I]: localFile (the local file with full path)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Settle(const string &localFile);
+
+    /**
+    * @brief   : OptionSign - the signature of the options with which the getters are run
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : CRC32 of the options and the sites in 'site.list' files, i.e., "5d2e8a1f"
+    * @note    :
+    **/
+    string OptionSign(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : DayKey - the key of the day in the manifest
+    * @param[I]: ts (the time of the day)
+    * @param[O]: none
+    * @return  : the key, i.e., "2022/032"
+    * @note    :
+    **/
+    string DayKey(gtime_t ts);
+
+    /**
+    * @brief   : MirrorUrls - find the remote directory on all the archives (CDDIS, IGN, and WHU)
+    * @param[I]: url (URL of the directory on one of the archives)
+    * @param[O]: cls (the class of products, i.e., IDX_OBSD)
+    * @param[O]: mirrors (the names of archives, the one of the URL is the first)
+    * @param[O]: urls (URL of the directory on each archive)
+    * @return  : true: found on more than one archive, false: NOT mirrored
+    * @note    : the sub-directories (i.e., year, day of year, hour, or GPS week) are translated by the templates of
+    *            the directories on the archives, and the archives NOT supported by the built-in transfer engine are skipped
+    **/
+    bool MirrorUrls(const string &url, int &cls, std::vector<string> &mirrors, std::vector<string> &urls);
+
+    /**
+    * @brief   : Plan - plan the remote file (or the files matching the pattern) instead of downloading it
+    * @param[I]: url (URL of the remote file, or URL of the directory + "/" + the pattern)
+    * @param[I]: localFile (the local file with full path, or the local directory if its name is unknown)
+    * @param[I]: decode (true: decoded from Compact RINEX after it is decompressed)
+    * @param[I]: wget (true: fetched by 'wget')
+    * @param[O]: none
+    * @return  : none
+    * @note    : the size is estimated by the statistics of the mirrored archives (see MirrorUtil::Size)
+    **/
+    void Plan(const string &url, const string &localFile, bool decode, bool wget);
+
+    /**
+    * @brief   : ArchiveUrl - the remote directory of the products on the archive
+    * @param[I]: ftpName (the name of archive, i.e., "CDDIS", "IGN", or "WHU")
+    * @param[I]: idx (the class of products, i.e., IDX_OBSD)
+    * @param[I]: fields (the values of the placeholders)
+    * @param[O]: none
+    * @return  : URL of the directory, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily/2022/032/22d"
+    * @note    : the archive NOT known is taken as CDDIS
+    **/
+    string ArchiveUrl(const string &ftpName, int idx, const TemplateUtil::fields_t &fields);
+
+    /**
+    * @brief   : FileName - the name of the observation file of the site
+    * @param[I]: idx (the kind of the file name, i.e., NAME_OBSD_O)
+    * @param[I]: fields (the values of the placeholders, including the site)
+    * @param[O]: none
+    * @return  : the file name, i.e., "algo0320.22o" or "ALGO00CAN_?_20220320000_01D_30S_MO.crx"
+    * @note    :
+    **/
+    string FileName(int idx, const TemplateUtil::fields_t &fields);
+
+    /**
+    * @brief   : FetchMirrors - download the remote file, or the files matching the pattern, from the mirrored archives
+    * @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+    * @param[I]: accept (file name pattern, i.e., "igs21906.sp3.*", or empty)
+    * @param[I]: localDir (local directory where the files are saved)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : number of files downloaded
+    * @note    : every file is raced among the archives (see MirrorUtil::Race) if 'hedgeMirror' is on and the directory is
+    *            mirrored, otherwise it is downloaded from the archive of the URL ONLY. The files are recorded in the manifest
+    **/
+    int FetchMirrors(const string &url, const string &accept, const string &localDir, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : FetchFiles - download the remote file, or the files matching the pattern in the remote directory
+    * @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+    * @param[I]: accept (file name pattern, i.e., "brdc0010.21n.*", or empty)
+    * @param[I]: localDir (local directory where the files are saved)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : number of files downloaded (-1: unknown when 'wget' is called)
+    * @note    : the built-in transfer engine is used, and 'wget' is ONLY called for the URL it can NOT handle. Nothing
+    *            is downloaded but planned if 'planOnly' is on (see Plan)
+    **/
+    int FetchFiles(const string &url, const string &accept, const string &localDir, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : FetchObs - download the observation files matching the pattern, and convert them to 'o' files on the fly
+    * @param[I]: url (URL of the directory)
+    * @param[I]: accept (file name pattern, i.e., "ALGO*_R_20220320000_01D_30S_MO.crx.*", or the exact file name)
+    * @param[I]: localDir (local directory where the 'o' files are saved)
+    * @param[I]: obsName (the function giving the name of 'o' file from the name of remote file)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: remoteFile (the name of the last remote file converted, nullptr:NO output)
+    * @return  : number of 'o' files created
+    * @note    : the remote file is decompressed and decoded (Hatanaka) while it is being downloaded, without any
+    *            intermediate file unless 'keepRawObs' is on. The remote file is skipped if its 'o' file exists, and the
+    *            'o' file created is recorded in the manifest. Nothing is downloaded but planned if 'planOnly' is on
+    **/
+    int FetchObs(const string &url, const string &accept, const string &localDir,
+        const std::function<string(const string &)> &obsName, const ftpopt_t *fopt, string *remoteFile);
+
+    /**
+    * @brief   : FetchObs - download the observation file matching the pattern, and convert it to the 'o' file on the fly
+    * @param[I]: url (URL of the directory)
+    * @param[I]: accept (file name pattern, i.e., "ALGO*_R_20220320000_01D_30S_MO.crx.*", or the exact file name)
+    * @param[I]: localDir (local directory where the 'o' file is saved)
+    * @param[I]: oFile (the name of 'o' file)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: remoteFile (the name of the remote file converted, nullptr:NO output)
+    * @return  : number of 'o' files created (0 or 1)
+    * @note    :
+    **/
+    int FetchObs(const string &url, const string &accept, const string &localDir, const string &oFile,
+        const ftpopt_t *fopt, string *remoteFile);
+
+    /**
+    * @brief   : RunJobs - run the jobs (i.e., one site per job) by the worker threads of the run
+    * @param[I]: njob (number of jobs)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: job (the job to run, the argument is the index of job)
+    * @param[O]: none
+    * @return  : none
+    * @note    : 'maxParallel' jobs are run at the same time at most, and they are run one by one if it is less than 2.
+    *            The failures in the jobs are counted against the getter calling it (see Fail)
+    **/
+    void RunJobs(int njob, const ftpopt_t *fopt, const std::function<void(int)> &job);
+
+    /**
+    * @brief   : RunJobs - run the jobs (i.e., one day per job) by the worker threads of the run
+    * @param[I]: njob (number of jobs)
+    * @param[I]: nparallel (number of jobs run at the same time at most)
+    * @param[I]: job (the job to run, the argument is the index of job)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the jobs are queued to the pool started by Setup, and they are run one by one if nparallel is less than 2.
+    *            The failures in the jobs are counted against the getter calling it (see Fail)
+    **/
+    void RunJobs(int njob, int nparallel, const std::function<void(int)> &job);
+
     /**
     * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
     * @param[I]: ts (start time)
@@ -396,6 +604,56 @@ private:
     **/
     void GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt);
 
+    /**
+    * @brief     : Setup - set up the archives, the third-party software, and the transfer engine before downloading
+    * @param[I/O]: fopt (FTP options)
+    * @return    : none
+    * @note      :
+    **/
+    void Setup(ftpopt_t *fopt);
+
+    /**
+    * @brief   : GetDay - download the observations and products of a day
+    * @param[I]: popt (processing options, the sub-directories are the ones of the day)
+    * @param[I]: fopt (FTP options, see Setup)
+    * @param[O]: none
+    * @return  : number of the getters NOT finished, i.e., with any file NOT found
+    * @note    : it is called for several days at the same time (see FtpDownload for the days)
+    **/
+    int GetDay(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : StartRun - set up the metrics and the windows of the hosts before the transfers
+    * @param[I]: popt (processing options, the sub-directories are the main ones)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the files are in the root/main directory unless they are given
+    **/
+    void StartRun(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : SaveRun - persist the windows of the hosts and the statistics of the archives, and write the report
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is called after every poll with any product downloaded in the watch mode (see FtpWatch)
+    **/
+    void SaveRun(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : PollIssue - download an issue of the product polled in the watch mode
+    * @param[I]: popt (processing options, the sub-directories are the main ones)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: w (the product polled)
+    * @param[I]: epoch (the epoch of the issue (s since 1970-01-01), i.e., 06:00 for "igu*_06.sp3")
+    * @param[O]: none
+    * @return  : number of the getters NOT finished (0: the issue has been downloaded)
+    * @note    : ONLY the getter of the product is run for the hour of the issue (see GetDay), and the files downloaded
+    *            are skipped, so the issue polled again costs the revalidation of the listings at most
+    **/
+    int PollIssue(const prcopt_t *popt, const ftpopt_t *fopt, const watch_t &w, long long epoch);
+
 public:
     FtpUtil()
 	{
@@ -406,6 +664,38 @@ public:
 
 	}
 
+    /**
+    * @brief   : OpenManifest - open the manifest of the files downloaded and the getters finished
+    * @param[I]: popt (processing options, the sub-directories are the main ones, NOT the ones of a day)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: opened, false: 'manifest' and 'refresh' are off or error
+    * @note    : the getters (and the days) finished with the same options are skipped by FtpDownload, but NOT if
+    *            'refresh' is on, for which the files are recorded ONLY (see Refresh)
+    **/
+    bool OpenManifest(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : OpenShard - join the queue of the jobs shared by the nodes running the same configure file
+    * @param[I]: popt (processing options, the sub-directories are the main ones, NOT the ones of a day)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: opened, false: 'shard' is off or error
+    * @note    : every getter of a day, and every site of the observations, is a job run by ONE node at a time, and
+    *            the nodes should mount the shared file system at the same path, since the directories are a part of
+    *            the signature of the options (see OptionSign)
+    **/
+    bool OpenShard(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : IsDayDone - check if all the getters of a day have been finished with the same options
+    * @param[I]: ts (the time of the day)
+    * @param[O]: none
+    * @return  : true: finished, false: otherwise or the manifest is NOT opened
+    * @note    :
+    **/
+    bool IsDayDone(gtime_t ts);
+
     /**
     * @brief     : FtpDownload - GNSS data downloading via FTP
     * @param[I]  : popt (processing options)
@@ -414,4 +704,43 @@ public:
     * @note      :
     **/
     void FtpDownload(const prcopt_t *popt, ftpopt_t *fopt);
+
+    /**
+    * @brief     : FtpDownload - GNSS data downloading via FTP for the days planned
+    * @param[I]  : popts (processing options of every day, the sub-directories are the ones of the day)
+    * @param[I/O]: fopt (FTP options)
+    * @return    : none
+    * @note      : 'dayParallel' days are downloaded at the same time, and they share the limit of connections per host
+    *              (see 'maxParallel' and 'hostParallel') as the global budget of concurrency. If 'planOnly' is on, the
+    *              job graph is printed instead (see PlanUtil::Print). The report of the run is written if 'metrics' is on
+    *              (see MetricsUtil::Save)
+    **/
+    void FtpDownload(const std::vector<prcopt_t> &popts, ftpopt_t *fopt);
+
+    /**
+    * @brief     : FtpWatch - keep polling the ultra-rapid orbit and clock products and the hourly/high-rate observations,
+    *              and download every issue as soon as it is published
+    * @param[I]  : popt (processing options, the sub-directories are the main ones, and the time settings are NOT used)
+    * @param[I/O]: fopt (FTP options)
+    * @return    : none
+    * @note      : it does NOT return. The issues are due at the cadences of the products (6 h for "igs_u" and "esa_u",
+    *              3 h for "gfz_u", 1 h for "whu_u" and the observations), and the latest 'watchDepth' issues NOT
+    *              downloaded yet are polled every 'watchPoll' seconds. The listings are revalidated by "MDTM" or
+    *              "If-Modified-Since" (see NetUtil::ExpireListings), and the FTP connections are kept open between the
+    *              polls (see NetUtil::KeepAlive)
+    **/
+    void FtpWatch(const prcopt_t *popt, ftpopt_t *fopt);
+
+    /**
+    * @brief     : FtpProxy - serve the remote files asked for by the other GOOD on the LAN as an HTTP caching proxy
+    * @param[I]  : popt (processing options, ONLY the root/main directory is used)
+    * @param[I/O]: fopt (FTP options, 'cache' is turned on)
+    * @return    : none
+    * @note      : it does NOT return unless the port can NOT be listened at. The remote files are downloaded once into
+    *              the cache (see 'cache') and sent from it by 'sendfile', and the requests of the same file at the same
+    *              time share one transfer from the archive (see ProxyUtil). The listings and the files served are
+    *              revalidated with the archives every 'proxyTtl' seconds, and the other GOOD ask for them through
+    *              'viaProxy' (see NetUtil::SetProxy)
+    **/
+    void FtpProxy(const prcopt_t *popt, ftpopt_t *fopt);
 };
\ No newline at end of file
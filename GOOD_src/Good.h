@@ -12,7 +12,15 @@
 #include <iomanip>
 #include <fstream>
 #include <vector>
+#include <map>
+#include <set>
+#include <deque>
 #include <algorithm>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #ifdef _WIN32  /* for Windows */
 #include <string>
 #include <winsock2.h>
@@ -49,6 +57,12 @@ struct gtime_t
     double sod;                   /* seconds of the day */
 };
 
+struct site_t
+{                                 /* a station in 'site.list' */
+    string name;                  /* the four-character name in lower case, i.e., "algo" */
+    string longName;              /* the nine-character name in upper case, i.e., "ALGO00CAN", empty: NOT given */
+};
+
 struct ftpopt_t
 {                                 /* the type of GNSS data downloading */
     bool ftpDownloading;          /* the master switch for data downloading, 0:off  1:on, only for data downloading */
@@ -93,16 +107,63 @@ struct ftpopt_t
     char trpAc[MAXCHARS];         /* analysis center (i.e., "igs" or "cod") */
     char trpLst[MAXCHARS];        /* 'all'; the full path of 'site.list' */
     bool getAtx;                  /* (0:off  1:on) ANTEX format antenna phase center correction */
-    char dir3party[MAXSTRPATH];   /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. 
+    char dir3party[MAXSTRPATH];   /* (optional) the directory where third-party softwares (i.e., 'wget') are stored. 
                                      This option is not needed if you have set the path or environment variable for them */
     bool isPath3party;            /* if true: the path need be set for third-party softwares */
     char wgetFull[MAXCHARS];      /* if isPath3party == true, set the full path where 'wget' is */
-    char gzipFull[MAXCHARS];      /* if isPath3party == true, set the full path where 'gzip' is */
-    char crx2rnxFull[MAXCHARS];   /* if isPath3party == true, set the full path where 'crx2rnx' is */
     bool minusAdd1day;            /* (0:off  1:on) the day before and after the current day for precise satellite orbit and 
                                      clock products downloading */
     bool printInfoWget;           /* (0:off  1 : on) print the information generated by 'wget' */
     char qr[MAXCHARS];            /* "-qr" (printInfoWget == false) or "r" (printInfoWget == true) in 'wget' command line */
+    int maxParallel;              /* number of sites downloaded in parallel, and the default limit of connections per host */
+    char hostParallel[MAXCHARS];  /* (optional) the limit of connections for some hosts, i.e., "cddis:2+hk:1", while the host is matched 
+                                     by the part of its name */
+    int dayParallel;              /* number of days downloaded in parallel, they share the limit of connections per host */
+    bool adaptParallel;           /* (0:off  1:on) adjust the requests in flight per host by additive-increase/multiplicative-decrease */
+    char adaptFil[MAXSTRPATH];    /* (optional) the file where the windows of the hosts are persisted, empty: 'GOOD_hosts.txt' in the
+                                     root/main directory */
+    char urlRedirect[MAXCHARS];   /* (optional) the prefixes of the remote URLs replaced, i.e., "ftps://gdc.cddis.eosdis.nasa.gov>
+                                     ftp://127.0.0.1:2121+ftp://igs.ign.fr>ftp://127.0.0.1:2122" for the local stand-ins of the
+                                     archives (see Benchmark/bench_GOOD.py) */
+    char viaProxy[MAXSTRPATH];    /* (optional) URL of the caching proxy of another GOOD which every remote file is downloaded
+                                     through, i.e., "http://192.168.1.10:8021", empty: NOT used (see 'proxy') */
+    int listCacheTtl;             /* time to live of the persisted listings of the remote directories (s), 0: the listings are ONLY 
+                                     kept during the run */
+    char listCacheDir[MAXSTRPATH];  /* the directory where the listings of the remote directories are persisted */
+    bool keepRawObs;              /* (0:off  1:on) keep the downloaded (compressed Hatanaka) observation files besides the 'o' files */
+    bool hedgeMirror;             /* (0:off  1:on) race the remote files among the mirrored archives (CDDIS, IGN, and WHU) */
+    double hedgeDelay;            /* the latency budget (s), the hedged request is fired to the next archive if the first byte misses it */
+    char mirrorStat[MAXSTRPATH];  /* (optional) the file where the statistics of the archives are persisted for the next runs */
+    bool manifest;                /* (0:off  1:on) record the files downloaded and the days finished, and skip the days finished */
+    char manifestFil[MAXSTRPATH]; /* (optional) the manifest file with full path, empty: 'GOOD.manifest' in the root/main directory */
+    bool refresh;                 /* (0:off  1:on) download again the products republished under the same name (the ultra-rapid
+                                     orbit and EOP files, the CNES real-time files, and the rapid GIMs) if the remote file is changed */
+    bool cache;                   /* (0:off  1:on) share the remote files downloaded among the runs on the host (i.e., with other
+                                     'mainDir'), the file in the cache is cloned by reflink or hard link without any transfer */
+    char cacheDir[MAXSTRPATH];    /* (optional) the directory of the cache, empty: 'GOOD_cache' in the root/main directory */
+    bool metrics;                 /* (0:off  1:on) measure every transfer and write the report of the run */
+    char metricsFil[MAXSTRPATH];  /* (optional) the report with full path but without suffix, empty: 'GOOD_metrics' in the root/main 
+                                     directory, and '.json' and '.prom' are added */
+    bool trace;                   /* (0:off  1:on) write the timeline of the run in the trace event format of Chrome */
+    char traceFil[MAXSTRPATH];    /* (optional) the trace with full path, empty: 'GOOD_trace.json' in the root/main directory */
+    bool watch;                   /* (0:off  1:on) keep polling the ultra-rapid orbit and clock products and the hourly/high-rate
+                                     observations, and download them as soon as they are published (see "--watch" of run_GOOD) */
+    int watchPoll;                /* the interval between the polls (s) */
+    int watchDepth;               /* number of the latest issues polled per product, the earlier ones missed are given up */
+    bool proxy;                   /* (0:off  1:on) serve the remote files to the other GOOD on the LAN as an HTTP caching proxy,
+                                     instead of downloading (see "--proxy" of run_GOOD) */
+    int proxyPort;                /* the port where the proxy listens */
+    int proxyTtl;                 /* the interval (s) after which the listings and the files served are revalidated with the archives */
+    bool shard;                   /* (0:off  1:on) share the jobs (the getters of the days and the sites of the observations) among
+                                     the nodes running the same configure file through the lease files on a shared file system */
+    int shardLease;               /* time to live of the leases (s), the jobs of the node NOT renewing its leases are taken over */
+    char shardDir[MAXSTRPATH];    /* (optional) the directory of the queue on the shared file system, empty: 'GOOD_shard' in the
+                                     root/main directory */
+    bool planOnly;                /* true: the jobs are planned and printed without any transfer (see "--plan" of run_GOOD) */
+    std::vector<site_t> obsSites; /* the stations in 'obsLst' (sorted by name, NO duplicate), which are read once by ReadCfgFile
+                                     and shared by all the getters and days */
+    std::vector<site_t> navSites; /* the stations in 'navLst' */
+    std::vector<site_t> trpSites; /* the stations in 'trpLst' */
 
     char logFil[MAXSTRPATH];      /* The log file with full path that gives the indications of whether the data downloading is
                                      successful or not */
@@ -137,4 +198,11 @@ struct prcopt_t
     /* time settings */
     gtime_t ts;                   /* start time for processing */
     int ndays;                    /* number of consecutive days */
+};
+
+struct runopt_t
+{                                 /* the options of run_GOOD given in the command line, which go before the configure file */
+    bool planOnly;                /* "--plan": the jobs are planned and printed without any transfer (see FtpUtil::FtpDownload) */
+    bool watch;                   /* "--watch": the watch mode is on whatever 'watch' in the configure file is (see FtpUtil::FtpWatch) */
+    bool proxy;                   /* "--proxy": the proxy mode is on whatever 'proxy' in the configure file is (see FtpUtil::FtpProxy) */
 };
\ No newline at end of file
@@ -0,0 +1,388 @@
+/*------------------------------------------------------------------------------
+* ManifestUtil.cpp : the persistent manifest of the files downloaded and the jobs finished
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, the local files are recorded with the remote URL, size, modification time, and CRC32,
+*                           and the days finished are recorded so that they are skipped without walking the directories
+*           2026/10/18      the manifest file is replaced atomically by FileUtil::Rename (on Windows as well)
+*           2026/10/18      the entity tag of the remote file is recorded as well, and the lines without it are taken
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "ManifestUtil.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifndef _WIN32 /* for Linux or Mac */
+#include <sys/mman.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MANIFEST_HEAD   "# GOOD manifest 1"  /* the first line of the manifest file */
+#define MANIFEST_MINLINE 1024     /* the manifest file is compacted ONLY if it has more lines than this */
+
+/* the manifest file is a log of the lines below, and the later line of the same local file or job wins
+     "F <local file> <URL> <remote size> <remote mtime> <CRC32> <local size> <ETag>"  the local file downloaded
+     "X <local file>"                                                                 the local file moved to another one
+     "D <job> <signature>"                                                            the job finished
+   while the fields are separated by TAB, and the ETag (empty: unknown) is NOT given by the older versions */
+
+
+/* function definition -------------------------------------------------------*/
+
+ManifestUtil::ManifestUtil()
+{
+    _fp = nullptr;
+    _nline = 0;
+    _torn = false;
+}
+
+ManifestUtil::~ManifestUtil()
+{
+    Close();
+}
+
+/**
+* @brief   : Parse - take the records from the content of the manifest file
+* @param[I]: buff (the content)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : none
+* @note    : the last line NOT ended by a newline (i.e., interrupted when it was written) is ignored
+**/
+void ManifestUtil::Parse(const char *buff, size_t n)
+{
+    const char *p = buff, *end = buff + n;
+    while (p < end)
+    {
+        const char *q = (const char *)memchr(p, '\n', end - p);
+        if (!q) break;
+        string line(p, q - p);
+        p = q + 1;
+        _nline++;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.size() < 2 || line[1] != '\t') continue;
+
+        std::vector<string> fields;
+        size_t pos = 2, next;
+        while ((next = line.find('\t', pos)) != string::npos)
+        {
+            fields.push_back(line.substr(pos, next - pos));
+            pos = next + 1;
+        }
+        fields.push_back(line.substr(pos));
+
+        if (line[0] == 'F' && (fields.size() == 6 || fields.size() == 7))
+        {
+            entry_t entry;
+            entry.url = fields[1];
+            entry.size = strtoll(fields[2].c_str(), nullptr, 10);
+            entry.mtime = (time_t)strtoll(fields[3].c_str(), nullptr, 10);
+            entry.crc = strtoul(fields[4].c_str(), nullptr, 16);
+            entry.localSize = strtoll(fields[5].c_str(), nullptr, 10);
+            if (fields.size() == 7) entry.etag = fields[6];
+            _files[fields[0]] = entry;
+        }
+        else if (line[0] == 'X' && fields.size() == 1) _files.erase(fields[0]);
+        else if (line[0] == 'D' && fields.size() == 2) _done[fields[0]] = fields[1];
+    }
+    _torn = p < end;
+} /* end of Parse */
+
+/**
+* @brief   : Load - read the manifest file by mapping it into memory
+* @param[I]: file (the manifest file with full path)
+* @param[O]: none
+* @return  : true: ok or the file does NOT exist, false: error
+* @note    :
+**/
+bool ManifestUtil::Load(const string &file)
+{
+    _files.clear();
+    _done.clear();
+    _nline = 0;
+    _torn = false;
+
+#ifdef _WIN32   /* for Windows */
+    HANDLE hFile = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return GetLastError() == ERROR_FILE_NOT_FOUND;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(hFile, &size))
+    {
+        CloseHandle(hFile);
+
+        return false;
+    }
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+
+        return true;
+    }
+    HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    const char *buff = hMap ? (const char *)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (buff) Parse(buff, (size_t)size.QuadPart);
+    if (buff) UnmapViewOfFile(buff);
+    if (hMap) CloseHandle(hMap);
+    CloseHandle(hFile);
+
+    return buff != nullptr;
+#else           /* for Linux or Mac */
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) return errno == ENOENT;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+
+        return false;
+    }
+    if (st.st_size == 0)
+    {
+        close(fd);
+
+        return true;
+    }
+    void *buff = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (buff == MAP_FAILED) return false;
+    Parse((const char *)buff, (size_t)st.st_size);
+    munmap(buff, (size_t)st.st_size);
+
+    return true;
+#endif
+} /* end of Load */
+
+/**
+* @brief   : Compact - rewrite the manifest file with the latest records only
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the file is written to '*.tmp' at first, and then renamed
+**/
+bool ManifestUtil::Compact()
+{
+    string tmpFile = _file + ".tmp";
+    FILE *fp = fopen(tmpFile.c_str(), "wb");
+    if (!fp)
+    {
+        cerr << "*** WARNING(ManifestUtil::Compact): open " << tmpFile << " failed" << endl;
+
+        return false;
+    }
+    fprintf(fp, "%s\n", MANIFEST_HEAD);
+    for (std::map<string, entry_t>::const_iterator it = _files.begin(); it != _files.end(); ++it)
+    {
+        const entry_t &e = it->second;
+        fprintf(fp, "F\t%s\t%s\t%lld\t%lld\t%08lx\t%lld\t%s\n", it->first.c_str(), e.url.c_str(), e.size,
+            (long long)e.mtime, e.crc, e.localSize, e.etag.c_str());
+    }
+    for (std::map<string, string>::const_iterator it = _done.begin(); it != _done.end(); ++it)
+    {
+        fprintf(fp, "D\t%s\t%s\n", it->first.c_str(), it->second.c_str());
+    }
+    bool ok = fclose(fp) == 0;
+    if (ok) ok = FileUtil::Rename(tmpFile, _file);
+    if (!ok) remove(tmpFile.c_str());
+    if (ok) _nline = 1 + (int)(_files.size() + _done.size());
+
+    return ok;
+} /* end of Compact */
+
+/**
+* @brief   : Append - write a line to the manifest file
+* @param[I]: line (the line without newline)
+* @param[O]: none
+* @return  : none
+* @note    : the lock should be held, and the line is flushed at once so that it survives an interruption
+**/
+void ManifestUtil::Append(const string &line)
+{
+    if (!_fp) return;
+
+    fprintf(_fp, "%s\n", line.c_str());
+    fflush(_fp);
+    _nline++;
+} /* end of Append */
+
+/**
+* @brief   : Open - load the manifest file and open it for the records to come
+* @param[I]: file (the manifest file with full path)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the file is created if it does NOT exist, and compacted if most of its lines are out of date or its
+*            last line is NOT complete
+**/
+bool ManifestUtil::Open(const string &file)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_fp && file == _file) return true;
+
+    if (_fp) fclose(_fp);
+    _fp = nullptr;
+    _file = file;
+    if (!Load(_file))
+    {
+        cerr << "*** WARNING(ManifestUtil::Open): read " << _file << " failed" << endl;
+        _file.clear();
+
+        return false;
+    }
+
+    int nrecord = (int)(_files.size() + _done.size());
+    if (_nline == 0 || _torn || (_nline > MANIFEST_MINLINE && _nline > 2 * nrecord)) Compact();
+    _fp = fopen(_file.c_str(), "ab");
+    if (!_fp)
+    {
+        cerr << "*** WARNING(ManifestUtil::Open): open " << _file << " failed" << endl;
+        _file.clear();
+
+        return false;
+    }
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Close - close the manifest file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ManifestUtil::Close()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_fp) fclose(_fp);
+    _fp = nullptr;
+    _file.clear();
+} /* end of Close */
+
+/**
+* @brief   : Find - find the record of a local file
+* @param[I]: localFile (the local file with full path)
+* @param[O]: entry (the record)
+* @return  : true: found, false: NOT recorded
+* @note    :
+**/
+bool ManifestUtil::Find(const string &localFile, entry_t &entry)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::map<string, entry_t>::const_iterator it = _files.find(localFile);
+    if (it == _files.end()) return false;
+    entry = it->second;
+
+    return true;
+} /* end of Find */
+
+/**
+* @brief   : Exists - check if a local file has been downloaded completely
+* @param[I]: localFile (the local file with full path)
+* @param[O]: none
+* @return  : true: it exists, and its size is the one recorded if it is recorded, false: otherwise
+* @note    : the file NOT recorded (i.e., downloaded by the older versions or by 'wget') is checked by its existence
+*            ONLY, and the one recorded but truncated or replaced is taken as NOT downloaded
+**/
+bool ManifestUtil::Exists(const string &localFile)
+{
+    entry_t entry;
+    if (!Find(localFile, entry)) return access(localFile.c_str(), 0) == 0;
+
+    struct stat st;
+    if (stat(localFile.c_str(), &st) != 0) return false;
+
+    return (long long)st.st_size == entry.localSize;
+} /* end of Exists */
+
+/**
+* @brief   : Add - record a local file downloaded
+* @param[I]: localFile (the local file with full path)
+* @param[I]: url (URL of the remote file)
+* @param[I]: size (size of the remote file, -1: unknown)
+* @param[I]: mtime (modification time of the remote file, 0: unknown)
+* @param[I]: etag (entity tag of the remote file, empty: unknown)
+* @param[I]: crc (CRC32 of the bytes as downloaded)
+* @param[O]: none
+* @return  : none
+* @note    : the size of the local file is taken at the moment, it may differ from the remote one (i.e., 'o' file)
+**/
+void ManifestUtil::Add(const string &localFile, const string &url, long long size, time_t mtime, const string &etag,
+    unsigned long crc)
+{
+    struct stat st;
+    if (localFile.find_first_of("\t\n") != string::npos || url.find_first_of("\t\n") != string::npos) return;
+    if (stat(localFile.c_str(), &st) != 0) return;
+
+    entry_t entry;
+    entry.url = url;
+    entry.size = size;
+    entry.mtime = mtime;
+    entry.crc = crc & 0xffffffffUL;
+    entry.localSize = (long long)st.st_size;
+    if (etag.find_first_of("\t\r\n") == string::npos) entry.etag = etag;
+
+    char line[MAXCHARS];
+    sprintf(line, "\t%lld\t%lld\t%08lx\t%lld\t", entry.size, (long long)entry.mtime, entry.crc, entry.localSize);
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_fp) return;
+    _files[localFile] = entry;
+    Append("F\t" + localFile + "\t" + url + line + entry.etag);
+} /* end of Add */
+
+/**
+* @brief   : Move - move the record of a local file to another one derived from it
+* @param[I]: from (the local file recorded, with full path)
+* @param[I]: to (the new local file with full path, i.e., the file decompressed)
+* @param[O]: none
+* @return  : none
+* @note    : nothing is done if the first file is NOT recorded
+**/
+void ManifestUtil::Move(const string &from, const string &to)
+{
+    entry_t entry;
+    if (!Find(from, entry)) return;
+
+    Add(to, entry.url, entry.size, entry.mtime, entry.etag, entry.crc);
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_fp) return;
+    _files.erase(from);
+    Append("X\t" + from);
+} /* end of Move */
+
+/**
+* @brief   : IsDone - check if a job has been finished with the same options
+* @param[I]: key (the job, i.e., "2022/032 orbclk cod")
+* @param[I]: sign (the signature of the options)
+* @param[O]: none
+* @return  : true: finished, false: otherwise
+* @note    :
+**/
+bool ManifestUtil::IsDone(const string &key, const string &sign)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::map<string, string>::const_iterator it = _done.find(key);
+
+    return it != _done.end() && it->second == sign;
+} /* end of IsDone */
+
+/**
+* @brief   : SetDone - record a job finished
+* @param[I]: key (the job, i.e., "2022/032 orbclk cod")
+* @param[I]: sign (the signature of the options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ManifestUtil::SetDone(const string &key, const string &sign)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_fp) return;
+    std::map<string, string>::const_iterator it = _done.find(key);
+    if (it != _done.end() && it->second == sign) return;
+    _done[key] = sign;
+    Append("D\t" + key + "\t" + sign);
+} /* end of SetDone */
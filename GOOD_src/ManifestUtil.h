@@ -0,0 +1,156 @@
+/*------------------------------------------------------------------------------
+* ManifestUtil.h : header file of ManifestUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class ManifestUtil
+{
+public:
+
+    struct entry_t
+    {                             /* the record of a local file downloaded */
+        string url;               /* URL of the remote file */
+        long long size;           /* size of the remote file (bytes), -1: unknown */
+        time_t mtime;             /* modification time of the remote file in seconds since 1970-01-01 UTC, 0: unknown */
+        unsigned long crc;        /* CRC32 of the bytes as downloaded */
+        long long localSize;      /* size of the local file (bytes) when it is recorded */
+        string etag;              /* entity tag of the remote file given by HTTP, empty: unknown */
+    };
+
+private:
+
+    std::map<string, entry_t> _files;  /* the local files downloaded, the key is the file with full path */
+    std::map<string, string> _done;    /* the jobs finished, the key is the job, i.e., "2022/032 orbclk cod", and the value is
+                                          the signature of the options with which it was finished */
+    std::mutex _lock;             /* the lock of the records and the manifest file */
+    string _file;                 /* the manifest file with full path, empty: NOT opened */
+    FILE *_fp;                    /* the manifest file opened for appending */
+    int _nline;                   /* number of the lines in the manifest file */
+    bool _torn;                   /* true: the last line of the manifest file is NOT complete */
+
+private:
+
+    /**
+    * @brief   : Parse - take the records from the content of the manifest file
+    * @param[I]: buff (the content)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the last line NOT ended by a newline (i.e., interrupted when it was written) is ignored
+    **/
+    void Parse(const char *buff, size_t n);
+
+    /**
+    * @brief   : Load - read the manifest file by mapping it into memory
+    * @param[I]: file (the manifest file with full path)
+    * @param[O]: none
+    * @return  : true: ok or the file does NOT exist, false: error
+    * @note    :
+    **/
+    bool Load(const string &file);
+
+    /**
+    * @brief   : Compact - rewrite the manifest file with the latest records only
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the file is written to '*.tmp' at first, and then renamed
+    **/
+    bool Compact();
+
+    /**
+    * @brief   : Append - write a line to the manifest file
+    * @param[I]: line (the line without newline)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the lock should be held, and the line is flushed at once so that it survives an interruption
+    **/
+    void Append(const string &line);
+
+public:
+    ManifestUtil();
+    ~ManifestUtil();
+
+    /**
+    * @brief   : Open - load the manifest file and open it for the records to come
+    * @param[I]: file (the manifest file with full path)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the file is created if it does NOT exist, and compacted if most of its lines are out of date or its
+    *            last line is NOT complete
+    **/
+    bool Open(const string &file);
+
+    /**
+    * @brief   : Close - close the manifest file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : Find - find the record of a local file
+    * @param[I]: localFile (the local file with full path)
+    * @param[O]: entry (the record)
+    * @return  : true: found, false: NOT recorded
+    * @note    :
+    **/
+    bool Find(const string &localFile, entry_t &entry);
+
+    /**
+    * @brief   : Exists - check if a local file has been downloaded completely
+    * @param[I]: localFile (the local file with full path)
+    * @param[O]: none
+    * @return  : true: it exists, and its size is the one recorded if it is recorded, false: otherwise
+    * @note    : the file NOT recorded (i.e., downloaded by the older versions or by 'wget') is checked by its existence
+    *            ONLY, and the one recorded but truncated or replaced is taken as NOT downloaded
+    **/
+    bool Exists(const string &localFile);
+
+    /**
+    * @brief   : Add - record a local file downloaded
+    * @param[I]: localFile (the local file with full path)
+    * @param[I]: url (URL of the remote file)
+    * @param[I]: size (size of the remote file, -1: unknown)
+    * @param[I]: mtime (modification time of the remote file, 0: unknown)
+    * @param[I]: etag (entity tag of the remote file, empty: unknown)
+    * @param[I]: crc (CRC32 of the bytes as downloaded)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the size of the local file is taken at the moment, it may differ from the remote one (i.e., 'o' file)
+    **/
+    void Add(const string &localFile, const string &url, long long size, time_t mtime, const string &etag,
+        unsigned long crc);
+
+    /**
+    * @brief   : Move - move the record of a local file to another one derived from it
+    * @param[I]: from (the local file recorded, with full path)
+    * @param[I]: to (the new local file with full path, i.e., the file decompressed)
+    * @param[O]: none
+    * @return  : none
+    * @note    : nothing is done if the first file is NOT recorded
+    **/
+    void Move(const string &from, const string &to);
+
+    /**
+    * @brief   : IsDone - check if a job has been finished with the same options
+    * @param[I]: key (the job, i.e., "2022/032 orbclk cod")
+    * @param[I]: sign (the signature of the options)
+    * @param[O]: none
+    * @return  : true: finished, false: otherwise
+    * @note    :
+    **/
+    bool IsDone(const string &key, const string &sign);
+
+    /**
+    * @brief   : SetDone - record a job finished
+    * @param[I]: key (the job, i.e., "2022/032 orbclk cod")
+    * @param[I]: sign (the signature of the options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetDone(const string &key, const string &sign);
+};
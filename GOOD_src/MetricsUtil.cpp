@@ -0,0 +1,432 @@
+/*------------------------------------------------------------------------------
+* MetricsUtil.cpp : the metrics of every transfer and the report of the run
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, the time of resolving, connecting, TLS handshake, first byte, transfer, decompressing,
+*                           and decoding of every remote file is measured with its bytes and retries, and the report of
+*                           the run is written in JSON and in the text format of Prometheus
+*           2026/10/18      JsonStr is public for the trace (see TraceUtil)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "PlanUtil.h"
+#include "MetricsUtil.h"
+
+#include <chrono>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MIN(x, y)       ((x) < (y) ? (x) : (y))
+#define MAX(x, y)       ((x) > (y) ? (x) : (y))
+
+/* the transfer running in the thread (see Current) */
+thread_local MetricsUtil::timing_t *MetricsUtil::_current = nullptr;
+
+
+/* function definition -------------------------------------------------------*/
+
+MetricsUtil::MetricsUtil()
+{
+    _start = Now();
+}
+
+MetricsUtil::~MetricsUtil()
+{
+
+}
+
+/**
+* @brief   : Quantile - the quantile of the samples (nearest rank)
+* @param[I]: samples (the samples in ascending order)
+* @param[I]: q (the quantile, i.e., 0.95)
+* @param[O]: none
+* @return  : the value, 0 if there is NO sample
+* @note    :
+**/
+double MetricsUtil::Quantile(const std::vector<double> &samples, double q)
+{
+    if (samples.empty()) return 0.0;
+
+    size_t rank = (size_t)ceil(q * samples.size());
+    if (rank < 1) rank = 1;
+    if (rank > samples.size()) rank = samples.size();
+
+    return samples[rank - 1];
+} /* end of Quantile */
+
+/**
+* @brief   : JsonStr - quote the string for JSON
+* @param[I]: str (string)
+* @param[O]: none
+* @return  : the quoted string, i.e., "\"C:\\data\""
+* @note    : it is used by TraceUtil as well
+**/
+string MetricsUtil::JsonStr(const string &str)
+{
+    string out = "\"";
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        unsigned char c = (unsigned char)str[i];
+        if (c == '"' || c == '\\') out += '\\';
+        if (c >= 0x20)
+        {
+            out += (char)c;
+            continue;
+        }
+        char buff[8];
+        sprintf(buff, "\\u%04x", c);
+        out += buff;
+    }
+
+    return out + "\"";
+} /* end of JsonStr */
+
+/**
+* @brief   : Hosts - sum up the transfers per host
+* @param[I]: none
+* @param[O]: hosts (the metrics of the transfers per host, the key is the host)
+* @return  : none
+* @note    : the lock should be held
+**/
+void MetricsUtil::Hosts(std::map<string, host_t> &hosts)
+{
+    hosts.clear();
+    for (size_t i = 0; i < _records.size(); i++)
+    {
+        const record_t &r = _records[i];
+        std::map<string, host_t>::iterator it = hosts.find(r.host);
+        if (it == hosts.end())
+        {
+            host_t h;
+            h.nok = h.nfail = 0;
+            h.first = r.start;
+            h.last = r.start + r.seconds;
+            Clear(h.sum);
+            it = hosts.insert(std::make_pair(r.host, h)).first;
+        }
+        host_t &h = it->second;
+        if (r.ok) h.nok++;
+        else h.nfail++;
+        h.first = MIN(h.first, r.start);
+        h.last = MAX(h.last, r.start + r.seconds);
+        Merge(r.timing, h.sum);
+        if (!r.ok) continue;
+        h.firstBytes.push_back(r.timing.firstByte);
+        h.seconds.push_back(r.seconds);
+    }
+    for (std::map<string, host_t>::iterator it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        std::sort(it->second.firstBytes.begin(), it->second.firstBytes.end());
+        std::sort(it->second.seconds.begin(), it->second.seconds.end());
+    }
+} /* end of Hosts */
+
+/**
+* @brief   : WriteJson - write the report in JSON
+* @param[I]: fp (file pointer)
+* @param[O]: none
+* @return  : none
+* @note    : the lock should be held
+**/
+void MetricsUtil::WriteJson(FILE *fp)
+{
+    std::map<string, host_t> hosts;
+    Hosts(hosts);
+
+    fprintf(fp, "{\n  \"seconds\": %.3f,\n  \"hosts\": [", Now() - _start);
+    for (std::map<string, host_t>::const_iterator it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        const host_t &h = it->second;
+        double span = h.last - h.first;
+        fprintf(fp, "%s\n    {\"host\": %s, \"ok\": %d, \"failed\": %d, \"bytes\": %lld, \"retries\": %d, "
+            "\"throughput\": %.0f,\n", it == hosts.begin() ? "" : ",", JsonStr(it->first).c_str(), h.nok, h.nfail,
+            h.sum.bytes, h.sum.retries, span > 0.0 ? h.sum.bytes / span : 0.0);
+        fprintf(fp, "     \"firstByte\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f},\n", Quantile(h.firstBytes, 0.50),
+            Quantile(h.firstBytes, 0.95), Quantile(h.firstBytes, 0.99));
+        fprintf(fp, "     \"seconds\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f},\n", Quantile(h.seconds, 0.50),
+            Quantile(h.seconds, 0.95), Quantile(h.seconds, 0.99));
+        fprintf(fp, "     \"stages\": {\"dns\": %.3f, \"connect\": %.3f, \"tls\": %.3f, \"firstByte\": %.3f, \"transfer\": %.3f, "
+            "\"inflate\": %.3f, \"decode\": %.3f}}", h.sum.dns, h.sum.connect, h.sum.tls, h.sum.firstByte, h.sum.transfer,
+            h.sum.inflate, h.sum.decode);
+    }
+    fprintf(fp, "\n  ],\n  \"files\": [");
+    for (size_t i = 0; i < _records.size(); i++)
+    {
+        const record_t &r = _records[i];
+        const timing_t &t = r.timing;
+        fprintf(fp, "%s\n    {\"url\": %s, \"file\": %s, \"ok\": %s, \"start\": %.3f, \"seconds\": %.3f, \"bytes\": %lld, "
+            "\"retries\": %d,\n", i == 0 ? "" : ",", JsonStr(r.url).c_str(), JsonStr(r.localFile).c_str(),
+            r.ok ? "true" : "false", r.start, r.seconds, t.bytes, t.retries);
+        fprintf(fp, "     \"dns\": %.3f, \"connect\": %.3f, \"tls\": %.3f, \"firstByte\": %.3f, \"transfer\": %.3f, "
+            "\"inflate\": %.3f, \"decode\": %.3f}", t.dns, t.connect, t.tls, t.firstByte, t.transfer, t.inflate, t.decode);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+} /* end of WriteJson */
+
+/**
+* @brief   : WriteProm - write the report in the text format of Prometheus
+* @param[I]: fp (file pointer)
+* @param[O]: none
+* @return  : none
+* @note    : the lock should be held
+**/
+void MetricsUtil::WriteProm(FILE *fp)
+{
+    std::map<string, host_t> hosts;
+    Hosts(hosts);
+    std::map<string, host_t>::const_iterator it;
+
+    fprintf(fp, "# HELP good_run_seconds The wall time of the run.\n# TYPE good_run_seconds gauge\n");
+    fprintf(fp, "good_run_seconds %.3f\n", Now() - _start);
+
+    fprintf(fp, "# HELP good_files_total The remote files transferred.\n# TYPE good_files_total counter\n");
+    for (it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        string host = JsonStr(it->first);
+        fprintf(fp, "good_files_total{host=%s,result=\"ok\"} %d\n", host.c_str(), it->second.nok);
+        fprintf(fp, "good_files_total{host=%s,result=\"failed\"} %d\n", host.c_str(), it->second.nfail);
+    }
+
+    fprintf(fp, "# HELP good_bytes_total The bytes received.\n# TYPE good_bytes_total counter\n");
+    for (it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        fprintf(fp, "good_bytes_total{host=%s} %lld\n", JsonStr(it->first).c_str(), it->second.sum.bytes);
+    }
+
+    fprintf(fp, "# HELP good_retries_total The attempts after the first one.\n# TYPE good_retries_total counter\n");
+    for (it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        fprintf(fp, "good_retries_total{host=%s} %d\n", JsonStr(it->first).c_str(), it->second.sum.retries);
+    }
+
+    fprintf(fp, "# HELP good_throughput_bytes_per_second The bytes received over the time the host was busy.\n"
+        "# TYPE good_throughput_bytes_per_second gauge\n");
+    for (it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        double span = it->second.last - it->second.first;
+        fprintf(fp, "good_throughput_bytes_per_second{host=%s} %.0f\n", JsonStr(it->first).c_str(),
+            span > 0.0 ? it->second.sum.bytes / span : 0.0);
+    }
+
+    fprintf(fp, "# HELP good_stage_seconds_total The time spent in every stage of the transfers.\n"
+        "# TYPE good_stage_seconds_total counter\n");
+    for (it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        const timing_t &t = it->second.sum;
+        const char *stages[7] = { "dns", "connect", "tls", "first_byte", "transfer", "inflate", "decode" };
+        double values[7] = { t.dns, t.connect, t.tls, t.firstByte, t.transfer, t.inflate, t.decode };
+        for (int i = 0; i < 7; i++)
+        {
+            fprintf(fp, "good_stage_seconds_total{host=%s,stage=\"%s\"} %.3f\n", JsonStr(it->first).c_str(), stages[i],
+                values[i]);
+        }
+    }
+
+    /* the summaries of the transfers succeeded */
+    const char *names[2] = { "good_first_byte_seconds", "good_file_seconds" };
+    const char *helps[2] = { "The time to the first byte.", "The wall time of the transfers of the files." };
+    const double qs[3] = { 0.50, 0.95, 0.99 };
+    for (int k = 0; k < 2; k++)
+    {
+        fprintf(fp, "# HELP %s %s\n# TYPE %s summary\n", names[k], helps[k], names[k]);
+        for (it = hosts.begin(); it != hosts.end(); ++it)
+        {
+            const std::vector<double> &samples = k == 0 ? it->second.firstBytes : it->second.seconds;
+            string host = JsonStr(it->first);
+            double sum = 0.0;
+            for (size_t i = 0; i < samples.size(); i++) sum += samples[i];
+            for (int i = 0; i < 3; i++)
+            {
+                fprintf(fp, "%s{host=%s,quantile=\"%g\"} %.3f\n", names[k], host.c_str(), qs[i], Quantile(samples, qs[i]));
+            }
+            fprintf(fp, "%s_sum{host=%s} %.3f\n", names[k], host.c_str(), sum);
+            fprintf(fp, "%s_count{host=%s} %d\n", names[k], host.c_str(), (int)samples.size());
+        }
+    }
+} /* end of WriteProm */
+
+/**
+* @brief   : Now - the monotonic time
+* @param[I]: none
+* @param[O]: none
+* @return  : the time (s)
+* @note    :
+**/
+double MetricsUtil::Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* end of Now */
+
+/**
+* @brief   : Current - the transfer running in the thread
+* @param[I]: none
+* @param[O]: none
+* @return  : the timing of the transfer, nullptr: none or the metrics are off
+* @note    : the stages are added to it by NetUtil where they happen, without passing it through every call
+**/
+MetricsUtil::timing_t *MetricsUtil::Current()
+{
+    return _current;
+} /* end of Current */
+
+/**
+* @brief   : SetCurrent - set the transfer running in the thread
+* @param[I]: timing (the timing of the transfer, nullptr: none)
+* @param[O]: none
+* @return  : none
+* @note    : the hedged requests run in their own threads with their own timings (see MirrorUtil::Race)
+**/
+void MetricsUtil::SetCurrent(timing_t *timing)
+{
+    _current = timing;
+} /* end of SetCurrent */
+
+/**
+* @brief   : Clear - reset the timing
+* @param[I]: none
+* @param[O]: timing (the timing of the transfer)
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::Clear(timing_t &timing)
+{
+    timing.dns = timing.connect = timing.tls = 0.0;
+    timing.firstByte = timing.transfer = 0.0;
+    timing.inflate = timing.decode = 0.0;
+    timing.bytes = 0;
+    timing.retries = 0;
+} /* end of Clear */
+
+/**
+* @brief   : Merge - add the stages and the bytes of a timing to another one
+* @param[I]: from (the timing added)
+* @param[I/O]: to (the timing added to)
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::Merge(const timing_t &from, timing_t &to)
+{
+    to.dns += from.dns;
+    to.connect += from.connect;
+    to.tls += from.tls;
+    to.firstByte += from.firstByte;
+    to.transfer += from.transfer;
+    to.inflate += from.inflate;
+    to.decode += from.decode;
+    to.bytes += from.bytes;
+    to.retries += from.retries;
+} /* end of Merge */
+
+/**
+* @brief   : SetFile - set the report of the run
+* @param[I]: file (the report with full path but without suffix, empty: the metrics are off)
+* @param[O]: none
+* @return  : none
+* @note    : the clock of the run is started
+**/
+void MetricsUtil::SetFile(const string &file)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _file = file;
+    _start = Now();
+    _records.clear();
+    _index.clear();
+} /* end of SetFile */
+
+/**
+* @brief   : Begin - start to measure the transfer of a remote file in the thread
+* @param[O]: timing (the timing of the transfer, which is cleared)
+* @return  : the time when the transfer was started (s)
+* @note    : nothing is measured if the metrics are off
+**/
+double MetricsUtil::Begin(timing_t &timing)
+{
+    Clear(timing);
+    if (!_file.empty()) _current = &timing;
+
+    return Now();
+} /* end of Begin */
+
+/**
+* @brief   : End - finish measuring the transfer of a remote file, and record it
+* @param[I]: timing (the timing of the transfer)
+* @param[I]: start (the time given by Begin)
+* @param[I]: url (URL of the remote file)
+* @param[I]: localFile (the local file with full path)
+* @param[I]: ok (true: the local file is complete)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::End(const timing_t &timing, double start, const string &url, const string &localFile, bool ok)
+{
+    _current = nullptr;
+    if (_file.empty()) return;
+
+    record_t r;
+    r.url = url;
+    r.host = PlanUtil::Host(url);
+    r.localFile = localFile;
+    r.seconds = Now() - start;
+    r.ok = ok;
+    r.timing = timing;
+    std::lock_guard<std::mutex> lock(_lock);
+    r.start = start - _start;
+    _index[localFile] = _records.size();
+    _records.push_back(r);
+} /* end of End */
+
+/**
+* @brief   : AddInflate - add the time of decompressing the local file after it was transferred
+* @param[I]: localFile (the local file with full path, i.e., "igs21906.sp3.Z")
+* @param[I]: seconds (the time of decompressing (s))
+* @param[O]: none
+* @return  : none
+* @note    : nothing is done if the file was NOT transferred in the run
+**/
+void MetricsUtil::AddInflate(const string &localFile, double seconds)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::map<string, size_t>::const_iterator it = _index.find(localFile);
+    if (it != _index.end()) _records[it->second].timing.inflate += seconds;
+} /* end of AddInflate */
+
+/**
+* @brief   : Save - write the report of the run in JSON and in the text format of Prometheus
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the report gives every transfer with its stages, and for every host the throughput, the quantiles
+*            (50%, 95%, and 99%) of the time to the first byte and of the wall time, and the failures
+**/
+bool MetricsUtil::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_file.empty()) return true;
+
+    bool ok = true;
+    const char *suffixes[2] = { ".json", ".prom" };
+    for (int i = 0; i < 2; i++)
+    {
+        string file = _file + suffixes[i], tmpFile = file + ".tmp";
+        FILE *fp = fopen(tmpFile.c_str(), "w");
+        if (!fp)
+        {
+            cerr << "*** WARNING(MetricsUtil::Save): open " << tmpFile << " failed" << endl;
+            ok = false;
+            continue;
+        }
+        if (i == 0) WriteJson(fp);
+        else WriteProm(fp);
+        bool okFile = fclose(fp) == 0;
+        if (okFile) okFile = FileUtil::Rename(tmpFile, file);
+        if (!okFile) remove(tmpFile.c_str());
+        if (!okFile) ok = false;
+        else cout << "*** INFO(MetricsUtil::Save): the report of " << _records.size() << " transfers is written to " <<
+            file << endl;
+    }
+
+    return ok;
+} /* end of Save */
@@ -0,0 +1,201 @@
+/*------------------------------------------------------------------------------
+* MetricsUtil.h : header file of MetricsUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class MetricsUtil
+{
+public:
+
+    struct timing_t
+    {                             /* the time spent in the stages of the transfer of a remote file (s) */
+        double dns;               /* resolving the host names */
+        double connect;           /* TCP connecting (control and data connections) */
+        double tls;               /* TLS handshakes */
+        double firstByte;         /* from the request to the first byte, including the stages above */
+        double transfer;          /* from the first byte to the last one */
+        double inflate;           /* decompressing, overlapped with the transfer if it is streamed (see PipeUtil) */
+        double decode;            /* decoding Compact RINEX, overlapped with the transfer as well */
+        long long bytes;          /* number of the bytes received */
+        int retries;              /* number of the attempts after the first one (stale connections, resumed partial files,
+                                     and hedged requests) */
+    };
+
+private:
+
+    struct record_t
+    {                             /* the metrics of the transfer of a remote file */
+        string url;               /* URL of the remote file */
+        string host;              /* the host of the URL */
+        string localFile;         /* the local file with full path */
+        double start;             /* the time when the transfer was started, since the start of the run (s) */
+        double seconds;           /* the wall time of the transfer, including the streamed stages (s) */
+        bool ok;                  /* true: the local file is complete */
+        timing_t timing;          /* the time spent in every stage */
+    };
+
+    struct host_t
+    {                             /* the metrics of the transfers from a host */
+        int nok;                  /* number of the transfers succeeded */
+        int nfail;                /* number of the transfers failed */
+        double first;             /* the time when the first transfer was started, since the start of the run (s) */
+        double last;              /* the time when the last transfer was finished, since the start of the run (s) */
+        timing_t sum;             /* the sums of the stages, bytes, and retries */
+        std::vector<double> firstBytes;  /* the times to the first byte of the transfers succeeded (s), in ascending order */
+        std::vector<double> seconds;  /* the wall times of the transfers succeeded (s), in ascending order */
+    };
+
+    std::vector<record_t> _records;  /* the transfers in the order they were finished */
+    std::map<string, size_t> _index;  /* the index of the transfers, the key is the local file */
+    std::mutex _lock;             /* the lock of the transfers */
+    string _file;                 /* the report without suffix, ".json" and ".prom" are added (empty: off) */
+    double _start;                /* the time when the run was started (s) */
+    static thread_local timing_t *_current;  /* the transfer running in the thread, nullptr: none or off */
+
+private:
+
+    /**
+    * @brief   : Quantile - the quantile of the samples (nearest rank)
+    * @param[I]: samples (the samples in ascending order)
+    * @param[I]: q (the quantile, i.e., 0.95)
+    * @param[O]: none
+    * @return  : the value, 0 if there is NO sample
+    * @note    :
+    **/
+    static double Quantile(const std::vector<double> &samples, double q);
+
+    /**
+    * @brief   : Hosts - sum up the transfers per host
+    * @param[I]: none
+    * @param[O]: hosts (the metrics of the transfers per host, the key is the host)
+    * @return  : none
+    * @note    : the lock should be held
+    **/
+    void Hosts(std::map<string, host_t> &hosts);
+
+    /**
+    * @brief   : WriteJson - write the report in JSON
+    * @param[I]: fp (file pointer)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the lock should be held
+    **/
+    void WriteJson(FILE *fp);
+
+    /**
+    * @brief   : WriteProm - write the report in the text format of Prometheus
+    * @param[I]: fp (file pointer)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the lock should be held
+    **/
+    void WriteProm(FILE *fp);
+
+public:
+    MetricsUtil();
+    ~MetricsUtil();
+
+    /**
+    * @brief   : JsonStr - quote the string for JSON
+    * @param[I]: str (string)
+    * @param[O]: none
+    * @return  : the quoted string, i.e., "\"C:\\data\""
+    * @note    : it is used by TraceUtil as well
+    **/
+    static string JsonStr(const string &str);
+
+    /**
+    * @brief   : Now - the monotonic time
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the time (s)
+    * @note    :
+    **/
+    static double Now();
+
+    /**
+    * @brief   : Current - the transfer running in the thread
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the timing of the transfer, nullptr: none or the metrics are off
+    * @note    : the stages are added to it by NetUtil where they happen, without passing it through every call
+    **/
+    static timing_t *Current();
+
+    /**
+    * @brief   : SetCurrent - set the transfer running in the thread
+    * @param[I]: timing (the timing of the transfer, nullptr: none)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the hedged requests run in their own threads with their own timings (see MirrorUtil::Race)
+    **/
+    static void SetCurrent(timing_t *timing);
+
+    /**
+    * @brief   : Clear - reset the timing
+    * @param[I]: none
+    * @param[O]: timing (the timing of the transfer)
+    * @return  : none
+    * @note    :
+    **/
+    static void Clear(timing_t &timing);
+
+    /**
+    * @brief   : Merge - add the stages and the bytes of a timing to another one
+    * @param[I]: from (the timing added)
+    * @param[I/O]: to (the timing added to)
+    * @return  : none
+    * @note    :
+    **/
+    static void Merge(const timing_t &from, timing_t &to);
+
+    /**
+    * @brief   : SetFile - set the report of the run
+    * @param[I]: file (the report with full path but without suffix, empty: the metrics are off)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the clock of the run is started
+    **/
+    void SetFile(const string &file);
+
+    /**
+    * @brief   : Begin - start to measure the transfer of a remote file in the thread
+    * @param[O]: timing (the timing of the transfer, which is cleared)
+    * @return  : the time when the transfer was started (s)
+    * @note    : nothing is measured if the metrics are off
+    **/
+    double Begin(timing_t &timing);
+
+    /**
+    * @brief   : End - finish measuring the transfer of a remote file, and record it
+    * @param[I]: timing (the timing of the transfer)
+    * @param[I]: start (the time given by Begin)
+    * @param[I]: url (URL of the remote file)
+    * @param[I]: localFile (the local file with full path)
+    * @param[I]: ok (true: the local file is complete)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void End(const timing_t &timing, double start, const string &url, const string &localFile, bool ok);
+
+    /**
+    * @brief   : AddInflate - add the time of decompressing the local file after it was transferred
+    * @param[I]: localFile (the local file with full path, i.e., "igs21906.sp3.Z")
+    * @param[I]: seconds (the time of decompressing (s))
+    * @param[O]: none
+    * @return  : none
+    * @note    : nothing is done if the file was NOT transferred in the run
+    **/
+    void AddInflate(const string &localFile, double seconds);
+
+    /**
+    * @brief   : Save - write the report of the run in JSON and in the text format of Prometheus
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the report gives every transfer with its stages, and for every host the throughput, the quantiles
+    *            (50%, 95%, and 99%) of the time to the first byte and of the wall time, and the failures
+    **/
+    bool Save();
+};
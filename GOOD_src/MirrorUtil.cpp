@@ -0,0 +1,438 @@
+/*------------------------------------------------------------------------------
+* MirrorUtil.cpp : hedged downloading from the mirrored FTP archives (CDDIS, IGN, and WHU)
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    J. Dean, L. A. Barroso, The Tail at Scale, Communications of the ACM, 56(2), 74-80, 2013
+*
+* history : 2026/10/18 1.0  new, the remote file is downloaded from the historically fastest archive, and a hedged
+*                           request is fired to the next archive if the first byte misses the latency budget
+*           2026/10/18      the size and modification time of the remote file won are given for the manifest
+*           2026/10/18      the expected size of a file of the class is given for the plan of downloading
+*           2026/10/18      the files are replaced atomically by FileUtil::Rename (on Windows as well)
+*           2026/10/18      every transfer in the race is measured by itself, and the winner (or all of them if they failed)
+*                             is added to the metrics of the caller with the hedged requests as retries (see MetricsUtil)
+*           2026/10/18      every transfer in the race is on a lane of its own in the trace (see TraceUtil)
+*           2026/10/18      the transfers are run by the worker threads of the run, the ones lost are cancelled and NOT
+*                             waited for, the winner failed in the middle is resumed from the other mirrors, and the
+*                             mirror which the file is downloaded from is given for the manifest and the cache
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "NetUtil.h"
+#include "MetricsUtil.h"
+#include "PoolUtil.h"
+#include "MirrorUtil.h"
+
+#include <chrono>
+#include <algorithm>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MIRROR_ALPHA    0.3       /* the weight of the new sample in the smoothed statistics */
+#define MIRROR_MINSPEED 65536     /* the minimum bytes of a transfer for the sample of throughput */
+#define MIRROR_NEVER    1.0E9     /* the score of the mirror without statistics (s) */
+
+
+/* function definition -------------------------------------------------------*/
+
+MirrorUtil::MirrorUtil()
+{
+    _delay = 2.0;
+    _verbose = false;
+}
+
+MirrorUtil::~MirrorUtil()
+{
+
+}
+
+/**
+* @brief   : Now - the monotonic time
+* @param[I]: none
+* @param[O]: none
+* @return  : the time (s)
+* @note    :
+**/
+double MirrorUtil::Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* end of Now */
+
+/**
+* @brief   : Score - the expected time to download a file of the class from the mirror
+* @param[I]: cls (the class of products)
+* @param[I]: mirror (the name of mirror, i.e., "CDDIS")
+* @param[O]: none
+* @return  : the time (s), -1: NO statistics
+* @note    : the lock should be held
+**/
+double MirrorUtil::Score(int cls, const string &mirror)
+{
+    std::map<string, stat_t>::const_iterator it = _stats.find(to_string(cls) + " " + mirror);
+    if (it == _stats.end() || it->second.n <= 0) return -1.0;
+
+    const stat_t &st = it->second;
+    double score = st.latency;
+    if (st.speed > 0.0 && st.size > 0.0) score += st.size / st.speed;
+
+    return score;
+} /* end of Score */
+
+/**
+* @brief   : Record - add a sample to the statistics of a mirror
+* @param[I]: cls (the class of products)
+* @param[I]: mirror (the name of mirror)
+* @param[I]: latency (the time to the first byte (s))
+* @param[I]: nbytes (number of the bytes downloaded, 0: the transfer is NOT complete)
+* @param[I]: seconds (the time from the first byte to the end of the transfer (s))
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MirrorUtil::Record(int cls, const string &mirror, double latency, long long nbytes, double seconds)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    string key = to_string(cls) + " " + mirror;
+    if (_stats.find(key) == _stats.end())
+    {
+        stat_t st = { 0, 0.0, 0.0, 0.0 };
+        _stats[key] = st;
+    }
+    stat_t &st = _stats[key];
+
+    double a = st.n > 0 ? MIRROR_ALPHA : 1.0;
+    st.latency += a * (latency - st.latency);
+    if (nbytes > 0)
+    {
+        a = st.size > 0.0 ? MIRROR_ALPHA : 1.0;
+        st.size += a * ((double)nbytes - st.size);
+        if (nbytes >= MIRROR_MINSPEED && seconds > 0.0)
+        {
+            a = st.speed > 0.0 ? MIRROR_ALPHA : 1.0;
+            st.speed += a * ((double)nbytes / seconds - st.speed);
+        }
+    }
+    st.n++;
+} /* end of Record */
+
+/**
+* @brief   : SetDelay - set the latency budget before the hedged request is fired
+* @param[I]: delay (the latency budget (s))
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MirrorUtil::SetDelay(double delay)
+{
+    _delay = delay > 0.0 ? delay : 0.0;
+} /* end of SetDelay */
+
+/**
+* @brief   : SetVerbose - print the information of every race or not
+* @param[I]: verbose (true: print)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MirrorUtil::SetVerbose(bool verbose)
+{
+    _verbose = verbose;
+} /* end of SetVerbose */
+
+/**
+* @brief   : Load - read the statistics persisted by the previous runs
+* @param[I]: statFile (the file with full path, empty: NOT persisted)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the statistics are kept in memory if the file is the one already loaded
+**/
+bool MirrorUtil::Load(const string &statFile)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (statFile == _statFile) return true;
+
+    _statFile = statFile;
+    _stats.clear();
+    if (_statFile.empty()) return true;
+
+    FILE *fp = fopen(_statFile.c_str(), "r");
+    if (!fp) return false;  /* NOT created yet */
+
+    char line[MAXCHARS], mirror[MAXCHARS];
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (line[0] == '#') continue;
+        int cls;
+        stat_t st;
+        if (sscanf(line, "%d %s %d %lf %lf %lf", &cls, mirror, &st.n, &st.latency, &st.speed, &st.size) != 6) continue;
+        if (st.n <= 0) continue;
+        _stats[to_string(cls) + " " + mirror] = st;
+    }
+    fclose(fp);
+
+    return true;
+} /* end of Load */
+
+/**
+* @brief   : Save - persist the statistics for the next runs
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool MirrorUtil::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_statFile.empty()) return true;
+
+    string tmpFile = _statFile + ".tmp";
+    FILE *fp = fopen(tmpFile.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** WARNING(MirrorUtil::Save): open " << tmpFile << " failed" << endl;
+
+        return false;
+    }
+    fprintf(fp, "# class  mirror  samples  latency(s)  throughput(bytes/s)  size(bytes)\n");
+    for (std::map<string, stat_t>::const_iterator it = _stats.begin(); it != _stats.end(); ++it)
+    {
+        const stat_t &st = it->second;
+        fprintf(fp, "%s %d %.3f %.0f %.0f\n", it->first.c_str(), st.n, st.latency, st.speed, st.size);
+    }
+    bool ok = fclose(fp) == 0;
+    if (ok) ok = FileUtil::Rename(tmpFile, _statFile);
+    if (!ok) remove(tmpFile.c_str());
+
+    return ok;
+} /* end of Save */
+
+/**
+* @brief   : Order - sort the mirrors from the historically fastest to the slowest for a class of products
+* @param[I]: cls (the class of products)
+* @param[I/O]: mirrors (the names of mirrors, the first one is preferred when there is NO statistics)
+* @param[I/O]: urls (URL of the remote file or directory on each mirror)
+* @return  : none
+* @note    : the mirrors without statistics are put after the ones with statistics, except the first one
+**/
+void MirrorUtil::Order(int cls, std::vector<string> &mirrors, std::vector<string> &urls)
+{
+    std::vector<std::pair<double, size_t> > scores;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (size_t i = 0; i < mirrors.size(); i++)
+        {
+            double score = Score(cls, mirrors[i]);
+            if (score < 0.0) score = i == 0 ? 0.0 : MIRROR_NEVER;
+            scores.push_back(std::make_pair(score, i));
+        }
+    }
+    std::stable_sort(scores.begin(), scores.end());
+
+    std::vector<string> mirrors0 = mirrors, urls0 = urls;
+    for (size_t i = 0; i < scores.size(); i++)
+    {
+        mirrors[i] = mirrors0[scores[i].second];
+        urls[i] = urls0[scores[i].second];
+    }
+} /* end of Order */
+
+/**
+* @brief   : Size - the expected size of a file of the class
+* @param[I]: cls (the class of products)
+* @param[O]: none
+* @return  : the size (bytes), -1: NO statistics
+* @note    : the smoothed sizes on all the mirrors are averaged
+**/
+long long MirrorUtil::Size(int cls)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    string prefix = to_string(cls) + " ";
+    double size = 0.0;
+    int n = 0;
+    for (std::map<string, stat_t>::const_iterator it = _stats.lower_bound(prefix); it != _stats.end(); ++it)
+    {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+        if (it->second.n <= 0 || it->second.size <= 0.0) continue;
+        size += it->second.size;
+        n++;
+    }
+
+    return n > 0 ? (long long)(size / n + 0.5) : -1;
+} /* end of Size */
+
+/**
+* @brief   : Race - download a remote file from the mirrors with the hedged requests
+* @param[I]: net (the transfer engine)
+* @param[I]: pool (the worker threads running the transfers)
+* @param[I]: cls (the class of products)
+* @param[I]: mirrors (the names of mirrors in order, see Order)
+* @param[I]: urls (URL of the remote file on each mirror)
+* @param[I]: partFile (the partial file with full path, see NetUtil::GetPart)
+* @param[I]: sink (the receiver of the bytes in order as well, nullptr: none)
+* @param[O]: remote (size and modification time of the remote file won, nullptr:NO output)
+* @param[O]: won (the index of the mirror which the file is downloaded from, -1: failed, nullptr:NO output)
+* @return  : true: the partial file is complete, false: error
+* @note    : the transfer from the first mirror is started at first, and the one from the next mirror is fired if
+*            the first byte misses the latency budget or the previous transfer failed. The transfer delivering the
+*            first byte wins, and the others are cancelled (see NetUtil::SetCancel) and left to finish by themselves
+*            when the winner is finished. The winner failed in the middle is resumed from the other mirrors in order
+**/
+bool MirrorUtil::Race(NetUtil &net, PoolUtil &pool, int cls, const std::vector<string> &mirrors, const std::vector<string> &urls,
+    const string &partFile, const NetUtil::sink_t *sink, NetUtil::remote_t *remote, int *won)
+{
+    size_t n = urls.size();
+    if (won) *won = -1;
+    if (n == 0) return false;
+    if (n == 1)
+    {
+        bool ok = net.GetPart(urls[0], partFile, sink, remote);
+        if (won && ok) *won = 0;
+
+        return ok;
+    }
+
+    /* each transfer has its own partial file, the one of the winner is taken over at last. The race is shared with
+       the transfers, since the ones lost are NOT waited for */
+    std::shared_ptr<race_t> race = std::make_shared<race_t>(n);
+    std::vector<racer_t> &racers = race->racers;
+    for (size_t i = 0; i < n; i++)
+    {
+        racers[i].url = urls[i];
+        racers[i].partFile = i == 0 ? partFile : partFile + "." + mirrors[i];
+        racers[i].start = racers[i].first = racers[i].end = 0.0;
+        racers[i].nbytes = 0;
+        racers[i].resumed = access(racers[i].partFile.c_str(), 0) == 0;
+        racers[i].ok = racers[i].rejected = false;
+        racers[i].cancel = false;
+        MetricsUtil::Clear(racers[i].timing);
+    }
+    MetricsUtil::timing_t *parent = MetricsUtil::Current();
+    bool timed = parent != nullptr;
+    std::function<void(size_t)> run = [race, &net, sink, timed](size_t k)
+    {
+        racer_t &r = race->racers[k];
+        NetUtil::sink_t toRacer = [race, k, sink](const char *buff, size_t nb)
+        {
+            racer_t &r = race->racers[k];
+            {
+                std::lock_guard<std::mutex> guard(race->lock);
+                if (r.first == 0.0)
+                {
+                    r.first = Now();
+                    if (race->winner < 0) race->winner = (int)k;
+                    race->cond.notify_all();
+                }
+                if (race->winner != (int)k) return false;  /* lost */
+            }
+            r.nbytes += nb;
+            if (sink && !(*sink)(buff, nb)) return !(r.rejected = true);
+
+            return true;
+        };
+        if (timed) MetricsUtil::SetCurrent(&r.timing);
+        NetUtil::SetCancel(&r.cancel);
+        bool ok = net.GetPart(r.url, r.partFile, &toRacer, &r.remote);
+        NetUtil::SetCancel(nullptr);
+        MetricsUtil::SetCurrent(nullptr);
+
+        std::lock_guard<std::mutex> guard(race->lock);
+        r.ok = ok;
+        r.end = Now();
+        race->cond.notify_all();
+    };
+
+    /* the next transfer is fired when the latency budget is missed or all the transfers started have failed */
+    std::unique_lock<std::mutex> guard(race->lock);
+    size_t nrun = 0;
+    double last = 0.0;
+    while (race->winner < 0)
+    {
+        bool idle = true;
+        for (size_t i = 0; i < nrun; i++) if (racers[i].end == 0.0) idle = false;
+        if (idle && nrun == n) break;
+        if (nrun < n && (idle || Now() - last >= _delay))
+        {
+            racers[nrun].start = last = Now();
+            pool.Post(std::bind(run, nrun));
+            if (_verbose && nrun > 0) cout << "*** INFO(MirrorUtil::Race): " << urls[nrun] << "  hedged" << endl;
+            nrun++;
+            continue;
+        }
+        if (nrun < n) race->cond.wait_for(guard, std::chrono::duration<double>(last + _delay - Now()));
+        else race->cond.wait(guard);
+    }
+    int winner = race->winner;
+    while (winner >= 0 && racers[winner].end == 0.0) race->cond.wait(guard);
+
+    /* the statistics, the transfer failed before the first byte is taken as the slowest one, and the one still
+       waiting for it is taken as NOT faster than the time waited */
+    double now = Now();
+    for (size_t i = 0; i < nrun; i++)
+    {
+        const racer_t &r = racers[i];
+        if (r.resumed) continue;
+        if (r.first > 0.0)
+        {
+            double end = r.end > 0.0 ? r.end : now;
+            Record(cls, mirrors[i], r.first - r.start, (int)i == winner && r.ok ? r.nbytes : 0, end - r.first);
+        }
+        else if (r.end == 0.0) Record(cls, mirrors[i], now - r.start, 0, 0.0);
+        else if (!r.ok) Record(cls, mirrors[i], r.end - r.start + _delay, 0, 0.0);
+    }
+
+    /* the transfers lost are cancelled, and NOT waited for */
+    for (size_t i = 0; i < nrun; i++) if ((int)i != winner) racers[i].cancel = true;
+
+    /* the timings of the transfers lost may be still in use */
+    if (parent)
+    {
+        for (size_t i = 0; i < nrun; i++) if (winner < 0 || (int)i == winner) MetricsUtil::Merge(racers[i].timing, *parent);
+        parent->retries += (int)nrun - 1;
+    }
+    guard.unlock();
+    if (_verbose && winner >= 0) cout << "*** INFO(MirrorUtil::Race): " << urls[winner] << "  won" << endl;
+
+    bool ok = winner >= 0 && racers[winner].ok;
+    int from = winner;
+    if (winner >= 0 && !ok && !racers[winner].rejected)
+    {
+        /* the winner failed in the middle is resumed (or downloaded again) from the other mirrors in order, and the
+           bytes already given to the sink are NOT given again */
+        racer_t &w = racers[winner];
+        long long given = w.nbytes;
+        for (size_t i = 0; i < n && !ok; i++)
+        {
+            if ((int)i == winner) continue;
+
+            long long pos = 0;
+            bool rejected = false;
+            NetUtil::sink_t toRest = [&](const char *buff, size_t nb)
+            {
+                size_t skip = pos >= given ? 0 : (size_t)std::min((long long)nb, given - pos);
+                pos += nb;
+                if (skip == nb) return true;
+                if (!(*sink)(buff + skip, nb - skip)) return !(rejected = true);
+                given = pos;
+
+                return true;
+            };
+            if (_verbose) cout << "*** INFO(MirrorUtil::Race): " << urls[i] << "  resumed for " << urls[winner] << endl;
+            if (parent) parent->retries++;
+            ok = net.GetPart(urls[i], w.partFile, sink ? &toRest : nullptr, &w.remote);
+            if (ok) from = (int)i;
+            if (rejected) break;
+        }
+    }
+
+    if (winner > 0 && access(racers[winner].partFile.c_str(), 0) == 0)
+    {
+        if (!FileUtil::Rename(racers[winner].partFile, partFile)) ok = false;
+    }
+    if (remote && winner >= 0) *remote = racers[winner].remote;
+    if (won && ok) *won = from;
+
+    return ok;
+} /* end of Race */
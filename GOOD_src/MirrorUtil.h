@@ -0,0 +1,164 @@
+/*------------------------------------------------------------------------------
+* MirrorUtil.h : header file of MirrorUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class PoolUtil;
+
+class MirrorUtil
+{
+private:
+
+    struct stat_t
+    {                             /* the statistics of a mirror for a class of products */
+        int n;                    /* number of the samples */
+        double latency;           /* the smoothed time to the first byte (s) */
+        double speed;             /* the smoothed throughput (bytes/s), 0: unknown */
+        double size;              /* the smoothed size of the files (bytes), 0: unknown */
+    };
+
+    struct racer_t
+    {                             /* a transfer taking part in the race */
+        string url;               /* URL of the remote file */
+        string partFile;          /* the partial file of the transfer */
+        double start;             /* the time when the transfer was started (s) */
+        double first;             /* the time when the first byte was received (s), 0: NOT yet */
+        double end;               /* the time when the transfer was finished (s), 0: NOT yet */
+        long long nbytes;         /* number of the bytes received */
+        bool resumed;             /* true: the transfer is resumed from the partial file left before */
+        bool ok;                  /* true: the transfer succeeded */
+        bool rejected;            /* true: the bytes were rejected by the sink of the caller */
+        std::atomic<bool> cancel; /* true: the transfer is cancelled, since it lost the race (see NetUtil::SetCancel) */
+        NetUtil::remote_t remote; /* size and modification time of the remote file (see NetUtil::GetPart) */
+        MetricsUtil::timing_t timing;  /* the time spent in the stages of the transfer (see MetricsUtil) */
+    };
+
+    struct race_t
+    {                             /* the race of a file, shared with the transfers which may outlive the call of Race */
+        std::vector<racer_t> racers;  /* the transfers, one per mirror */
+        std::mutex lock;          /* the lock of the race */
+        std::condition_variable cond;  /* notified when the first byte of a transfer is received or it is finished */
+        int winner;               /* the index of the transfer delivering the first byte, -1: NOT yet */
+
+        race_t(size_t n) : racers(n), winner(-1) {}
+    };
+
+    std::map<string, stat_t> _stats;  /* the statistics, the key is "class mirror", i.e., "7 CDDIS" */
+    std::mutex _lock;             /* the lock of the statistics */
+    string _statFile;             /* the file where the statistics are persisted (empty: NOT persisted) */
+    double _delay;                /* the latency budget (s), the hedged request is fired if the first byte misses it */
+    bool _verbose;                /* true: print the information of every race */
+
+private:
+
+    /**
+    * @brief   : Now - the monotonic time
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the time (s)
+    * @note    :
+    **/
+    static double Now();
+
+    /**
+    * @brief   : Score - the expected time to download a file of the class from the mirror
+    * @param[I]: cls (the class of products)
+    * @param[I]: mirror (the name of mirror, i.e., "CDDIS")
+    * @param[O]: none
+    * @return  : the time (s), -1: NO statistics
+    * @note    : the lock should be held
+    **/
+    double Score(int cls, const string &mirror);
+
+    /**
+    * @brief   : Record - add a sample to the statistics of a mirror
+    * @param[I]: cls (the class of products)
+    * @param[I]: mirror (the name of mirror)
+    * @param[I]: latency (the time to the first byte (s))
+    * @param[I]: nbytes (number of the bytes downloaded, 0: the transfer is NOT complete)
+    * @param[I]: seconds (the time from the first byte to the end of the transfer (s))
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Record(int cls, const string &mirror, double latency, long long nbytes, double seconds);
+
+public:
+    MirrorUtil();
+    ~MirrorUtil();
+
+    /**
+    * @brief   : SetDelay - set the latency budget before the hedged request is fired
+    * @param[I]: delay (the latency budget (s))
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetDelay(double delay);
+
+    /**
+    * @brief   : SetVerbose - print the information of every race or not
+    * @param[I]: verbose (true: print)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetVerbose(bool verbose);
+
+    /**
+    * @brief   : Load - read the statistics persisted by the previous runs
+    * @param[I]: statFile (the file with full path, empty: NOT persisted)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the statistics are kept in memory if the file is the one already loaded
+    **/
+    bool Load(const string &statFile);
+
+    /**
+    * @brief   : Save - persist the statistics for the next runs
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Save();
+
+    /**
+    * @brief   : Order - sort the mirrors from the historically fastest to the slowest for a class of products
+    * @param[I]: cls (the class of products)
+    * @param[I/O]: mirrors (the names of mirrors, the first one is preferred when there is NO statistics)
+    * @param[I/O]: urls (URL of the remote file or directory on each mirror)
+    * @return  : none
+    * @note    : the mirrors without statistics are put after the ones with statistics, except the first one
+    **/
+    void Order(int cls, std::vector<string> &mirrors, std::vector<string> &urls);
+
+    /**
+    * @brief   : Size - the expected size of a file of the class
+    * @param[I]: cls (the class of products)
+    * @param[O]: none
+    * @return  : the size (bytes), -1: NO statistics
+    * @note    : the smoothed sizes on all the mirrors are averaged
+    **/
+    long long Size(int cls);
+
+    /**
+    * @brief   : Race - download a remote file from the mirrors with the hedged requests
+    * @param[I]: net (the transfer engine)
+    * @param[I]: pool (the worker threads running the transfers)
+    * @param[I]: cls (the class of products)
+    * @param[I]: mirrors (the names of mirrors in order, see Order)
+    * @param[I]: urls (URL of the remote file on each mirror)
+    * @param[I]: partFile (the partial file with full path, see NetUtil::GetPart)
+    * @param[I]: sink (the receiver of the bytes in order as well, nullptr: none)
+    * @param[O]: remote (size and modification time of the remote file won, nullptr:NO output)
+    * @param[O]: won (the index of the mirror which the file is downloaded from, -1: failed, nullptr:NO output)
+    * @return  : true: the partial file is complete, false: error
+    * @note    : the transfer from the first mirror is started at first, and the one from the next mirror is fired if
+    *            the first byte misses the latency budget or the previous transfer failed. The transfer delivering the
+    *            first byte wins, and the others are cancelled (see NetUtil::SetCancel) and left to finish by themselves
+    *            when the winner is finished. The winner failed in the middle is resumed from the other mirrors in order
+    **/
+    bool Race(NetUtil &net, PoolUtil &pool, int cls, const std::vector<string> &mirrors, const std::vector<string> &urls,
+        const string &partFile, const NetUtil::sink_t *sink, NetUtil::remote_t *remote, int *won);
+};
@@ -0,0 +1,2049 @@
+/*------------------------------------------------------------------------------
+* NetUtil.cpp : native FTP/FTPS/HTTP/HTTPS transfer engine
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RFC 959 (FTP), RFC 2428 (EPSV), RFC 4217 (FTP over TLS), RFC 7230 (HTTP/1.1)
+*
+* history : 2026/10/18 1.0  new, replace the per-file 'wget' process with the connections kept open per host
+*           2026/10/18      the size and modification time of the remote file are given by GetPart for the manifest
+*           2026/10/18      the directory of the listings is created, and the files are renamed by FileUtil
+*           2026/10/18      the time of resolving, connecting, TLS handshake, first byte, and transfer, the bytes, and the
+*                             retries are added to the metrics of the transfer running in the thread (see MetricsUtil)
+*           2026/10/18      the listings and the transfers are recorded as the spans of the trace (see TraceUtil)
+*           2026/10/18      the prefixes of the URLs can be redirected, i.e., to the local stand-ins of the archives
+*           2026/10/18      the requests in flight per host are limited by the windows adjusted by AIMD (see AimdUtil)
+*           2026/10/18      the listings expired are revalidated by "MDTM" or "If-Modified-Since", and the idle FTP control
+*                             connections are kept open by "NOOP" (see ExpireListings and KeepAlive for the watch mode)
+*           2026/10/18      the entity tag of HTTP is kept with the remote file, and the file downloaded is revalidated
+*                             by a round trip (see Revalidate)
+*           2026/10/18      the URLs can be sent through the caching proxy of another GOOD (see SetProxy and ProxyUtil)
+*           2026/10/18      the FTP transfer broken, short, or rejected by the sink is an error even if "226" is replied, and
+*                             whether the control connection is still usable is given apart (see FtpTransfer)
+*           2026/10/18      the partial file is complete ONLY if its size is the one of the remote file, which is given by
+*                             the reply of "RETR" or "SIZE" for FTP as well (see GetPart)
+*           2026/10/18      the size and modification time of 'remote_t' are unknown by default
+*           2026/10/18      the body of an HTTP error is read ONLY if it is small and its length is known, otherwise the
+*                             connection is closed, and the location redirected by the proxy is NOT sent through it twice
+*           2026/10/18      the partial file is created at the first byte received, so nothing is left for the remote file
+*                             NOT found (see GetPart)
+*           2026/10/18      the transfer of the thread can be cancelled, so the hedged request lost is given up while it
+*                             waits instead of at its timeout (see SetCancel)
+*           2026/10/18      the idle connections of the host are closed when the one reused is found stale, so the request
+*                             tried again is NOT sent on another stale connection (see CloseIdle)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "FileUtil.h"
+#include "MetricsUtil.h"
+#include "TraceUtil.h"
+#include "AimdUtil.h"
+#include "NetUtil.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <chrono>
+#ifdef _WIN32  /* for Windows */
+#include <sys/utime.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else          /* for Linux or Mac */
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <utime.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#endif
+
+#ifndef NOTLS  /* TLS support by OpenSSL */
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define NET_TIMEOUT     60        /* timeout for connecting and receiving (s) */
+#define NET_BUFFSIZE    65536     /* buffer size for transfer (bytes) */
+#define MAXREDIRECT     5         /* max number of HTTP redirections */
+#define NET_MAXREFUSED  3         /* max number of the tries again for the requests refused by the busy host */
+#define NET_MAXDRAIN    65536     /* max bytes of the body of an HTTP error read to keep the connection (bytes) */
+#define NET_SLICE       0.2       /* the slice of waiting of the cancellable transfer (s) */
+#define FTP_ANONYMOUS   "anonymous"
+#define FTP_PASSWORD    "anonymous@"
+#define HTTP_AGENT      "GOOD/2.0"
+#define MIN(x, y)       ((x) < (y) ? (x) : (y))
+
+#ifdef _WIN32  /* for Windows */
+#define SOCKET_INVALID  INVALID_SOCKET
+#define closesock       closesocket
+#define MSG_NOSIGNAL    0
+#else          /* for Linux or Mac */
+#define SOCKET_INVALID  (-1)
+#define closesock       close
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL    0
+#endif
+#endif
+
+
+/* the flag of the transfer running in the thread (see SetCancel) */
+thread_local const std::atomic<bool> *NetUtil::_cancel = nullptr;
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : UtcTime - convert the calendar date and time (UTC) to the time in seconds since 1970-01-01
+* @param[I]: year, mon, day, hour, min, sec (UTC)
+* @param[O]: none
+* @return  : the time (0: invalid date)
+* @note    : 'timegm' is NOT available on every platform
+**/
+static time_t UtcTime(int year, int mon, int day, int hour, int min, int sec)
+{
+    if (year < 1970 || mon < 1 || mon > 12 || day < 1 || day > 31) return 0;
+
+    /* the days since 1970-01-01 (the year begins in March to put the leap day at the end) */
+    int y = mon <= 2 ? year - 1 : year, m = mon <= 2 ? mon + 9 : mon - 3;
+    long days = 365L * y + y / 4 - y / 100 + y / 400 + (153 * m + 2) / 5 + day - 1 - 719468L;
+
+    return (time_t)(days * 86400L + hour * 3600L + min * 60L + sec);
+} /* end of UtcTime */
+
+/**
+* @brief   : ParseHttpTime - parse the date and time in HTTP header, i.e., "Tue, 01 Feb 2022 12:34:56 GMT"
+* @param[I]: value (the value of the header field)
+* @param[O]: none
+* @return  : the time (0: invalid)
+* @note    :
+**/
+static time_t ParseHttpTime(const string &value)
+{
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char mon[4] = { '\0' };
+    int year, day, hour, min, sec;
+    size_t pos = value.find(',');
+    if (pos == string::npos || sscanf(value.c_str() + pos + 1, "%d %3s %d %d:%d:%d", &day, mon, &year, &hour, &min, &sec) != 6) return 0;
+    const char *p = strstr(months, mon);
+    if (!p || strlen(mon) != 3) return 0;
+
+    return UtcTime(year, (int)(p - months) / 3 + 1, day, hour, min, sec);
+} /* end of ParseHttpTime */
+
+/**
+* @brief   : HttpTime - format the time for HTTP header, i.e., "Tue, 01 Feb 2022 12:34:56 GMT"
+* @param[I]: time (the time in seconds since 1970-01-01)
+* @param[O]: none
+* @return  : the value of the header field
+* @note    :
+**/
+string NetUtil::HttpTime(time_t time)
+{
+    static const char *days[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char *months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    struct tm t;
+#ifdef _WIN32  /* for Windows */
+    gmtime_s(&t, &time);
+#else          /* for Linux or Mac */
+    gmtime_r(&time, &t);
+#endif
+    char buff[64] = { '\0' };
+    sprintf(buff, "%s, %02d %s %04d %02d:%02d:%02d GMT", days[t.tm_wday], t.tm_mday, months[t.tm_mon], t.tm_year + 1900,
+        t.tm_hour, t.tm_min, t.tm_sec);
+
+    return buff;
+} /* end of HttpTime */
+
+NetUtil::NetUtil()
+{
+    _tlsCtx = nullptr;
+    _verbose = false;
+    _defLimit = 0;
+    _aimd = nullptr;
+    _listTtl = 0;
+    _listMtime = false;
+#ifdef _WIN32  /* for Windows */
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+#else          /* for Linux or Mac */
+    signal(SIGPIPE, SIG_IGN);  /* a broken connection is reported by the return value of send */
+#endif
+}
+
+NetUtil::~NetUtil()
+{
+    CloseAll();
+#ifndef NOTLS
+    if (_tlsCtx) SSL_CTX_free(_tlsCtx);
+#endif
+#ifdef _WIN32  /* for Windows */
+    WSACleanup();
+#endif
+}
+
+/**
+* @brief   : Connect - open a TCP connection (and a TLS session if required) to the host
+* @param[I]: host (host name)
+* @param[I]: port (port number)
+* @param[I]: tls (true: start TLS immediately after connecting)
+* @param[O]: none
+* @return  : connection (nullptr: failed)
+* @note    :
+**/
+NetUtil::conn_t *NetUtil::Connect(const string &host, int port, bool tls)
+{
+    struct addrinfo hints, *res = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    string sPort = to_string(port);
+    MetricsUtil::timing_t *tm = MetricsUtil::Current();
+    double t0 = MetricsUtil::Now();
+    int err = getaddrinfo(host.c_str(), sPort.c_str(), &hints, &res);
+    if (tm) tm->dns += MetricsUtil::Now() - t0;
+    if (err != 0 || !res)
+    {
+        cerr << "*** WARNING(NetUtil::Connect): failed to resolve host " << host << endl;
+
+        return nullptr;
+    }
+
+    socket_t fd = SOCKET_INVALID;
+    char ip[NI_MAXHOST] = { '\0' };
+    t0 = MetricsUtil::Now();
+    for (struct addrinfo *ai = res; ai; ai = ai->ai_next)
+    {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd == SOCKET_INVALID) continue;
+
+        /* non-blocking connect to apply the timeout */
+#ifdef _WIN32  /* for Windows */
+        u_long mode = 1;
+        ioctlsocket(fd, FIONBIO, &mode);
+#else          /* for Linux or Mac */
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+#endif
+        bool ok = connect(fd, ai->ai_addr, (int)ai->ai_addrlen) == 0;
+        if (!ok)
+        {
+            if (Wait(fd, true) > 0)
+            {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, (char *)&err, &len);
+                ok = err == 0;
+            }
+        }
+#ifdef _WIN32  /* for Windows */
+        mode = 0;
+        ioctlsocket(fd, FIONBIO, &mode);
+#else          /* for Linux or Mac */
+        fcntl(fd, F_SETFL, flags);
+#endif
+        if (ok)
+        {
+            getnameinfo(ai->ai_addr, (socklen_t)ai->ai_addrlen, ip, sizeof(ip), nullptr, 0, NI_NUMERICHOST);
+            break;
+        }
+        closesock(fd);
+        fd = SOCKET_INVALID;
+    }
+    freeaddrinfo(res);
+    if (tm) tm->connect += MetricsUtil::Now() - t0;
+    if (fd == SOCKET_INVALID)
+    {
+        cerr << "*** WARNING(NetUtil::Connect): failed to connect " << host << ":" << port << endl;
+
+        return nullptr;
+    }
+
+    /* timeout for blocking send/receive */
+#ifdef _WIN32  /* for Windows */
+    DWORD tmo = NET_TIMEOUT * 1000;
+#else          /* for Linux or Mac */
+    struct timeval tmo = { NET_TIMEOUT, 0 };
+#endif
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char *)&tmo, sizeof(tmo));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, (const char *)&tmo, sizeof(tmo));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
+
+    conn_t *conn = new conn_t;
+    conn->host = host;
+    conn->peerIp = ip;
+    conn->fd = fd;
+    conn->ssl = nullptr;
+    conn->gen = 0;
+    if (tls && !StartTls(conn, nullptr))
+    {
+        Close(conn);
+
+        return nullptr;
+    }
+
+    return conn;
+} /* end of Connect */
+
+/**
+* @brief   : StartTls - start TLS session on a connected socket
+* @param[I]: conn (connection)
+* @param[I]: reuse (the connection whose TLS session is reused, nullptr: new session)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the session of FTPS control connection is reused on the data connections as most of the servers require
+**/
+bool NetUtil::StartTls(conn_t *conn, const conn_t *reuse)
+{
+#ifndef NOTLS
+    {
+        std::lock_guard<std::mutex> lock(_tlsLock);
+        if (!_tlsCtx)
+        {
+            _tlsCtx = SSL_CTX_new(TLS_client_method());
+            if (!_tlsCtx) return false;
+            SSL_CTX_set_default_verify_paths(_tlsCtx);
+            SSL_CTX_set_verify(_tlsCtx, SSL_VERIFY_PEER, nullptr);
+            SSL_CTX_set_session_cache_mode(_tlsCtx, SSL_SESS_CACHE_CLIENT);
+        }
+    }
+
+    SSL *ssl = SSL_new(_tlsCtx);
+    if (!ssl) return false;
+    SSL_set_fd(ssl, (int)conn->fd);
+    SSL_set_tlsext_host_name(ssl, conn->host.c_str());
+    SSL_set1_host(ssl, conn->host.c_str());
+    if (reuse && reuse->ssl)
+    {
+        SSL_SESSION *sess = SSL_get1_session(reuse->ssl);
+        if (sess)
+        {
+            SSL_set_session(ssl, sess);
+            SSL_SESSION_free(sess);
+        }
+    }
+    MetricsUtil::timing_t *tm = MetricsUtil::Current();
+    double t0 = MetricsUtil::Now();
+    int ret = SSL_connect(ssl);
+    if (tm) tm->tls += MetricsUtil::Now() - t0;
+    if (ret != 1)
+    {
+        char err[256] = { '\0' };
+        ERR_error_string_n(ERR_get_error(), err, sizeof(err));
+        cerr << "*** WARNING(NetUtil::StartTls): TLS handshake with " << conn->host << " failed: " << err << endl;
+        SSL_free(ssl);
+
+        return false;
+    }
+    conn->ssl = ssl;
+
+    return true;
+#else
+    cerr << "*** WARNING(NetUtil::StartTls): TLS is NOT supported in this build (NOTLS)" << endl;
+
+    return false;
+#endif
+} /* end of StartTls */
+
+/**
+* @brief   : Close - close the connection and free it
+* @param[I]: conn (connection)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::Close(conn_t *conn)
+{
+    if (!conn) return;
+#ifndef NOTLS
+    if (conn->ssl)
+    {
+        SSL_shutdown(conn->ssl);
+        SSL_free(conn->ssl);
+    }
+#endif
+    if (conn->fd != SOCKET_INVALID) closesock(conn->fd);
+    delete conn;
+} /* end of Close */
+
+/**
+* @brief   : Send - send the bytes on the connection
+* @param[I]: conn (connection)
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool NetUtil::Send(conn_t *conn, const char *buff, size_t n)
+{
+    while (n > 0)
+    {
+        int ns;
+#ifndef NOTLS
+        if (conn->ssl) ns = SSL_write(conn->ssl, buff, (int)n);
+        else
+#endif
+        ns = (int)send(conn->fd, buff, (int)n, MSG_NOSIGNAL);
+        if (ns < 0 && errno == EINTR) continue;
+        if (ns <= 0) return false;
+        buff += ns;
+        n -= ns;
+    }
+
+    return true;
+} /* end of Send */
+
+/**
+* @brief   : Cancelled - check if the transfer running in the thread is cancelled
+* @param[I]: none
+* @param[O]: none
+* @return  : true: cancelled, false: NOT cancelled or NOT cancellable
+* @note    : see SetCancel
+**/
+bool NetUtil::Cancelled()
+{
+    return _cancel && _cancel->load();
+} /* end of Cancelled */
+
+/**
+* @brief   : Wait - wait until the socket is ready to read (or to write, i.e., connected)
+* @param[I]: fd (socket descriptor)
+* @param[I]: write (true: ready to write, false: ready to read)
+* @param[O]: none
+* @return  : 1: ready, 0: timeout or cancelled, -1: error
+* @note    : the cancellable transfer waits in slices of NET_SLICE, so it is given up soon after it is cancelled
+**/
+int NetUtil::Wait(socket_t fd, bool write)
+{
+    double t0 = MetricsUtil::Now();
+    while (true)
+    {
+        if (Cancelled()) return 0;
+        double left = NET_TIMEOUT - (MetricsUtil::Now() - t0);
+        if (left <= 0.0) return 0;
+        if (_cancel && left > NET_SLICE) left = NET_SLICE;
+
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(fd, &set);
+        struct timeval tv;
+        tv.tv_sec = (long)left;
+        tv.tv_usec = (long)((left - tv.tv_sec) * 1.0E6);
+        int ns = select((int)fd + 1, write ? nullptr : &set, write ? &set : nullptr, nullptr, &tv);
+        if (ns > 0) return 1;
+        if (ns < 0 && errno != EINTR) return -1;
+    }
+} /* end of Wait */
+
+/**
+* @brief   : RecvRaw - receive the bytes from the socket (or TLS session) of the connection
+* @param[I]: conn (connection)
+* @param[O]: buff (bytes)
+* @param[I]: n (size of buffer)
+* @return  : number of bytes received (0: end of stream, -1: error or cancelled)
+* @note    : the call interrupted by a signal (i.e., SIGCHLD of 'wget' run by another thread) is restarted, and the
+*            cancellable transfer waits for the bytes by Wait at first
+**/
+int NetUtil::RecvRaw(conn_t *conn, char *buff, size_t n)
+{
+    int nr;
+    while (true)
+    {
+        /* the bytes already decrypted in the TLS session are NOT seen by the socket */
+        bool pending = false;
+#ifndef NOTLS
+        pending = conn->ssl && SSL_pending(conn->ssl) > 0;
+#endif
+        if (_cancel && !pending && Wait(conn->fd, false) <= 0) return -1;
+#ifndef NOTLS
+        if (conn->ssl)
+        {
+            nr = SSL_read(conn->ssl, buff, (int)n);
+            if (nr > 0) return nr;
+            int err = SSL_get_error(conn->ssl, nr);
+            if (err == SSL_ERROR_ZERO_RETURN) return 0;
+            if (err == SSL_ERROR_SYSCALL && errno == EINTR) continue;
+
+            return -1;
+        }
+#endif
+        nr = (int)recv(conn->fd, buff, (int)n, 0);
+        if (nr >= 0) return nr;
+        if (errno != EINTR) return -1;
+    }
+} /* end of RecvRaw */
+
+/**
+* @brief   : Recv - receive the bytes from the connection
+* @param[I]: conn (connection)
+* @param[O]: buff (bytes)
+* @param[I]: n (size of buffer)
+* @return  : number of bytes received (0: end of stream, -1: error)
+* @note    : the bytes buffered in conn->rbuf are returned at first
+**/
+int NetUtil::Recv(conn_t *conn, char *buff, size_t n)
+{
+    if (!conn->rbuf.empty())
+    {
+        size_t nr = MIN(n, conn->rbuf.size());
+        memcpy(buff, conn->rbuf.data(), nr);
+        conn->rbuf.erase(0, nr);
+
+        return (int)nr;
+    }
+
+    return RecvRaw(conn, buff, n);
+} /* end of Recv */
+
+/**
+* @brief   : ReadLine - read one line (without CR/LF) from the connection
+* @param[I]: conn (connection)
+* @param[O]: line (the line read)
+* @return  : true:ok, false:error or end of stream
+* @note    :
+**/
+bool NetUtil::ReadLine(conn_t *conn, string &line)
+{
+    size_t pos;
+    while ((pos = conn->rbuf.find('\n')) == string::npos)
+    {
+        char buff[4096];
+        int nr = RecvRaw(conn, buff, sizeof(buff));
+        if (nr <= 0) return false;
+        conn->rbuf.append(buff, nr);
+    }
+    line = conn->rbuf.substr(0, pos);
+    conn->rbuf.erase(0, pos + 1);
+    if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+
+    return true;
+} /* end of ReadLine */
+
+/**
+* @brief   : Acquire - take an idle connection from the pool or open a new one
+* @param[I]: u (URL)
+* @param[O]: reused (true: the connection came from the pool, nullptr:NO output)
+* @return  : connection (nullptr: failed)
+* @note    : FTP control connections are returned logged in with binary type. The request waits for the window of
+*            the host at first if the windows are adjusted by AIMD (see SetAimd), and the login refused by the host
+*            is tried again up to NET_MAXREFUSED times. The wait for a connection released is given up if the
+*            transfer is cancelled (see SetCancel)
+**/
+NetUtil::conn_t *NetUtil::Acquire(const url_t &u, bool *reused)
+{
+    string key = u.scheme + "://" + (u.user.empty() ? "" : u.user + "@") + u.host + ":" + to_string(u.port);
+    if (reused) *reused = false;
+    bool isFtp = u.scheme == "ftp" || u.scheme == "ftps";
+    for (int itry = 0; itry <= NET_MAXREFUSED; itry++)
+    {
+        int gen = _aimd ? _aimd->Enter(u.host) : 0;
+        {
+            StringUtil str;
+            string host = u.host;
+            str.ToLower(host);
+            std::unique_lock<std::mutex> lock(_poolLock);
+            int limit = _defLimit;
+            for (size_t i = 0; i < _hostLimits.size(); i++)
+            {
+                if (host.find(_hostLimits[i].first) == string::npos) continue;
+                limit = _hostLimits[i].second;
+                break;
+            }
+            while (true)
+            {
+                std::vector<conn_t *> &idle = _idle[key];
+                if (!idle.empty())
+                {
+                    conn_t *conn = idle.back();
+                    idle.pop_back();
+                    conn->gen = gen;
+                    if (reused) *reused = true;
+
+                    return conn;
+                }
+                if (limit <= 0 || _nconn[key] < limit) break;
+                if (Cancelled())
+                {
+                    lock.unlock();
+                    if (_aimd) _aimd->Leave(u.host);
+
+                    return nullptr;
+                }
+                if (_cancel) _poolFree.wait_for(lock, std::chrono::duration<double>(NET_SLICE));
+                else _poolFree.wait(lock);
+            }
+            _nconn[key]++;
+        }
+
+        int code = 0;
+        conn_t *conn = Connect(u.host, u.port, u.scheme == "https");
+        if (conn)
+        {
+            conn->key = key;
+            conn->gen = gen;
+            if (!isFtp || FtpLogin(conn, u, &code)) return conn;
+            Close(conn);
+        }
+        if (_aimd)
+        {
+            if (!conn) _aimd->Backoff(u.host, "connect", gen);
+            _aimd->Leave(u.host);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_poolLock);
+            _nconn[key]--;
+            _poolFree.notify_all();
+        }
+
+        /* the login refused by the busy host (i.e., "421 Too many connections") is tried again when the requests in
+           flight are within the window halved */
+        if (!_aimd || (code != 421 && code != 530)) break;
+    }
+
+    return nullptr;
+} /* end of Acquire */
+
+/**
+* @brief   : Release - put the connection back to the pool or close it
+* @param[I]: conn (connection)
+* @param[I]: keep (true: the connection can be reused)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::Release(conn_t *conn, bool keep)
+{
+    if (!conn) return;
+    if (_aimd) _aimd->Leave(conn->host);
+    {
+        std::lock_guard<std::mutex> lock(_poolLock);
+        if (keep) _idle[conn->key].push_back(conn);
+        else _nconn[conn->key]--;
+        _poolFree.notify_all();
+    }
+    if (!keep) Close(conn);
+} /* end of Release */
+
+/**
+* @brief   : CloseIdle - close the idle connections of a key of the pool
+* @param[I]: key (the key in the connection pool)
+* @param[O]: none
+* @return  : none
+* @note    : it is called when a connection reused is found stale, since the others idle as long have most likely
+*            been closed by the server as well, so the request tried again opens a new connection
+**/
+void NetUtil::CloseIdle(const string &key)
+{
+    std::vector<conn_t *> conns;
+    {
+        std::lock_guard<std::mutex> lock(_poolLock);
+        conns.swap(_idle[key]);
+        _nconn[key] -= (int)conns.size();
+        _poolFree.notify_all();
+    }
+    for (size_t i = 0; i < conns.size(); i++) Close(conns[i]);
+} /* end of CloseIdle */
+
+/**
+* @brief   : FtpReply - read a (multi-line) reply from the FTP control connection
+* @param[I]: conn (control connection)
+* @param[O]: reply (the last line of reply, nullptr:NO output)
+* @return  : reply code (-1: error)
+* @note    :
+**/
+int NetUtil::FtpReply(conn_t *conn, string *reply)
+{
+    string line;
+    if (!ReadLine(conn, line) || line.size() < 3) return -1;
+
+    /* multi-line reply: "ddd-" ... "ddd " */
+    if (line.size() > 3 && line[3] == '-')
+    {
+        string code = line.substr(0, 3);
+        do
+        {
+            if (!ReadLine(conn, line)) return -1;
+        } while (!(line.size() >= 4 && line.compare(0, 3, code) == 0 && line[3] == ' '));
+    }
+    if (reply) *reply = line;
+
+    return atoi(line.substr(0, 3).c_str());
+} /* end of FtpReply */
+
+/**
+* @brief   : FtpCmd - send a command on the FTP control connection and read the reply
+* @param[I]: conn (control connection)
+* @param[I]: cmd (command without CR/LF)
+* @param[O]: reply (the last line of reply, nullptr:NO output)
+* @return  : reply code (-1: error)
+* @note    :
+**/
+int NetUtil::FtpCmd(conn_t *conn, const string &cmd, string *reply)
+{
+    string line = cmd + "\r\n";
+    if (!Send(conn, line.c_str(), line.size())) return -1;
+
+    return FtpReply(conn, reply);
+} /* end of FtpCmd */
+
+/**
+* @brief   : FtpLogin - log in the FTP server and set the binary type
+* @param[I]: conn (control connection)
+* @param[I]: u (URL)
+* @param[O]: code (the reply code of the greeting or the login refused, i.e., 421 or 530, nullptr:NO output)
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool NetUtil::FtpLogin(conn_t *conn, const url_t &u, int *code)
+{
+    string reply;
+    int rc = FtpReply(conn, &reply);
+    if (code) *code = rc;
+    if (rc == 421 && _aimd) _aimd->Backoff(u.host, "421", conn->gen);  /* i.e., "421 Too many connections" */
+    if (rc != 220)
+    {
+        cerr << "*** WARNING(NetUtil::FtpLogin): unexpected greeting from " << u.host << ": " << reply << endl;
+
+        return false;
+    }
+
+    if (u.scheme == "ftps")  /* explicit FTP over TLS */
+    {
+        if (FtpCmd(conn, "AUTH TLS", &reply) != 234 || !StartTls(conn, nullptr))
+        {
+            cerr << "*** WARNING(NetUtil::FtpLogin): AUTH TLS refused by " << u.host << ": " << reply << endl;
+
+            return false;
+        }
+        FtpCmd(conn, "PBSZ 0", nullptr);
+        if (FtpCmd(conn, "PROT P", &reply) != 200)
+        {
+            cerr << "*** WARNING(NetUtil::FtpLogin): PROT P refused by " << u.host << ": " << reply << endl;
+
+            return false;
+        }
+    }
+
+    string user = u.user.empty() ? FTP_ANONYMOUS : u.user;
+    string passwd = u.user.empty() ? FTP_PASSWORD : u.passwd;
+    rc = FtpCmd(conn, "USER " + user, &reply);
+    if (rc == 331) rc = FtpCmd(conn, "PASS " + passwd, &reply);
+    if (code) *code = rc;
+    if ((rc == 421 || rc == 530) && _aimd) _aimd->Backoff(u.host, to_string(rc), conn->gen);  /* i.e., "530 Too many users" */
+    if (rc != 230 && rc != 202)
+    {
+        if (!Cancelled()) cerr << "*** WARNING(NetUtil::FtpLogin): login to " << u.host << " failed: " << reply << endl;
+
+        return false;
+    }
+    if (FtpCmd(conn, "TYPE I", &reply) != 200) return false;
+
+    return true;
+} /* end of FtpLogin */
+
+/**
+* @brief   : FtpTransfer - run a command with passive data connection (i.e., "NLST" or "RETR")
+* @param[I]: ctrl (control connection)
+* @param[I]: cmd (command)
+* @param[I]: tls (true: protected data connection)
+* @param[I]: offset (the bytes to be skipped from the start of the file, "REST" is sent if it is NOT zero)
+* @param[I]: sink (receiver of the data)
+* @param[O]: code (the reply code of the command)
+* @param[O]: usable (true: the control connection is still usable, whether the transfer is ok or NOT)
+* @param[O]: size (the size of the file given by the reply of the command, i.e., "150 ... (2766034 bytes)", -1: unknown)
+* @return  : true: the command is finished, i.e., the file is transferred completely or it is refused by the reply,
+*            false: error, i.e., the transfer is broken, short, or the bytes are rejected by the sink
+* @note    : code is 450 or 550 if the remote file or directory does not exist. If the server does NOT accept "REST",
+*            the whole file is transferred and the bytes before the offset are dropped. The size is taken ONLY if
+*            the offset is zero, since the servers differ in the size given for "REST"
+**/
+bool NetUtil::FtpTransfer(conn_t *ctrl, const string &cmd, bool tls, long long offset, const sink_t &sink, int *code,
+    bool *usable, long long *size)
+{
+    /* passive mode, EPSV at first and then PASV */
+    string reply;
+    int port = -1;
+    *usable = false;
+    *size = -1;
+    *code = FtpCmd(ctrl, "EPSV", &reply);
+    if (*code == 229)
+    {
+        size_t pos = reply.find("(|||");
+        if (pos != string::npos) port = atoi(reply.c_str() + pos + 4);
+    }
+    else if (*code > 0)
+    {
+        *code = FtpCmd(ctrl, "PASV", &reply);
+        if (*code == 227)
+        {
+            int h[6] = { 0 };
+            size_t pos = reply.find('(');
+            if (pos != string::npos && sscanf(reply.c_str() + pos + 1, "%d,%d,%d,%d,%d,%d", h, h + 1, h + 2, h + 3, h + 4, h + 5) == 6)
+                port = h[4] * 256 + h[5];
+        }
+    }
+    *usable = *code >= 0 && *code != 421;
+    if (port <= 0) return false;
+
+    /* the address in PASV reply may be private, so the address of control connection is used */
+    conn_t *data = Connect(ctrl->peerIp, port, false);
+    if (!data) return false;
+    data->host = ctrl->host;
+
+    long long skip = 0;
+    if (offset > 0)
+    {
+        *code = FtpCmd(ctrl, "REST " + to_string(offset), &reply);
+        if (*code < 0)
+        {
+            Close(data);
+            *usable = false;
+
+            return false;
+        }
+        if (*code != 350) skip = offset;
+    }
+
+    *code = FtpCmd(ctrl, cmd, &reply);
+    if (*code != 125 && *code != 150)
+    {
+        Close(data);
+        *usable = *code >= 0 && *code != 421;
+
+        return *code >= 400;  /* refused, i.e., the file does not exist */
+    }
+    size_t pos = reply.find_last_of('(');
+    long long nsize = -1;
+    if (offset == 0 && pos != string::npos && sscanf(reply.c_str() + pos + 1, "%lld bytes", &nsize) == 1 &&
+        reply.find(" bytes", pos) != string::npos) *size = nsize;
+    if (tls && !StartTls(data, ctrl))
+    {
+        Close(data);
+        *code = -1;
+        *usable = false;
+
+        return false;
+    }
+
+    bool ok = true;
+    std::vector<char> buff(NET_BUFFSIZE);
+    int nr;
+    while ((nr = Recv(data, buff.data(), buff.size())) > 0)
+    {
+        int n0 = (int)MIN((long long)nr, skip);
+        skip -= n0;
+        if (nr > n0 && !sink(buff.data() + n0, nr - n0))
+        {
+            ok = false;
+            break;
+        }
+    }
+    if (nr < 0 || skip > 0) ok = false;
+    Close(data);
+
+    /* "226 Transfer complete", which may be sent even if the sink rejected the bytes or the transfer was short, so
+       the file is NOT taken as complete by the reply alone */
+    *code = FtpReply(ctrl, &reply);
+    *usable = *code >= 0 && *code != 421;
+    if (*code < 0) return false;
+    if (ok && *code >= 400) *code = 550;
+
+    return ok;
+} /* end of FtpTransfer */
+
+/**
+* @brief   : FtpGet - download or list via FTP/FTPS
+* @param[I]: u (URL)
+* @param[I]: list (true: "NLST" for directory, false: "RETR" for file)
+* @param[I]: offset (the bytes to be skipped from the start of the file)
+* @param[I]: sink (receiver of the data)
+* @param[O]: size (the size of the remote file, -1: unknown, nullptr: NOT asked)
+* @return  : true:ok, false:error
+* @note    : a stale pooled connection is replaced and the command is tried once more. The size is asked by "SIZE"
+*            after the transfer if it is NOT given by the reply of "RETR"
+**/
+bool NetUtil::FtpGet(const url_t &u, bool list, long long offset, const sink_t &sink, long long *size)
+{
+    string cmd = (list ? "NLST " : "RETR ") + u.path;
+    for (int itry = 0; itry < 2; itry++)
+    {
+        bool reused = false;
+        conn_t *ctrl = Acquire(u, &reused);
+        if (!ctrl) return false;
+
+        /* nothing may be given to the sink before a stale connection is detected */
+        size_t nbytes = 0;
+        sink_t counted = [&](const char *buff, size_t n) { nbytes += n; return sink(buff, n); };
+        int code = -1;
+        bool usable = false;
+        long long nsize = -1;
+        bool ok = FtpTransfer(ctrl, cmd, u.scheme == "ftps", offset, counted, &code, &usable, &nsize);
+        if (code < 0 || code == 421)
+        {
+            /* a stale pooled connection is NOT the sign of congestion, nor is the transfer cancelled */
+            bool cancelled = Cancelled();
+            if (_aimd && !cancelled && (code == 421 || !reused || nbytes > 0))
+                _aimd->Backoff(u.host, code == 421 ? "421" : "reset", ctrl->gen);
+            if (reused && !cancelled) CloseIdle(ctrl->key);
+            Release(ctrl, false);
+            if (cancelled) return false;
+            MetricsUtil::timing_t *tm = MetricsUtil::Current();
+            if (reused && nbytes == 0 && tm) tm->retries++;
+            if (reused && nbytes == 0) continue;
+
+            return false;
+        }
+
+        /* the size is checked against the bytes transferred by the caller (see GetPart), since "226" may be replied to
+           the transfer cut short */
+        if (ok && size && code < 400)
+        {
+            string reply;
+            if (nsize < 0 && usable)
+            {
+                int code2 = FtpCmd(ctrl, "SIZE " + u.path, &reply);
+                if (code2 == 213) nsize = strtoll(reply.c_str() + 4, nullptr, 10);
+                if (code2 < 0 || code2 == 421) usable = false;
+            }
+            *size = nsize;
+        }
+        Release(ctrl, usable);
+        if (!ok) return false;
+
+        /* 450/550: the file or directory does not exist, an empty list is NOT an error */
+        if (code == 450 || code == 550) return list;
+
+        return code < 400;
+    }
+
+    return false;
+} /* end of FtpGet */
+
+/**
+* @brief   : FtpStat - get the size and modification time of a remote file via FTP/FTPS
+* @param[I]: u (URL)
+* @param[I]: full (true: both of them, false: "SIZE" is sent ONLY if "MDTM" is NOT supported)
+* @param[O]: remote (size and modification time of the remote file)
+* @return  : true:ok, false:error
+* @note    : "SIZE" and "MDTM" (RFC 3659) are used, and the modification time is unknown (0) if "MDTM" is NOT supported.
+*            It costs a round trip ONLY if 'full' is off and "MDTM" is supported
+**/
+bool NetUtil::FtpStat(const url_t &u, bool full, remote_t &remote)
+{
+    for (int itry = 0; itry < 2; itry++)
+    {
+        bool reused = false;
+        conn_t *ctrl = Acquire(u, &reused);
+        if (!ctrl) return false;
+
+        /* i.e., "213 20220202013108" and "213 2766034" */
+        string reply;
+        remote.size = -1;
+        remote.mtime = 0;
+        int code = FtpCmd(ctrl, "MDTM " + u.path, &reply);
+        int year, mon, day, hour, min, sec;
+        if (code == 213 && sscanf(reply.c_str() + 4, "%4d%2d%2d%2d%2d%2d", &year, &mon, &day, &hour, &min, &sec) == 6)
+            remote.mtime = UtcTime(year, mon, day, hour, min, sec);
+        if (code >= 0 && code != 421 && (full || remote.mtime == 0))
+        {
+            code = FtpCmd(ctrl, "SIZE " + u.path, &reply);
+            if (code == 213) remote.size = strtoll(reply.c_str() + 4, nullptr, 10);
+        }
+        if (code < 0 || code == 421)
+        {
+            bool cancelled = Cancelled();
+            if (_aimd && !cancelled && (code == 421 || !reused)) _aimd->Backoff(u.host, code == 421 ? "421" : "reset", ctrl->gen);
+            if (reused && !cancelled) CloseIdle(ctrl->key);
+            Release(ctrl, false);
+            if (reused && !cancelled) continue;
+
+            return false;
+        }
+        Release(ctrl, true);
+
+        return remote.size >= 0 || (!full && remote.mtime > 0);
+    }
+
+    return false;
+} /* end of FtpStat */
+
+/**
+* @brief   : ReadBody - read HTTP message body to the sink
+* @param[I]: conn (connection)
+* @param[I]: chunked (true: chunked transfer coding)
+* @param[I]: length (content length, -1: until the end of stream)
+* @param[I]: sink (receiver of the data, nullptr: discard)
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool NetUtil::ReadBody(conn_t *conn, bool chunked, long long length, const sink_t *sink)
+{
+    std::vector<char> buff(NET_BUFFSIZE);
+    if (chunked)
+    {
+        string line;
+        while (true)
+        {
+            if (!ReadLine(conn, line)) return false;
+            long long size = strtoll(line.c_str(), nullptr, 16);
+            if (size <= 0) break;
+            while (size > 0)
+            {
+                int nr = Recv(conn, buff.data(), (size_t)MIN((long long)buff.size(), size));
+                if (nr <= 0) return false;
+                if (sink && !(*sink)(buff.data(), nr)) return false;
+                size -= nr;
+            }
+            if (!ReadLine(conn, line)) return false;  /* CRLF after the chunk */
+        }
+        /* trailer */
+        while (ReadLine(conn, line) && !line.empty());
+
+        return true;
+    }
+
+    while (length != 0)
+    {
+        size_t n = length < 0 ? buff.size() : (size_t)MIN((long long)buff.size(), length);
+        int nr = Recv(conn, buff.data(), n);
+        if (nr < 0) return false;
+        if (nr == 0) return length < 0;
+        if (sink && !(*sink)(buff.data(), nr)) return false;
+        if (length > 0) length -= nr;
+    }
+
+    return true;
+} /* end of ReadBody */
+
+/**
+* @brief   : HttpGet - download via HTTP/HTTPS with keep-alive and redirection
+* @param[I]: url (URL)
+* @param[I]: sink (receiver of the data, nullptr: "HEAD" instead of "GET")
+* @param[I]: offset (the bytes to be skipped from the start of the file, "Range" is sent if it is NOT zero)
+* @param[I]: known (the remote file known, "If-Modified-Since" and "If-None-Match" are sent with its modification
+*            time and entity tag if they are known, nullptr: NOT conditional)
+* @param[I]: nredir (number of redirections followed so far)
+* @param[O]: remote (size, modification time, and entity tag of the remote file, nullptr:NO output)
+* @return  : true:ok, false:error
+* @note    : if the server does NOT accept "Range", the whole file is transferred and the bytes before the offset are
+*            dropped. The file NOT modified (304) is ok with nothing given to the sink, and it is given as 'known'
+**/
+bool NetUtil::HttpGet(const string &url, const sink_t *sink, long long offset, const remote_t *known, int nredir,
+    remote_t *remote)
+{
+    url_t u;
+    if (!ParseUrl(url, u)) return false;
+
+    for (int itry = 0; itry < 2; itry++)
+    {
+        bool reused = false;
+        conn_t *conn = Acquire(u, &reused);
+        if (!conn) return false;
+
+        string host = u.host;
+        if ((u.scheme == "http" && u.port != 80) || (u.scheme == "https" && u.port != 443)) host += ":" + to_string(u.port);
+        string req = (sink ? "GET " : "HEAD ") + u.path + " HTTP/1.1\r\n"
+            "Host: " + host + "\r\n"
+            "User-Agent: " HTTP_AGENT "\r\n"
+            "Accept: */*\r\n";
+        if (offset > 0) req += "Range: bytes=" + to_string(offset) + "-\r\n";
+        if (known && !known->etag.empty()) req += "If-None-Match: " + known->etag + "\r\n";
+        if (known && known->mtime > 0) req += "If-Modified-Since: " + HttpTime(known->mtime) + "\r\n";
+        req += "Connection: keep-alive\r\n\r\n";
+        string line;
+        if (!Send(conn, req.c_str(), req.size()) || !ReadLine(conn, line))
+        {
+            bool cancelled = Cancelled();
+            if (_aimd && !cancelled && !reused) _aimd->Backoff(u.host, "reset", conn->gen);
+            if (reused && !cancelled) CloseIdle(conn->key);
+            Release(conn, false);
+            if (cancelled) return false;
+            MetricsUtil::timing_t *tm = MetricsUtil::Current();
+            if (reused && tm) tm->retries++;
+            if (reused) continue;
+
+            return false;
+        }
+
+        /* status line, i.e., "HTTP/1.1 200 OK" */
+        int status = 0;
+        bool http10 = line.compare(0, 8, "HTTP/1.0") == 0;
+        size_t pos = line.find(' ');
+        if (pos != string::npos) status = atoi(line.c_str() + pos + 1);
+        if ((status == 429 || status == 503) && _aimd) _aimd->Backoff(u.host, to_string(status), conn->gen);  /* i.e., "429 Too Many Requests" */
+
+        /* header fields */
+        long long length = -1, size = -1;
+        time_t mtime = 0;
+        bool chunked = false, keep = !http10;
+        string location, etag;
+        StringUtil str;
+        while (ReadLine(conn, line) && !line.empty())
+        {
+            pos = line.find(':');
+            if (pos == string::npos) continue;
+            string name = line.substr(0, pos), value = line.substr(pos + 1);
+            str.ToLower(name);
+            str.TrimSpace4String(value);
+            if (name == "content-length") length = strtoll(value.c_str(), nullptr, 10);
+            else if (name == "transfer-encoding") { str.ToLower(value); chunked = value.find("chunked") != string::npos; }
+            else if (name == "connection") { str.ToLower(value); if (value == "close") keep = false; else if (value == "keep-alive") keep = true; }
+            else if (name == "location") location = value;
+            else if (name == "last-modified") mtime = ParseHttpTime(value);
+            else if (name == "etag") etag = value;
+            else if (name == "content-range" && (pos = value.find('/')) != string::npos) size = strtoll(value.c_str() + pos + 1, nullptr, 10);
+        }
+        /* the response to the conditional request has NO body (see List and Revalidate) */
+        if (status == 304 && known)
+        {
+            Release(conn, keep);
+            if (remote) *remote = *known;
+
+            return true;
+        }
+        if (status == 200) size = length;
+        if (remote)
+        {
+            remote->size = size;
+            remote->mtime = mtime;
+            remote->etag = etag;
+        }
+
+        /* the response to "HEAD" has NO body, and the request refused by the busy host is tried once more when the
+           requests in flight are within the window halved */
+        bool redirect = status >= 300 && status < 400 && !location.empty();
+        bool refused = (status == 429 || status == 503) && _aimd && itry == 0;
+        if (!sink)
+        {
+            Release(conn, keep);
+            if (refused) continue;
+            if (!redirect) return status == 200;
+        }
+        else
+        {
+            if (!chunked && length < 0) keep = false;
+            if (redirect || (status != 200 && !(status == 206 && offset > 0)))
+            {
+                /* the body NOT wanted is read ONLY if its length is known and small, otherwise the connection is
+                   closed instead of waiting for the end of the body (or the timeout of a keep-alive connection) */
+                keep = keep && !chunked && length >= 0 && length <= NET_MAXDRAIN && ReadBody(conn, false, length, nullptr);
+                Release(conn, keep);
+                if (refused) continue;
+                if (!redirect) return false;
+            }
+        }
+
+        if (redirect)
+        {
+            if (nredir >= MAXREDIRECT) return false;
+
+            /* relative reference */
+            if (location.find("://") == string::npos)
+            {
+                string base = u.scheme + "://" + host;
+                if (location[0] == '/') location = base + location;
+                else location = base + u.path.substr(0, u.path.find_last_of('/') + 1) + location;
+            }
+
+            /* the location given by the proxy is sent through it again by ParseUrl */
+            location = Unproxy(location);
+
+            return HttpGet(location, sink, offset, known, nredir + 1, remote);
+        }
+
+        /* the whole file is sent if "Range" is NOT accepted */
+        long long skip = status == 200 ? offset : 0;
+        sink_t skipped = [&skip, sink](const char *buff, size_t n)
+        {
+            size_t n0 = (size_t)MIN((long long)n, skip);
+            skip -= n0;
+
+            return n == n0 || (*sink)(buff + n0, n - n0);
+        };
+        bool ok = ReadBody(conn, chunked, length, &skipped) && skip == 0;
+        Release(conn, ok && keep);
+
+        return ok;
+    }
+
+    return false;
+} /* end of HttpGet */
+
+/**
+* @brief   : ListFile - get the name of the file where the listing of the remote directory is persisted
+* @param[I]: url (URL of the directory)
+* @param[O]: none
+* @return  : local file with full path
+* @note    : the name is the FNV-1a hash of the URL, which contains the year and day of year of the directory
+**/
+string NetUtil::ListFile(const string &url)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < url.size(); i++)
+    {
+        hash ^= (unsigned char)url[i];
+        hash *= 1099511628211ULL;
+    }
+
+    char name[32] = { '\0' };
+    sprintf(name, "%016llx.list", hash);
+    StringUtil str;
+
+    return str.FullPath(_listDir, name);
+} /* end of ListFile */
+
+/**
+* @brief   : LoadListing - read the persisted listing of the remote directory
+* @param[I]: url (URL of the directory)
+* @param[O]: names (file names in the directory)
+* @param[O]: time (the time when the directory was listed)
+* @return  : true: the listing is found and NOT expired, false: otherwise
+* @note    :
+**/
+bool NetUtil::LoadListing(const string &url, std::vector<string> &names, time_t &time)
+{
+    if (_listDir.empty() || _listTtl <= 0) return false;
+
+    string listFile = ListFile(url);
+    struct stat st;
+    if (stat(listFile.c_str(), &st) != 0) return false;
+    if (::time(NULL) - st.st_mtime > _listTtl) return false;
+
+    ifstream lst(listFile.c_str());
+    if (!lst.is_open()) return false;
+
+    /* the first line is the URL, to be safe from the collision of the hash */
+    string line;
+    if (!getline(lst, line) || line != url) return false;
+    names.clear();
+    while (getline(lst, line))
+    {
+        if (!line.empty()) names.push_back(line);
+    }
+    time = st.st_mtime;
+
+    return true;
+} /* end of LoadListing */
+
+/**
+* @brief   : SaveListing - persist the listing of the remote directory
+* @param[I]: url (URL of the directory)
+* @param[I]: names (file names in the directory)
+* @param[O]: none
+* @return  : none
+* @note    : the listing is written to a temporary file and renamed, so the other processes never read a part of it
+**/
+void NetUtil::SaveListing(const string &url, const std::vector<string> &names)
+{
+    if (_listDir.empty() || _listTtl <= 0) return;
+
+    string listFile = ListFile(url);
+    char tmpName[64] = { '\0' };
+    sprintf(tmpName, ".%d.%llx.tmp", (int)getpid(), (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id()));
+    string tmpFile = listFile + tmpName;
+    FILE *fp = fopen(tmpFile.c_str(), "w");
+    if (!fp) return;
+
+    bool ok = fprintf(fp, "%s\n", url.c_str()) > 0;
+    for (size_t i = 0; i < names.size() && ok; i++) ok = fprintf(fp, "%s\n", names[i].c_str()) > 0;
+    if (fclose(fp) != 0) ok = false;
+    if (!ok || !FileUtil::Rename(tmpFile, listFile)) remove(tmpFile.c_str());
+} /* end of SaveListing */
+
+/**
+* @brief   : SetVerbose - print (or not) the information of every transfer
+* @param[I]: verbose (true: print)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::SetVerbose(bool verbose)
+{
+    _verbose = verbose;
+} /* end of SetVerbose */
+
+/**
+* @brief   : SetCancel - set the flag which cancels the transfers of the thread
+* @param[I]: cancel (the flag, true: the transfer is given up at its next wait, nullptr: NOT cancellable)
+* @param[O]: none
+* @return  : none
+* @note    : the transfer cancelled fails without being tried again, and its connection is closed, i.e., the
+*            hedged request lost (see MirrorUtil::Race)
+**/
+void NetUtil::SetCancel(const std::atomic<bool> *cancel)
+{
+    _cancel = cancel;
+} /* end of SetCancel */
+
+/**
+* @brief   : SetHostLimit - set the max number of connections to the host at the same time
+* @param[I]: host (part of the host name, i.e., "cddis" or "ign"; empty: the default for all hosts)
+* @param[I]: limit (max number of connections, 0: no limit)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::SetHostLimit(const string &host, int limit)
+{
+    StringUtil str;
+    string name = host;
+    str.TrimSpace4String(name);
+    str.ToLower(name);
+    if (limit < 0) limit = 0;
+
+    std::lock_guard<std::mutex> lock(_poolLock);
+    if (name.empty())
+    {
+        _defLimit = limit;
+
+        return;
+    }
+    for (size_t i = 0; i < _hostLimits.size(); i++)
+    {
+        if (_hostLimits[i].first != name) continue;
+        _hostLimits[i].second = limit;
+
+        return;
+    }
+    _hostLimits.push_back(std::make_pair(name, limit));
+} /* end of SetHostLimit */
+
+/**
+* @brief   : SetAimd - adjust the requests in flight per host by additive-increase/multiplicative-decrease
+* @param[I]: aimd (the windows of the hosts, nullptr: ONLY the limits of connections, see SetHostLimit)
+* @param[O]: none
+* @return  : none
+* @note    : it should be called before any transfer. The windows are widened by the transfers finished and
+*            halved by the refusals (FTP 421/530, HTTP 429/503) and the connections reset (see AimdUtil)
+**/
+void NetUtil::SetAimd(AimdUtil *aimd)
+{
+    _aimd = aimd;
+} /* end of SetAimd */
+
+/**
+* @brief   : SetRedirect - replace the prefix of the URLs, i.e., to download from a local stand-in of the archive
+* @param[I]: from (the prefix replaced, i.e., "ftps://gdc.cddis.eosdis.nasa.gov")
+* @param[I]: to (the replacement, i.e., "ftp://127.0.0.1:2121")
+* @param[O]: none
+* @return  : none
+* @note    : it should be called before any transfer. The URLs are replaced when they are parsed (see ParseUrl), so
+*            the listings, the manifest, the metrics, and the trace keep the original URLs
+**/
+void NetUtil::SetRedirect(const string &from, const string &to)
+{
+    StringUtil str;
+    string prefix = from, target = to;
+    str.TrimSpace4String(prefix);
+    str.TrimSpace4String(target);
+    if (prefix.empty() || target.empty()) return;
+
+    _redirects.push_back(std::make_pair(prefix, target));
+} /* end of SetRedirect */
+
+/**
+* @brief   : SetProxy - send every URL through the caching proxy of another GOOD (see ProxyUtil)
+* @param[I]: proxy (URL of the proxy, i.e., "http://192.168.1.10:8021", empty: none)
+* @param[O]: none
+* @return  : none
+* @note    : it should be called before any transfer. The URL redirected (see SetRedirect) is replaced by the one of
+*            the proxy when it is parsed, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/" by
+*            "http://192.168.1.10:8021/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/"
+**/
+void NetUtil::SetProxy(const string &proxy)
+{
+    StringUtil str;
+    _proxy = proxy;
+    str.TrimSpace4String(_proxy);
+    while (!_proxy.empty() && _proxy[_proxy.size() - 1] == '/') _proxy.erase(_proxy.size() - 1);
+    if (!_proxy.empty() && _proxy.find("://") == string::npos) _proxy = "http://" + _proxy;  /* i.e., "192.168.1.10:8021" */
+} /* end of SetProxy */
+
+/**
+* @brief   : SetListCache - set the persistence of the listings of the remote directories
+* @param[I]: dir (the directory where the listings are persisted, empty: NOT persisted)
+* @param[I]: ttl (time to live of the persisted listings (s), 0: NOT persisted)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::SetListCache(const string &dir, int ttl)
+{
+    std::lock_guard<std::mutex> lock(_listLock);
+    _listDir = dir;
+    _listTtl = ttl > 0 ? ttl : 0;
+    if (_listDir.empty() || _listTtl == 0) return;
+
+    /* If the directory does not exist, creat it */
+    FileUtil::MakeDir(_listDir);
+} /* end of SetListCache */
+
+/**
+* @brief   : ParseUrl - split URL into its components
+* @param[I]: url (URL)
+* @param[O]: u (URL components)
+* @return  : true:ok, false:error
+* @note    : the prefix of the URL is replaced at first if it is redirected (see SetRedirect), and then the URL is
+*            sent through the proxy if any (see SetProxy)
+**/
+bool NetUtil::ParseUrl(const string &url, url_t &u)
+{
+    string full = url;
+    for (size_t i = 0; i < _redirects.size(); i++)
+    {
+        if (url.compare(0, _redirects[i].first.size(), _redirects[i].first) != 0) continue;
+        full = _redirects[i].second + url.substr(_redirects[i].first.size());
+        break;
+    }
+
+    size_t pos = full.find("://");
+    if (pos == string::npos) return false;
+
+    /* "scheme://rest" is asked for as "<proxy>/scheme/rest" */
+    if (!_proxy.empty())
+    {
+        full = _proxy + "/" + full.substr(0, pos) + "/" + full.substr(pos + 3);
+        pos = full.find("://");
+    }
+    u.scheme = full.substr(0, pos);
+    StringUtil str;
+    str.ToLower(u.scheme);
+
+    string rest = full.substr(pos + 3);
+    pos = rest.find('/');
+    string auth = rest.substr(0, pos);
+    u.path = pos == string::npos ? "/" : rest.substr(pos);
+
+    /* user:passwd@host:port */
+    u.user.clear();
+    u.passwd.clear();
+    pos = auth.find_last_of('@');
+    if (pos != string::npos)
+    {
+        string userInfo = auth.substr(0, pos);
+        auth = auth.substr(pos + 1);
+        pos = userInfo.find(':');
+        u.user = userInfo.substr(0, pos);
+        if (pos != string::npos) u.passwd = userInfo.substr(pos + 1);
+    }
+    if (u.scheme == "ftp" || u.scheme == "ftps") u.port = 21;
+    else if (u.scheme == "http") u.port = 80;
+    else if (u.scheme == "https") u.port = 443;
+    else return false;
+    pos = auth.find_last_of(':');
+    if (pos != string::npos && auth.find(']') == string::npos)
+    {
+        u.port = atoi(auth.c_str() + pos + 1);
+        auth = auth.substr(0, pos);
+    }
+    u.host = auth;
+
+    /* "ftp://host/a//b" is the same as "ftp://host/a/b" */
+    string::size_type p2;
+    while ((p2 = u.path.find("//")) != string::npos) u.path.erase(p2, 1);
+
+    return !u.host.empty();
+} /* end of ParseUrl */
+
+/**
+* @brief   : Unproxy - get the original URL of the one sent through the proxy
+* @param[I]: url (URL, i.e., "http://192.168.1.10:8021/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/")
+* @param[O]: none
+* @return  : the original URL, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/", or the URL itself if
+*            it is NOT sent through the proxy
+* @note    : it is the reverse of ParseUrl for the proxy (see SetProxy)
+**/
+string NetUtil::Unproxy(const string &url)
+{
+    if (_proxy.empty() || url.compare(0, _proxy.size() + 1, _proxy + "/") != 0) return url;
+
+    string rest = url.substr(_proxy.size() + 1);
+    size_t pos = rest.find('/');
+    if (pos == string::npos || pos == 0) return url;
+
+    return rest.substr(0, pos) + "://" + rest.substr(pos + 1);
+} /* end of Unproxy */
+
+/**
+* @brief   : IsSupported - check if the URL can be handled by the native transfer engine
+* @param[I]: url (URL)
+* @param[O]: none
+* @return  : true: supported, false: NOT supported (i.e., "ftps" or "https" without TLS support)
+* @note    :
+**/
+bool NetUtil::IsSupported(const string &url)
+{
+    url_t u;
+    if (!ParseUrl(url, u)) return false;
+#ifdef NOTLS
+    if (u.scheme == "ftps" || u.scheme == "https") return false;
+#endif
+
+    return true;
+} /* end of IsSupported */
+
+/**
+* @brief   : List - get the names of the files in a remote directory
+* @param[I]: url (URL of the directory)
+* @param[O]: names (file names without path)
+* @return  : true:ok, false:error
+* @note    : "NLST" is used for FTP and the links of the index page are used for HTTP
+**/
+bool NetUtil::List(const string &url, std::vector<string> &names)
+{
+    time_t mtime = 0;
+    bool modified = true;
+
+    return List(url, -1, names, mtime, modified);
+} /* end of List */
+
+/**
+* @brief   : List - get the names of the files in a remote directory unless it is NOT modified
+* @param[I]: url (URL of the directory)
+* @param[I]: since (the modification time of the directory known (s), 0: unknown, -1: NOT asked)
+* @param[O]: names (file names without path, NOT changed if the directory is NOT modified)
+* @param[O]: mtime (the modification time of the directory, 0: unknown)
+* @param[O]: modified (false: the directory is NOT modified since 'since')
+* @return  : true:ok, false:error
+* @note    : "MDTM" of the directory is sent before "NLST" for FTP, and "If-Modified-Since" is sent for HTTP, so
+*            the directory NOT modified costs a round trip without any transfer if the server gives the time
+**/
+bool NetUtil::List(const string &url, time_t since, std::vector<string> &names, time_t &mtime, bool &modified)
+{
+    url_t u;
+    mtime = 0;
+    modified = true;
+    if (!ParseUrl(url, u)) return false;
+
+    string text;
+    sink_t toText = [&text](const char *buff, size_t n) { text.append(buff, n); return true; };
+    if (u.scheme == "ftp" || u.scheme == "ftps")
+    {
+        /* the directory is NOT listed again if its modification time is NOT changed ("MDTM" of the directory is NOT
+           given by every server, and then it is listed as usual) */
+        if (since >= 0)
+        {
+            remote_t remote;
+            FtpStat(u, false, remote);
+            mtime = remote.mtime;
+            if (since > 0 && mtime > 0 && mtime <= since)
+            {
+                modified = false;
+
+                return true;
+            }
+        }
+        names.clear();
+        if (!FtpGet(u, true, 0, toText, nullptr)) return false;
+
+        /* one name per line, some servers give the path as well */
+        size_t p0 = 0, p1;
+        while (p0 < text.size())
+        {
+            p1 = text.find('\n', p0);
+            if (p1 == string::npos) p1 = text.size();
+            string name = text.substr(p0, p1 - p0);
+            if (!name.empty() && name[name.size() - 1] == '\r') name.erase(name.size() - 1);
+            size_t ps = name.find_last_of('/');
+            if (ps != string::npos) name = name.substr(ps + 1);
+            if (!name.empty() && name != "." && name != "..") names.push_back(name);
+            p0 = p1 + 1;
+        }
+    }
+    else
+    {
+        string dirUrl = url;
+        if (dirUrl[dirUrl.size() - 1] != '/') dirUrl += '/';
+        remote_t known, remote;
+        known.mtime = since;
+        if (!HttpGet(dirUrl, &toText, 0, since > 0 ? &known : nullptr, 0, &remote)) return false;
+        mtime = remote.mtime;
+        if (since > 0 && text.empty() && mtime == since)
+        {
+            modified = false;  /* 304 Not Modified */
+
+            return true;
+        }
+        names.clear();
+
+        /* the links of the index page, i.e., <a href="brdc0010.21n.gz"> */
+        string lower = text;
+        StringUtil str;
+        str.ToLower(lower);
+        size_t pos = 0;
+        while ((pos = lower.find("href=", pos)) != string::npos)
+        {
+            pos += 5;
+            if (pos >= text.size()) break;
+            char quote = text[pos];
+            size_t pe;
+            if (quote == '"' || quote == '\'') pe = text.find(quote, ++pos);
+            else pe = text.find_first_of(" >", pos);
+            if (pe == string::npos) break;
+            string link = text.substr(pos, pe - pos);
+            pos = pe;
+            if (link.empty() || link[0] == '?' || link[0] == '#' || link[link.size() - 1] == '/') continue;
+            link = link.substr(0, link.find_first_of("?#"));
+            size_t ps = link.find_last_of('/');
+            if (ps != string::npos) link = link.substr(ps + 1);
+
+            /* percent-decoding */
+            string name;
+            for (size_t i = 0; i < link.size(); i++)
+            {
+                if (link[i] == '%' && i + 2 < link.size() && isxdigit(link[i + 1]) && isxdigit(link[i + 2]))
+                {
+                    name.push_back((char)strtol(link.substr(i + 1, 2).c_str(), nullptr, 16));
+                    i += 2;
+                }
+                else name.push_back(link[i]);
+            }
+            if (!name.empty()) names.push_back(name);
+        }
+        sort(names.begin(), names.end());
+        names.erase(unique(names.begin(), names.end()), names.end());
+    }
+
+    return true;
+} /* end of List */
+
+/**
+* @brief   : ListCached - get the names of the files in a remote directory, which is listed only once
+* @param[I]: url (URL of the directory)
+* @param[O]: names (file names without path)
+* @return  : true:ok, false:error
+* @note    : the threads asking for the same directory at the same time wait for the one listing it; the failed
+*            listing is NOT cached, and the listing expired is revalidated (see ExpireListings)
+**/
+bool NetUtil::ListCached(const string &url, std::vector<string> &names)
+{
+    string key = url;
+    while (key.size() > 1 && key[key.size() - 1] == '/') key.erase(key.size() - 1);
+
+    std::vector<string> known;    /* the listing expired, which is used again if the directory is NOT modified */
+    time_t since = 0;
+    bool stale = false;
+    std::unique_lock<std::mutex> lock(_listLock);
+    for (;;)
+    {
+        std::map<string, listing_t>::iterator it = _listings.find(key);
+        if (it == _listings.end()) break;
+        if (it->second.busy)
+        {
+            /* the time waiting for the thread listing it is a span of its own in the trace */
+            double t0 = MetricsUtil::Now();
+            _listDone.wait(lock);
+            TraceUtil::Add("listing", "listing wait", key, t0, MetricsUtil::Now());
+            continue;
+        }
+        if (it->second.stale)
+        {
+            /* the modification time in the same second as the listing can NOT tell the files added after it */
+            stale = true;
+            known = it->second.names;
+            if (it->second.mtime < it->second.time) since = it->second.mtime;
+            break;
+        }
+        if (_listTtl <= 0 || ::time(NULL) - it->second.time <= _listTtl)
+        {
+            names = it->second.names;
+
+            return true;
+        }
+        _listings.erase(it);  /* expired */
+        break;
+    }
+    listing_t &entry = _listings[key];
+    entry.busy = true;
+    entry.stale = false;
+    entry.time = 0;
+    entry.mtime = 0;
+    bool askMtime = _listMtime;
+    lock.unlock();
+
+    /* the persisted listing written by this or another process */
+    TraceUtil::Span span("listing", "listing", key);
+    time_t time = 0, mtime = 0;
+    bool modified = true;
+    bool ok = !stale && LoadListing(key, names, time);
+    if (ok)
+    {
+        if (_verbose) cout << "*** INFO(NetUtil::ListCached): " << key << "  (" << names.size() << " files, persisted)" << endl;
+    }
+    else
+    {
+        ok = List(key, askMtime ? since : -1, names, mtime, modified);
+        time = ::time(NULL);
+        if (ok && !modified) names = known;
+        else if (ok) SaveListing(key, names);
+        if (_verbose) cout << "*** INFO(NetUtil::ListCached): " << key << "  (" << names.size() << " files" <<
+            (modified ? "" : ", NOT modified") << ")" << endl;
+    }
+
+    lock.lock();
+    if (ok)
+    {
+        listing_t &done = _listings[key];
+        done.names = names;
+        done.time = time;
+        done.mtime = mtime;
+        done.busy = false;
+        done.stale = false;
+    }
+    else _listings.erase(key);
+    _listDone.notify_all();
+
+    return ok;
+} /* end of ListCached */
+
+/**
+* @brief   : ExpireListings - expire the listings cached, i.e., before every poll of the watch mode
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the listing expired is revalidated by the modification time of the directory when it is asked again,
+*            and the persisted listings are NOT used for it (see ListCached)
+**/
+void NetUtil::ExpireListings()
+{
+    std::lock_guard<std::mutex> lock(_listLock);
+    _listMtime = true;
+    for (std::map<string, listing_t>::iterator it = _listings.begin(); it != _listings.end(); ++it)
+    {
+        if (!it->second.busy) it->second.stale = true;
+    }
+} /* end of ExpireListings */
+
+/**
+* @brief   : Stat - get the size and modification time of a remote file
+* @param[I]: url (URL of the file)
+* @param[O]: remote (size and modification time of the remote file)
+* @return  : true:ok, false:error or NOT found
+* @note    : "SIZE" and "MDTM" are used for FTP, and "HEAD" is used for HTTP
+**/
+bool NetUtil::Stat(const string &url, remote_t &remote)
+{
+    url_t u;
+    remote.size = -1;
+    remote.mtime = 0;
+    if (!ParseUrl(url, u)) return false;
+    if (u.scheme == "ftp" || u.scheme == "ftps") return FtpStat(u, true, remote);
+
+    return HttpGet(url, nullptr, 0, nullptr, 0, &remote) && remote.size >= 0;
+} /* end of Stat */
+
+/**
+* @brief   : Revalidate - check if a remote file has been modified since it was downloaded
+* @param[I]: url (URL of the file)
+* @param[I]: known (size, modification time, and entity tag of the remote file when it was downloaded)
+* @param[O]: remote (size, modification time, and entity tag of the remote file as far as they are known)
+* @return  : 1: modified, 0: NOT modified, -1: unknown (error, or nothing to compare)
+* @note    : it costs a round trip, "MDTM" for FTP ("SIZE" as well if the modification time is NOT known), and the
+*            conditional "HEAD" with "If-None-Match" and "If-Modified-Since" for HTTP. The file is modified if any
+*            of its entity tag, modification time, and size known differs from the remote one
+**/
+int NetUtil::Revalidate(const string &url, const remote_t &known, remote_t &remote)
+{
+    url_t u;
+    remote.size = -1;
+    remote.mtime = 0;
+    remote.etag.clear();
+    if (!ParseUrl(url, u)) return -1;
+
+    /* the server ignoring the conditional "HEAD" gives the fields of the file as well */
+    bool ok;
+    if (u.scheme == "ftp" || u.scheme == "ftps") ok = FtpStat(u, known.mtime <= 0, remote);
+    else ok = HttpGet(url, nullptr, 0, &known, 0, &remote);
+    if (!ok) return -1;
+
+    int ncmp = 0;
+    if (!known.etag.empty() && !remote.etag.empty())
+    {
+        if (known.etag != remote.etag) return 1;
+        ncmp++;
+    }
+    if (known.mtime > 0 && remote.mtime > 0)
+    {
+        if (known.mtime != remote.mtime) return 1;
+        ncmp++;
+    }
+    if (known.size >= 0 && remote.size >= 0)
+    {
+        if (known.size != remote.size) return 1;
+        ncmp++;
+    }
+
+    return ncmp > 0 ? 0 : -1;
+} /* end of Revalidate */
+
+/**
+* @brief   : Get - download a remote file to the sink
+* @param[I]: url (URL of the file)
+* @param[I]: offset (the bytes to be skipped from the start of the file, 0: the whole file)
+* @param[I]: sink (receiver of the data)
+* @param[O]: remote (size and modification time of the remote file given by HTTP headers, or the size given by
+*            FTP, nullptr:NO output)
+* @return  : true:ok, false:error
+* @note    : the transfer starts at the offset by "REST" for FTP or "Range" for HTTP
+**/
+bool NetUtil::Get(const string &url, long long offset, const sink_t &sink, remote_t *remote)
+{
+    url_t u;
+    if (!ParseUrl(url, u)) return false;
+    if (u.scheme == "ftp" || u.scheme == "ftps")
+    {
+        long long size = -1;
+        bool ok = FtpGet(u, false, offset, sink, remote ? &size : nullptr);
+        if (remote && size >= 0) remote->size = size;
+
+        return ok;
+    }
+
+    return HttpGet(url, &sink, offset, nullptr, 0, remote);
+} /* end of Get */
+
+/**
+* @brief   : GetPart - download a remote file to the partial file, resuming the one left by the previous transfer
+* @param[I]: url (URL of the file)
+* @param[I]: partFile (the partial file with full path, i.e., "*.part")
+* @param[I]: sink (receiver of all the bytes of the file including the ones resumed, nullptr: NOT used)
+* @param[O]: remote (size and modification time of the remote file as far as they are known, nullptr:NO output)
+* @return  : true: the partial file is complete, false: error
+* @note    : the partial file of a failed transfer is kept with its modification time set to the start of the transfer.
+*            It is resumed ONLY if the remote file is NOT smaller and NOT modified since then, otherwise it is
+*            downloaded again from the start. The partial file is removed if the sink rejected the bytes. It is NOT
+*            complete unless its size is the one of the remote file, if the size is known, and it is NOT created
+*            until the first byte is received
+**/
+bool NetUtil::GetPart(const string &url, const string &partFile, const sink_t *sink, remote_t *remote)
+{
+    TraceUtil::Span span("transfer", "transfer", url);
+    time_t start = time(NULL);
+    double t0 = MetricsUtil::Now(), first = 0.0;
+    long long offset = 0;
+    remote_t info;
+    struct stat st;
+    if (stat(partFile.c_str(), &st) == 0 && st.st_size > 0 && Stat(url, info) && info.size >= (long long)st.st_size &&
+        info.mtime > 0 && info.mtime <= st.st_mtime) offset = (long long)st.st_size;
+
+    /* the bytes resumed are given to the sink at first */
+    bool ok = true, rejected = false;
+    if (offset > 0 && sink)
+    {
+        FILE *fp = fopen(partFile.c_str(), "rb");
+        std::vector<char> buff(NET_BUFFSIZE);
+        size_t n;
+        ok = fp != nullptr;
+        while (ok && (n = fread(buff.data(), 1, buff.size(), fp)) > 0) rejected = !(ok = (*sink)(buff.data(), n));
+        if (fp) fclose(fp);
+    }
+
+    /* the partial file is opened (or created) at the first byte, so the remote file NOT found (i.e., 404 or 550)
+       leaves nothing, and another transfer never resumes from an empty partial file */
+    FILE *fp = nullptr;
+    bool failed = false;
+    long long nbytes = 0;
+    if (ok && (offset == 0 || offset < info.size))
+    {
+        sink_t toPart = [&](const char *buff, size_t n)
+        {
+            if (first == 0.0) first = MetricsUtil::Now();
+            if (!fp && !(fp = fopen(partFile.c_str(), offset > 0 ? "ab" : "wb"))) return !(failed = true);
+            nbytes += n;
+            if (fwrite(buff, 1, n, fp) != n) return false;
+            if (sink && !(*sink)(buff, n)) return !(rejected = true);
+
+            return true;
+        };
+        remote_t got;
+        ok = Get(url, offset, toPart, &got);
+        if (got.size >= 0) info.size = got.size;
+        if (got.mtime > 0) info.mtime = got.mtime;
+        if (!got.etag.empty()) info.etag = got.etag;
+    }
+    if (ok && !fp && offset == 0 && !(fp = fopen(partFile.c_str(), "wb"))) failed = true;  /* the empty remote file */
+    if (fp && fclose(fp) != 0) ok = false;
+    if (failed)
+    {
+        cerr << "*** WARNING(NetUtil::GetPart): open local file " << partFile << " failed" << endl;
+        ok = false;
+    }
+
+    /* the partial file is complete ONLY if it has all the bytes of the remote file, since "226" (or the end of the
+       stream without "Content-Length") may be given to a transfer cut short. It is kept for the next transfer */
+    if (ok && info.size >= 0 && offset + nbytes != info.size)
+    {
+        cerr << "*** WARNING(NetUtil::GetPart): " << url << " is incomplete (" << offset + nbytes << " of " << info.size <<
+            " bytes)" << endl;
+        ok = false;
+    }
+
+    /* the time waiting for the first byte of a failed transfer is counted as well */
+    MetricsUtil::timing_t *tm = MetricsUtil::Current();
+    if (tm)
+    {
+        double t1 = MetricsUtil::Now();
+        tm->firstByte += (first > 0.0 ? first : t1) - t0;
+        if (first > 0.0) tm->transfer += t1 - first;
+        tm->bytes += nbytes;
+        if (offset > 0) tm->retries++;
+    }
+
+    if (!ok && rejected) remove(partFile.c_str());
+    else if (!ok && offset + nbytes > 0)
+    {
+        struct utimbuf times;
+        times.actime = times.modtime = start;
+        utime(partFile.c_str(), &times);
+    }
+    if (ok && info.size < 0) info.size = offset + nbytes;
+    if (remote) *remote = info;
+
+    /* the transfer finished is counted in the round of the window of the host */
+    url_t u;
+    if (ok && _aimd && nbytes > 0 && ParseUrl(url, u)) _aimd->Done(u.host, nbytes);
+    if (_verbose && offset > 0) cout << "*** INFO(NetUtil::GetPart): " << url << "  resumed at " << offset << " bytes" << endl;
+
+    return ok;
+} /* end of GetPart */
+
+/**
+* @brief   : GetFile - download a remote file to the local file
+* @param[I]: url (URL of the file)
+* @param[I]: localFile (local file with full path)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the file is downloaded to "localFile.part", which is renamed to the local file when it is complete and
+*            is resumed by the next call if the transfer failed (see GetPart)
+**/
+bool NetUtil::GetFile(const string &url, const string &localFile)
+{
+    string partFile = localFile + ".part";
+    bool ok = GetPart(url, partFile, nullptr, nullptr);
+    if (ok)
+    {
+        ok = FileUtil::Rename(partFile, localFile);
+        if (!ok) remove(partFile.c_str());
+    }
+
+    if (_verbose)
+    {
+        if (ok) cout << "*** INFO(NetUtil::GetFile): " << url << "  ->  " << localFile << endl;
+        else cout << "*** INFO(NetUtil::GetFile): " << url << "  NOT downloaded" << endl;
+    }
+
+    return ok;
+} /* end of GetFile */
+
+/**
+* @brief   : GetFiles - download the remote file, or the files matching the pattern in the remote directory
+* @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+* @param[I]: accept (file name pattern with wildcards '*' and '?', i.e., "brdc0010.21n.*")
+* @param[I]: localDir (local directory)
+* @param[O]: none
+* @return  : number of files downloaded
+* @note    : it is the counterpart of 'wget -r -nH --cut-dirs=n -A accept url'
+**/
+int NetUtil::GetFiles(const string &url, const string &accept, const string &localDir)
+{
+    char sep = (char)FILEPATHSEP;
+    if (accept.empty())
+    {
+        string name = url.substr(url.find_last_of('/') + 1);
+        if (name.empty()) return 0;
+
+        return GetFile(url, localDir + sep + name) ? 1 : 0;
+    }
+
+    std::vector<string> names;
+    if (!ListCached(url, names)) return 0;
+
+    StringUtil str;
+    string dirUrl = url;
+    if (dirUrl[dirUrl.size() - 1] != '/') dirUrl += '/';
+    int nget = 0;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (!str.MatchPattern(names[i], accept)) continue;
+        if (GetFile(dirUrl + names[i], localDir + sep + names[i])) nget++;
+    }
+
+    return nget;
+} /* end of GetFiles */
+
+/**
+* @brief   : CloseAll - close all the idle connections
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void NetUtil::CloseAll()
+{
+    std::lock_guard<std::mutex> lock(_poolLock);
+    for (std::map<string, std::vector<conn_t *> >::iterator it = _idle.begin(); it != _idle.end(); ++it)
+    {
+        for (size_t i = 0; i < it->second.size(); i++)
+        {
+            conn_t *conn = it->second[i];
+            if (conn->key.compare(0, 3, "ftp") == 0)
+            {
+                string line = "QUIT\r\n";
+                Send(conn, line.c_str(), line.size());
+            }
+            Close(conn);
+            _nconn[it->first]--;
+        }
+    }
+    _idle.clear();
+} /* end of CloseAll */
+
+/**
+* @brief   : KeepAlive - keep the idle FTP control connections open between the polls of the watch mode
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : "NOOP" is sent on every idle FTP control connection, and the ones closed by the server are dropped so
+*            that the next request does NOT wait for a stale connection. The idle HTTP connections are left as they are
+**/
+void NetUtil::KeepAlive()
+{
+    /* the connections are taken out of the pool, so NO other thread uses them at the same time */
+    std::vector<conn_t *> conns;
+    {
+        std::lock_guard<std::mutex> lock(_poolLock);
+        for (std::map<string, std::vector<conn_t *> >::iterator it = _idle.begin(); it != _idle.end(); ++it)
+        {
+            if (it->first.compare(0, 3, "ftp") != 0) continue;
+            conns.insert(conns.end(), it->second.begin(), it->second.end());
+            it->second.clear();
+        }
+    }
+
+    for (size_t i = 0; i < conns.size(); i++)
+    {
+        conn_t *conn = conns[i];
+        bool keep = FtpCmd(conn, "NOOP", nullptr) == 200;
+        {
+            std::lock_guard<std::mutex> lock(_poolLock);
+            if (keep) _idle[conn->key].push_back(conn);
+            else _nconn[conn->key]--;
+            _poolFree.notify_all();
+        }
+        if (!keep)
+        {
+            if (_verbose) cout << "*** INFO(NetUtil::KeepAlive): " << conn->key << " closed by the server" << endl;
+            Close(conn);
+        }
+    }
+} /* end of KeepAlive */
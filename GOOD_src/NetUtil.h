@@ -0,0 +1,576 @@
+/*------------------------------------------------------------------------------
+* NetUtil.h : header file of NetUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+struct ssl_st;
+struct ssl_ctx_st;
+class AimdUtil;
+
+class NetUtil
+{
+public:
+
+    struct url_t
+    {                             /* the components of a remote URL */
+        string scheme;            /* "ftp", "ftps", "http", or "https" */
+        string user;              /* user name (anonymous if empty) */
+        string passwd;            /* password */
+        string host;              /* host name */
+        int port;                 /* port number */
+        string path;              /* absolute path on the server, i.e., "/pub/gnss/data/daily" */
+    };
+
+    struct remote_t
+    {                             /* the size, modification time, and entity tag of a remote file */
+        long long size = -1;      /* size in bytes (-1: unknown) */
+        time_t mtime = 0;         /* modification time in seconds since 1970-01-01 UTC (0: unknown) */
+        string etag;              /* entity tag given by HTTP "ETag" (empty: unknown) */
+    };
+
+    /* the receiver of the downloaded bytes, return false to abort the transfer */
+    typedef std::function<bool(const char *buff, size_t n)> sink_t;
+
+private:
+
+#ifdef _WIN32  /* for Windows */
+    typedef SOCKET socket_t;
+#else          /* for Linux or Mac */
+    typedef int socket_t;
+#endif
+
+    struct conn_t
+    {                             /* a connection to the remote server */
+        string key;               /* the key in the connection pool, i.e., "ftps://gdc.cddis.eosdis.nasa.gov:21" */
+        string host;              /* host name */
+        string peerIp;            /* the numeric address of the peer, used for FTP passive data connections */
+        socket_t fd;              /* socket descriptor */
+        ssl_st *ssl;              /* TLS session (nullptr: plain text) */
+        string rbuf;              /* received but not yet consumed bytes */
+        int gen;                  /* the generation of the window of the host when the request was started (see AimdUtil) */
+    };
+
+    std::map<string, std::vector<conn_t *> > _idle;  /* the idle connections (FTP control or HTTP keep-alive) kept per host */
+    std::map<string, int> _nconn;  /* number of the open connections (in use or idle) per key of the pool */
+    std::vector<std::pair<string, int> > _hostLimits;  /* the limit of connections for the hosts matched by the part of name */
+    int _defLimit;                /* the default limit of connections per host (0: no limit) */
+    AimdUtil *_aimd;              /* the windows of the requests in flight per host, nullptr: ONLY the limits of connections */
+    std::vector<std::pair<string, string> > _redirects;  /* the prefixes of the URLs replaced, and their replacements */
+    string _proxy;                /* the caching proxy which every URL is sent through, i.e., "http://192.168.1.10:8021" (empty: none) */
+    std::mutex _poolLock;         /* the lock of the connection pool */
+    std::condition_variable _poolFree;  /* notified when a connection is released */
+    std::mutex _tlsLock;          /* the lock of the creation of TLS context */
+    ssl_ctx_st *_tlsCtx;          /* TLS context shared by all connections */
+    bool _verbose;                /* true: print the information of every transfer */
+
+    struct listing_t
+    {                             /* the cached listing of a remote directory */
+        std::vector<string> names;  /* file names in the directory */
+        time_t time;              /* the time when the directory was listed */
+        time_t mtime;             /* the modification time of the directory given by the server (0: unknown) */
+        bool busy;                /* true: the directory is being listed by one of the threads */
+        bool stale;               /* true: the listing is revalidated before it is used again (see ExpireListings) */
+    };
+    std::map<string, listing_t> _listings;  /* the listings of the remote directories, the key is the URL of directory */
+    std::mutex _listLock;         /* the lock of the listings */
+    std::condition_variable _listDone;  /* notified when a directory has been listed */
+    string _listDir;              /* the directory where the listings are persisted (empty: NOT persisted) */
+    int _listTtl;                 /* time to live of the persisted listings (s), 0: the listings are ONLY kept during the run */
+    bool _listMtime;              /* true: the modification times of the directories are asked for revalidating the listings */
+    static thread_local const std::atomic<bool> *_cancel;  /* the flag of the transfer running in the thread, nullptr: NOT cancellable */
+
+private:
+
+    /**
+    * @brief   : Connect - open a TCP connection (and a TLS session if required) to the host
+    * @param[I]: host (host name)
+    * @param[I]: port (port number)
+    * @param[I]: tls (true: start TLS immediately after connecting)
+    * @param[O]: none
+    * @return  : connection (nullptr: failed)
+    * @note    :
+    **/
+    conn_t *Connect(const string &host, int port, bool tls);
+
+    /**
+    * @brief   : StartTls - start TLS session on a connected socket
+    * @param[I]: conn (connection)
+    * @param[I]: reuse (the connection whose TLS session is reused, nullptr: new session)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the session of FTPS control connection is reused on the data connections as most of the servers require
+    **/
+    bool StartTls(conn_t *conn, const conn_t *reuse);
+
+    /**
+    * @brief   : Close - close the connection and free it
+    * @param[I]: conn (connection)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close(conn_t *conn);
+
+    /**
+    * @brief   : Send - send the bytes on the connection
+    * @param[I]: conn (connection)
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Send(conn_t *conn, const char *buff, size_t n);
+
+    /**
+    * @brief   : Cancelled - check if the transfer running in the thread is cancelled
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: cancelled, false: NOT cancelled or NOT cancellable
+    * @note    : see SetCancel
+    **/
+    static bool Cancelled();
+
+    /**
+    * @brief   : Wait - wait until the socket is ready to read (or to write, i.e., connected)
+    * @param[I]: fd (socket descriptor)
+    * @param[I]: write (true: ready to write, false: ready to read)
+    * @param[O]: none
+    * @return  : 1: ready, 0: timeout or cancelled, -1: error
+    * @note    : the cancellable transfer waits in slices of NET_SLICE, so it is given up soon after it is cancelled
+    **/
+    static int Wait(socket_t fd, bool write);
+
+    /**
+    * @brief   : RecvRaw - receive the bytes from the socket (or TLS session) of the connection
+    * @param[I]: conn (connection)
+    * @param[O]: buff (bytes)
+    * @param[I]: n (size of buffer)
+    * @return  : number of bytes received (0: end of stream, -1: error or cancelled)
+    * @note    : the call interrupted by a signal (i.e., SIGCHLD of 'wget' run by another thread) is restarted, and the
+    *            cancellable transfer waits for the bytes by Wait at first
+    **/
+    int RecvRaw(conn_t *conn, char *buff, size_t n);
+
+    /**
+    * @brief   : Recv - receive the bytes from the connection
+    * @param[I]: conn (connection)
+    * @param[O]: buff (bytes)
+    * @param[I]: n (size of buffer)
+    * @return  : number of bytes received (0: end of stream, -1: error)
+    * @note    : the bytes buffered in conn->rbuf are returned at first
+    **/
+    int Recv(conn_t *conn, char *buff, size_t n);
+
+    /**
+    * @brief   : ReadLine - read one line (without CR/LF) from the connection
+    * @param[I]: conn (connection)
+    * @param[O]: line (the line read)
+    * @return  : true:ok, false:error or end of stream
+    * @note    :
+    **/
+    bool ReadLine(conn_t *conn, string &line);
+
+    /**
+    * @brief   : Acquire - take an idle connection from the pool or open a new one
+    * @param[I]: u (URL)
+    * @param[O]: reused (true: the connection came from the pool, nullptr:NO output)
+    * @return  : connection (nullptr: failed)
+    * @note    : FTP control connections are returned logged in with binary type. It waits until a connection is released
+    *            if the limit of connections of the host is reached, or until the transfer is cancelled (see SetCancel)
+    **/
+    conn_t *Acquire(const url_t &u, bool *reused);
+
+    /**
+    * @brief   : Release - put the connection back to the pool or close it
+    * @param[I]: conn (connection)
+    * @param[I]: keep (true: the connection can be reused)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Release(conn_t *conn, bool keep);
+
+    /**
+    * @brief   : CloseIdle - close the idle connections of a key of the pool
+    * @param[I]: key (the key in the connection pool)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is called when a connection reused is found stale, since the others idle as long have most likely
+    *            been closed by the server as well, so the request tried again opens a new connection
+    **/
+    void CloseIdle(const string &key);
+
+    /**
+    * @brief   : FtpReply - read a (multi-line) reply from the FTP control connection
+    * @param[I]: conn (control connection)
+    * @param[O]: reply (the last line of reply, nullptr:NO output)
+    * @return  : reply code (-1: error)
+    * @note    :
+    **/
+    int FtpReply(conn_t *conn, string *reply);
+
+    /**
+    * @brief   : FtpCmd - send a command on the FTP control connection and read the reply
+    * @param[I]: conn (control connection)
+    * @param[I]: cmd (command without CR/LF)
+    * @param[O]: reply (the last line of reply, nullptr:NO output)
+    * @return  : reply code (-1: error)
+    * @note    :
+    **/
+    int FtpCmd(conn_t *conn, const string &cmd, string *reply);
+
+    /**
+    * @brief   : FtpLogin - log in the FTP server and set the binary type
+    * @param[I]: conn (control connection)
+    * @param[I]: u (URL)
+    * @param[O]: code (the reply code of the greeting or the login refused, i.e., 421 or 530, nullptr:NO output)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool FtpLogin(conn_t *conn, const url_t &u, int *code);
+
+    /**
+    * @brief   : FtpTransfer - run a command with passive data connection (i.e., "NLST" or "RETR")
+    * @param[I]: ctrl (control connection)
+    * @param[I]: cmd (command)
+    * @param[I]: tls (true: protected data connection)
+    * @param[I]: offset (the bytes to be skipped from the start of the file, "REST" is sent if it is NOT zero)
+    * @param[I]: sink (receiver of the data)
+    * @param[O]: code (the reply code of the command)
+    * @param[O]: usable (true: the control connection is still usable, whether the transfer is ok or NOT)
+    * @param[O]: size (the size of the file given by the reply of the command, i.e., "150 ... (2766034 bytes)", -1: unknown)
+    * @return  : true: the command is finished, i.e., the file is transferred completely or it is refused by the reply,
+    *            false: error, i.e., the transfer is broken, short, or the bytes are rejected by the sink
+    * @note    : code is 450 or 550 if the remote file or directory does not exist. If the server does NOT accept "REST",
+    *            the whole file is transferred and the bytes before the offset are dropped. The size is taken ONLY if
+    *            the offset is zero, since the servers differ in the size given for "REST"
+    **/
+    bool FtpTransfer(conn_t *ctrl, const string &cmd, bool tls, long long offset, const sink_t &sink, int *code,
+        bool *usable, long long *size);
+
+    /**
+    * @brief   : FtpGet - download or list via FTP/FTPS
+    * @param[I]: u (URL)
+    * @param[I]: list (true: "NLST" for directory, false: "RETR" for file)
+    * @param[I]: offset (the bytes to be skipped from the start of the file)
+    * @param[I]: sink (receiver of the data)
+    * @param[O]: size (the size of the remote file, -1: unknown, nullptr: NOT asked)
+    * @return  : true:ok, false:error
+    * @note    : a stale pooled connection is replaced and the command is tried once more. The size is asked by "SIZE"
+    *            after the transfer if it is NOT given by the reply of "RETR"
+    **/
+    bool FtpGet(const url_t &u, bool list, long long offset, const sink_t &sink, long long *size);
+
+    /**
+    * @brief   : FtpStat - get the size and modification time of a remote file via FTP/FTPS
+    * @param[I]: u (URL)
+    * @param[I]: full (true: both of them, false: "SIZE" is sent ONLY if "MDTM" is NOT supported)
+    * @param[O]: remote (size and modification time of the remote file)
+    * @return  : true:ok, false:error
+    * @note    : "SIZE" and "MDTM" (RFC 3659) are used, and the modification time is unknown (0) if "MDTM" is NOT supported.
+    *            It costs a round trip ONLY if 'full' is off and "MDTM" is supported
+    **/
+    bool FtpStat(const url_t &u, bool full, remote_t &remote);
+
+    /**
+    * @brief   : HttpGet - download via HTTP/HTTPS with keep-alive and redirection
+    * @param[I]: url (URL)
+    * @param[I]: sink (receiver of the data, nullptr: "HEAD" instead of "GET")
+    * @param[I]: offset (the bytes to be skipped from the start of the file, "Range" is sent if it is NOT zero)
+    * @param[I]: known (the remote file known, "If-Modified-Since" and "If-None-Match" are sent with its modification
+    *            time and entity tag if they are known, nullptr: NOT conditional)
+    * @param[I]: nredir (number of redirections followed so far)
+    * @param[O]: remote (size, modification time, and entity tag of the remote file, nullptr:NO output)
+    * @return  : true:ok, false:error
+    * @note    : if the server does NOT accept "Range", the whole file is transferred and the bytes before the offset are
+    *            dropped. The file NOT modified (304) is ok with nothing given to the sink, and it is given as 'known'
+    **/
+    bool HttpGet(const string &url, const sink_t *sink, long long offset, const remote_t *known, int nredir,
+        remote_t *remote);
+
+    /**
+    * @brief   : ReadBody - read HTTP message body to the sink
+    * @param[I]: conn (connection)
+    * @param[I]: chunked (true: chunked transfer coding)
+    * @param[I]: length (content length, -1: until the end of stream)
+    * @param[I]: sink (receiver of the data, nullptr: discard)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool ReadBody(conn_t *conn, bool chunked, long long length, const sink_t *sink);
+
+    /**
+    * @brief   : Unproxy - get the original URL of the one sent through the proxy
+    * @param[I]: url (URL, i.e., "http://192.168.1.10:8021/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/")
+    * @param[O]: none
+    * @return  : the original URL, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/", or the URL itself if
+    *            it is NOT sent through the proxy
+    * @note    : it is the reverse of ParseUrl for the proxy (see SetProxy)
+    **/
+    string Unproxy(const string &url);
+
+    /**
+    * @brief   : ListFile - get the name of the file where the listing of the remote directory is persisted
+    * @param[I]: url (URL of the directory)
+    * @param[O]: none
+    * @return  : local file with full path
+    * @note    : the name is the FNV-1a hash of the URL, which contains the year and day of year of the directory
+    **/
+    string ListFile(const string &url);
+
+    /**
+    * @brief   : LoadListing - read the persisted listing of the remote directory
+    * @param[I]: url (URL of the directory)
+    * @param[O]: names (file names in the directory)
+    * @param[O]: time (the time when the directory was listed)
+    * @return  : true: the listing is found and NOT expired, false: otherwise
+    * @note    :
+    **/
+    bool LoadListing(const string &url, std::vector<string> &names, time_t &time);
+
+    /**
+    * @brief   : SaveListing - persist the listing of the remote directory
+    * @param[I]: url (URL of the directory)
+    * @param[I]: names (file names in the directory)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the listing is written to a temporary file and renamed, so the other processes never read a part of it
+    **/
+    void SaveListing(const string &url, const std::vector<string> &names);
+
+public:
+    NetUtil();
+    ~NetUtil();
+
+    /**
+    * @brief   : SetVerbose - print (or not) the information of every transfer
+    * @param[I]: verbose (true: print)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetVerbose(bool verbose);
+
+    /**
+    * @brief   : SetCancel - set the flag which cancels the transfers of the thread
+    * @param[I]: cancel (the flag, true: the transfer is given up at its next wait, nullptr: NOT cancellable)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transfer cancelled fails without being tried again, and its connection is closed, i.e., the
+    *            hedged request lost (see MirrorUtil::Race)
+    **/
+    static void SetCancel(const std::atomic<bool> *cancel);
+
+    /**
+    * @brief   : SetHostLimit - set the max number of connections to the host at the same time
+    * @param[I]: host (part of the host name, i.e., "cddis" or "ign"; empty: the default for all hosts)
+    * @param[I]: limit (max number of connections, 0: no limit)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetHostLimit(const string &host, int limit);
+
+    /**
+    * @brief   : SetAimd - adjust the requests in flight per host by additive-increase/multiplicative-decrease
+    * @param[I]: aimd (the windows of the hosts, nullptr: ONLY the limits of connections, see SetHostLimit)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it should be called before any transfer. The windows are widened by the transfers finished and
+    *            halved by the refusals (FTP 421/530, HTTP 429/503) and the connections reset (see AimdUtil)
+    **/
+    void SetAimd(AimdUtil *aimd);
+
+    /**
+    * @brief   : SetRedirect - replace the prefix of the URLs, i.e., to download from a local stand-in of the archive
+    * @param[I]: from (the prefix replaced, i.e., "ftps://gdc.cddis.eosdis.nasa.gov")
+    * @param[I]: to (the replacement, i.e., "ftp://127.0.0.1:2121")
+    * @param[O]: none
+    * @return  : none
+    * @note    : it should be called before any transfer. The URLs are replaced when they are parsed (see ParseUrl), so
+    *            the listings, the manifest, the metrics, and the trace keep the original URLs
+    **/
+    void SetRedirect(const string &from, const string &to);
+
+    /**
+    * @brief   : SetProxy - send every URL through the caching proxy of another GOOD (see ProxyUtil)
+    * @param[I]: proxy (URL of the proxy, i.e., "http://192.168.1.10:8021", empty: none)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it should be called before any transfer. The URL redirected (see SetRedirect) is replaced by the one of
+    *            the proxy when it is parsed, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/" by
+    *            "http://192.168.1.10:8021/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/"
+    **/
+    void SetProxy(const string &proxy);
+
+    /**
+    * @brief   : SetListCache - set the persistence of the listings of the remote directories
+    * @param[I]: dir (the directory where the listings are persisted, empty: NOT persisted)
+    * @param[I]: ttl (time to live of the persisted listings (s), 0: NOT persisted)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetListCache(const string &dir, int ttl);
+
+    /**
+    * @brief   : ParseUrl - split URL into its components
+    * @param[I]: url (URL)
+    * @param[O]: u (URL components)
+    * @return  : true:ok, false:error
+    * @note    : the prefix of the URL is replaced at first if it is redirected (see SetRedirect), and then the URL is
+    *            sent through the proxy if any (see SetProxy)
+    **/
+    bool ParseUrl(const string &url, url_t &u);
+
+    /**
+    * @brief   : IsSupported - check if the URL can be handled by the native transfer engine
+    * @param[I]: url (URL)
+    * @param[O]: none
+    * @return  : true: supported, false: NOT supported (i.e., "ftps" or "https" without TLS support)
+    * @note    :
+    **/
+    bool IsSupported(const string &url);
+
+    /**
+    * @brief   : List - get the names of the files in a remote directory
+    * @param[I]: url (URL of the directory)
+    * @param[O]: names (file names without path)
+    * @return  : true:ok, false:error
+    * @note    : "NLST" is used for FTP and the links of the index page are used for HTTP
+    **/
+    bool List(const string &url, std::vector<string> &names);
+
+    /**
+    * @brief   : List - get the names of the files in a remote directory unless it is NOT modified
+    * @param[I]: url (URL of the directory)
+    * @param[I]: since (the modification time of the directory known (s), 0: unknown, -1: NOT asked)
+    * @param[O]: names (file names without path, NOT changed if the directory is NOT modified)
+    * @param[O]: mtime (the modification time of the directory, 0: unknown)
+    * @param[O]: modified (false: the directory is NOT modified since 'since')
+    * @return  : true:ok, false:error
+    * @note    : "MDTM" of the directory is sent before "NLST" for FTP, and "If-Modified-Since" is sent for HTTP, so
+    *            the directory NOT modified costs a round trip without any transfer if the server gives the time
+    **/
+    bool List(const string &url, time_t since, std::vector<string> &names, time_t &mtime, bool &modified);
+
+    /**
+    * @brief   : ListCached - get the names of the files in a remote directory, which is listed only once
+    * @param[I]: url (URL of the directory)
+    * @param[O]: names (file names without path)
+    * @return  : true:ok, false:error
+    * @note    : the threads asking for the same directory at the same time wait for the one listing it; the failed
+    *            listing is NOT cached, and the listing expired is revalidated (see ExpireListings)
+    **/
+    bool ListCached(const string &url, std::vector<string> &names);
+
+    /**
+    * @brief   : ExpireListings - expire the listings cached, i.e., before every poll of the watch mode
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the listing expired is revalidated by the modification time of the directory when it is asked again,
+    *            and the persisted listings are NOT used for it (see ListCached)
+    **/
+    void ExpireListings();
+
+    /**
+    * @brief   : Stat - get the size and modification time of a remote file
+    * @param[I]: url (URL of the file)
+    * @param[O]: remote (size and modification time of the remote file)
+    * @return  : true:ok, false:error or NOT found
+    * @note    : "SIZE" and "MDTM" are used for FTP, and "HEAD" is used for HTTP
+    **/
+    bool Stat(const string &url, remote_t &remote);
+
+    /**
+    * @brief   : Revalidate - check if a remote file has been modified since it was downloaded
+    * @param[I]: url (URL of the file)
+    * @param[I]: known (size, modification time, and entity tag of the remote file when it was downloaded)
+    * @param[O]: remote (size, modification time, and entity tag of the remote file as far as they are known)
+    * @return  : 1: modified, 0: NOT modified, -1: unknown (error, or nothing to compare)
+    * @note    : it costs a round trip, "MDTM" for FTP ("SIZE" as well if the modification time is NOT known), and the
+    *            conditional "HEAD" with "If-None-Match" and "If-Modified-Since" for HTTP. The file is modified if any
+    *            of its entity tag, modification time, and size known differs from the remote one
+    **/
+    int Revalidate(const string &url, const remote_t &known, remote_t &remote);
+
+    /**
+    * @brief   : Get - download a remote file to the sink
+    * @param[I]: url (URL of the file)
+    * @param[I]: offset (the bytes to be skipped from the start of the file, 0: the whole file)
+    * @param[I]: sink (receiver of the data)
+    * @param[O]: remote (size and modification time of the remote file given by HTTP headers, or the size given by
+    *            FTP, nullptr:NO output)
+    * @return  : true:ok, false:error
+    * @note    : the transfer starts at the offset by "REST" for FTP or "Range" for HTTP
+    **/
+    bool Get(const string &url, long long offset, const sink_t &sink, remote_t *remote);
+
+    /**
+    * @brief   : GetPart - download a remote file to the partial file, resuming the one left by the previous transfer
+    * @param[I]: url (URL of the file)
+    * @param[I]: partFile (the partial file with full path, i.e., "*.part")
+    * @param[I]: sink (receiver of all the bytes of the file including the ones resumed, nullptr: NOT used)
+    * @param[O]: remote (size and modification time of the remote file as far as they are known, nullptr:NO output)
+    * @return  : true: the partial file is complete, false: error
+    * @note    : the partial file of a failed transfer is kept with its modification time set to the start of the transfer.
+    *            It is resumed ONLY if the remote file is NOT smaller and NOT modified since then, otherwise it is
+    *            downloaded again from the start. The partial file is removed if the sink rejected the bytes. It is NOT
+    *            complete unless its size is the one of the remote file, if the size is known, and it is NOT created
+    *            until the first byte is received
+    **/
+    bool GetPart(const string &url, const string &partFile, const sink_t *sink, remote_t *remote);
+
+    /**
+    * @brief   : GetFile - download a remote file to the local file
+    * @param[I]: url (URL of the file)
+    * @param[I]: localFile (local file with full path)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the file is downloaded to "localFile.part", which is renamed to the local file when it is complete and
+    *            is resumed by the next call if the transfer failed (see GetPart)
+    **/
+    bool GetFile(const string &url, const string &localFile);
+
+    /**
+    * @brief   : GetFiles - download the remote file, or the files matching the pattern in the remote directory
+    * @param[I]: url (URL of the file if accept is empty, otherwise URL of the directory)
+    * @param[I]: accept (file name pattern with wildcards '*' and '?', i.e., "brdc0010.21n.*")
+    * @param[I]: localDir (local directory)
+    * @param[O]: none
+    * @return  : number of files downloaded
+    * @note    : it is the counterpart of 'wget -r -nH --cut-dirs=n -A accept url', while the remote directory is listed
+    *            only once for all the calls (see ListCached) and the matched files are retrieved directly
+    **/
+    int GetFiles(const string &url, const string &accept, const string &localDir);
+
+    /**
+    * @brief   : CloseAll - close all the idle connections
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void CloseAll();
+
+    /**
+    * @brief   : KeepAlive - keep the idle FTP control connections open between the polls of the watch mode
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : "NOOP" is sent on every idle FTP control connection, and the ones closed by the server are dropped so
+    *            that the next request does NOT wait for a stale connection. The idle HTTP connections are left as they are
+    **/
+    void KeepAlive();
+
+    /**
+    * @brief   : HttpTime - format the time for HTTP header, i.e., "Tue, 01 Feb 2022 12:34:56 GMT"
+    * @param[I]: time (the time in seconds since 1970-01-01)
+    * @param[O]: none
+    * @return  : the value of the header field
+    * @note    :
+    **/
+    static string HttpTime(time_t time);
+};
@@ -0,0 +1,228 @@
+/*------------------------------------------------------------------------------
+* PipeUtil.cpp : streaming pipeline from the downloaded bytes to the final observation file
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    Y. Hatanaka, A Compression Format and Tools for GNSS Observation Data, Bulletin of the Geospatioal Information
+*    Authority of Japan, 55, 21-30, 2008
+*
+* history : 2026/10/18 1.0  new, the '*.gz' or '*.Z' Hatanaka file is decompressed and converted to 'o' file on the fly,
+*                           instead of 'gzip -d', 'mv', and 'crx2rnx' on the intermediate files
+*           2026/10/18      Compact RINEX is decoded by CrxUtil in the process instead of the external 'crx2rnx'
+*           2026/10/18      the bytes are decompressed by ZipUtil in the process instead of the external 'gzip'
+*           2026/10/18      the bytes as downloaded are no longer kept here, the caller keeps them in '*.part' file for resuming
+*           2026/10/18      the 'o' file is replaced atomically by FileUtil::Rename (on Windows as well)
+*           2026/10/18      the time spent in decompressing and decoding is measured for the metrics (see MetricsUtil)
+*           2026/10/18      the chunks decompressed and decoded are recorded as the spans of the trace (see TraceUtil), the
+*                             decoding spans are nested in the decompressing ones
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "CrxUtil.h"
+#include "ZipUtil.h"
+#include "MetricsUtil.h"
+#include "TraceUtil.h"
+#include "PipeUtil.h"
+
+
+/* function definition -------------------------------------------------------*/
+
+PipeUtil::PipeUtil()
+{
+    _fpOut = nullptr;
+    _ok = false;
+    _isCrx = false;
+    _okDec = false;
+    _isZip = false;
+    _secInflate = 0.0;
+    _secDecode = 0.0;
+}
+
+PipeUtil::~PipeUtil()
+{
+    if (_fpOut) Close(false);
+}
+
+/**
+* @brief   : Decode - feed the decompressed bytes to the decoder of Compact RINEX or the output file
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool PipeUtil::Decode(const char *buff, size_t n)
+{
+    if (!_okDec) return false;
+
+    if (_isCrx)
+    {
+        double t0 = MetricsUtil::Now();
+        _okDec = _crx.Write(buff, n);
+        double t1 = MetricsUtil::Now();
+        _secDecode += t1 - t0;
+        TraceUtil::Add("decode", "decode", "", t0, t1);
+    }
+    else _okDec = fwrite(buff, 1, n, _fpOut) == n;
+
+    return _okDec;
+} /* end of Decode */
+
+/**
+* @brief   : IsCompressed - check if the file is compressed by 'gzip' or 'compress'
+* @param[I]: file (file name)
+* @param[O]: none
+* @return  : true: '*.gz' or '*.Z', false: otherwise
+* @note    :
+**/
+bool PipeUtil::IsCompressed(const string &file)
+{
+    size_t n = file.size();
+    if (n > 3 && file.compare(n - 3, 3, ".gz") == 0) return true;
+    if (n > 2 && file.compare(n - 2, 2, ".Z") == 0) return true;
+
+    return false;
+} /* end of IsCompressed */
+
+/**
+* @brief   : IsHatanaka - check if the file is in Compact RINEX (Hatanaka) format
+* @param[I]: file (file name, with or without the suffix of compression)
+* @param[O]: none
+* @return  : true: short name '*.YYd' or long name '*.crx', false: otherwise
+* @note    :
+**/
+bool PipeUtil::IsHatanaka(const string &file)
+{
+    string name = file;
+    if (IsCompressed(name)) name = name.substr(0, name.find_last_of('.'));
+
+    size_t n = name.size();
+    if (n > 4 && (name.compare(n - 4, 4, ".crx") == 0 || name.compare(n - 4, 4, ".CRX") == 0)) return true;
+    if (n > 4 && name[n - 4] == '.' && isdigit(name[n - 3]) && isdigit(name[n - 2]) &&
+        (name[n - 1] == 'd' || name[n - 1] == 'D')) return true;
+
+    return false;
+} /* end of IsHatanaka */
+
+/**
+* @brief   : Open - set up the pipeline from the remote file to the local file
+* @param[I]: remoteFile (remote file name without path, i.e., "ALGO00CAN_R_20220320000_01D_30S_MO.crx.gz")
+* @param[I]: outFile (local file with full path, i.e., the 'o' file)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the stages (decompressing and Hatanaka decoding) are chosen by the suffixes of the remote file, and
+*            the bytes pass through them without any intermediate file
+**/
+bool PipeUtil::Open(const string &remoteFile, const string &outFile)
+{
+    if (_fpOut) Close(false);
+
+    _outFile = outFile;
+    _tmpFile = outFile + ".tmp";
+    _fpOut = fopen(_tmpFile.c_str(), "wb");
+    if (!_fpOut)
+    {
+        cerr << "*** WARNING(PipeUtil::Open): open " << _tmpFile << " failed" << endl;
+
+        return false;
+    }
+
+    /* the stages of the pipeline */
+    _okDec = true;
+    _secInflate = _secDecode = 0.0;
+    _isCrx = IsHatanaka(remoteFile);
+    if (_isCrx)
+    {
+        FILE *fp = _fpOut;
+        _crx.Open([fp](const char *buff, size_t n) { return fwrite(buff, 1, n, fp) == n; });
+    }
+    _isZip = IsCompressed(remoteFile);
+    if (_isZip) _zip.Open([this](const char *buff, size_t n) { return Decode(buff, n); });
+    _ok = true;
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Write - feed the bytes (as downloaded) to the pipeline
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool PipeUtil::Write(const char *buff, size_t n)
+{
+    if (!_ok || !_fpOut) return false;
+
+    if (_isZip)
+    {
+        /* the bytes decompressed are decoded in the same call, whose time is NOT counted twice */
+        double t0 = MetricsUtil::Now(), dec0 = _secDecode;
+        _ok = _zip.Write(buff, n);
+        double t1 = MetricsUtil::Now();
+        _secInflate += t1 - t0 - (_secDecode - dec0);
+        TraceUtil::Add("inflate", "inflate", "", t0, t1);
+    }
+    else _ok = Decode(buff, n);
+
+    return _ok;
+} /* end of Write */
+
+/**
+* @brief   : Close - finish the pipeline
+* @param[I]: ok (true: all the bytes have been fed, false: the transfer failed)
+* @param[O]: none
+* @return  : true: the local file is complete, false: error (the local file is NOT created)
+* @note    : the local file appears only when every stage succeeded, so a truncated file is never taken for a
+*            downloaded one
+**/
+bool PipeUtil::Close(bool ok)
+{
+    ok = ok && _ok;
+    _ok = false;
+    double t0 = MetricsUtil::Now(), dec0 = _secDecode;
+    if (_isZip && !_zip.Close()) ok = false;
+    if (_isZip) _secInflate += MetricsUtil::Now() - t0 - (_secDecode - dec0);
+    _isZip = false;
+    t0 = MetricsUtil::Now();
+    if (_isCrx && !_crx.Close()) ok = false;
+    if (_isCrx) _secDecode += MetricsUtil::Now() - t0;
+    _isCrx = false;
+    if (!_okDec) ok = false;
+    if (_fpOut)
+    {
+        if (fclose(_fpOut) != 0) ok = false;
+        _fpOut = nullptr;
+    }
+
+    /* an empty output means that the input is empty */
+    FILE *fp = ok ? fopen(_tmpFile.c_str(), "rb") : nullptr;
+    if (fp)
+    {
+        ok = fgetc(fp) != EOF;
+        fclose(fp);
+    }
+    else ok = false;
+
+    if (ok) ok = FileUtil::Rename(_tmpFile, _outFile);
+    if (!ok) remove(_tmpFile.c_str());
+
+    return ok;
+} /* end of Close */
+
+/**
+* @brief   : Seconds - the time spent in the stages of the pipeline
+* @param[I]: none
+* @param[O]: inflate (the time spent in decompressing (s))
+* @param[O]: decode (the time spent in decoding Compact RINEX (s))
+* @return  : none
+* @note    : the time of writing the output file is counted in decoding if the file is Compact RINEX
+**/
+void PipeUtil::Seconds(double &inflate, double &decode)
+{
+    inflate = _secInflate;
+    decode = _secDecode;
+} /* end of Seconds */
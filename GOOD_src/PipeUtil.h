@@ -0,0 +1,95 @@
+/*------------------------------------------------------------------------------
+* PipeUtil.h : header file of PipeUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class PipeUtil
+{
+private:
+    string _outFile;              /* the final file with full path, i.e., the 'o' file */
+    string _tmpFile;              /* the file being written, renamed to _outFile when the pipeline is closed successfully */
+    FILE *_fpOut;                 /* the file receiving the output of the last stage */
+    bool _ok;                     /* false: writing failed */
+    bool _isCrx;                  /* true: the bytes are decoded from Compact RINEX (Hatanaka) */
+    CrxUtil _crx;                 /* the decoder of Compact RINEX */
+    bool _okDec;                  /* false: decoding failed */
+    bool _isZip;                  /* true: the bytes are decompressed from gzip or 'compress' */
+    ZipUtil _zip;                 /* the decompressor */
+    double _secInflate;           /* the time spent in decompressing (s) */
+    double _secDecode;            /* the time spent in decoding Compact RINEX (s) */
+
+private:
+
+    /**
+    * @brief   : Decode - feed the decompressed bytes to the decoder of Compact RINEX or the output file
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Decode(const char *buff, size_t n);
+
+public:
+    PipeUtil();
+    ~PipeUtil();
+
+    /**
+    * @brief   : IsCompressed - check if the file is compressed by 'gzip' or 'compress'
+    * @param[I]: file (file name)
+    * @param[O]: none
+    * @return  : true: '*.gz' or '*.Z', false: otherwise
+    * @note    :
+    **/
+    static bool IsCompressed(const string &file);
+
+    /**
+    * @brief   : IsHatanaka - check if the file is in Compact RINEX (Hatanaka) format
+    * @param[I]: file (file name, with or without the suffix of compression)
+    * @param[O]: none
+    * @return  : true: short name '*.YYd' or long name '*.crx', false: otherwise
+    * @note    :
+    **/
+    static bool IsHatanaka(const string &file);
+
+    /**
+    * @brief   : Open - set up the pipeline from the remote file to the local file
+    * @param[I]: remoteFile (remote file name without path, i.e., "ALGO00CAN_R_20220320000_01D_30S_MO.crx.gz")
+    * @param[I]: outFile (local file with full path, i.e., the 'o' file)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the stages (decompressing and Hatanaka decoding) are chosen by the suffixes of the remote file, and
+    *            the bytes pass through them without any intermediate file
+    **/
+    bool Open(const string &remoteFile, const string &outFile);
+
+    /**
+    * @brief   : Write - feed the bytes (as downloaded) to the pipeline
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Write(const char *buff, size_t n);
+
+    /**
+    * @brief   : Close - finish the pipeline
+    * @param[I]: ok (true: all the bytes have been fed, false: the transfer failed)
+    * @param[O]: none
+    * @return  : true: the local file is complete, false: error (the local file is NOT created)
+    * @note    : the local file appears only when every stage succeeded, so a truncated file is never taken for a
+    *            downloaded one
+    **/
+    bool Close(bool ok);
+
+    /**
+    * @brief   : Seconds - the time spent in the stages of the pipeline
+    * @param[I]: none
+    * @param[O]: inflate (the time spent in decompressing (s))
+    * @param[O]: decode (the time spent in decoding Compact RINEX (s))
+    * @return  : none
+    * @note    : the time of writing the output file is counted in decoding if the file is Compact RINEX
+    **/
+    void Seconds(double &inflate, double &decode);
+};
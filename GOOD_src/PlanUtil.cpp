@@ -0,0 +1,209 @@
+/*------------------------------------------------------------------------------
+* PlanUtil.cpp : the job graph of the downloading planned before any transfer (dry run)
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, the remote files planned by the getters are deduplicated and expanded to the jobs
+*                           "fetch", "inflate", "decode", and "place", which are printed in the order for throughput
+*           2026/10/18      Host is public for the metrics of the transfers per host (see MetricsUtil)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "PlanUtil.h"
+
+
+/* function definition -------------------------------------------------------*/
+
+PlanUtil::PlanUtil()
+{
+
+}
+
+PlanUtil::~PlanUtil()
+{
+
+}
+
+/**
+* @brief   : Host - the host of the URL
+* @param[I]: url (URL, i.e., "ftp://gdc.cddis.eosdis.nasa.gov/gnss/data/daily")
+* @param[O]: none
+* @return  : the host, i.e., "gdc.cddis.eosdis.nasa.gov"
+* @note    :
+**/
+string PlanUtil::Host(const string &url)
+{
+    size_t pos = url.find("://");
+    pos = pos == string::npos ? 0 : pos + 3;
+    size_t end = url.find_first_of(":/", pos);
+
+    return url.substr(pos, end == string::npos ? string::npos : end - pos);
+} /* end of Host */
+
+/**
+* @brief   : Bytes - the size in a readable form
+* @param[I]: bytes (number of bytes, -1: unknown)
+* @param[O]: none
+* @return  : the size, i.e., "1.2 MB", or "-" if it is unknown
+* @note    :
+**/
+string PlanUtil::Bytes(long long bytes)
+{
+    if (bytes < 0) return "-";
+
+    const char *units[4] = { "B", "KB", "MB", "GB" };
+    double size = (double)bytes;
+    int i = 0;
+    while (size >= 1024.0 && i < 3)
+    {
+        size /= 1024.0;
+        i++;
+    }
+    char buff[32];
+    if (i == 0) sprintf(buff, "%lld B", bytes);
+    else sprintf(buff, "%.1f %s", size, units[i]);
+
+    return buff;
+} /* end of Bytes */
+
+/**
+* @brief   : Clear - remove all the files planned
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void PlanUtil::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _files.clear();
+    _index.clear();
+} /* end of Clear */
+
+/**
+* @brief   : Add - plan the remote file (or the files matching the pattern) to be downloaded
+* @param[I]: url (URL of the remote file, or URL of the directory + "/" + the pattern)
+* @param[I]: localFile (the local file with full path, or the local directory if its name is unknown)
+* @param[I]: bytes (the estimated size of the remote file, -1: unknown)
+* @param[I]: inflate (true: decompressed after it is fetched)
+* @param[I]: decode (true: decoded from Compact RINEX after it is decompressed)
+* @param[I]: wget (true: fetched by 'wget')
+* @param[O]: none
+* @return  : true: planned, false: the URL has been planned already
+* @note    : the same URL planned by several getters or days (i.e., the orbits of the day before and after) is
+*            fetched ONLY once
+**/
+bool PlanUtil::Add(const string &url, const string &localFile, long long bytes, bool inflate, bool decode, bool wget)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_index.find(url) != _index.end()) return false;
+
+    file_t file;
+    file.url = url;
+    file.host = Host(url);
+    file.localFile = localFile;
+    file.bytes = bytes;
+    file.inflate = inflate;
+    file.decode = decode;
+    file.wget = wget;
+    _index[url] = _files.size();
+    _files.push_back(file);
+
+    return true;
+} /* end of Add */
+
+/**
+* @brief   : Size - number of the remote files planned
+* @param[I]: none
+* @param[O]: none
+* @return  : number of the remote files
+* @note    :
+**/
+int PlanUtil::Size()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    return (int)_files.size();
+} /* end of Size */
+
+/**
+* @brief   : Print - print the job graph in the order for throughput
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : every remote file is expanded to the jobs "fetch" -> "inflate" -> "decode" -> "place", and each job
+*            depends on the one before it. The files are ordered by the estimated size from the largest one (the
+*            unknown ones are put last), so that the longest transfers are started at first, and the hosts are
+*            interleaved so that the limit of connections of every host is used at the same time
+**/
+void PlanUtil::Print()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    /* the largest transfer first, and the ones of unknown size last in the order they were planned */
+    std::vector<size_t> order;
+    for (size_t i = 0; i < _files.size(); i++) order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return _files[a].bytes > _files[b].bytes; });
+
+    /* one file of every host in turn */
+    std::vector<string> hosts;
+    std::map<string, std::vector<size_t> > queues;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const string &host = _files[order[i]].host;
+        if (queues.find(host) == queues.end()) hosts.push_back(host);
+        queues[host].push_back(order[i]);
+    }
+    order.clear();
+    for (size_t k = 0; order.size() < _files.size(); k++)
+    {
+        for (size_t i = 0; i < hosts.size(); i++)
+        {
+            if (k < queues[hosts[i]].size()) order.push_back(queues[hosts[i]][k]);
+        }
+    }
+
+    /* the summary */
+    int njob = 0, nunknown = 0;
+    long long total = 0;
+    for (size_t i = 0; i < _files.size(); i++)
+    {
+        njob += 2 + (_files[i].inflate ? 1 : 0) + (_files[i].decode ? 1 : 0);
+        if (_files[i].bytes < 0) nunknown++;
+        else total += _files[i].bytes;
+    }
+    cout << "*** INFO(PlanUtil::Print): " << _files.size() << " remote files planned, " << njob << " jobs, " <<
+        Bytes(total) << " estimated (" << nunknown << " files of unknown size), NOTHING is downloaded" << endl;
+    for (size_t i = 0; i < hosts.size(); i++)
+    {
+        long long bytes = 0;
+        for (size_t j = 0; j < queues[hosts[i]].size(); j++)
+        {
+            if (_files[queues[hosts[i]][j]].bytes > 0) bytes += _files[queues[hosts[i]][j]].bytes;
+        }
+        cout << "    host " << hosts[i] << ": " << queues[hosts[i]].size() << " files, " << Bytes(bytes) << endl;
+    }
+
+    /* the jobs, i.e., "#12 decode <- #11" */
+    int id = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const file_t &file = _files[order[i]];
+        id++;
+        cout << setw(8) << "#" + to_string(id) << "  fetch   " << setw(10) << Bytes(file.bytes) << "  " << file.url <<
+            (file.wget ? "  (wget)" : "") << endl;
+        if (file.inflate)
+        {
+            id++;
+            cout << setw(8) << "#" + to_string(id) << "  inflate " << setw(10) << "<- #" + to_string(id - 1) << endl;
+        }
+        if (file.decode)
+        {
+            id++;
+            cout << setw(8) << "#" + to_string(id) << "  decode  " << setw(10) << "<- #" + to_string(id - 1) << endl;
+        }
+        id++;
+        cout << setw(8) << "#" + to_string(id) << "  place   " << setw(10) << "<- #" + to_string(id - 1) << "  " <<
+            file.localFile << endl;
+    }
+} /* end of Print */
@@ -0,0 +1,93 @@
+/*------------------------------------------------------------------------------
+* PlanUtil.h : header file of PlanUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class PlanUtil
+{
+private:
+
+    struct file_t
+    {                             /* a remote file (or the files matching a pattern) planned */
+        string url;               /* URL of the remote file, or URL of the directory + "/" + the pattern */
+        string host;              /* the host of the URL, i.e., "gdc.cddis.eosdis.nasa.gov" */
+        string localFile;         /* the local file with full path, or the local directory if its name is unknown */
+        long long bytes;          /* the estimated size of the remote file (bytes), -1: unknown */
+        bool inflate;             /* true: decompressed ('*.gz' or '*.Z') after it is fetched */
+        bool decode;              /* true: decoded from Compact RINEX (Hatanaka) after it is decompressed */
+        bool wget;                /* true: fetched by 'wget' instead of the built-in transfer engine */
+    };
+
+    std::vector<file_t> _files;   /* the remote files planned, in the order they were planned */
+    std::map<string, size_t> _index;  /* the index of the files planned, the key is the URL */
+    std::mutex _lock;             /* the lock of the files planned */
+
+private:
+
+    /**
+    * @brief   : Bytes - the size in a readable form
+    * @param[I]: bytes (number of bytes, -1: unknown)
+    * @param[O]: none
+    * @return  : the size, i.e., "1.2 MB", or "-" if it is unknown
+    * @note    :
+    **/
+    static string Bytes(long long bytes);
+
+public:
+    PlanUtil();
+    ~PlanUtil();
+
+    /**
+    * @brief   : Host - the host of the URL
+    * @param[I]: url (URL, i.e., "ftp://gdc.cddis.eosdis.nasa.gov/gnss/data/daily")
+    * @param[O]: none
+    * @return  : the host, i.e., "gdc.cddis.eosdis.nasa.gov"
+    * @note    :
+    **/
+    static string Host(const string &url);
+
+    /**
+    * @brief   : Clear - remove all the files planned
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Clear();
+
+    /**
+    * @brief   : Add - plan the remote file (or the files matching the pattern) to be downloaded
+    * @param[I]: url (URL of the remote file, or URL of the directory + "/" + the pattern)
+    * @param[I]: localFile (the local file with full path, or the local directory if its name is unknown)
+    * @param[I]: bytes (the estimated size of the remote file, -1: unknown)
+    * @param[I]: inflate (true: decompressed after it is fetched)
+    * @param[I]: decode (true: decoded from Compact RINEX after it is decompressed)
+    * @param[I]: wget (true: fetched by 'wget')
+    * @param[O]: none
+    * @return  : true: planned, false: the URL has been planned already
+    * @note    : the same URL planned by several getters or days (i.e., the orbits of the day before and after) is
+    *            fetched ONLY once
+    **/
+    bool Add(const string &url, const string &localFile, long long bytes, bool inflate, bool decode, bool wget);
+
+    /**
+    * @brief   : Size - number of the remote files planned
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of the remote files
+    * @note    :
+    **/
+    int Size();
+
+    /**
+    * @brief   : Print - print the job graph in the order for throughput
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : every remote file is expanded to the jobs "fetch" -> "inflate" -> "decode" -> "place", and each job
+    *            depends on the one before it. The files are ordered by the estimated size from the largest one (the
+    *            unknown ones are put last), so that the longest transfers are started at first, and the hosts are
+    *            interleaved so that the limit of connections of every host is used at the same time
+    **/
+    void Print();
+};
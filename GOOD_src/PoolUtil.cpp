@@ -0,0 +1,200 @@
+/*------------------------------------------------------------------------------
+* PoolUtil.cpp : the pool of worker threads shared by the days, the getters, and the sites of a run
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, the worker threads are started once per run, and the jobs of the days, the getters,
+*                           and the sites are queued to them in batches instead of a new pool per batch
+*           2026/10/18      the jobs can be posted without waiting for them, i.e., the hedged requests (see Post)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "TraceUtil.h"
+#include "PoolUtil.h"
+
+
+/* function definition -------------------------------------------------------*/
+
+PoolUtil::PoolUtil()
+{
+    _nidle = 0;
+    _stopping = false;
+}
+
+PoolUtil::~PoolUtil()
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+    _ready.notify_all();
+    for (size_t i = 0; i < _workers.size(); i++) _workers[i].join();
+}
+
+/**
+* @brief   : Take - take the next job of a batch that is below its limit
+* @param[I]: only (the batch whose jobs are taken, nullptr: any batch)
+* @param[O]: batch (the batch of the job)
+* @param[O]: k (the index of the job)
+* @return  : true: a job is taken, false: NO job can be run now
+* @note    : the lock of the batches is held by the caller
+**/
+bool PoolUtil::Take(batch_t *only, batch_t *&batch, int &k)
+{
+    for (size_t i = 0; i < _batches.size(); i++)
+    {
+        batch_t *b = _batches[i];
+        if ((only && b != only) || b->nrun >= b->limit) continue;
+
+        batch = b;
+        k = b->next++;
+        b->nrun++;
+        /* the batch is left to the threads running its jobs once all of them are started */
+        if (b->next >= b->njob) _batches.erase(_batches.begin() + i);
+
+        return true;
+    }
+
+    return false;
+} /* end of Take */
+
+/**
+* @brief   : Exec - run a job taken, and count it as finished
+* @param[I]: batch (the batch of the job)
+* @param[I]: k (the index of the job)
+* @param[I]: lock (the lock of the batches held by the caller, it is released while the job runs)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void PoolUtil::Exec(batch_t *batch, int k, std::unique_lock<std::mutex> &lock)
+{
+    lock.unlock();
+    (*batch->job)(k);
+    lock.lock();
+
+    batch->nrun--;
+    batch->ndone++;
+    _ready.notify_all();
+} /* end of Exec */
+
+/**
+* @brief   : Spawn - start one more worker thread
+* @param[I]: lane (the name of the worker in the trace)
+* @param[O]: none
+* @return  : none
+* @note    : the lock of the batches is held by the caller
+**/
+void PoolUtil::Spawn(const string &lane)
+{
+    _workers.push_back(std::thread(&PoolUtil::Work, this, lane));
+} /* end of Spawn */
+
+/**
+* @brief   : Work - the loop of a worker thread
+* @param[I]: lane (the name of the worker in the trace, i.e., "worker 1/8")
+* @param[O]: none
+* @return  : none
+* @note    : the jobs posted are taken before the jobs of the batches
+**/
+void PoolUtil::Work(const string &lane)
+{
+    TraceUtil::SetLane(lane);
+
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        batch_t *batch = nullptr;
+        int k = 0;
+        _nidle++;
+        while (!_stopping && _posts.empty() && !Take(nullptr, batch, k)) _ready.wait(lock);
+        _nidle--;
+        if (_stopping) break;
+
+        if (batch) Exec(batch, k, lock);
+        else
+        {
+            std::function<void()> job = std::move(_posts.front());
+            _posts.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+} /* end of Work */
+
+/**
+* @brief   : Start - start the worker threads
+* @param[I]: nworker (number of worker threads)
+* @param[O]: none
+* @return  : none
+* @note    : it is done ONLY once, the workers are stopped by the destructor
+**/
+void PoolUtil::Start(int nworker)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_workers.empty()) return;
+
+    for (int i = 0; i < nworker; i++) Spawn("worker " + to_string(i + 1) + "/" + to_string(nworker));
+} /* end of Start */
+
+/**
+* @brief   : Run - run the jobs by the worker threads, and wait for them
+* @param[I]: njob (number of jobs)
+* @param[I]: limit (the jobs run at the same time at most)
+* @param[I]: job (the job to run, the argument is the index of job)
+* @param[O]: none
+* @return  : none
+* @note    : the calling thread runs the jobs of its own batch while it waits, so that the batches submitted by
+*            the jobs (i.e., the sites of a getter of a day) can NOT deadlock even if all the workers wait. The
+*            jobs are run one by one by the calling thread if the pool is NOT started or the limit is less than 2
+**/
+void PoolUtil::Run(int njob, int limit, const std::function<void(int)> &job)
+{
+    if (njob <= 0) return;
+
+    /* the workers may be started by Post at any time */
+    std::unique_lock<std::mutex> lock(_lock);
+    if (_workers.empty() || limit < 2 || njob < 2)
+    {
+        lock.unlock();
+        for (int k = 0; k < njob; k++) job(k);
+
+        return;
+    }
+
+    batch_t batch;
+    batch.job = &job;
+    batch.njob = njob;
+    batch.limit = limit;
+    batch.next = batch.nrun = batch.ndone = 0;
+
+    _batches.push_back(&batch);
+    _ready.notify_all();
+    while (batch.ndone < batch.njob)
+    {
+        batch_t *taken = nullptr;
+        int k = 0;
+        if (Take(&batch, taken, k)) Exec(taken, k, lock);
+        else _ready.wait(lock);
+    }
+} /* end of Run */
+
+/**
+* @brief   : Post - run a job by a worker thread without waiting for it
+* @param[I]: job (the job to run)
+* @param[O]: none
+* @return  : none
+* @note    : the job posted is taken before the jobs of the batches, and one more worker is started if NO worker is
+*            waiting for it, so it is started at once even if all the workers are busy (i.e., the hedged requests,
+*            see MirrorUtil::Race). The job NOT started when the pool is stopped is dropped
+**/
+void PoolUtil::Post(const std::function<void()> &job)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_stopping) return;
+
+    _posts.push_back(job);
+    if (_nidle < (int)_posts.size()) Spawn("worker " + to_string(_workers.size() + 1) + " (posted)");
+    _ready.notify_all();
+} /* end of Post */
@@ -0,0 +1,105 @@
+/*------------------------------------------------------------------------------
+* PoolUtil.h : header file of PoolUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class PoolUtil
+{
+private:
+
+    struct batch_t
+    {                             /* the jobs submitted by one call of Run */
+        const std::function<void(int)> *job;  /* the job to run, the argument is the index of job */
+        int njob;                 /* number of jobs */
+        int limit;                /* the jobs of the batch run at the same time at most */
+        int next;                 /* the index of the next job NOT started */
+        int nrun;                 /* number of the jobs being run */
+        int ndone;                /* number of the jobs finished */
+    };
+
+    std::vector<std::thread> _workers;  /* the worker threads shared by all the batches */
+    std::vector<batch_t *> _batches;    /* the batches with any job NOT started, in the order submitted */
+    std::deque<std::function<void()> > _posts;  /* the jobs posted and NOT started, in the order posted (see Post) */
+    int _nidle;                   /* number of the workers waiting for a job */
+    std::mutex _lock;             /* the lock of the batches */
+    std::condition_variable _ready;  /* notified when a job is submitted or finished, or the pool is stopped */
+    bool _stopping;               /* true: the workers are being stopped */
+
+private:
+
+    /**
+    * @brief   : Take - take the next job of a batch that is below its limit
+    * @param[I]: only (the batch whose jobs are taken, nullptr: any batch)
+    * @param[O]: batch (the batch of the job)
+    * @param[O]: k (the index of the job)
+    * @return  : true: a job is taken, false: NO job can be run now
+    * @note    : the lock of the batches is held by the caller
+    **/
+    bool Take(batch_t *only, batch_t *&batch, int &k);
+
+    /**
+    * @brief   : Exec - run a job taken, and count it as finished
+    * @param[I]: batch (the batch of the job)
+    * @param[I]: k (the index of the job)
+    * @param[I]: lock (the lock of the batches held by the caller, it is released while the job runs)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Exec(batch_t *batch, int k, std::unique_lock<std::mutex> &lock);
+
+    /**
+    * @brief   : Spawn - start one more worker thread
+    * @param[I]: lane (the name of the worker in the trace)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the lock of the batches is held by the caller
+    **/
+    void Spawn(const string &lane);
+
+    /**
+    * @brief   : Work - the loop of a worker thread
+    * @param[I]: lane (the name of the worker in the trace, i.e., "worker 1/8")
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Work(const string &lane);
+
+public:
+    PoolUtil();
+    ~PoolUtil();
+
+    /**
+    * @brief   : Start - start the worker threads
+    * @param[I]: nworker (number of worker threads)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is done ONLY once, the workers are stopped by the destructor
+    **/
+    void Start(int nworker);
+
+    /**
+    * @brief   : Run - run the jobs by the worker threads, and wait for them
+    * @param[I]: njob (number of jobs)
+    * @param[I]: limit (the jobs run at the same time at most)
+    * @param[I]: job (the job to run, the argument is the index of job)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the calling thread runs the jobs of its own batch while it waits, so that the batches submitted by
+    *            the jobs (i.e., the sites of a getter of a day) can NOT deadlock even if all the workers wait. The
+    *            jobs are run one by one by the calling thread if the pool is NOT started or the limit is less than 2
+    **/
+    void Run(int njob, int limit, const std::function<void(int)> &job);
+
+    /**
+    * @brief   : Post - run a job by a worker thread without waiting for it
+    * @param[I]: job (the job to run)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the job posted is taken before the jobs of the batches, and one more worker is started if NO worker is
+    *            waiting for it, so it is started at once even if all the workers are busy (i.e., the hedged requests,
+    *            see MirrorUtil::Race). The job NOT started when the pool is stopped is dropped
+    **/
+    void Post(const std::function<void()> &job);
+};
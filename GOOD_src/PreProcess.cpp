@@ -9,10 +9,41 @@
 * history : 2020/09/25 1.0  new (by Feng Zhou)
 *           2021/04/30      a bug for EOP downloading is fixed (by Feng Zhou @ SDUST)
 *           2021/04/30      the option "minusAdd1day" is added (by Feng Zhou @ SDUST)
+*           2026/10/18      the lines without '=' are skipped, since the notes continued in the following lines may
+*                             mention the name of an option
+*           2026/10/18      the days are planned at first and downloaded in parallel, and the option "dayParallel" is added
+*           2026/10/18      the jobs can be planned and printed without downloading ("--plan" of run_GOOD)
+*           2026/10/18      the sub-directories are created by FileUtil instead of 'mkdir'
+*           2026/10/18      'site.list' files are read once into the tables of stations shared by all the getters, and the
+*                             nine-character long names are supported
+*           2026/10/18      TemplateUtil.h is included for the templates of URLs and file names used by FtpUtil
+*           2026/10/18      the option "metrics" is added for the report of the run (see MetricsUtil)
+*           2026/10/18      the option "trace" is added for the timeline of the run (see TraceUtil)
+*           2026/10/18      the option "urlRedirect" is added for the local stand-ins of the archives (see Benchmark)
+*           2026/10/18      the option "adaptParallel" is added for the requests in flight per host (see AimdUtil)
+*           2026/10/18      the option "watch" is added for polling the products as they are published ("--watch" of run_GOOD)
+*           2026/10/18      the option "refresh" is added for downloading again the products republished under the same name
+*           2026/10/18      the option "cache" is added for sharing the remote files among the runs on the same host
+*           2026/10/18      the options "proxy" and "viaProxy" are added for the HTTP caching proxy serving the other GOOD
+*                             on the LAN ("--proxy" of run_GOOD)
+*           2026/10/18      the option "shard" is added for sharing the jobs among the nodes on a shared file system
+*           2026/10/18      the options of the command line are given to 'run' by 'runopt_t' in place of the overloads
+*           2026/10/18      PoolUtil.h is included for the worker threads of the run used by FtpUtil
 *-----------------------------------------------------------------------------*/
 #include "Good.h"
 #include "StringUtil.h"
+#include "FileUtil.h"
 #include "TimeUtil.h"
+#include "NetUtil.h"
+#include "MetricsUtil.h"
+#include "MirrorUtil.h"
+#include "AimdUtil.h"
+#include "ManifestUtil.h"
+#include "CacheUtil.h"
+#include "ShardUtil.h"
+#include "PoolUtil.h"
+#include "PlanUtil.h"
+#include "TemplateUtil.h"
 #include "FtpUtil.h"
 #include "PreProcess.h"
 
@@ -67,12 +98,42 @@ void PreProcess::init(prcopt_t *popt, ftpopt_t *fopt)
     str.SetStr(fopt->dir3party, "", 1);     /* the absolute path where third-party softwares are stored */
     fopt->isPath3party = false;             /* if true: the path need be set for third-party softwares */
     str.SetStr(fopt->wgetFull, "", 1);      /* if isPath3party == true, set the full path where 'wget' is */
-    str.SetStr(fopt->gzipFull, "", 1);      /* if isPath3party == true, set the full path where 'gzip' is */
-    str.SetStr(fopt->crx2rnxFull, "", 1);   /* if isPath3party == true, set the full path where 'crx2rnx' is */
     fopt->minusAdd1day = true;              /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock 
                                                products downloading */
     fopt->printInfoWget = false;            /* (0:off  1:on) print the information generated by 'wget' */
     str.SetStr(fopt->qr, "", 1);            /* '-qr' (printInfoWget == false) or '-r' (printInfoWget == true) in 'wget' command line */
+    fopt->maxParallel = 1;                  /* number of sites downloaded in parallel, and the default limit of connections per host */
+    str.SetStr(fopt->hostParallel, "", 1);  /* (optional) the limit of connections for some hosts, i.e., "cddis:2+hk:1" */
+    fopt->dayParallel = 1;                  /* number of days downloaded in parallel */
+    fopt->adaptParallel = true;             /* (0:off  1:on) adjust the requests in flight per host by AIMD */
+    str.SetStr(fopt->adaptFil, "", 1);      /* the windows of the hosts, empty: 'GOOD_hosts.txt' in the root/main directory */
+    str.SetStr(fopt->urlRedirect, "", 1);   /* (optional) the prefixes of the remote URLs replaced, i.e., "ftp://igs.ign.fr>ftp://127.0.0.1:2121" */
+    str.SetStr(fopt->viaProxy, "", 1);      /* (optional) URL of the caching proxy of another GOOD, i.e., "http://192.168.1.10:8021" */
+    fopt->listCacheTtl = 0;                 /* time to live of the persisted listings of the remote directories (s) */
+    str.SetStr(fopt->listCacheDir, "", 1);  /* the directory where the listings of the remote directories are persisted */
+    fopt->keepRawObs = false;               /* (0:off  1:on) keep the downloaded observation files besides the 'o' files */
+    fopt->hedgeMirror = false;              /* (0:off  1:on) race the remote files among the mirrored archives */
+    fopt->hedgeDelay = 2.0;                 /* the latency budget before the hedged request is fired (s) */
+    str.SetStr(fopt->mirrorStat, "", 1);    /* the file where the statistics of the archives are persisted */
+    fopt->manifest = false;                 /* (0:off  1:on) record the files downloaded and the days finished */
+    str.SetStr(fopt->manifestFil, "", 1);   /* the manifest file, empty: 'GOOD.manifest' in the root/main directory */
+    fopt->refresh = false;                  /* (0:off  1:on) download again the products republished under the same name */
+    fopt->cache = false;                    /* (0:off  1:on) share the remote files downloaded among the runs on the host */
+    str.SetStr(fopt->cacheDir, "", 1);      /* the directory of the cache, empty: 'GOOD_cache' in the root/main directory */
+    fopt->metrics = false;                  /* (0:off  1:on) measure every transfer and write the report of the run */
+    str.SetStr(fopt->metricsFil, "", 1);    /* the report without suffix, empty: 'GOOD_metrics' in the root/main directory */
+    fopt->trace = false;                    /* (0:off  1:on) write the timeline of the run in the trace event format of Chrome */
+    str.SetStr(fopt->traceFil, "", 1);      /* the trace, empty: 'GOOD_trace.json' in the root/main directory */
+    fopt->watch = false;                    /* (0:off  1:on) keep polling the products as they are published */
+    fopt->watchPoll = 30;                   /* the interval between the polls (s) */
+    fopt->watchDepth = 2;                   /* number of the latest issues polled per product */
+    fopt->proxy = false;                    /* (0:off  1:on) serve the remote files to the other GOOD as an HTTP caching proxy */
+    fopt->proxyPort = 8021;                 /* the port where the proxy listens */
+    fopt->proxyTtl = 60;                    /* the interval after which the listings and the files served are revalidated (s) */
+    fopt->shard = false;                    /* (0:off  1:on) share the jobs among the nodes through the lease files */
+    fopt->shardLease = 120;                 /* time to live of the leases (s) */
+    str.SetStr(fopt->shardDir, "", 1);      /* the directory of the queue, empty: 'GOOD_shard' in the root/main directory */
+    fopt->planOnly = false;                 /* the jobs are downloaded */
 
     /* initialization for FTP options */
     fopt->ftpDownloading = false;           /* the master switch for data downloading, 0:off  1:on, only for data downloading */
@@ -141,6 +202,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
         if ((sline != nullptr) && (sline[0] == '#')) continue;
 
         p = strrchr(sline, '=');
+        if (p == nullptr) continue;                   /* the lines of comments only, i.e., the continued notes of an option */
 
         /* processing directory */
         if (strstr(sline, "mainDir"))                 /* the root/main directory of GNSS observations and products */
@@ -261,7 +323,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             strcpy(popt->tblDir, tmpDir);
             if (debug) cout << "* tblDir = " << popt->tblDir << endl;
         }
-        else if (strstr(sline, "3partyDir"))          /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
+        else if (strstr(sline, "3partyDir"))          /* (optional) the directory where third-party softwares (i.e., 'wget') are stored. This option is not needed if you have set the path or environment variable for them */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace4Char(tmpLine);
@@ -271,16 +333,8 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             if (debug) cout << "* 3partyDir = " << fopt->dir3party << "  " << fopt->isPath3party << endl;
 
             string tmpDir = fopt->dir3party;
-            if (access(tmpDir.c_str(), 0) == -1)
-            {
-                /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + tmpDir;
-#endif
-                std::system(cmd.c_str());
-            }
+            /* If the directory does not exist, creat it */
+            FileUtil::MakeDir(tmpDir);
         }
         else if (strstr(sline, "logFile"))            /* The log file with full path that gives the indications of whether the data downloading is successful or not */
         {
@@ -336,6 +390,146 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             fopt->printInfoWget = j == 1 ? true : false;
             if (debug) cout << "* printInfoWget = " << fopt->printInfoWget << endl;
         }
+        else if (strstr(sline, "maxParallel"))        /* number of sites downloaded in parallel; (optional) the limit of connections for some hosts */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %s", &fopt->maxParallel, &tmpLine);
+            if (fopt->maxParallel < 1) fopt->maxParallel = 1;
+            if (tmpLine[0] != '%') strcpy(fopt->hostParallel, tmpLine);
+            if (debug) cout << "* maxParallel = " << fopt->maxParallel << "  " << fopt->hostParallel << endl;
+        }
+        else if (strstr(sline, "urlRedirect"))        /* (optional) the prefixes of the remote URLs replaced */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%[^%]", tmpLine);
+            str.TrimSpace4Char(tmpLine);
+            strcpy(fopt->urlRedirect, tmpLine);
+            if (debug) cout << "* urlRedirect = " << fopt->urlRedirect << endl;
+        }
+        else if (strstr(sline, "viaProxy"))           /* (optional) URL of the caching proxy of another GOOD */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%[^%]", tmpLine);
+            str.TrimSpace4Char(tmpLine);
+            strcpy(fopt->viaProxy, tmpLine);
+            if (debug) cout << "* viaProxy = " << fopt->viaProxy << endl;
+        }
+        else if (strstr(sline, "dayParallel"))        /* number of days downloaded in parallel */
+        {
+            sscanf(p + 1, "%d", &fopt->dayParallel);
+            if (fopt->dayParallel < 1) fopt->dayParallel = 1;
+            if (debug) cout << "* dayParallel = " << fopt->dayParallel << endl;
+        }
+        else if (strstr(sline, "adaptParallel"))      /* (0:off  1:on) adjust the requests in flight per host by AIMD; (optional) the file of the windows */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &j, &tmpLine);
+            fopt->adaptParallel = j == 1 ? true : false;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->adaptFil, tmpLine);
+            if (debug) cout << "* adaptParallel = " << fopt->adaptParallel << "  " << fopt->adaptFil << endl;
+        }
+        else if (strstr(sline, "listCache"))          /* time to live of the persisted listings of the remote directories (s); the directory where they are persisted */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &fopt->listCacheTtl, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
+            if (fopt->listCacheTtl < 0) fopt->listCacheTtl = 0;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->listCacheDir, tmpLine);
+            if (debug) cout << "* listCache = " << fopt->listCacheTtl << "  " << fopt->listCacheDir << endl;
+        }
+        else if (strstr(sline, "keepRawObs"))         /* (0:off  1:on) keep the downloaded observation files besides the 'o' files */
+        {
+            sscanf(p + 1, "%d", &j);
+            fopt->keepRawObs = j == 1 ? true : false;
+            if (debug) cout << "* keepRawObs = " << fopt->keepRawObs << endl;
+        }
+        else if (strstr(sline, "hedgeMirror"))        /* (0:off  1:on) race the remote files among the mirrored archives; the latency budget (s); (optional) the file of statistics */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %lf %[^%]", &j, &fopt->hedgeDelay, &tmpLine);
+            fopt->hedgeMirror = j == 1 ? true : false;
+            if (fopt->hedgeDelay < 0.0) fopt->hedgeDelay = 0.0;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->mirrorStat, tmpLine);
+            if (debug) cout << "* hedgeMirror = " << fopt->hedgeMirror << "  " << fopt->hedgeDelay << "  " << fopt->mirrorStat << endl;
+        }
+        else if (strstr(sline, "manifest"))           /* (0:off  1:on) record the files downloaded and the days finished; (optional) the manifest file */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &j, &tmpLine);
+            fopt->manifest = j == 1 ? true : false;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->manifestFil, tmpLine);
+            if (debug) cout << "* manifest = " << fopt->manifest << "  " << fopt->manifestFil << endl;
+        }
+        else if (strstr(sline, "refresh"))            /* (0:off  1:on) download again the products republished under the same name */
+        {
+            sscanf(p + 1, "%d", &j);
+            fopt->refresh = j == 1 ? true : false;
+            if (debug) cout << "* refresh = " << fopt->refresh << endl;
+        }
+        else if (strstr(sline, "cache"))              /* (0:off  1:on) share the remote files downloaded among the runs on the host; (optional) the directory of the cache */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &j, &tmpLine);
+            fopt->cache = j == 1 ? true : false;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->cacheDir, tmpLine);
+            if (debug) cout << "* cache = " << fopt->cache << "  " << fopt->cacheDir << endl;
+        }
+        else if (strstr(sline, "metrics"))            /* (0:off  1:on) measure every transfer and write the report of the run; (optional) the report without suffix */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &j, &tmpLine);
+            fopt->metrics = j == 1 ? true : false;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->metricsFil, tmpLine);
+            if (debug) cout << "* metrics = " << fopt->metrics << "  " << fopt->metricsFil << endl;
+        }
+        else if (strstr(sline, "trace"))              /* (0:off  1:on) write the timeline of the run; (optional) the trace file */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &j, &tmpLine);
+            fopt->trace = j == 1 ? true : false;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->traceFil, tmpLine);
+            if (debug) cout << "* trace = " << fopt->trace << "  " << fopt->traceFil << endl;
+        }
+        else if (strstr(sline, "watch"))              /* (0:off  1:on) keep polling the products as they are published; the interval between the polls (s); number of the latest issues polled */
+        {
+            sscanf(p + 1, "%d %d %d", &j, &fopt->watchPoll, &fopt->watchDepth);
+            fopt->watch = j == 1 ? true : false;
+            if (fopt->watchPoll < 1) fopt->watchPoll = 1;
+            if (fopt->watchDepth < 1) fopt->watchDepth = 1;
+            if (debug) cout << "* watch = " << fopt->watch << "  " << fopt->watchPoll << "  " << fopt->watchDepth << endl;
+        }
+        else if (strstr(sline, "proxy"))              /* (0:off  1:on) serve the remote files to the other GOOD as an HTTP caching proxy; the port; the interval of the revalidation (s) */
+        {
+            sscanf(p + 1, "%d %d %d", &j, &fopt->proxyPort, &fopt->proxyTtl);
+            fopt->proxy = j == 1 ? true : false;
+            if (fopt->proxyPort < 1 || fopt->proxyPort > 65535) fopt->proxyPort = 8021;
+            if (fopt->proxyTtl < 1) fopt->proxyTtl = 1;
+            if (debug) cout << "* proxy = " << fopt->proxy << "  " << fopt->proxyPort << "  " << fopt->proxyTtl << endl;
+        }
+        else if (strstr(sline, "shard"))              /* (0:off  1:on) share the jobs among the nodes through the lease files; time to live of the leases (s); (optional) the directory of the queue */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %d %[^%]", &j, &fopt->shardLease, &tmpLine);
+            fopt->shard = j == 1 ? true : false;
+            if (fopt->shardLease < 3) fopt->shardLease = 3;
+            str.TrimSpace4Char(tmpLine);
+            str.CutFilePathSep(tmpLine);
+            strcpy(fopt->shardDir, tmpLine);
+            if (debug) cout << "* shard = " << fopt->shard << "  " << fopt->shardLease << "  " << fopt->shardDir << endl;
+        }
 
         /* handling of FTP downloading */
         else if (strstr(sline, "ftpDownloading"))     /* the master switch for data downloading (0:off  1:on, only for data downloading); the FTP archive, i.e., CDDIS, IGN, or WHU */
@@ -351,6 +545,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                 {
                     if ((sline != nullptr) && (sline[0] == '#')) continue;
                     p = strrchr(sline, '=');
+                    if (p == nullptr) continue;       /* the lines of comments only */
 
                     if (strstr(sline, "getObs"))      /* (0:off  1:on) GNSS observation data */
                     {
@@ -483,17 +678,73 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
 
     if (debug) cout << "##################### End of configure file ###########################" << endl;
 
+    /* the stations are read once for all the getters and days */
+    if (fopt->getObs) ReadSiteList(fopt->obsLst, fopt->obsSites);
+    if (fopt->getNav) ReadSiteList(fopt->navLst, fopt->navSites);
+    if (fopt->getTrp) ReadSiteList(fopt->trpLst, fopt->trpSites);
+
     return true;
 } /* end of ReadCfgFile */
 
 /**
-* @brief   : run - start iPPP-RTK processing
+* @brief   : ReadSiteList - read the stations in 'site.list' file
+* @param[I]: sitFile (the full path of 'site.list', or 'all')
+* @param[O]: sites (the stations sorted by name, without duplicate)
+* @return  : true: ok or 'all', false: error
+* @note    : the line beginning with '#' is skipped, and the station is given by either its four-character name
+*            (i.e., "algo") or its nine-character long name (i.e., "ALGO00CAN") in any case
+**/
+bool PreProcess::ReadSiteList(const char *sitFile, std::vector<site_t> &sites)
+{
+    sites.clear();
+    if (strlen(sitFile) < 9 || access(sitFile, 0) == -1) return true;  /* 'all', or NOT given */
+
+    ifstream sitLst(sitFile);
+    if (!sitLst.is_open())
+    {
+        cerr << "*** ERROR(PreProcess::ReadSiteList): open site.list = " << sitFile << " file failed, please check it" << endl;
+
+        return false;
+    }
+
+    /* the long name is kept if the station is given by both names */
+    StringUtil str;
+    std::map<string, string> names;
+    string sitName;
+    while (getline(sitLst, sitName))
+    {
+        if (!sitName.empty() && sitName[sitName.size() - 1] == '\r') sitName.erase(sitName.size() - 1);
+        if (sitName.empty() || sitName[0] == '#') continue;
+        str.TrimSpace4String(sitName);
+        if (sitName.size() != 4 && sitName.size() != 9) continue;
+        string name = sitName.substr(0, 4), longName = sitName.size() == 9 ? sitName : "";
+        str.ToLower(name);
+        str.ToUpper(longName);
+        string &known = names[name];
+        if (known.empty()) known = longName;
+    }
+    sitLst.close();
+
+    for (std::map<string, string>::const_iterator it = names.begin(); it != names.end(); ++it)
+    {
+        site_t site = { it->first, it->second };
+        sites.push_back(site);
+    }
+
+    return true;
+} /* end of ReadSiteList */
+
+/**
+* @brief   : run - start iPPP-RTK processing, print the jobs planned, keep polling the products, or serve the remote
+*            files to the other GOOD
 * @param[I]: cfgFile (configure file with full path)
+* @param[I]: ropt (the options given in the command line, see runopt_t)
 * @param[O]: none
 * @return  : none
-* @note    :
+* @note    : the sub-directories of the days and the log file are NOT created if planOnly is true, the watch mode
+*            and the proxy mode are off if planOnly is true, and the proxy mode goes before the watch mode
 **/
-void PreProcess::run(const char *cfgFile)
+void PreProcess::run(const char *cfgFile, const runopt_t &ropt)
 {
     prcopt_t popt;
     ftpopt_t fopt;
@@ -502,6 +753,10 @@ void PreProcess::run(const char *cfgFile)
 
     /* read configure file to get processing information */
     ReadCfgFile(cfgFile, &popt, &fopt);
+    fopt.planOnly = ropt.planOnly;
+    if (ropt.watch) fopt.watch = true;
+    if (ropt.proxy) fopt.proxy = true;
+    if (fopt.planOnly) fopt.watch = fopt.proxy = false;
 
     /* data downloading for GNSS further processing */
     if (fopt.ftpDownloading)
@@ -516,7 +771,7 @@ void PreProcess::run(const char *cfgFile)
 
         /* check if it need to write log file */
         fopt.fpLog = nullptr;
-        if (fopt.logWriteMode > 0)
+        if (fopt.logWriteMode > 0 && !fopt.planOnly)
         {
             string logFilePath = fopt.logFil;
             int iPos = 0;
@@ -528,21 +783,40 @@ void PreProcess::run(const char *cfgFile)
             char logDirPath[MAXSTRPATH];
             str.StrMid(logDirPath, fopt.logFil, 0, iPos);
             /* If the directory does not exist, creat it */
-            if (access(logDirPath, 0) == -1)
-            {
-                string tmpDir = logDirPath;
-#ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + tmpDir;
-#endif
-                std::system(cmd.c_str());
-            }
+            FileUtil::MakeDir(logDirPath);
 
             if (fopt.logWriteMode == 1) fopt.fpLog = fopen(fopt.logFil, "w");  /* overwrite mode */
             else if (fopt.logWriteMode == 2) fopt.fpLog = fopen(fopt.logFil, "a");  /* append mode */
         }
 
+        /* the remote files asked for by the other GOOD are served until the process is stopped, and the getters
+           are NOT run */
+        if (fopt.proxy)
+        {
+            ftp.FtpProxy(&popt, &fopt);
+            if (fopt.fpLog) fclose(fopt.fpLog);  /* close the log file */
+
+            return;
+        }
+
+        /* the products are polled as they are published until the process is stopped, the main sub-directories
+           are given and the ones of the days are created on the fly */
+        if (fopt.watch)
+        {
+            ftp.FtpWatch(&popt, &fopt);
+            if (fopt.fpLog) fclose(fopt.fpLog);  /* close the log file */
+
+            return;
+        }
+
+        /* the days finished by the previous runs with the same options are skipped (see FtpUtil::OpenManifest) */
+        bool manifest = ftp.OpenManifest(&popt, &fopt);
+
+        /* the jobs are shared with the other nodes running the same configure file (see FtpUtil::OpenShard) */
+        if (!fopt.planOnly) ftp.OpenShard(&popt, &fopt);
+
+        std::vector<prcopt_t> days;
+
         for (int i = 0; i < popt.ndays; i++)
         {
             int yyyy, doy;
@@ -550,6 +824,13 @@ void PreProcess::run(const char *cfgFile)
             string sYyyy = str.yyyy2str(yyyy);
             string sDoy = str.doy2str(doy);
 
+            if (manifest && ftp.IsDayDone(popt.ts))
+            {
+                cout << "*** INFO(PreProcess::run): the data of " << sYyyy << "/" << sDoy << " have been downloaded!" << endl;
+                popt.ts = tu.TimeAdd(popt.ts, 86400.0);
+                continue;
+            }
+
             /* creat new observation sub-directory */
             if (fopt.getObs)
             {
@@ -560,16 +841,8 @@ void PreProcess::run(const char *cfgFile)
                 str.CutFilePathSep(dir);
                 strcpy(popt.obsDir, dir);
                 string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                /* If the directory does not exist, creat it */
+                if (!fopt.planOnly) FileUtil::MakeDir(tmpDir);
             }
 
             /* creat new NAV sub-directory */
@@ -582,16 +855,8 @@ void PreProcess::run(const char *cfgFile)
                 str.CutFilePathSep(dir);
                 strcpy(popt.navDir, dir);
                 string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                /* If the directory does not exist, creat it */
+                if (!fopt.planOnly) FileUtil::MakeDir(tmpDir);
             }
 
             /* creat new ION sub-directory */
@@ -604,16 +869,8 @@ void PreProcess::run(const char *cfgFile)
                 str.CutFilePathSep(dir);
                 strcpy(popt.ionDir, dir);
                 string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                /* If the directory does not exist, creat it */
+                if (!fopt.planOnly) FileUtil::MakeDir(tmpDir);
             }
 
             /* creat new ZTD sub-directory */
@@ -626,24 +883,19 @@ void PreProcess::run(const char *cfgFile)
                 str.CutFilePathSep(dir);
                 strcpy(popt.ztdDir, dir);
                 string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                /* If the directory does not exist, creat it */
+                if (!fopt.planOnly) FileUtil::MakeDir(tmpDir);
             }
 
-            /* the main entry of FTP downloader */
-            ftp.FtpDownload(&popt, &fopt);
+            /* the day is planned with its own sub-directories, and all the days are downloaded below */
+            days.push_back(popt);
 
             popt.ts = tu.TimeAdd(popt.ts, 86400.0);
         }
 
+        /* the main entry of FTP downloader, 'dayParallel' days are downloaded at the same time */
+        if (!days.empty()) ftp.FtpDownload(days, &fopt);
+
         if (fopt.fpLog) fclose(fopt.fpLog);  /* close the log file */
     }
 } /* end of run */
\ No newline at end of file
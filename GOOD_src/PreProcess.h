@@ -26,6 +26,16 @@ private:
     **/
     bool ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt);
 
+    /**
+    * @brief   : ReadSiteList - read the stations in 'site.list' file
+    * @param[I]: sitFile (the full path of 'site.list', or 'all')
+    * @param[O]: sites (the stations sorted by name, without duplicate)
+    * @return  : true: ok or 'all', false: error
+    * @note    : the line beginning with '#' is skipped, and the station is given by either its four-character name
+    *            (i.e., "algo") or its nine-character long name (i.e., "ALGO00CAN") in any case
+    **/
+    bool ReadSiteList(const char *sitFile, std::vector<site_t> &sites);
+
 public:
     PreProcess()
 	{
@@ -37,11 +47,14 @@ public:
 	}
 
     /**
-    * @brief   : run - start iPPP-RTK processing
+    * @brief   : run - start iPPP-RTK processing, print the jobs planned, keep polling the products, or serve the remote
+    *            files to the other GOOD
     * @param[I]: cfgFile (configure file with full path)
+    * @param[I]: ropt (the options given in the command line, see runopt_t)
     * @param[O]: none
     * @return  : none
-    * @note    :
+    * @note    : the sub-directories of the days and the log file are NOT created if planOnly is true, the watch mode
+    *            and the proxy mode are off if planOnly is true, and the proxy mode goes before the watch mode
     **/
-    void run(const char *cfgFile);
+    void run(const char *cfgFile, const runopt_t &ropt);
 };
\ No newline at end of file
@@ -0,0 +1,567 @@
+/*------------------------------------------------------------------------------
+* ProxyUtil.cpp : the HTTP caching proxy of the remote files for the other GOOD on the LAN
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RFC 7230 (HTTP/1.1), RFC 7232 (conditional requests), RFC 7233 (range requests)
+*
+* history : 2026/10/18 1.0  new, the remote files asked for by the other GOOD are downloaded once into the cache (see
+*                           CacheUtil) and sent from it, and the requests of the same file at the same time share one
+*                           transfer from the archive
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "ZipUtil.h"
+#include "NetUtil.h"
+#include "CacheUtil.h"
+#include "ProxyUtil.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <ws2tcpip.h>
+#else          /* for Linux or Mac */
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#elif defined(__APPLE__)
+#include <sys/uio.h>
+#endif
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define PROXY_TIMEOUT   60        /* timeout for receiving the requests and sending the responses (s) */
+#define PROXY_MAXCONN   64        /* max number of the clients served at a time */
+#define PROXY_BACKLOG   64        /* the length of the queue of the clients NOT accepted yet */
+#define PROXY_MAXHEAD   16384     /* max size of the request line and the header fields (bytes) */
+#define PROXY_BUFFSIZE  65536     /* buffer size for sending the file NOT by 'sendfile' (bytes) */
+#define PROXY_MAXSEND   1073741824LL  /* max bytes sent by 'sendfile' at a time */
+#define MIN(x, y)       ((x) < (y) ? (x) : (y))
+
+#ifdef _WIN32  /* for Windows */
+typedef SOCKET socket_t;
+#define SOCKET_INVALID  INVALID_SOCKET
+#define closesock       closesocket
+#define MSG_NOSIGNAL    0
+#else          /* for Linux or Mac */
+typedef int socket_t;
+#define SOCKET_INVALID  (-1)
+#define closesock       close
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL    0
+#endif
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : SendAll - send all the bytes to the client
+* @param[I]: fd (the socket of the client)
+* @param[I]: buff (the bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SendAll(socket_t fd, const char *buff, size_t n)
+{
+    while (n > 0)
+    {
+        int m = (int)send(fd, buff, (int)(n > PROXY_BUFFSIZE ? PROXY_BUFFSIZE : n), MSG_NOSIGNAL);
+        if (m < 0 && errno == EINTR) continue;
+        if (m <= 0) return false;
+        buff += m;
+        n -= (size_t)m;
+    }
+
+    return true;
+} /* end of SendAll */
+
+/**
+* @brief   : SendFile - send a part of the file to the client
+* @param[I]: fd (the socket of the client)
+* @param[I]: file (the file with full path)
+* @param[I]: offset (the first byte sent)
+* @param[I]: count (number of bytes sent)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : 'sendfile' is used on Linux and Mac, so the bytes are sent from the page cache without being copied to
+*            the process
+**/
+static bool SendFile(socket_t fd, const string &file, long long offset, long long count)
+{
+#if defined(__linux__)
+    int in = open(file.c_str(), O_RDONLY);
+    if (in < 0) return false;
+    off_t off = (off_t)offset;
+    while (count > 0)
+    {
+        ssize_t n = sendfile(fd, in, &off, (size_t)(count > PROXY_MAXSEND ? PROXY_MAXSEND : count));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        count -= n;
+    }
+    close(in);
+
+    return count == 0;
+#elif defined(__APPLE__)
+    int in = open(file.c_str(), O_RDONLY);
+    if (in < 0) return false;
+    off_t off = (off_t)offset;
+    while (count > 0)
+    {
+        off_t n = (off_t)(count > PROXY_MAXSEND ? PROXY_MAXSEND : count);
+        int ret = sendfile(in, fd, off, &n, nullptr, 0);  /* 'n' is the bytes sent even if it failed */
+        off += n;
+        count -= n;
+        if (ret < 0 && errno != EINTR && errno != EAGAIN) break;
+        if (ret == 0 && n == 0) break;
+    }
+    close(in);
+
+    return count == 0;
+#else          /* for Windows and the others */
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return false;
+#ifdef _WIN32  /* for Windows */
+    bool ok = _fseeki64(fp, offset, SEEK_SET) == 0;
+#else
+    bool ok = fseeko(fp, (off_t)offset, SEEK_SET) == 0;
+#endif
+    std::vector<char> buff(PROXY_BUFFSIZE);
+    while (ok && count > 0)
+    {
+        size_t n = fread(buff.data(), 1, (size_t)(count > PROXY_BUFFSIZE ? PROXY_BUFFSIZE : count), fp);
+        ok = n > 0 && SendAll(fd, buff.data(), n);
+        count -= (long long)n;
+    }
+    fclose(fp);
+
+    return ok && count == 0;
+#endif
+} /* end of SendFile */
+
+/**
+* @brief   : ToUrl - the remote URL asked for by the target of the request
+* @param[I]: target (the target of the request, i.e., "/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/",
+*            or the absolute URL sent to a forward proxy)
+* @param[O]: none
+* @return  : the remote URL, i.e., "ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/", empty: NOT supported
+* @note    :
+**/
+static string ToUrl(const string &target)
+{
+    string scheme, rest;
+    size_t pos = target.find("://");
+    if (target[0] == '/')
+    {
+        pos = target.find('/', 1);
+        if (pos == string::npos) return "";
+        scheme = target.substr(1, pos - 1);
+        rest = target.substr(pos + 1);
+    }
+    else if (pos != string::npos)
+    {
+        scheme = target.substr(0, pos);
+        rest = target.substr(pos + 3);
+    }
+    StringUtil str;
+    str.ToLower(scheme);
+    if (scheme != "ftp" && scheme != "ftps" && scheme != "http" && scheme != "https") return "";
+    if (rest.empty() || rest[0] == '/') return "";
+
+    return scheme + "://" + rest;
+} /* end of ToUrl */
+
+/**
+* @brief   : Escape - percent-encode a file name for the link of the index page
+* @param[I]: name (file name)
+* @param[O]: none
+* @return  : the name encoded
+* @note    :
+**/
+static string Escape(const string &name)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    string link;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        unsigned char c = (unsigned char)name[i];
+        if (isalnum(c) || strchr("-._~+", c)) link.push_back((char)c);
+        else
+        {
+            link.push_back('%');
+            link.push_back(hex[c >> 4]);
+            link.push_back(hex[c & 15]);
+        }
+    }
+
+    return link;
+} /* end of Escape */
+
+ProxyUtil::ProxyUtil()
+{
+    _net = nullptr;
+    _cache = nullptr;
+    _fd = SOCKET_INVALID;
+    _verbose = false;
+    _nconn = 0;
+}
+
+ProxyUtil::~ProxyUtil()
+{
+    if (_fd != SOCKET_INVALID) closesock(_fd);
+}
+
+/**
+* @brief   : Accept - accept the clients and serve every one in a thread of its own
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : it does NOT return, and ONLY PROXY_MAXCONN clients are served at a time, the others wait in the backlog
+**/
+void ProxyUtil::Accept()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            while (_nconn >= PROXY_MAXCONN) _slot.wait(lock);
+        }
+
+        socket_t fd = accept(_fd, nullptr, nullptr);
+        if (fd == SOCKET_INVALID)
+        {
+            if (errno != EINTR) std::this_thread::sleep_for(std::chrono::milliseconds(100));  /* i.e., too many open files */
+            continue;
+        }
+
+        /* the idle client is dropped, and the response is sent as soon as it is ready */
+#ifdef _WIN32  /* for Windows */
+        DWORD tv = PROXY_TIMEOUT * 1000;
+#else          /* for Linux or Mac */
+        struct timeval tv = { PROXY_TIMEOUT, 0 };
+#endif
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char *)&tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, (const char *)&tv, sizeof(tv));
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _nconn++;
+        }
+        std::thread(&ProxyUtil::Serve, this, fd).detach();
+    }
+} /* end of Accept */
+
+/**
+* @brief   : Serve - serve the requests of a client until it closes the connection or is idle for PROXY_TIMEOUT
+* @param[I]: fd (the socket of the client)
+* @param[O]: none
+* @return  : none
+* @note    : the socket is closed
+**/
+void ProxyUtil::Serve(socket_t fd)
+{
+    StringUtil str;
+    string rbuf;                  /* received but not yet consumed bytes */
+    std::vector<char> buff(PROXY_BUFFSIZE);
+    for (;;)
+    {
+        /* the request line and the header fields */
+        size_t end;
+        while ((end = rbuf.find("\r\n\r\n")) == string::npos && rbuf.size() < PROXY_MAXHEAD)
+        {
+            int n = (int)recv(fd, buff.data(), (int)buff.size(), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            rbuf.append(buff.data(), n);
+        }
+        if (end == string::npos) break;
+        string head = rbuf.substr(0, end + 2);
+        rbuf.erase(0, end + 4);
+
+        /* i.e., "GET /ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/igs21906.sp3.Z HTTP/1.1" */
+        size_t p0 = head.find("\r\n");
+        std::vector<string> words;
+        str.GetSubStr(head.substr(0, p0), " ", words);
+        if (words.size() != 3 || words[2].compare(0, 5, "HTTP/") != 0) break;
+        std::map<string, string> fields;
+        while ((p0 += 2) < head.size())
+        {
+            size_t p1 = head.find("\r\n", p0), pc = head.find(':', p0);
+            if (pc != string::npos && pc < p1)
+            {
+                string name = head.substr(p0, pc - p0), value = head.substr(pc + 1, p1 - pc - 1);
+                str.ToLower(name);
+                str.TrimSpace4String(value);
+                fields[name] = value;
+            }
+            p0 = p1;
+        }
+
+        /* the connection of HTTP/1.1 is kept open unless it is asked to be closed */
+        string conn = fields.count("connection") > 0 ? fields["connection"] : "";
+        str.ToLower(conn);
+        bool keep = words[2] == "HTTP/1.0" ? conn == "keep-alive" : conn != "close";
+        if (!Respond(fd, words[0], words[1], fields, keep) || !keep) break;
+    }
+    closesock(fd);
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _nconn--;
+    }
+    _slot.notify_one();
+} /* end of Serve */
+
+/**
+* @brief   : Respond - respond to a request
+* @param[I]: fd (the socket of the client)
+* @param[I]: method ("GET" or "HEAD")
+* @param[I]: target (the target of the request, i.e., "/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/")
+* @param[I]: fields (the header fields with the names in lowercase)
+* @param[I]: keep (true: the connection is kept open after the response)
+* @param[O]: none
+* @return  : true: the response has been sent, false: the connection is broken
+* @note    : the target ending with '/' is a directory, which is listed as an index page of links (see
+*            NetUtil::List), and the file is sent with "ETag" (SHA-256 of the content) and "Last-Modified" of
+*            the remote file, and "Range" and "If-None-Match" are accepted
+**/
+bool ProxyUtil::Respond(socket_t fd, const string &method, const string &target, const std::map<string, string> &fields,
+    bool keep)
+{
+    string status, body, extra, objFile;
+    long long length = 0, first = 0;
+    string url = ToUrl(target);
+    bool head = method == "HEAD";
+    if (method != "GET" && !head)
+    {
+        status = "405 Method Not Allowed";
+        extra = "Allow: GET, HEAD\r\n";
+    }
+    else if (url.empty()) status = "400 Bad Request";
+    else if (url[url.size() - 1] == '/')
+    {
+        /* the directory is listed once for all the clients until the listings are expired */
+        std::vector<string> names;
+        if (!_net->ListCached(url, names)) status = "404 Not Found";
+        else
+        {
+            status = "200 OK";
+            extra = "Content-Type: text/html\r\n";
+            body = "<html><body>\n";
+            for (size_t i = 0; i < names.size(); i++)
+            {
+                string link = Escape(names[i]);
+                body += "<a href=\"" + link + "\">" + link + "</a>\n";
+            }
+            body += "</body></html>\n";
+            length = (long long)body.size();
+        }
+    }
+    else
+    {
+        CacheUtil::entry_t entry;
+        objFile = Fetch(url, entry);
+        std::map<string, string>::const_iterator it;
+        string etag = "\"" + entry.object + "\"";
+        if (objFile.empty()) status = "404 Not Found";
+        else if ((it = fields.find("if-none-match")) != fields.end() && it->second.find(etag) != string::npos)
+        {
+            status = "304 Not Modified";
+            extra = "ETag: " + etag + "\r\n";
+            objFile.clear();
+        }
+        else
+        {
+            /* "Range: bytes=first-[last]" of the file resumed */
+            long long last = entry.length - 1;
+            status = "200 OK";
+            if ((it = fields.find("range")) != fields.end() && it->second.compare(0, 6, "bytes=") == 0 &&
+                it->second.find(',') == string::npos)
+            {
+                char *p;
+                first = strtoll(it->second.c_str() + 6, &p, 10);
+                if (*p == '-' && *(p + 1) != '\0') last = MIN(last, strtoll(p + 1, nullptr, 10));
+                if (*p != '-' || first > last)
+                {
+                    status = "416 Range Not Satisfiable";
+                    extra = "Content-Range: bytes */" + to_string(entry.length) + "\r\n";
+                    objFile.clear();
+                    first = 0;
+                    last = -1;
+                }
+                else
+                {
+                    status = "206 Partial Content";
+                    extra = "Content-Range: bytes " + to_string(first) + "-" + to_string(last) + "/" +
+                        to_string(entry.length) + "\r\n";
+                }
+            }
+            length = last - first + 1;
+            extra += "Content-Type: application/octet-stream\r\nAccept-Ranges: bytes\r\nETag: " + etag + "\r\n";
+            if (entry.mtime > 0) extra += "Last-Modified: " + NetUtil::HttpTime(entry.mtime) + "\r\n";
+        }
+    }
+    if (_verbose) cout << "*** INFO(ProxyUtil::Respond): " << method << " " << (url.empty() ? target : url) << "  " <<
+        status << endl;
+
+    string resp = "HTTP/1.1 " + status + "\r\n" + extra + "Content-Length: " + to_string(length) + "\r\n" +
+        (keep ? "Connection: keep-alive\r\n" : "Connection: close\r\n") + "\r\n";
+    if (!head) resp += body;
+    if (!SendAll(fd, resp.c_str(), resp.size())) return false;
+    if (!head && !objFile.empty() && length > 0) return SendFile(fd, objFile, first, length);
+
+    return true;
+} /* end of Respond */
+
+/**
+* @brief   : Fetch - get a remote file into the cache, which is downloaded by ONLY one thread at a time
+* @param[I]: url (URL of the remote file)
+* @param[O]: entry (the remote file in the cache)
+* @return  : the object with full path, empty: NOT found
+* @note    : the requests of the same URL at the same time wait for the one downloading or revalidating it, and
+*            then share its result (single-flight), so one transfer from the archive serves all of them
+**/
+string ProxyUtil::Fetch(const string &url, CacheUtil::entry_t &entry)
+{
+    string objFile;
+    bool waited = false;
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;)
+    {
+        while (_busy.count(url) > 0)
+        {
+            waited = true;
+            _landed.wait(lock);
+        }
+        if (!waited && _fresh.count(url) == 0) break;
+
+        /* the object is looked up without the lock */
+        lock.unlock();
+        bool found = _cache->Find(url, entry, objFile);
+        lock.lock();
+        if (found) return objFile;
+        if (waited) return "";    /* the transfer waited for has failed */
+        _fresh.erase(url);        /* the object has been removed (i.e., by hand) */
+    }
+    _busy.insert(url);
+    lock.unlock();
+
+    bool ok = Refill(url, entry, objFile);
+
+    lock.lock();
+    _busy.erase(url);
+    if (ok) _fresh.insert(url);
+    lock.unlock();
+    _landed.notify_all();
+
+    return ok ? objFile : "";
+} /* end of Fetch */
+
+/**
+* @brief   : Refill - revalidate the remote file in the cache, or download it if it is NOT in the cache or modified
+* @param[I]: url (URL of the remote file)
+* @param[O]: entry (the remote file in the cache)
+* @param[O]: objFile (the object with full path)
+* @return  : true:ok, false:error or NOT found
+* @note    : the file in the cache is used if the archive can NOT tell whether it has been modified
+**/
+bool ProxyUtil::Refill(const string &url, CacheUtil::entry_t &entry, string &objFile)
+{
+    if (_cache->Find(url, entry, objFile))
+    {
+        NetUtil::remote_t known, remote;
+        known.size = entry.size;
+        known.mtime = entry.mtime;
+        known.etag = entry.etag;
+        if (_net->Revalidate(url, known, remote) <= 0) return true;
+
+        _cache->Forget(url);
+        if (_verbose) cout << "*** INFO(ProxyUtil::Refill): " << url << "  modified, downloaded again" << endl;
+    }
+
+    /* the partial file of the transfer broken is resumed */
+    string partFile = _cache->Spool(url);
+    unsigned long crc = 0;
+    NetUtil::sink_t toCrc = [&crc](const char *buff, size_t n) { crc = ZipUtil::Crc32(crc, buff, n); return true; };
+    NetUtil::remote_t remote;
+    if (partFile.empty() || !_net->GetPart(url, partFile, &toCrc, &remote)) return false;
+    bool ok = _cache->Put(url, partFile, remote.size, remote.mtime, remote.etag, crc) && _cache->Find(url, entry, objFile);
+    remove(partFile.c_str());
+
+    return ok;
+} /* end of Refill */
+
+/**
+* @brief   : SetVerbose - print the information of every request or not
+* @param[I]: verbose (true: print)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProxyUtil::SetVerbose(bool verbose)
+{
+    _verbose = verbose;
+} /* end of SetVerbose */
+
+/**
+* @brief   : Start - listen at the port and serve the remote files to the other GOOD (see NetUtil::SetProxy)
+* @param[I]: net (the transfer engine of the upstream archives)
+* @param[I]: cache (the cache where the remote files are kept, which should be open)
+* @param[I]: port (port number)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the clients are accepted in a thread of its own, and the proxy should be kept until the process exits.
+*            A request "GET /scheme/rest" is served with the remote file "scheme://rest"
+**/
+bool ProxyUtil::Start(NetUtil *net, CacheUtil *cache, int port)
+{
+    if (!net || !cache || !cache->IsOpen() || _fd != SOCKET_INVALID) return false;
+    _net = net;
+    _cache = cache;
+
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_fd == SOCKET_INVALID) return false;
+    int one = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, (const char *)&one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((unsigned short)port);
+    if (bind(_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(_fd, PROXY_BACKLOG) != 0)
+    {
+        cerr << "*** WARNING(ProxyUtil::Start): listen at port " << port << " failed" << endl;
+        closesock(_fd);
+        _fd = SOCKET_INVALID;
+
+        return false;
+    }
+    std::thread(&ProxyUtil::Accept, this).detach();
+
+    return true;
+} /* end of Start */
+
+/**
+* @brief   : Expire - revalidate the remote files when they are asked for again
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProxyUtil::Expire()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _fresh.clear();
+} /* end of Expire */
@@ -0,0 +1,118 @@
+/*------------------------------------------------------------------------------
+* ProxyUtil.h : header file of ProxyUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class NetUtil;
+
+class ProxyUtil
+{
+private:
+
+#ifdef _WIN32  /* for Windows */
+    typedef SOCKET socket_t;
+#else          /* for Linux or Mac */
+    typedef int socket_t;
+#endif
+
+    NetUtil *_net;                /* the transfer engine of the upstream archives */
+    CacheUtil *_cache;            /* the cache where the remote files are kept and served from */
+    socket_t _fd;                 /* the listening socket */
+    bool _verbose;                /* true: print the information of every request */
+    std::set<string> _busy;       /* the URLs being downloaded or revalidated by one of the threads */
+    std::set<string> _fresh;      /* the URLs revalidated since the last expiry, which are served without asking the archive */
+    int _nconn;                   /* number of the clients being served */
+    std::mutex _lock;             /* the lock of the URLs and the clients */
+    std::condition_variable _landed;  /* notified when a URL has been downloaded or revalidated */
+    std::condition_variable _slot;    /* notified when a client has been served */
+
+private:
+
+    /**
+    * @brief   : Accept - accept the clients and serve every one in a thread of its own
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it does NOT return, and ONLY PROXY_MAXCONN clients are served at a time, the others wait in the backlog
+    **/
+    void Accept();
+
+    /**
+    * @brief   : Serve - serve the requests of a client until it closes the connection or is idle for PROXY_TIMEOUT
+    * @param[I]: fd (the socket of the client)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the socket is closed
+    **/
+    void Serve(socket_t fd);
+
+    /**
+    * @brief   : Respond - respond to a request
+    * @param[I]: fd (the socket of the client)
+    * @param[I]: method ("GET" or "HEAD")
+    * @param[I]: target (the target of the request, i.e., "/ftps/gdc.cddis.eosdis.nasa.gov/pub/gnss/products/2190/")
+    * @param[I]: fields (the header fields with the names in lowercase)
+    * @param[I]: keep (true: the connection is kept open after the response)
+    * @param[O]: none
+    * @return  : true: the response has been sent, false: the connection is broken
+    * @note    : the target ending with '/' is a directory, which is listed as an index page of links (see
+    *            NetUtil::List), and the file is sent with "ETag" (SHA-256 of the content) and "Last-Modified" of
+    *            the remote file, and "Range" and "If-None-Match" are accepted
+    **/
+    bool Respond(socket_t fd, const string &method, const string &target, const std::map<string, string> &fields,
+        bool keep);
+
+    /**
+    * @brief   : Fetch - get a remote file into the cache, which is downloaded by ONLY one thread at a time
+    * @param[I]: url (URL of the remote file)
+    * @param[O]: entry (the remote file in the cache)
+    * @return  : the object with full path, empty: NOT found
+    * @note    : the requests of the same URL at the same time wait for the one downloading or revalidating it, and
+    *            then share its result (single-flight), so one transfer from the archive serves all of them
+    **/
+    string Fetch(const string &url, CacheUtil::entry_t &entry);
+
+    /**
+    * @brief   : Refill - revalidate the remote file in the cache, or download it if it is NOT in the cache or modified
+    * @param[I]: url (URL of the remote file)
+    * @param[O]: entry (the remote file in the cache)
+    * @param[O]: objFile (the object with full path)
+    * @return  : true:ok, false:error or NOT found
+    * @note    : the file in the cache is used if the archive can NOT tell whether it has been modified
+    **/
+    bool Refill(const string &url, CacheUtil::entry_t &entry, string &objFile);
+
+public:
+    ProxyUtil();
+    ~ProxyUtil();
+
+    /**
+    * @brief   : SetVerbose - print the information of every request or not
+    * @param[I]: verbose (true: print)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetVerbose(bool verbose);
+
+    /**
+    * @brief   : Start - listen at the port and serve the remote files to the other GOOD (see NetUtil::SetProxy)
+    * @param[I]: net (the transfer engine of the upstream archives)
+    * @param[I]: cache (the cache where the remote files are kept, which should be open)
+    * @param[I]: port (port number)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the clients are accepted in a thread of its own, and the proxy should be kept until the process exits.
+    *            A request "GET /scheme/rest" is served with the remote file "scheme://rest"
+    **/
+    bool Start(NetUtil *net, CacheUtil *cache, int port);
+
+    /**
+    * @brief   : Expire - revalidate the remote files when they are asked for again
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Expire();
+};
@@ -0,0 +1,421 @@
+/*------------------------------------------------------------------------------
+* ShardUtil.cpp : the queue of the jobs shared by the nodes through the lease files on a shared file system
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, every job (i.e., a getter of a day, or a site of the observations) is leased to ONE
+*                           node at a time by a file created exclusively, the leases are renewed by a heartbeat, and
+*                           the ones of the nodes died are taken over when they expire
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "FileUtil.h"
+#include "ShardUtil.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <sys/utime.h>
+#else          /* for Linux or Mac */
+#include <utime.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define FNV_OFFSET      14695981039346656037ULL  /* the offset basis of FNV-1a 64 */
+#define FNV_PRIME       1099511628211ULL         /* the prime of FNV-1a 64 */
+
+/* the queue directory is laid out as below, and every file holds the name of the node and the job in two lines
+     "lease/5f3e...0a"                       the lease of a job being run, renewed (touched) by the heartbeat
+     "lease/5f3e...0a.<node>.expired"        the lease expired, which is being taken over by the node
+     "done/5f3e...0a"                        the job finished by one of the nodes
+     "node/<node>"                           touched by the heartbeat, its time is the clock of the shared file system
+   the files are named by FNV-1a 64 of the scope (the signature of the options) and the job */
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Touch - set the modification time of a file to the current time of the file system
+* @param[I]: file (the file with full path)
+* @param[O]: none
+* @return  : true:ok, false:error (i.e., the file does NOT exist)
+* @note    : the time is set by the file server on the network file systems (i.e., NFS and SMB)
+**/
+static bool Touch(const string &file)
+{
+#ifdef _WIN32  /* for Windows */
+    return _utime(file.c_str(), NULL) == 0;
+#else          /* for Linux or Mac */
+    return utime(file.c_str(), NULL) == 0;
+#endif
+} /* end of Touch */
+
+/**
+* @brief   : CreateNew - create a file exclusively and write the text to it
+* @param[I]: file (the file with full path)
+* @param[I]: text (the content)
+* @param[O]: none
+* @return  : 1: created, 0: the file exists, -1: error
+* @note    : ONLY one of the nodes creating the same file at the same time gets 1 (O_EXCL is atomic on NFS v3 and later)
+**/
+static int CreateNew(const string &file, const string &text)
+{
+#ifdef _WIN32  /* for Windows */
+    int fd = _open(file.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else          /* for Linux or Mac */
+    int fd = open(file.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+#endif
+    if (fd < 0) return errno == EEXIST ? 0 : -1;
+
+#ifdef _WIN32  /* for Windows */
+    bool ok = _write(fd, text.c_str(), (unsigned int)text.size()) == (int)text.size();
+    if (_close(fd) != 0) ok = false;
+#else          /* for Linux or Mac */
+    bool ok = write(fd, text.c_str(), text.size()) == (ssize_t)text.size();
+    if (close(fd) != 0) ok = false;
+#endif
+    if (!ok)
+    {
+        remove(file.c_str());
+
+        return -1;
+    }
+
+    return 1;
+} /* end of CreateNew */
+
+ShardUtil::ShardUtil()
+{
+    _ttl = 0;
+    _nbusy = 0;
+    _skew = 0;
+    _stopping = false;
+}
+
+ShardUtil::~ShardUtil()
+{
+    Close();
+}
+
+/**
+* @brief   : Path - the file of a job in a sub-directory of the queue
+* @param[I]: sub (the sub-directory, "lease" or "done")
+* @param[I]: job (the job, i.e., "2022/032 obs igs daily algo")
+* @param[O]: none
+* @return  : the file with full path, which is named by the FNV-1a hash of the job and the scope
+* @note    :
+**/
+string ShardUtil::Path(const string &sub, const string &job)
+{
+    StringUtil str;
+    string key = _scope + " " + job;
+    unsigned long long hash = FNV_OFFSET;
+    for (size_t i = 0; i < key.size(); i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= FNV_PRIME;
+    }
+    char name[32] = { '\0' };
+    sprintf(name, "%016llx", hash);
+
+    return str.FullPath(str.FullPath(_dir, sub), name);
+} /* end of Path */
+
+/**
+* @brief   : Now - the current time of the shared file system
+* @param[I]: none
+* @param[O]: none
+* @return  : the time in seconds since 1970-01-01
+* @note    : the modification times of the leases are set by the file server, so they are compared with its clock
+*            instead of the local one (see Beat)
+**/
+long long ShardUtil::Now()
+{
+    return (long long)time(NULL) + _skew;
+} /* end of Now */
+
+/**
+* @brief   : Holder - the node holding a lease
+* @param[I]: leaseFile (the lease with full path)
+* @param[O]: none
+* @return  : the name of the node, empty: error
+* @note    :
+**/
+string ShardUtil::Holder(const string &leaseFile)
+{
+    FILE *fp = fopen(leaseFile.c_str(), "r");
+    if (!fp) return "";
+
+    char line[MAXCHARS] = { '\0' };
+    string node;
+    if (fgets(line, MAXCHARS, fp)) node = line;
+    fclose(fp);
+    node.erase(node.find_last_not_of(" \r\n") + 1);
+
+    return node;
+} /* end of Holder */
+
+/**
+* @brief   : Beat - renew the leases held by this node, and measure the clock of the shared file system
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : it runs in the heartbeat thread every third of the time to live of the leases until Close
+**/
+void ShardUtil::Beat()
+{
+    StringUtil str;
+    string nodeFile = str.FullPath(str.FullPath(_dir, "node"), _node);
+    std::unique_lock<std::mutex> lock(_lock);
+    while (!_stopping)
+    {
+        std::set<string> held = _held;
+        lock.unlock();
+
+        /* the clock of the shared file system */
+        struct stat st;
+        if (!Touch(nodeFile))
+        {
+            FILE *fp = fopen(nodeFile.c_str(), "w");
+            if (fp) fclose(fp);
+        }
+        if (stat(nodeFile.c_str(), &st) == 0) _skew = (long long)st.st_mtime - (long long)time(NULL);
+
+        /* the leases taken over by the other nodes are NOT renewed, i.e., this node was suspended longer than
+           their time to live */
+        std::vector<string> lost;
+        for (std::set<string>::iterator it = held.begin(); it != held.end(); ++it)
+        {
+            string leaseFile = Path("lease", *it);
+            if (Holder(leaseFile) != _node || !Touch(leaseFile)) lost.push_back(*it);
+        }
+
+        lock.lock();
+        for (size_t i = 0; i < lost.size(); i++)
+        {
+            if (_held.erase(lost[i]) == 0) continue;  /* finished just now */
+            cerr << "*** WARNING(ShardUtil::Beat): the lease of the job \"" << lost[i] << "\" has been taken over" << endl;
+        }
+        _wake.wait_for(lock, std::chrono::seconds(_ttl / 3 > 1 ? _ttl / 3 : 1), [this]() { return _stopping; });
+    }
+} /* end of Beat */
+
+/**
+* @brief   : HostName - the name of the local host
+* @param[I]: none
+* @param[O]: none
+* @return  : the host name, "localhost" if it is unknown
+* @note    :
+**/
+string ShardUtil::HostName()
+{
+    char name[MAXCHARS] = { '\0' };
+#ifdef _WIN32  /* for Windows */
+    DWORD n = MAXCHARS;
+    if (!GetComputerNameA(name, &n)) name[0] = '\0';
+#else          /* for Linux or Mac */
+    if (gethostname(name, MAXCHARS - 1) != 0) name[0] = '\0';
+#endif
+    string host = name;
+    for (size_t i = 0; i < host.size(); i++)
+    {
+        if (host[i] == FILEPATHSEP || host[i] == '/' || isspace((unsigned char)host[i])) host[i] = '_';
+    }
+
+    return host.empty() ? "localhost" : host;
+} /* end of HostName */
+
+/**
+* @brief   : Open - join the queue of the jobs shared by the nodes
+* @param[I]: dir (the directory of the queue on the shared file system)
+* @param[I]: scope (the signature of the options, the nodes with the same one share the jobs)
+* @param[I]: ttl (time to live of the leases (s))
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the directory (and its sub-directories) are created if they do NOT exist, and the heartbeat is started
+**/
+bool ShardUtil::Open(const string &dir, const string &scope, int ttl)
+{
+    StringUtil str;
+    Close();
+    if (dir.empty()) return false;
+
+    if (!FileUtil::MakeDir(str.FullPath(dir, "lease")) || !FileUtil::MakeDir(str.FullPath(dir, "done")) ||
+        !FileUtil::MakeDir(str.FullPath(dir, "node")))
+    {
+        cerr << "*** WARNING(ShardUtil::Open): the queue " << dir << " can NOT be used" << endl;
+
+        return false;
+    }
+    _dir = dir;
+    _scope = scope;
+    _node = HostName() + "." + to_string((int)getpid());
+    _ttl = ttl > 3 ? ttl : 3;
+    _nbusy = 0;
+    _stopping = false;
+    _done.clear();
+    _failed.clear();
+    _beat = std::thread(&ShardUtil::Beat, this);
+    cout << "*** INFO(ShardUtil::Open): the jobs are shared through " << dir << " as the node " << _node << endl;
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Close - leave the queue, the leases held are released
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ShardUtil::Close()
+{
+    if (_dir.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    if (_beat.joinable()) _beat.join();
+
+    for (std::set<string>::iterator it = _held.begin(); it != _held.end(); ++it)
+    {
+        string leaseFile = Path("lease", *it);
+        if (Holder(leaseFile) == _node) remove(leaseFile.c_str());
+    }
+    _held.clear();
+    StringUtil str;
+    remove(str.FullPath(str.FullPath(_dir, "node"), _node).c_str());
+    _dir.clear();
+} /* end of Close */
+
+/**
+* @brief   : IsOpen - check if the queue is used
+* @param[I]: none
+* @param[O]: none
+* @return  : true: used, false: NOT used
+* @note    :
+**/
+bool ShardUtil::IsOpen()
+{
+    return !_dir.empty();
+} /* end of IsOpen */
+
+/**
+* @brief   : Claim - lease a job to this node unless it is finished or being run by another node
+* @param[I]: job (the job, i.e., "2022/032 obs igs daily algo")
+* @param[O]: none
+* @return  : SHARD_RUN, SHARD_DONE, SHARD_BUSY, or SHARD_SKIP (SHARD_RUN if the queue is NOT used)
+* @note    : the lease is a file created exclusively, so ONLY one node gets it. The lease NOT renewed within its
+*            time to live (i.e., the node has died) is taken over by renaming it away, which ONLY one node can do
+**/
+int ShardUtil::Claim(const string &job)
+{
+    if (_dir.empty()) return SHARD_RUN;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_done.count(job) > 0) return SHARD_DONE;
+        if (_failed.count(job) > 0) return SHARD_SKIP;
+    }
+
+    string doneFile = Path("done", job), leaseFile = Path("lease", job);
+    if (access(doneFile.c_str(), 0) == 0)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _done.insert(job);
+
+        return SHARD_DONE;
+    }
+
+    /* the second try is for the lease released or taken over just now */
+    for (int itry = 0; itry < 2; itry++)
+    {
+        int stat0 = CreateNew(leaseFile, _node + "\n" + job + "\n");
+        if (stat0 < 0)
+        {
+            cerr << "*** WARNING(ShardUtil::Claim): the lease " << leaseFile << " can NOT be created" << endl;
+
+            return SHARD_SKIP;
+        }
+        if (stat0 > 0)
+        {
+            /* the job may be finished by another node between the check and the lease */
+            if (access(doneFile.c_str(), 0) == 0)
+            {
+                remove(leaseFile.c_str());
+                std::lock_guard<std::mutex> lock(_lock);
+                _done.insert(job);
+
+                return SHARD_DONE;
+            }
+            std::lock_guard<std::mutex> lock(_lock);
+            _held.insert(job);
+
+            return SHARD_RUN;
+        }
+
+        struct stat st;
+        if (stat(leaseFile.c_str(), &st) != 0) continue;
+        if (Now() - (long long)st.st_mtime <= _ttl) break;
+
+        /* the lease has expired, and ONLY the node renaming it away takes the job over */
+        string holder = Holder(leaseFile), expiredFile = leaseFile + "." + _node + ".expired";
+        if (rename(leaseFile.c_str(), expiredFile.c_str()) != 0) continue;
+        remove(expiredFile.c_str());
+        cout << "*** INFO(ShardUtil::Claim): the job \"" << job << "\" of the node " << holder <<
+            " is taken over since its lease has expired" << endl;
+    }
+    _nbusy++;
+
+    return SHARD_BUSY;
+} /* end of Claim */
+
+/**
+* @brief   : Finish - release the lease of a job run by this node
+* @param[I]: job (the job)
+* @param[I]: ok (true: the job is finished, false: failed, and it is left to the other nodes)
+* @param[O]: none
+* @return  : none
+* @note    : the job finished is marked as done for all the nodes and the runs to come
+**/
+void ShardUtil::Finish(const string &job, bool ok)
+{
+    if (_dir.empty()) return;
+
+    string leaseFile = Path("lease", job);
+    if (ok)
+    {
+        string doneFile = Path("done", job), tmpFile = doneFile + "." + _node + ".tmp";
+        FILE *fp = fopen(tmpFile.c_str(), "w");
+        bool wrote = fp && fprintf(fp, "%s\n%s\n", _node.c_str(), job.c_str()) > 0;
+        if (fp && fclose(fp) != 0) wrote = false;
+        if (!wrote || !FileUtil::Rename(tmpFile, doneFile))
+        {
+            remove(tmpFile.c_str());
+            cerr << "*** WARNING(ShardUtil::Finish): the job \"" << job << "\" can NOT be marked as done" << endl;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (ok) _done.insert(job);
+    else _failed.insert(job);
+    if (_held.erase(job) > 0 && Holder(leaseFile) == _node) remove(leaseFile.c_str());
+} /* end of Finish */
+
+/**
+* @brief   : Pass - start a new pass over the jobs
+* @param[I]: none
+* @param[O]: none
+* @return  : number of the jobs found being run by the other nodes since the last pass
+* @note    :
+**/
+int ShardUtil::Pass()
+{
+    return _nbusy.exchange(0);
+} /* end of Pass */
@@ -0,0 +1,140 @@
+/*------------------------------------------------------------------------------
+* ShardUtil.h : header file of ShardUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* the claims of the jobs (see ShardUtil::Claim) */
+#define SHARD_RUN       1         /* the job is run by this node */
+#define SHARD_DONE      0         /* the job has been finished by one of the nodes */
+#define SHARD_BUSY      (-1)      /* the job is being run by another node */
+#define SHARD_SKIP      (-2)      /* the job has failed in this node, or the queue can NOT be used */
+
+class ShardUtil
+{
+private:
+
+    string _dir;                  /* the directory of the queue shared by the nodes, empty: NOT used */
+    string _scope;                /* the signature of the options, the nodes with the same one share the jobs */
+    string _node;                 /* the name of this node, i.e., "node01.1234" (host name and process ID) */
+    int _ttl;                     /* time to live of the leases (s), the lease NOT renewed within it has expired */
+    std::set<string> _held;       /* the jobs leased by this node */
+    std::set<string> _done;       /* the jobs known to be finished */
+    std::set<string> _failed;     /* the jobs failed in this node, which are NOT run again in the run */
+    std::atomic<int> _nbusy;      /* number of the jobs found being run by the other nodes since the last pass */
+    std::atomic<long long> _skew; /* the clock of the shared file system minus the local clock (s) */
+    std::mutex _lock;             /* the lock of the jobs */
+    std::condition_variable _wake;  /* notified when the heartbeat is stopped */
+    bool _stopping;               /* true: the heartbeat is being stopped */
+    std::thread _beat;            /* the heartbeat renewing the leases */
+
+private:
+
+    /**
+    * @brief   : Path - the file of a job in a sub-directory of the queue
+    * @param[I]: sub (the sub-directory, "lease" or "done")
+    * @param[I]: job (the job, i.e., "2022/032 obs igs daily algo")
+    * @param[O]: none
+    * @return  : the file with full path, which is named by the FNV-1a hash of the job and the scope
+    * @note    :
+    **/
+    string Path(const string &sub, const string &job);
+
+    /**
+    * @brief   : Now - the current time of the shared file system
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the time in seconds since 1970-01-01
+    * @note    : the modification times of the leases are set by the file server, so they are compared with its clock
+    *            instead of the local one (see Beat)
+    **/
+    long long Now();
+
+    /**
+    * @brief   : Holder - the node holding a lease
+    * @param[I]: leaseFile (the lease with full path)
+    * @param[O]: none
+    * @return  : the name of the node, empty: error
+    * @note    :
+    **/
+    static string Holder(const string &leaseFile);
+
+    /**
+    * @brief   : Beat - renew the leases held by this node, and measure the clock of the shared file system
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it runs in the heartbeat thread every third of the time to live of the leases until Close
+    **/
+    void Beat();
+
+public:
+    ShardUtil();
+    ~ShardUtil();
+
+    /**
+    * @brief   : HostName - the name of the local host
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the host name, "localhost" if it is unknown
+    * @note    :
+    **/
+    static string HostName();
+
+    /**
+    * @brief   : Open - join the queue of the jobs shared by the nodes
+    * @param[I]: dir (the directory of the queue on the shared file system)
+    * @param[I]: scope (the signature of the options, the nodes with the same one share the jobs)
+    * @param[I]: ttl (time to live of the leases (s))
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the directory (and its sub-directories) are created if they do NOT exist, and the heartbeat is started
+    **/
+    bool Open(const string &dir, const string &scope, int ttl);
+
+    /**
+    * @brief   : Close - leave the queue, the leases held are released
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : IsOpen - check if the queue is used
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: used, false: NOT used
+    * @note    :
+    **/
+    bool IsOpen();
+
+    /**
+    * @brief   : Claim - lease a job to this node unless it is finished or being run by another node
+    * @param[I]: job (the job, i.e., "2022/032 obs igs daily algo")
+    * @param[O]: none
+    * @return  : SHARD_RUN, SHARD_DONE, SHARD_BUSY, or SHARD_SKIP (SHARD_RUN if the queue is NOT used)
+    * @note    : the lease is a file created exclusively, so ONLY one node gets it. The lease NOT renewed within its
+    *            time to live (i.e., the node has died) is taken over by renaming it away, which ONLY one node can do
+    **/
+    int Claim(const string &job);
+
+    /**
+    * @brief   : Finish - release the lease of a job run by this node
+    * @param[I]: job (the job)
+    * @param[I]: ok (true: the job is finished, false: failed, and it is left to the other nodes)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the job finished is marked as done for all the nodes and the runs to come
+    **/
+    void Finish(const string &job, bool ok);
+
+    /**
+    * @brief   : Pass - start a new pass over the jobs
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of the jobs found being run by the other nodes since the last pass
+    * @note    :
+    **/
+    int Pass();
+};
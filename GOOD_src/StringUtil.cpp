@@ -7,10 +7,16 @@
 * References:
 *    
 * history : 2020/09/25 1.0  new (by Feng Zhou)
+*           2026/10/18      the files in the directory are listed by reading it in the process instead of 'ls' or 'dir'
 *-----------------------------------------------------------------------------*/
 #include "Good.h"
 #include "StringUtil.h"
 
+#include <sys/stat.h>
+#ifndef _WIN32 /* for Linux or Mac */
+#include <dirent.h>
+#endif
+
 
 /* constants/macros ----------------------------------------------------------*/
 
@@ -250,59 +256,85 @@ void StringUtil::CutFilePathSep(char *strPath)
 } /* end of CutFilePathSep */
 
 /**
-* @brief   : GetFilesAll - get the name list of all the files from the current directory
-* @param[I]: dir (the current directory)
-* @param[I]: suffix (file suffix)
-* @param[O]: files (the name list of all the files)
+* @brief   : GetFilesAll - get the name list of all the files from the directory
+* @param[I]: dir (the directory)
+* @param[I]: suffix (file suffix, the file whose name contains it is taken, empty: all the files)
+* @param[O]: files (the name list of all the files, sorted by name)
 * @return  : none
-* @note    :
+* @note    : the directory is read in the process, without any shell command or temporary file, so that it is safe
+*            to be called from several threads or runs at the same time. The sub-directories and the hidden files
+*            (i.e., ".listing") are skipped as 'ls' does
 **/
 void StringUtil::GetFilesAll(string dir, string suffix, vector<string> &files)
 {
-    /* change directory */
+    size_t n0 = files.size();
 #ifdef _WIN32   /* for Windows */
-    _chdir(dir.c_str());
-#else           /* for Linux or Mac */
-    chdir(dir.c_str());
-#endif
+    WIN32_FIND_DATAA data;
+    HANDLE h = FindFirstFileA(FullPath(dir, "*").c_str(), &data);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        cerr << "*** ERROR(StringUtil::GetFilesAll): list the files in " << dir << " failed, please check it" << endl;
 
-    string cmd, fileList = "files.list";
-#ifdef _WIN32   /* for Windows */
-    cmd = "dir /b | find \"" + suffix + "\"" + " > " + fileList;
+        return;
+    }
+    do
+    {
+        string fileName = data.cFileName;
+        if (data.dwFileAttributes & (FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_HIDDEN)) continue;
+        if (fileName.empty() || fileName[0] == '.') continue;
+        if (!suffix.empty() && fileName.find(suffix) == string::npos) continue;
+        files.push_back(fileName);
+    } while (FindNextFileA(h, &data));
+    FindClose(h);
 #else           /* for Linux or Mac */
-    cmd = "ls *" + suffix + "* > " + fileList;
-#endif
-    std::system(cmd.c_str());
-
-    if (access(fileList.c_str(), 0) == 0)
+    DIR *dp = opendir(dir.c_str());
+    if (dp == NULL)
     {
-        ifstream filLst(fileList.c_str());
-        if (!filLst.is_open())
-        {
-            cerr << "*** ERROR(StringUtil::GetFilesAll): open files.list = " << fileList << " file failed, please check it" << endl;
+        cerr << "*** ERROR(StringUtil::GetFilesAll): list the files in " << dir << " failed, please check it" << endl;
 
-            return;
-        }
+        return;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(dp)) != NULL)
+    {
+        string fileName = ent->d_name;
+        if (fileName.empty() || fileName[0] == '.') continue;
+        if (!suffix.empty() && fileName.find(suffix) == string::npos) continue;
 
-        string fileName;
-        while (getline(filLst, fileName))
+        /* the type is NOT given by some file systems, and it is taken by 'stat' then */
+        bool isDir = ent->d_type == DT_DIR;
+        if (ent->d_type == DT_UNKNOWN || ent->d_type == DT_LNK)
         {
-            files.push_back(fileName);
+            struct stat st;
+            isDir = stat(FullPath(dir, fileName).c_str(), &st) == 0 && S_ISDIR(st.st_mode);
         }
-
-        /* close 'files.list' */
-        filLst.close();
+        if (!isDir) files.push_back(fileName);
     }
-
-    /* delete 'files.list' */
-#ifdef _WIN32   /* for Windows */
-    cmd = "del " + fileList;
-#else           /* for Linux or Mac */
-    cmd = "rm -rf " + fileList;
+    closedir(dp);
 #endif
-    std::system(cmd.c_str());
+
+    /* in the order of 'ls' (by name) */
+    std::sort(files.begin() + n0, files.end());
 } /* end of GetFilesAll */
 
+/**
+* @brief   : FullPath - join the directory and the file name with the path separator
+* @param[I]: dir (the directory)
+* @param[I]: file (file name without path)
+* @param[O]: none
+* @return  : the file name with full path
+* @note    :
+**/
+string StringUtil::FullPath(const string &dir, const string &file)
+{
+    if (dir.empty()) return file;
+
+    char sep = (char)FILEPATHSEP;
+    if (dir[dir.size() - 1] == sep) return dir + file;
+
+    return dir + sep + file;
+} /* end of FullPath */
+
 /**
 * @brief   : GetSubStr - get sub-string in a vector from a string
 * @param[I]: str (string)
@@ -324,4 +356,75 @@ void StringUtil::GetSubStr(string str, string sep, vector<string> &subStrs)
         pos2 = str.find(sep, pos1);
     }
     if (pos1 != str.length()) subStrs.push_back(str.substr(pos1));
-} /* end of GetSubStr */
\ No newline at end of file
+} /* end of GetSubStr */
+
+/**
+* @brief   : MatchPattern - check if the file name matches the pattern
+* @param[I]: name (file name)
+* @param[I]: pattern (pattern with wildcards '*', '?' and '[...]', or a suffix without wildcard)
+* @param[O]: none
+* @return  : true: matched, false: NOT matched
+* @note    : the same rule as the '-A' option of 'wget'
+**/
+bool StringUtil::MatchPattern(const string &name, const string &pattern)
+{
+    /* a pattern without wildcard is a suffix */
+    if (pattern.find_first_of("*?[") == string::npos)
+    {
+        return name.size() >= pattern.size() && name.compare(name.size() - pattern.size(), pattern.size(), pattern) == 0;
+    }
+
+    /* wildcard matching with backtracking to the last '*' */
+    size_t in = 0, ip = 0, starP = string::npos, starN = 0;
+    while (in < name.size())
+    {
+        bool matched = false;
+        size_t next = ip + 1;
+        if (ip < pattern.size())
+        {
+            if (pattern[ip] == '*')
+            {
+                starP = ip++;
+                starN = in;
+                continue;
+            }
+            else if (pattern[ip] == '?') matched = true;
+            else if (pattern[ip] == '[')
+            {
+                size_t ie = pattern.find(']', ip + 1);
+                if (ie != string::npos)
+                {
+                    bool negate = pattern[ip + 1] == '!' || pattern[ip + 1] == '^';
+                    bool inSet = false;
+                    for (size_t i = ip + 1 + (negate ? 1 : 0); i < ie; i++)
+                    {
+                        if (i + 2 < ie && pattern[i + 1] == '-')
+                        {
+                            if (name[in] >= pattern[i] && name[in] <= pattern[i + 2]) inSet = true;
+                            i += 2;
+                        }
+                        else if (name[in] == pattern[i]) inSet = true;
+                    }
+                    matched = inSet != negate;
+                    next = ie + 1;
+                }
+                else matched = name[in] == '[';
+            }
+            else matched = name[in] == pattern[ip];
+        }
+        if (matched)
+        {
+            in++;
+            ip = next;
+        }
+        else if (starP != string::npos)
+        {
+            ip = starP + 1;
+            in = ++starN;
+        }
+        else return false;
+    }
+    while (ip < pattern.size() && pattern[ip] == '*') ip++;
+
+    return ip == pattern.size();
+} /* end of MatchPattern */
\ No newline at end of file
@@ -128,15 +128,27 @@ public:
     void CutFilePathSep(char *strPath);
 
     /**
-    * @brief   : GetFilesAll - get the name list of all the files from the current directory
-    * @param[I]: dir (the current directory)
-    * @param[I]: suffix (file suffix)
-    * @param[O]: files (the name list of all the files)
+    * @brief   : GetFilesAll - get the name list of all the files from the directory
+    * @param[I]: dir (the directory)
+    * @param[I]: suffix (file suffix, the file whose name contains it is taken, empty: all the files)
+    * @param[O]: files (the name list of all the files, sorted by name)
     * @return  : none
-    * @note    :
+    * @note    : the directory is read in the process, without any shell command or temporary file, so that it is safe
+    *            to be called from several threads or runs at the same time. The sub-directories and the hidden files
+    *            (i.e., ".listing") are skipped as 'ls' does
     **/
     void GetFilesAll(string dir, string suffix, vector<string> &files);
 
+    /**
+    * @brief   : FullPath - join the directory and the file name with the path separator
+    * @param[I]: dir (the directory)
+    * @param[I]: file (file name without path)
+    * @param[O]: none
+    * @return  : the file name with full path
+    * @note    :
+    **/
+    string FullPath(const string &dir, const string &file);
+
     /**
     * @brief   : GetSubStr - get sub-string in a vector from a string
     * @param[I]: str (string)
@@ -146,4 +158,14 @@ public:
     * @note    :
     **/
     void GetSubStr(string str, string sep, vector<string> &subStrs);
+
+    /**
+    * @brief   : MatchPattern - check if the file name matches the pattern
+    * @param[I]: name (file name)
+    * @param[I]: pattern (pattern with wildcards '*', '?' and '[...]', or a suffix without wildcard)
+    * @param[O]: none
+    * @return  : true: matched, false: NOT matched
+    * @note    : the same rule as the '-A' option of 'wget'
+    **/
+    bool MatchPattern(const string &name, const string &pattern);
 };
\ No newline at end of file
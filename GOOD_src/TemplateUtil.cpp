@@ -0,0 +1,332 @@
+/*------------------------------------------------------------------------------
+* TemplateUtil.cpp : the templates of URLs and file names compiled once and expanded without temporary strings
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* history : 2026/10/18 1.0  new, the directories of the archives and the names of the observation files are made by
+*                           the templates with the placeholders "{YYYY}", "{DDD}", "{WWWW}", "{HH}", "{site}", etc.
+*           2026/10/18      add 'Match' for the values of the placeholders of the directories on the archives
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "TimeUtil.h"
+#include "TemplateUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define FLD_YYYY   0    /* four-digit year */
+#define FLD_YY     1    /* two-digit year */
+#define FLD_DDD    2    /* day of year */
+#define FLD_WWWW   3    /* GPS week */
+#define FLD_D      4    /* day of week */
+#define FLD_HH     5    /* hour */
+#define FLD_H      6    /* hourly session, 'a' to 'x' */
+#define FLD_MM     7    /* minute */
+#define FLD_SITE   8    /* four-character site name in lower case */
+#define FLD_USITE  9    /* four-character site name in upper case */
+#define FLD_LONG   10   /* the beginning of the long file name of the site */
+
+static const struct
+{
+    const char *name;             /* the placeholder without braces */
+    int field;                    /* the field (see FLD_*) */
+    size_t size;                  /* the length of the value expected */
+} PLACEHOLDERS[] = {
+    { "YYYY", FLD_YYYY,  4 },
+    { "YY",   FLD_YY,    2 },
+    { "DDD",  FLD_DDD,   3 },
+    { "WWWW", FLD_WWWW,  4 },
+    { "D",    FLD_D,     1 },
+    { "HH",   FLD_HH,    2 },
+    { "H",    FLD_H,     1 },
+    { "MM",   FLD_MM,    2 },
+    { "site", FLD_SITE,  4 },
+    { "SITE", FLD_USITE, 4 },
+    { "LONG", FLD_LONG,  12 }
+};
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : AppendInt - append the integer with leading zeros
+* @param[I]: value (non-negative integer)
+* @param[I]: width (minimum number of digits)
+* @param[O]: out (the string appended)
+* @return  : none
+* @note    :
+**/
+static void AppendInt(int value, int width, string &out)
+{
+    char buff[16];
+    int n = 0;
+    do
+    {
+        buff[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && n < 15);
+    while (n < width) buff[n++] = '0';
+    while (n > 0) out.push_back(buff[--n]);
+} /* end of AppendInt */
+
+/**
+* @brief   : AppendCase - append the string in lower or upper case
+* @param[I]: str (the string)
+* @param[I]: upper (true: upper case, false: lower case)
+* @param[O]: out (the string appended)
+* @return  : none
+* @note    :
+**/
+static void AppendCase(const string &str, bool upper, string &out)
+{
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        out.push_back((char)(upper ? toupper((unsigned char)str[i]) : tolower((unsigned char)str[i])));
+    }
+} /* end of AppendCase */
+
+TemplateUtil::TemplateUtil()
+{
+    _size = 0;
+}
+
+TemplateUtil::~TemplateUtil()
+{
+
+}
+
+/**
+* @brief   : Fields - the values of the placeholders of a day
+* @param[I]: ts (the time)
+* @param[O]: none
+* @return  : the values of the year, day of year, GPS week, and day of week, the others are unknown
+* @note    :
+**/
+TemplateUtil::fields_t TemplateUtil::Fields(gtime_t ts)
+{
+    TimeUtil tu;
+    fields_t fields;
+    tu.time2yrdoy(ts, &fields.yyyy, &fields.doy);
+    fields.dow = tu.time2gpst(ts, &fields.wwww, nullptr);
+    fields.hh = -1;
+    fields.mm = -1;
+    fields.site = nullptr;
+
+    return fields;
+} /* end of Fields */
+
+/**
+* @brief   : Compile - split the template into the literal text and the placeholders
+* @param[I]: pattern (the template, i.e., "{YYYY}/{DDD}/{YY}d" or "{site}{DDD}0.{YY}d")
+* @param[O]: none
+* @return  : true:ok, false: the placeholder is NOT known (it is taken as the literal text)
+* @note    : the placeholders are "{YYYY}", "{YY}", "{DDD}", "{WWWW}", "{D}", "{HH}", "{H}", "{MM}", "{site}"
+*            (four-character name in lower case), "{SITE}" (in upper case), and "{LONG}" (the beginning of the
+*            long file name, i.e., "ALGO00CAN_?_" or "ALGO*")
+**/
+bool TemplateUtil::Compile(const string &pattern)
+{
+    bool ok = true;
+    _segs.clear();
+    _size = 0;
+
+    segment_t lit;
+    lit.field = -1;
+    size_t pos = 0;
+    while (pos < pattern.size())
+    {
+        int field = -1;
+        size_t end = string::npos;
+        if (pattern[pos] == '{' && (end = pattern.find('}', pos)) != string::npos)
+        {
+            string name = pattern.substr(pos + 1, end - pos - 1);
+            for (size_t i = 0; i < sizeof(PLACEHOLDERS) / sizeof(PLACEHOLDERS[0]); i++)
+            {
+                if (name != PLACEHOLDERS[i].name) continue;
+                field = PLACEHOLDERS[i].field;
+                _size += PLACEHOLDERS[i].size;
+                break;
+            }
+            if (field < 0)
+            {
+                cerr << "*** WARNING(TemplateUtil::Compile): unknown placeholder {" << name << "} in " << pattern << endl;
+                ok = false;
+            }
+        }
+        if (field < 0)
+        {
+            lit.text.push_back(pattern[pos++]);
+            continue;
+        }
+
+        /* the literal text before the placeholder */
+        if (!lit.text.empty())
+        {
+            _size += lit.text.size();
+            _segs.push_back(lit);
+            lit.text.clear();
+        }
+        segment_t seg;
+        seg.field = field;
+        _segs.push_back(seg);
+        pos = end + 1;
+    }
+    if (!lit.text.empty())
+    {
+        _size += lit.text.size();
+        _segs.push_back(lit);
+    }
+
+    return ok;
+} /* end of Compile */
+
+/**
+* @brief   : Expand - fill the placeholders of the template with their values
+* @param[I]: fields (the values of the placeholders)
+* @param[O]: out (the string expanded, its buffer is reused)
+* @return  : none
+* @note    : NO temporary string is made, and the buffer is allocated at most once
+**/
+void TemplateUtil::Expand(const fields_t &fields, string &out) const
+{
+    out.clear();
+    out.reserve(_size);
+    for (size_t i = 0; i < _segs.size(); i++)
+    {
+        const segment_t &seg = _segs[i];
+        if (seg.field < 0)
+        {
+            out.append(seg.text);
+            continue;
+        }
+
+        /* the placeholder whose value is unknown is kept as it is, so that the mistake is seen in the URL */
+        int value = -1;
+        switch (seg.field)
+        {
+        case FLD_YYYY: case FLD_YY: value = fields.yyyy; break;
+        case FLD_DDD:  value = fields.doy;  break;
+        case FLD_WWWW: value = fields.wwww; break;
+        case FLD_D:    value = fields.dow;  break;
+        case FLD_HH:   case FLD_H: value = fields.hh; break;
+        case FLD_MM:   value = fields.mm;   break;
+        default:       value = fields.site ? 0 : -1; break;
+        }
+        if (value < 0)
+        {
+            for (size_t j = 0; j < sizeof(PLACEHOLDERS) / sizeof(PLACEHOLDERS[0]); j++)
+            {
+                if (PLACEHOLDERS[j].field == seg.field) out.append("{").append(PLACEHOLDERS[j].name).append("}");
+            }
+            continue;
+        }
+
+        switch (seg.field)
+        {
+        case FLD_YYYY:  AppendInt(value, 4, out); break;
+        case FLD_YY:    AppendInt(value % 100, 2, out); break;
+        case FLD_DDD:   AppendInt(value, 3, out); break;
+        case FLD_WWWW:  AppendInt(value, 4, out); break;
+        case FLD_D:     AppendInt(value, 1, out); break;
+        case FLD_HH:    AppendInt(value, 2, out); break;
+        case FLD_H:     out.push_back((char)('a' + value % 24)); break;  /* 'a' = 97, 'b' = 98, ... */
+        case FLD_MM:    AppendInt(value, 2, out); break;
+        case FLD_SITE:  AppendCase(fields.site->name, false, out); break;
+        case FLD_USITE: AppendCase(fields.site->name, true, out); break;
+        case FLD_LONG:
+            if (!fields.site->longName.empty()) out.append(fields.site->longName).append("_?_");
+            else
+            {
+                AppendCase(fields.site->name, true, out);
+                out.push_back('*');
+            }
+            break;
+        }
+    }
+} /* end of Expand */
+
+/**
+* @brief   : Expand - fill the placeholders of the template with their values
+* @param[I]: fields (the values of the placeholders)
+* @param[O]: none
+* @return  : the string expanded
+* @note    :
+**/
+string TemplateUtil::Expand(const fields_t &fields) const
+{
+    string out;
+    Expand(fields, out);
+
+    return out;
+} /* end of Expand */
+
+/**
+* @brief   : Match - get the values of the placeholders from the string made by the template
+* @param[I]: str (the string, i.e., "2022/032/22d")
+* @param[O]: fields (the values of the placeholders, the ones NOT in the template are unknown)
+* @return  : true: the string is made by the template, false: NOT matched
+* @note    : the placeholders of the sites are NOT matched, and "{YY}" is taken as the year 2000-2099 if "{YYYY}"
+*            is NOT in the template
+**/
+bool TemplateUtil::Match(const string &str, fields_t &fields) const
+{
+    fields.yyyy = fields.doy = fields.wwww = fields.dow = fields.hh = fields.mm = -1;
+    fields.site = nullptr;
+
+    int yy = -1;
+    size_t pos = 0;
+    for (size_t i = 0; i < _segs.size(); i++)
+    {
+        const segment_t &seg = _segs[i];
+        if (seg.field < 0)
+        {
+            if (str.compare(pos, seg.text.size(), seg.text) != 0) return false;
+            pos += seg.text.size();
+            continue;
+        }
+        if (seg.field == FLD_H)
+        {
+            if (pos >= str.size() || str[pos] < 'a' || str[pos] > 'x') return false;
+            if (fields.hh >= 0 && fields.hh != str[pos] - 'a') return false;
+            fields.hh = str[pos++] - 'a';
+            continue;
+        }
+
+        /* the numbers of fixed width */
+        size_t size = 0;
+        for (size_t j = 0; j < sizeof(PLACEHOLDERS) / sizeof(PLACEHOLDERS[0]); j++)
+        {
+            if (PLACEHOLDERS[j].field == seg.field) size = PLACEHOLDERS[j].size;
+        }
+        if (seg.field >= FLD_SITE || pos + size > str.size()) return false;
+        int value = 0;
+        for (size_t j = 0; j < size; j++)
+        {
+            if (!isdigit((unsigned char)str[pos + j])) return false;
+            value = value * 10 + (str[pos + j] - '0');
+        }
+        pos += size;
+
+        int *field = nullptr;
+        switch (seg.field)
+        {
+        case FLD_YYYY: field = &fields.yyyy; break;
+        case FLD_YY:   field = &yy;          break;
+        case FLD_DDD:  field = &fields.doy;  break;
+        case FLD_WWWW: field = &fields.wwww; break;
+        case FLD_D:    field = &fields.dow;  break;
+        case FLD_HH:   field = &fields.hh;   break;
+        case FLD_MM:   field = &fields.mm;   break;
+        default:       return false;
+        }
+        if (*field >= 0 && *field != value) return false;
+        *field = value;
+    }
+    if (pos != str.size()) return false;
+
+    /* the two-digit year agrees with the four-digit one */
+    if (yy >= 0 && fields.yyyy >= 0 && fields.yyyy % 100 != yy) return false;
+    if (yy >= 0 && fields.yyyy < 0) fields.yyyy = 2000 + yy;
+
+    return true;
+} /* end of Match */
@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+* TemplateUtil.h : header file of TemplateUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class TemplateUtil
+{
+public:
+
+    struct fields_t
+    {                             /* the values of the placeholders, -1 (or nullptr): unknown */
+        int yyyy;                 /* four-digit year, "{YYYY}", and two-digit year, "{YY}" */
+        int doy;                  /* day of year, "{DDD}" */
+        int wwww;                 /* GPS week, "{WWWW}" */
+        int dow;                  /* day of week, "{D}" */
+        int hh;                   /* hour, "{HH}", and the hourly session ('a' to 'x'), "{H}" */
+        int mm;                   /* minute, "{MM}" */
+        const site_t *site;       /* the site, "{site}", "{SITE}", and "{LONG}" */
+    };
+
+private:
+
+    struct segment_t
+    {                             /* a piece of the template */
+        int field;                /* the placeholder (see TemplateUtil.cpp), -1: the literal text */
+        string text;              /* the literal text */
+    };
+
+    std::vector<segment_t> _segs; /* the pieces of the template in order */
+    size_t _size;                 /* the length of the expanded string expected, by which the buffer is reserved */
+
+public:
+    TemplateUtil();
+    ~TemplateUtil();
+
+    /**
+    * @brief   : Fields - the values of the placeholders of a day
+    * @param[I]: ts (the time)
+    * @param[O]: none
+    * @return  : the values of the year, day of year, GPS week, and day of week, the others are unknown
+    * @note    :
+    **/
+    static fields_t Fields(gtime_t ts);
+
+    /**
+    * @brief   : Compile - split the template into the literal text and the placeholders
+    * @param[I]: pattern (the template, i.e., "{YYYY}/{DDD}/{YY}d" or "{site}{DDD}0.{YY}d")
+    * @param[O]: none
+    * @return  : true:ok, false: the placeholder is NOT known (it is taken as the literal text)
+    * @note    : the placeholders are "{YYYY}", "{YY}", "{DDD}", "{WWWW}", "{D}", "{HH}", "{H}", "{MM}", "{site}"
+    *            (four-character name in lower case), "{SITE}" (in upper case), and "{LONG}" (the beginning of the
+    *            long file name, i.e., "ALGO00CAN_?_" or "ALGO*")
+    **/
+    bool Compile(const string &pattern);
+
+    /**
+    * @brief   : Expand - fill the placeholders of the template with their values
+    * @param[I]: fields (the values of the placeholders)
+    * @param[O]: out (the string expanded, its buffer is reused)
+    * @return  : none
+    * @note    : NO temporary string is made, and the buffer is allocated at most once
+    **/
+    void Expand(const fields_t &fields, string &out) const;
+
+    /**
+    * @brief   : Expand - fill the placeholders of the template with their values
+    * @param[I]: fields (the values of the placeholders)
+    * @param[O]: none
+    * @return  : the string expanded
+    * @note    :
+    **/
+    string Expand(const fields_t &fields) const;
+
+    /**
+    * @brief   : Match - get the values of the placeholders from the string made by the template
+    * @param[I]: str (the string, i.e., "2022/032/22d")
+    * @param[O]: fields (the values of the placeholders, the ones NOT in the template are unknown)
+    * @return  : true: the string is made by the template, false: NOT matched
+    * @note    : the placeholders of the sites are NOT matched, and "{YY}" is taken as the year 2000-2099 if "{YYYY}"
+    *            is NOT in the template
+    **/
+    bool Match(const string &str, fields_t &fields) const;
+};
@@ -0,0 +1,195 @@
+/*------------------------------------------------------------------------------
+* TraceUtil.cpp : the timeline of a run in the trace event format of Chrome
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    Trace Event Format, https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+*
+* history : 2026/10/18 1.0  new, the spans of the days, the getters, the jobs, and the stages of the transfers
+*                           (listing, transfer, decompressing, decoding, and renaming) are recorded with a lane per
+*                           thread, so that the idle time and the serialization are seen on the timeline
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "MetricsUtil.h"
+#include "TraceUtil.h"
+
+
+/* function definition -------------------------------------------------------*/
+
+std::vector<TraceUtil::event_t> TraceUtil::_events;
+std::map<int, string> TraceUtil::_lanes;
+std::mutex TraceUtil::_lock;
+std::atomic<bool> TraceUtil::_on(false);
+std::atomic<int> TraceUtil::_ntid(0);
+double TraceUtil::_start = 0.0;
+thread_local int TraceUtil::_tid = 0;
+
+TraceUtil::Span::Span(const char *cat, const string &name)
+{
+    _cat = cat;
+    _start = 0.0;
+    if (!IsOn()) return;
+    _name = name;
+    _start = MetricsUtil::Now();
+}
+
+TraceUtil::Span::Span(const char *cat, const string &name, const string &detail)
+{
+    _cat = cat;
+    _start = 0.0;
+    if (!IsOn()) return;
+    _name = name;
+    _detail = detail;
+    _start = MetricsUtil::Now();
+}
+
+TraceUtil::Span::~Span()
+{
+    if (_start > 0.0) Add(_cat, _name, _detail, _start, MetricsUtil::Now());
+}
+
+/**
+* @brief   : Tid - the lane of the thread
+* @param[I]: none
+* @param[O]: none
+* @return  : the lane, which is given to the thread at its first span
+* @note    : the lock should be held
+**/
+int TraceUtil::Tid()
+{
+    if (_tid > 0) return _tid;
+
+    _tid = ++_ntid;
+    if (_lanes.find(_tid) == _lanes.end()) _lanes[_tid] = "thread " + to_string(_tid);
+
+    return _tid;
+} /* end of Tid */
+
+/**
+* @brief   : Start - start to record the spans
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the thread calling it is the lane "main"
+**/
+void TraceUtil::Start()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _events.clear();
+    _start = MetricsUtil::Now();
+    _lanes[Tid()] = "main";
+    _on = true;
+} /* end of Start */
+
+/**
+* @brief   : IsOn - check if the spans are recorded
+* @param[I]: none
+* @param[O]: none
+* @return  : true: on, false: off
+* @note    :
+**/
+bool TraceUtil::IsOn()
+{
+    return _on;
+} /* end of IsOn */
+
+/**
+* @brief   : SetLane - name the lane of the thread
+* @param[I]: name (the name of the lane, i.e., "worker 1/4")
+* @param[O]: none
+* @return  : none
+* @note    : the lanes NOT named are shown as "thread n"
+**/
+void TraceUtil::SetLane(const string &name)
+{
+    if (!IsOn()) return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _lanes[Tid()] = name;
+} /* end of SetLane */
+
+/**
+* @brief   : Add - record a span in the thread
+* @param[I]: cat (the category)
+* @param[I]: name (the name shown on the timeline)
+* @param[I]: detail (the detail shown in the arguments, empty: none)
+* @param[I]: start (the time when the span was started (s), see MetricsUtil::Now)
+* @param[I]: end (the time when the span was finished (s))
+* @param[O]: none
+* @return  : none
+* @note    : nothing is done if the trace is off
+**/
+void TraceUtil::Add(const char *cat, const string &name, const string &detail, double start, double end)
+{
+    if (!IsOn()) return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    event_t ev;
+    ev.cat = cat;
+    ev.name = name;
+    ev.detail = detail;
+    ev.start = start - _start;
+    ev.seconds = end - start;
+    ev.tid = Tid();
+    _events.push_back(ev);
+} /* end of Add */
+
+/**
+* @brief   : Save - stop recording and write the trace
+* @param[I]: file (the trace with full path, i.e., "C:\data\GOOD_trace.json")
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the trace is in the trace event format (JSON) of Chrome, which is loaded by 'chrome://tracing' or
+*            Perfetto UI (https://ui.perfetto.dev) with a lane per thread
+**/
+bool TraceUtil::Save(const string &file)
+{
+    /* it is stopped at first, so that the renaming below is NOT recorded */
+    _on = false;
+    std::lock_guard<std::mutex> lock(_lock);
+
+    string tmpFile = file + ".tmp";
+    FILE *fp = fopen(tmpFile.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** WARNING(TraceUtil::Save): open " << tmpFile << " failed" << endl;
+
+        return false;
+    }
+
+    /* the names of the process and the lanes (metadata events "M"), then the spans (complete events "X") in
+       microseconds */
+    fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(fp, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GOOD\"}}");
+    for (std::map<int, string>::const_iterator it = _lanes.begin(); it != _lanes.end(); ++it)
+    {
+        fprintf(fp, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":%s}}",
+            it->first, MetricsUtil::JsonStr(it->second).c_str());
+        fprintf(fp, ",\n{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":1,\"tid\":%d,\"args\":{\"sort_index\":%d}}",
+            it->first, it->first);
+    }
+    for (size_t i = 0; i < _events.size(); i++)
+    {
+        const event_t &ev = _events[i];
+        fprintf(fp, ",\n{\"ph\":\"X\",\"cat\":\"%s\",\"name\":%s,\"pid\":1,\"tid\":%d,\"ts\":%.1f,\"dur\":%.1f", ev.cat,
+            MetricsUtil::JsonStr(ev.name).c_str(), ev.tid, ev.start * 1e6, ev.seconds * 1e6);
+        if (!ev.detail.empty()) fprintf(fp, ",\"args\":{\"detail\":%s}", MetricsUtil::JsonStr(ev.detail).c_str());
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "\n]}\n");
+
+    bool ok = fclose(fp) == 0;
+    if (ok) ok = FileUtil::Rename(tmpFile, file);
+    if (!ok)
+    {
+        remove(tmpFile.c_str());
+        cerr << "*** WARNING(TraceUtil::Save): write " << file << " failed" << endl;
+    }
+    else cout << "*** INFO(TraceUtil::Save): the trace of " << _events.size() << " spans is written to " << file << endl;
+    _events.clear();
+
+    return ok;
+} /* end of Save */
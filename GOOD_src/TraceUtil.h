@@ -0,0 +1,106 @@
+/*------------------------------------------------------------------------------
+* TraceUtil.h : header file of TraceUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class TraceUtil
+{
+public:
+
+    class Span
+    {                             /* the span of a stage in the thread, recorded when it goes out of scope */
+    private:
+        const char *_cat;         /* the category, i.e., "getter", "job", "listing", "transfer", "inflate", "decode", or "rename" */
+        string _name;             /* the name shown on the timeline */
+        string _detail;           /* the detail shown in the arguments, i.e., the URL of the remote file */
+        double _start;            /* the time when the span was started (s), 0: the trace is off */
+
+    public:
+        Span(const char *cat, const string &name);
+        Span(const char *cat, const string &name, const string &detail);
+        ~Span();
+    };
+
+private:
+
+    struct event_t
+    {                             /* the span recorded, i.e., the complete event ("X") of the trace */
+        const char *cat;          /* the category */
+        string name;              /* the name shown on the timeline */
+        string detail;            /* the detail shown in the arguments, empty: none */
+        double start;             /* the time when the span was started, since the start of the trace (s) */
+        double seconds;           /* the duration of the span (s) */
+        int tid;                  /* the lane of the thread */
+    };
+
+    static std::vector<event_t> _events;  /* the spans in the order they were finished */
+    static std::map<int, string> _lanes;  /* the names of the lanes, the key is the lane of the thread */
+    static std::mutex _lock;        /* the lock of the spans and the lanes */
+    static std::atomic<bool> _on;   /* true: the spans are recorded */
+    static std::atomic<int> _ntid;  /* number of the lanes */
+    static double _start;           /* the time when the trace was started (s) */
+    static thread_local int _tid;   /* the lane of the thread, 0: NOT given yet */
+
+private:
+
+    /**
+    * @brief   : Tid - the lane of the thread
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the lane, which is given to the thread at its first span
+    * @note    : the lock should be held
+    **/
+    static int Tid();
+
+public:
+
+    /**
+    * @brief   : Start - start to record the spans
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the thread calling it is the lane "main"
+    **/
+    static void Start();
+
+    /**
+    * @brief   : IsOn - check if the spans are recorded
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    static bool IsOn();
+
+    /**
+    * @brief   : SetLane - name the lane of the thread
+    * @param[I]: name (the name of the lane, i.e., "worker 1/4")
+    * @param[O]: none
+    * @return  : none
+    * @note    : the lanes NOT named are shown as "thread n"
+    **/
+    static void SetLane(const string &name);
+
+    /**
+    * @brief   : Add - record a span in the thread
+    * @param[I]: cat (the category)
+    * @param[I]: name (the name shown on the timeline)
+    * @param[I]: detail (the detail shown in the arguments, empty: none)
+    * @param[I]: start (the time when the span was started (s), see MetricsUtil::Now)
+    * @param[I]: end (the time when the span was finished (s))
+    * @param[O]: none
+    * @return  : none
+    * @note    : nothing is done if the trace is off
+    **/
+    static void Add(const char *cat, const string &name, const string &detail, double start, double end);
+
+    /**
+    * @brief   : Save - stop recording and write the trace
+    * @param[I]: file (the trace with full path, i.e., "C:\data\GOOD_trace.json")
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the trace is in the trace event format (JSON) of Chrome, which is loaded by 'chrome://tracing' or
+    *            Perfetto UI (https://ui.perfetto.dev) with a lane per thread
+    **/
+    static bool Save(const string &file);
+};
@@ -0,0 +1,819 @@
+/*------------------------------------------------------------------------------
+* ZipUtil.cpp : decompressor of gzip (deflate) and Unix 'compress' (LZW) formats
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    P. Deutsch, DEFLATE Compressed Data Format Specification version 1.3, RFC 1951, 1996
+*    P. Deutsch, GZIP file format specification version 4.3, RFC 1952, 1996
+*
+* history : 2026/10/18 1.0  new, '*.gz' and '*.Z' files are decompressed in the process instead of the external 'gzip'
+*           2026/10/18      CRC32 is available to the others (see Crc32), i.e., for the checksums in the manifest
+*           2026/10/18      the decompressed file is replaced atomically by FileUtil::Rename (on Windows as well)
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "FileUtil.h"
+#include "ZipUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXWINDOW       32768     /* the window of deflate, the maximum distance of the back references */
+#define MAXOUTBUFF      65536     /* the decompressed bytes are given to the receiver in blocks of this size */
+#define MAXLZWBITS      16        /* the maximum code width of 'compress' */
+#define MINAVAIL        1024      /* the bytes received NOT yet used before decoding the next codes, so that the codes
+                                     are NEVER split by the end of the bytes received unless it is the end of stream */
+
+static const unsigned short LENBASE[29] = {              /* the base lengths of the length codes 257..285 */
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const unsigned char LENEXTRA[29] = {              /* the extra bits of the length codes 257..285 */
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const unsigned short DISTBASE[30] = {             /* the base distances of the distance codes 0..29 */
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+    6145, 8193, 12289, 16385, 24577 };
+static const unsigned char DISTEXTRA[30] = {             /* the extra bits of the distance codes 0..29 */
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const unsigned char CLENORDER[19] = {             /* the order of the code length codes */
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Crc32Table - the tables of CRC32 (polynomial 0xedb88320), four bytes at a time
+* @param[I]: none
+* @param[O]: none
+* @return  : the tables, table[k][i]: CRC32 of the byte i followed by k zero bytes
+* @note    :
+**/
+static const unsigned long (*Crc32Table())[256]
+{
+    static unsigned long table[4][256];
+    static bool init = [](unsigned long (*t)[256])
+    {
+        for (unsigned long i = 0; i < 256; i++)
+        {
+            unsigned long c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320UL ^ (c >> 1) : c >> 1;
+            t[0][i] = c;
+        }
+        for (int k = 1; k < 4; k++)
+        {
+            for (int i = 0; i < 256; i++) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+        }
+        return true;
+    }(table);
+    (void)init;
+
+    return table;
+} /* end of Crc32Table */
+
+/**
+* @brief   : Crc32Update - update CRC32 with the bytes
+* @param[I]: crc (CRC32 of the previous bytes, NOT inverted)
+* @param[I]: p (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : CRC32 with the bytes
+* @note    :
+**/
+static unsigned long Crc32Update(unsigned long crc, const unsigned char *p, size_t n)
+{
+    const unsigned long (*t)[256] = Crc32Table();
+    for (; n >= 4; n -= 4, p += 4)
+    {
+        crc ^= p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long)p[3] << 24);
+        crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff] ^ t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+    }
+    for (; n > 0; n--, p++) crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+
+    return crc;
+} /* end of Crc32Update */
+
+ZipUtil::ZipUtil()
+{
+    _pos = 0;
+    _bitBuf = 0;
+    _bitCnt = 0;
+    _final = false;
+    _nout = 0;
+    _nflush = 0;
+    _state = ZIP_MAGIC;
+    _nmember = 0;
+    _lastBlock = false;
+    _nstored = 0;
+    _lit.nbits = _dist.nbits = 0;
+    _crc = 0xffffffffUL;
+    _nmemb = 0;
+    _maxBits = MAXLZWBITS;
+    _blockMode = true;
+    _nbits = 9;
+    _freeEnt = 256;
+    _oldCode = -1;
+    _finChar = 0;
+    _ncode = 0;
+    _ok = false;
+}
+
+ZipUtil::~ZipUtil()
+{
+}
+
+/**
+* @brief   : Need - check if the bits are available in the bit buffer, loading the bytes received
+* @param[I]: n (number of the bits, up to 57)
+* @param[O]: none
+* @return  : true: available, false: NOT available
+* @note    :
+**/
+bool ZipUtil::Need(int n)
+{
+    if (_bitCnt >= n) return true;
+    if (_pos + 8 <= _in.size())
+    {
+        /* the bit buffer is filled up to 56 bits or more at once */
+        unsigned long long val = 0;
+        for (int i = 7; i >= 0; i--) val = (val << 8) | _in[_pos + i];
+        _bitBuf |= val << _bitCnt;
+        _pos += (63 - _bitCnt) >> 3;
+        _bitCnt |= 56;
+
+        return _bitCnt >= n;
+    }
+    while (_bitCnt < n && _pos < _in.size())
+    {
+        _bitBuf |= (unsigned long long)_in[_pos++] << _bitCnt;
+        _bitCnt += 8;
+    }
+
+    return _bitCnt >= n;
+} /* end of Need */
+
+/**
+* @brief   : Bits - take the bits from the bit buffer
+* @param[I]: n (number of the bits, up to 57)
+* @param[O]: none
+* @return  : the bits, the first one is the least significant bit
+* @note    : Need(n) should be true
+**/
+unsigned long ZipUtil::Bits(int n)
+{
+    unsigned long val = (unsigned long)(_bitBuf & ((1ULL << n) - 1));
+    _bitBuf >>= n;
+    _bitCnt -= n;
+
+    return val;
+} /* end of Bits */
+
+/**
+* @brief   : Unload - put the whole bytes in the bit buffer back to the received bytes
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the bits of the partial byte are dropped
+**/
+void ZipUtil::Unload()
+{
+    _pos -= _bitCnt / 8;
+    _bitBuf = 0;
+    _bitCnt = 0;
+} /* end of Unload */
+
+/**
+* @brief   : Build - build the look-up table of Huffman code from the code lengths
+* @param[I]: lens (the code lengths of the symbols, 0: NOT used)
+* @param[I]: n (number of the symbols)
+* @param[O]: huff (the look-up table)
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ZipUtil::Build(const unsigned char *lens, int n, huff_t &huff)
+{
+    int count[16] = { 0 }, next[16] = { 0 };
+    for (int i = 0; i < n; i++) count[lens[i]]++;
+    count[0] = 0;
+
+    /* the incomplete code is allowed (i.e., only one distance code), but NOT the over-subscribed one */
+    int left = 1, maxLen = 0;
+    for (int len = 1; len < 16; len++)
+    {
+        left = (left << 1) - count[len];
+        if (left < 0) return false;
+        if (count[len] > 0) maxLen = len;
+    }
+    for (int len = 1, code = 0; len < 16; len++)
+    {
+        code = (code + count[len - 1]) << 1;
+        next[len] = code;
+    }
+
+    huff.nbits = maxLen > 0 ? maxLen : 1;
+    huff.table.assign((size_t)1 << huff.nbits, 0);
+    for (int sym = 0; sym < n; sym++)
+    {
+        int len = lens[sym];
+        if (len == 0) continue;
+
+        /* the codes are packed from the most significant bit, so the index of the table is reversed */
+        int code = next[len]++, rev = 0;
+        for (int k = 0; k < len; k++, code >>= 1) rev = (rev << 1) | (code & 1);
+        for (size_t k = rev; k < huff.table.size(); k += (size_t)1 << len) huff.table[k] = (unsigned short)(sym << 4 | len);
+    }
+
+    return true;
+} /* end of Build */
+
+/**
+* @brief   : Decode - decode one symbol of Huffman code
+* @param[I]: huff (the look-up table)
+* @param[O]: none
+* @return  : the symbol, -1: invalid code
+* @note    : Need(huff.nbits) should be called before
+**/
+int ZipUtil::Decode(const huff_t &huff)
+{
+    unsigned short e = huff.table[(size_t)(_bitBuf & ((1ULL << huff.nbits) - 1))];
+    int len = e & 15;
+    if (len == 0 || len > _bitCnt) return -1;
+    _bitBuf >>= len;
+    _bitCnt -= len;
+
+    return e >> 4;
+} /* end of Decode */
+
+/**
+* @brief   : Put - put one decompressed byte into the window
+* @param[I]: c (the byte)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ZipUtil::Put(unsigned char c)
+{
+    _out[_nout++] = c;
+    _nmemb++;
+} /* end of Put */
+
+/**
+* @brief   : Flush - give the decompressed bytes to the receiver
+* @param[I]: keep (number of the bytes at the end of the window to be kept for the back references)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ZipUtil::Flush(size_t keep)
+{
+    if (_nout > _nflush)
+    {
+        _crc = Crc32Update(_crc, &_out[_nflush], _nout - _nflush);
+
+        if (!_sink((const char *)&_out[_nflush], _nout - _nflush)) return false;
+    }
+    if (_nout > keep)
+    {
+        memmove(&_out[0], &_out[_nout - keep], keep);
+        _nout = keep;
+    }
+    _nflush = _nout;
+
+    return true;
+} /* end of Flush */
+
+/**
+* @brief   : GzHead - read the header of gzip member
+* @param[I]: none
+* @param[O]: none
+* @return  : 1:ok, 0:more bytes needed, -1:error
+* @note    :
+**/
+int ZipUtil::GzHead()
+{
+    int need = _final ? -1 : 0;
+    size_t avail = _in.size() - _pos;
+    if (avail < 10) return need;
+
+    const unsigned char *p = &_in[_pos];
+    int flag = p[3];
+    if (p[2] != 8 || (flag & 0xe0)) return -1;  /* NOT deflate, or the reserved flags */
+
+    size_t i = 10;
+    if (flag & 0x04)  /* FEXTRA */
+    {
+        if (avail < i + 2) return need;
+        i += 2 + (p[i] | (p[i + 1] << 8));
+    }
+    for (int k = 0x08; k <= 0x10; k <<= 1)  /* FNAME and FCOMMENT, terminated by zero */
+    {
+        if (!(flag & k)) continue;
+        while (i < avail && p[i] != 0) i++;
+        if (i++ >= avail) return need;
+    }
+    if (flag & 0x02) i += 2;  /* FHCRC */
+    if (i > avail) return need;
+
+    _pos += i;
+    _crc = 0xffffffffUL;
+    _nmemb = 0;
+    _lastBlock = false;
+
+    return 1;
+} /* end of GzHead */
+
+/**
+* @brief   : Block - read the header of deflate block (and the Huffman codes of dynamic block)
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ZipUtil::Block()
+{
+    if (!Need(3)) return false;
+    _lastBlock = Bits(1) != 0;
+    int type = (int)Bits(2);
+
+    if (type == 0)         /* stored */
+    {
+        Unload();
+        if (_in.size() - _pos < 4) return false;
+        const unsigned char *p = &_in[_pos];
+        unsigned long len = p[0] | (p[1] << 8), nlen = p[2] | (p[3] << 8);
+        if (len != (~nlen & 0xffff)) return false;
+        _pos += 4;
+        _nstored = (long)len;
+        _state = ZIP_STORED;
+
+        return true;
+    }
+
+    unsigned char lens[320];
+    if (type == 1)         /* fixed Huffman codes */
+    {
+        int i = 0;
+        for (; i < 144; i++) lens[i] = 8;
+        for (; i < 256; i++) lens[i] = 9;
+        for (; i < 280; i++) lens[i] = 7;
+        for (; i < 288; i++) lens[i] = 8;
+        for (i = 0; i < 30; i++) lens[288 + i] = 5;
+        if (!Build(lens, 288, _lit) || !Build(lens + 288, 30, _dist)) return false;
+        _state = ZIP_CODES;
+
+        return true;
+    }
+    if (type != 2) return false;
+
+    /* dynamic Huffman codes */
+    if (!Need(14)) return false;
+    int nlen = (int)Bits(5) + 257, ndist = (int)Bits(5) + 1, nclen = (int)Bits(4) + 4;
+    if (nlen > 286 || ndist > 30) return false;
+
+    unsigned char clens[19] = { 0 };
+    for (int i = 0; i < nclen; i++)
+    {
+        if (!Need(3)) return false;
+        clens[CLENORDER[i]] = (unsigned char)Bits(3);
+    }
+    huff_t clen;
+    if (!Build(clens, 19, clen)) return false;
+
+    int n = 0;
+    while (n < nlen + ndist)
+    {
+        Need(clen.nbits);
+        int sym = Decode(clen);
+        if (sym < 0) return false;
+        if (sym < 16)
+        {
+            lens[n++] = (unsigned char)sym;
+            continue;
+        }
+
+        unsigned char len = 0;
+        int rep;
+        if (sym == 16)
+        {
+            if (n == 0 || !Need(2)) return false;
+            len = lens[n - 1];
+            rep = 3 + (int)Bits(2);
+        }
+        else if (sym == 17)
+        {
+            if (!Need(3)) return false;
+            rep = 3 + (int)Bits(3);
+        }
+        else
+        {
+            if (!Need(7)) return false;
+            rep = 11 + (int)Bits(7);
+        }
+        if (n + rep > nlen + ndist) return false;
+        while (rep-- > 0) lens[n++] = len;
+    }
+    if (lens[256] == 0) return false;  /* NO end of block */
+    if (!Build(lens, nlen, _lit) || !Build(lens + nlen, ndist, _dist)) return false;
+    _state = ZIP_CODES;
+
+    return true;
+} /* end of Block */
+
+/**
+* @brief   : Codes - decode the codes of Huffman compressed block
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : it returns at the end of the block or when the bytes received are nearly used up
+**/
+bool ZipUtil::Codes()
+{
+    while (_final || _in.size() - _pos >= MINAVAIL)
+    {
+        Need(_lit.nbits);
+        int sym = Decode(_lit);
+        if (sym < 0) return false;
+        if (sym < 256)
+        {
+            Put((unsigned char)sym);
+        }
+        else if (sym == 256)  /* end of block */
+        {
+            _state = _lastBlock ? ZIP_GZTAIL : ZIP_BLOCK;
+
+            return true;
+        }
+        else
+        {
+            sym -= 257;
+            if (sym >= 29 || !Need(LENEXTRA[sym])) return false;
+            int len = LENBASE[sym] + (int)Bits(LENEXTRA[sym]);
+
+            Need(_dist.nbits);
+            int dsym = Decode(_dist);
+            if (dsym < 0 || dsym >= 30 || !Need(DISTEXTRA[dsym])) return false;
+            size_t dist = DISTBASE[dsym] + Bits(DISTEXTRA[dsym]);
+            if (dist > _nout || dist > _nmemb) return false;
+
+            unsigned char *dst = &_out[_nout], *src = dst - dist;
+            for (int i = 0; i < len; i++) dst[i] = src[i];
+            _nout += len;
+            _nmemb += len;
+        }
+        if (_nout >= MAXWINDOW + MAXOUTBUFF && !Flush(MAXWINDOW)) return false;
+    }
+
+    return true;
+} /* end of Codes */
+
+/**
+* @brief   : Lzw - decode the codes of 'compress'
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : it returns at the end of the stream or when the bytes received are nearly used up
+**/
+bool ZipUtil::Lzw()
+{
+    int maxMaxCode = 1 << _maxBits;
+    while (_final || _in.size() - _pos >= MINAVAIL)
+    {
+        int maxCode = _nbits == _maxBits ? maxMaxCode : (1 << _nbits) - 1;
+        bool clear = false;
+        if (_freeEnt <= maxCode)
+        {
+            if (!Need(_nbits))  /* end of stream */
+            {
+                _state = ZIP_END;
+
+                return true;
+            }
+            int code = (int)Bits(_nbits);
+            _ncode++;
+
+            if (_oldCode == -1)
+            {
+                if (code >= 256) return false;
+                _finChar = (unsigned char)code;
+                _oldCode = code;
+                Put(_finChar);
+                continue;
+            }
+            clear = code == 256 && _blockMode;
+            if (!clear)
+            {
+                int inCode = code;
+                unsigned char *sp = &_stack[_stack.size() - 1], *bottom = &_stack[0];
+                if (code >= _freeEnt)  /* the string of the code is defined by itself, KwKwK */
+                {
+                    if (code > _freeEnt) return false;
+                    *sp-- = _finChar;
+                    code = _oldCode;
+                }
+                while (code >= 256)
+                {
+                    if (sp == bottom) return false;
+                    *sp-- = _suffix[code];
+                    code = _prefix[code];
+                }
+                *sp = _finChar = _suffix[code];
+
+                size_t n = &_stack[_stack.size() - 1] - sp + 1;
+                memcpy(&_out[_nout], sp, n);
+                _nout += n;
+                _nmemb += n;
+
+                if (_freeEnt < maxMaxCode)
+                {
+                    _prefix[_freeEnt] = (unsigned short)_oldCode;
+                    _suffix[_freeEnt] = _finChar;
+                    _freeEnt++;
+                }
+                _oldCode = inCode;
+                if (_nout >= MAXOUTBUFF && !Flush(0)) return false;
+                continue;
+            }
+        }
+
+        /* the codes are written in the groups of 8 codes, the rest of the group is skipped when the code width changes */
+        int skip = (int)((8 - _ncode % 8) % 8) * _nbits;
+        while (skip > 0)
+        {
+            int n = skip < 32 ? skip : 32;
+            if (!Need(n))
+            {
+                _state = ZIP_END;
+
+                return true;
+            }
+            Bits(n);
+            skip -= n;
+        }
+        _ncode = 0;
+        if (clear)
+        {
+            _freeEnt = 256;
+            _nbits = 9;
+        }
+        else _nbits++;
+    }
+
+    return true;
+} /* end of Lzw */
+
+/**
+* @brief   : Run - decompress the bytes received as far as possible
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ZipUtil::Run()
+{
+    while (_ok)
+    {
+        size_t avail = _in.size() - _pos;
+        switch (_state)
+        {
+        case ZIP_MAGIC:
+            if (avail < 3 && !_final) return true;
+            if (avail >= 2 && _in[_pos] == 0x1f && _in[_pos + 1] == 0x8b)
+            {
+                _state = ZIP_GZHEAD;
+            }
+            else if (avail >= 3 && _in[_pos] == 0x1f && _in[_pos + 1] == 0x9d)
+            {
+                _maxBits = _in[_pos + 2] & 0x1f;
+                _blockMode = (_in[_pos + 2] & 0x80) != 0;
+                if (_maxBits < 9 || _maxBits > MAXLZWBITS) _ok = false;
+                _pos += 3;
+                _nbits = 9;
+                _freeEnt = _blockMode ? 257 : 256;
+                _oldCode = -1;
+                _ncode = 0;
+                _prefix.assign((size_t)1 << MAXLZWBITS, 0);
+                _suffix.resize((size_t)1 << MAXLZWBITS);
+                for (int i = 0; i < 256; i++) _suffix[i] = (unsigned char)i;
+                _stack.resize(((size_t)1 << MAXLZWBITS) + 1);
+                _state = ZIP_LZW;
+            }
+            else if (_nmember > 0)  /* the trailing bytes after the last member are ignored as 'gzip' does */
+            {
+                _state = ZIP_END;
+            }
+            else _ok = false;
+            break;
+        case ZIP_GZHEAD:
+        {
+            int stat = GzHead();
+            if (stat == 0) return true;
+            if (stat < 0) _ok = false;
+            else _state = ZIP_BLOCK;
+            break;
+        }
+        case ZIP_BLOCK:
+            if (avail < MINAVAIL && !_final) return true;
+            _ok = Block();
+            break;
+        case ZIP_STORED:
+        {
+            if (avail == 0)
+            {
+                if (_final) _ok = false;
+                return _ok;
+            }
+            size_t n = (size_t)_nstored < avail ? (size_t)_nstored : avail;
+            if (n > _out.size() - _nout) n = _out.size() - _nout;
+            memcpy(&_out[_nout], &_in[_pos], n);
+            _pos += n;
+            _nout += n;
+            _nmemb += n;
+            _nstored -= (long)n;
+            if (_nout >= MAXWINDOW + MAXOUTBUFF && !Flush(MAXWINDOW)) _ok = false;
+            if (_nstored == 0) _state = _lastBlock ? ZIP_GZTAIL : ZIP_BLOCK;
+            break;
+        }
+        case ZIP_CODES:
+            if (avail < MINAVAIL && !_final) return true;
+            _ok = Codes();
+            if (_ok && _state == ZIP_CODES && !_final) return true;
+            break;
+        case ZIP_GZTAIL:
+        {
+            Unload();
+            avail = _in.size() - _pos;
+            if (avail < 8)
+            {
+                if (_final) _ok = false;
+                return _ok;
+            }
+            if (!Flush(MAXWINDOW))
+            {
+                _ok = false;
+                break;
+            }
+            const unsigned char *p = &_in[_pos];
+            unsigned long crc = p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long)p[3] << 24);
+            unsigned long size = p[4] | (p[5] << 8) | (p[6] << 16) | ((unsigned long)p[7] << 24);
+            if (crc != (~_crc & 0xffffffffUL) || size != (unsigned long)(_nmemb & 0xffffffffULL)) _ok = false;
+            _pos += 8;
+            _nmember++;
+            _state = ZIP_MAGIC;
+            break;
+        }
+        case ZIP_LZW:
+            if (avail < MINAVAIL && !_final) return true;
+            _ok = Lzw();
+            if (_ok && _state == ZIP_LZW) return true;
+            if (_ok) _nmember++;
+            break;
+        default:  /* ZIP_END */
+            _pos = _in.size();
+            return true;
+        }
+    }
+
+    return false;
+} /* end of Run */
+
+/**
+* @brief   : Open - start decompressing a stream of gzip or 'compress' (the format is told by the magic number)
+* @param[I]: sink (the receiver of the decompressed bytes)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ZipUtil::Open(const sink_t &sink)
+{
+    _sink = sink;
+    _in.clear();
+    _pos = 0;
+    _bitBuf = 0;
+    _bitCnt = 0;
+    _final = false;
+    _out.resize(MAXWINDOW + MAXOUTBUFF + ((size_t)1 << MAXLZWBITS) + 1);
+    _nout = 0;
+    _nflush = 0;
+    _state = ZIP_MAGIC;
+    _nmember = 0;
+    _crc = 0xffffffffUL;
+    _nmemb = 0;
+    _ok = true;
+} /* end of Open */
+
+/**
+* @brief   : Write - feed the compressed bytes
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the bytes may be split anywhere
+**/
+bool ZipUtil::Write(const char *buff, size_t n)
+{
+    if (!_ok) return false;
+    if (_state == ZIP_END) return true;
+
+    /* the bytes used are dropped, except the ones which may be put back from the bit buffer */
+    if (_pos > MAXOUTBUFF)
+    {
+        _in.erase(_in.begin(), _in.begin() + (_pos - 8));
+        _pos = 8;
+    }
+    _in.insert(_in.end(), (const unsigned char *)buff, (const unsigned char *)buff + n);
+
+    return Run();
+} /* end of Write */
+
+/**
+* @brief   : Close - finish decompressing the stream
+* @param[I]: none
+* @param[O]: none
+* @return  : true: the stream is decompressed completely, false: error or truncated stream
+* @note    :
+**/
+bool ZipUtil::Close()
+{
+    if (_ok)
+    {
+        _final = true;
+        Run();
+    }
+    if (_ok && _state != ZIP_END && !(_state == ZIP_MAGIC && _nmember > 0)) _ok = false;
+    if (_ok && !Flush(0)) _ok = false;
+
+    bool ok = _ok;
+    _ok = false;
+    _in.clear();
+    _in.shrink_to_fit();
+
+    return ok;
+} /* end of Close */
+
+/**
+* @brief   : Uncompress - decompress '*.gz' or '*.Z' file, and remove it
+* @param[I]: compFile (the compressed file with full path, i.e., "igs21906.sp3.Z")
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : it is the counterpart of 'gzip -d -f compFile', and the decompressed file is NOT created on error
+**/
+bool ZipUtil::Uncompress(const string &compFile)
+{
+    size_t n = compFile.size();
+    string outFile;
+    if (n > 3 && compFile.compare(n - 3, 3, ".gz") == 0) outFile = compFile.substr(0, n - 3);
+    else if (n > 2 && compFile.compare(n - 2, 2, ".Z") == 0) outFile = compFile.substr(0, n - 2);
+    else
+    {
+        cerr << "*** WARNING(ZipUtil::Uncompress): unknown suffix of " << compFile << endl;
+
+        return false;
+    }
+
+    FILE *fpIn = fopen(compFile.c_str(), "rb");
+    if (!fpIn)
+    {
+        cerr << "*** WARNING(ZipUtil::Uncompress): open " << compFile << " failed" << endl;
+
+        return false;
+    }
+    string tmpFile = outFile + ".tmp";
+    FILE *fpOut = fopen(tmpFile.c_str(), "wb");
+    if (!fpOut)
+    {
+        cerr << "*** WARNING(ZipUtil::Uncompress): open " << tmpFile << " failed" << endl;
+        fclose(fpIn);
+
+        return false;
+    }
+
+    ZipUtil zip;
+    zip.Open([fpOut](const char *buff, size_t n) { return fwrite(buff, 1, n, fpOut) == n; });
+    std::vector<char> buff(MAXOUTBUFF);
+    bool ok = true;
+    while (ok && (n = fread(&buff[0], 1, buff.size(), fpIn)) > 0) ok = zip.Write(&buff[0], n);
+    ok = zip.Close() && ok;
+    fclose(fpIn);
+    if (fclose(fpOut) != 0) ok = false;
+
+    if (ok) ok = FileUtil::Rename(tmpFile, outFile);
+    if (ok) remove(compFile.c_str());
+    else
+    {
+        remove(tmpFile.c_str());
+        cerr << "*** WARNING(ZipUtil::Uncompress): decompress " << compFile << " failed" << endl;
+    }
+
+    return ok;
+} /* end of Uncompress */
+
+/**
+* @brief   : Crc32 - update CRC32 with the bytes
+* @param[I]: crc (CRC32 of the previous bytes, 0 for the first bytes)
+* @param[I]: buff (bytes)
+* @param[I]: n (number of bytes)
+* @param[O]: none
+* @return  : CRC32 with the bytes
+* @note    : it is the same as 'crc32' of zlib and the trailer of gzip member
+**/
+unsigned long ZipUtil::Crc32(unsigned long crc, const char *buff, size_t n)
+{
+    return ~Crc32Update(~crc & 0xffffffffUL, (const unsigned char *)buff, n) & 0xffffffffUL;
+} /* end of Crc32 */
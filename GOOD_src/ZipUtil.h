@@ -0,0 +1,224 @@
+/*------------------------------------------------------------------------------
+* ZipUtil.h : header file of ZipUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class ZipUtil
+{
+public:
+
+    /* the receiver of the decompressed bytes, return false to abort the decompression */
+    typedef std::function<bool(const char *buff, size_t n)> sink_t;
+
+private:
+
+    struct huff_t
+    {                             /* the look-up table of one Huffman code */
+        std::vector<unsigned short> table;  /* indexed by the next 'nbits' bits, (symbol << 4) | code length, 0: invalid */
+        int nbits;                /* the maximum code length */
+    };
+
+    enum
+    {                             /* the state of the decompression */
+        ZIP_MAGIC,                /* the magic number of the next gzip member or the 'compress' stream */
+        ZIP_GZHEAD,               /* the header of gzip member */
+        ZIP_BLOCK,                /* the header of deflate block */
+        ZIP_STORED,               /* the bytes of stored block */
+        ZIP_CODES,                /* the codes of Huffman compressed block */
+        ZIP_GZTAIL,               /* the trailer (CRC32 and size) of gzip member */
+        ZIP_LZW,                  /* the codes of 'compress' (LZW) */
+        ZIP_END                   /* the end of the stream */
+    };
+
+    sink_t _sink;                 /* the receiver of the decompressed bytes */
+    std::vector<unsigned char> _in;  /* the compressed bytes received, from the first one NOT consumed */
+    size_t _pos;                  /* the next byte in _in to be loaded into the bit buffer */
+    unsigned long long _bitBuf;   /* the bit buffer, the least significant bit is the next one */
+    int _bitCnt;                  /* number of the bits in the bit buffer */
+    bool _final;                  /* true: all the compressed bytes have been received */
+    std::vector<unsigned char> _out;  /* the window of the decompressed bytes */
+    size_t _nout;                 /* number of the bytes in the window */
+    size_t _nflush;               /* number of the bytes in the window given to the receiver */
+    int _state;                   /* the state of the decompression */
+    int _nmember;                 /* number of the gzip members or 'compress' streams finished */
+    bool _lastBlock;              /* true: the current deflate block is the last one of the member */
+    long _nstored;                /* number of the bytes of the stored block NOT yet copied */
+    huff_t _lit;                  /* Huffman code of the literals/lengths */
+    huff_t _dist;                 /* Huffman code of the distances */
+    unsigned long _crc;           /* CRC32 of the decompressed bytes of the member */
+    unsigned long long _nmemb;    /* number of the decompressed bytes of the member */
+    int _maxBits;                 /* the maximum code width of 'compress' */
+    bool _blockMode;              /* true: the code 256 clears the table of 'compress' */
+    int _nbits;                   /* the current code width of 'compress' */
+    int _freeEnt;                 /* the next free entry of the table of 'compress' */
+    int _oldCode;                 /* the previous code of 'compress', -1: none */
+    unsigned char _finChar;       /* the first character of the previous string of 'compress' */
+    long _ncode;                  /* number of the codes read in the current code width of 'compress' */
+    std::vector<unsigned short> _prefix;  /* the table of 'compress', the prefix code of each entry */
+    std::vector<unsigned char> _suffix;   /* the table of 'compress', the last character of each entry */
+    std::vector<unsigned char> _stack;    /* the string being decoded (reversed) */
+    bool _ok;                     /* false: the decompression failed */
+
+private:
+
+    /**
+    * @brief   : Need - check if the bits are available in the bit buffer, loading the bytes received
+    * @param[I]: n (number of the bits, up to 57)
+    * @param[O]: none
+    * @return  : true: available, false: NOT available
+    * @note    :
+    **/
+    bool Need(int n);
+
+    /**
+    * @brief   : Bits - take the bits from the bit buffer
+    * @param[I]: n (number of the bits, up to 57)
+    * @param[O]: none
+    * @return  : the bits, the first one is the least significant bit
+    * @note    : Need(n) should be true
+    **/
+    unsigned long Bits(int n);
+
+    /**
+    * @brief   : Unload - put the whole bytes in the bit buffer back to the received bytes
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the bits of the partial byte are dropped
+    **/
+    void Unload();
+
+    /**
+    * @brief   : Build - build the look-up table of Huffman code from the code lengths
+    * @param[I]: lens (the code lengths of the symbols, 0: NOT used)
+    * @param[I]: n (number of the symbols)
+    * @param[O]: huff (the look-up table)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    static bool Build(const unsigned char *lens, int n, huff_t &huff);
+
+    /**
+    * @brief   : Decode - decode one symbol of Huffman code
+    * @param[I]: huff (the look-up table)
+    * @param[O]: none
+    * @return  : the symbol, -1: invalid code
+    * @note    : Need(huff.nbits) should be called before
+    **/
+    int Decode(const huff_t &huff);
+
+    /**
+    * @brief   : Put - put one decompressed byte into the window
+    * @param[I]: c (the byte)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Put(unsigned char c);
+
+    /**
+    * @brief   : Flush - give the decompressed bytes to the receiver
+    * @param[I]: keep (number of the bytes at the end of the window to be kept for the back references)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Flush(size_t keep);
+
+    /**
+    * @brief   : GzHead - read the header of gzip member
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : 1:ok, 0:more bytes needed, -1:error
+    * @note    :
+    **/
+    int GzHead();
+
+    /**
+    * @brief   : Block - read the header of deflate block (and the Huffman codes of dynamic block)
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Block();
+
+    /**
+    * @brief   : Codes - decode the codes of Huffman compressed block
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : it returns at the end of the block or when the bytes received are nearly used up
+    **/
+    bool Codes();
+
+    /**
+    * @brief   : Lzw - decode the codes of 'compress'
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : it returns at the end of the stream or when the bytes received are nearly used up
+    **/
+    bool Lzw();
+
+    /**
+    * @brief   : Run - decompress the bytes received as far as possible
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Run();
+
+public:
+    ZipUtil();
+    ~ZipUtil();
+
+    /**
+    * @brief   : Open - start decompressing a stream of gzip or 'compress' (the format is told by the magic number)
+    * @param[I]: sink (the receiver of the decompressed bytes)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Open(const sink_t &sink);
+
+    /**
+    * @brief   : Write - feed the compressed bytes
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the bytes may be split anywhere
+    **/
+    bool Write(const char *buff, size_t n);
+
+    /**
+    * @brief   : Close - finish decompressing the stream
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: the stream is decompressed completely, false: error or truncated stream
+    * @note    :
+    **/
+    bool Close();
+
+    /**
+    * @brief   : Uncompress - decompress '*.gz' or '*.Z' file, and remove it
+    * @param[I]: compFile (the compressed file with full path, i.e., "igs21906.sp3.Z")
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : it is the counterpart of 'gzip -d -f compFile', and the decompressed file is NOT created on error
+    **/
+    static bool Uncompress(const string &compFile);
+
+    /**
+    * @brief   : Crc32 - update CRC32 with the bytes
+    * @param[I]: crc (CRC32 of the previous bytes, 0 for the first bytes)
+    * @param[I]: buff (bytes)
+    * @param[I]: n (number of bytes)
+    * @param[O]: none
+    * @return  : CRC32 with the bytes
+    * @note    : it is the same as 'crc32' of zlib and the trailer of gzip member
+    **/
+    static unsigned long Crc32(unsigned long crc, const char *buff, size_t n);
+};
@@ -53,8 +53,20 @@ int main(int argc, char * argv[])
     _setmaxstdio(8192);   /* to open many files */
 #endif
 
+    /* "run_GOOD cfgFile --plan" prints the jobs planned without downloading, "run_GOOD cfgFile --watch" keeps
+       polling the ultra-rapid products and the hourly observations as they are published, and "run_GOOD cfgFile
+       --proxy" serves the remote files to the other GOOD on the LAN */
+    runopt_t ropt;
+    ropt.planOnly = ropt.watch = ropt.proxy = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--plan") == 0) ropt.planOnly = true;
+        else if (strcmp(argv[i], "--watch") == 0) ropt.watch = true;
+        else if (strcmp(argv[i], "--proxy") == 0) ropt.proxy = true;
+    }
+
     PreProcess preProc;
-    preProc.run(cfgFile);
+    preProc.run(cfgFile, ropt);
 
 #ifdef _WIN32  /* for Windows */
     /*cout << "Press any key to exit!" << endl;